@@ -0,0 +1,105 @@
+//
+// File: bench_contingency.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/Stat/ContingencyTableBatch.h>
+#include <Bpp/Numeric/Stat/ContingencyTableTest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+// Throughput of the tests on many small contingency tables: one
+// ContingencyTableTest object per table, compared to ContingencyTableBatch.
+// Output: one tab-separated line per method and table size, with the number
+// of tables, the elapsed time in seconds and the throughput in millions of tables per second.
+
+double sink = 0;
+
+void report(const string& name, size_t dim, size_t n, chrono::steady_clock::time_point start)
+{
+  double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << name << "\t" << dim << "x" << dim << "\t" << n << "\t" << s << "\t" << static_cast<double>(n) / s / 1e6 << endl;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = (argc > 1 ? static_cast<size_t>(stoul(argv[1])) : 1000000);
+  RandomTools::setSeed(1);
+  cout << "method\tsize\ttables\tseconds\tMtables_per_second" << endl;
+
+  for (size_t dim = 2; dim <= 4; ++dim)
+  {
+    size_t nbCells = dim * dim;
+    vector<size_t> counts(nbCells * n);
+    for (size_t k = 0; k < counts.size(); ++k)
+      counts[k] = 1 + static_cast<size_t>(RandomTools::giveIntRandomNumberBetweenZeroAndEntry<int>(30));
+
+    auto start = chrono::steady_clock::now();
+    vector< vector<size_t> > table(dim, vector<size_t>(dim));
+    for (size_t t = 0; t < n; ++t)
+    {
+      for (size_t i = 0; i < dim; ++i)
+        for (size_t j = 0; j < dim; ++j)
+          table[i][j] = counts[(i * dim + j) * n + t];
+      ContingencyTableTest test(table, 0, false);
+      sink += test.getPValue();
+    }
+    report("chisq_per_table", dim, n, start);
+
+    start = chrono::steady_clock::now();
+    ContingencyTableBatch batch(dim, dim);
+    vector<double> stats, pvalues;
+    batch.chiSquareTests(counts, n, stats, pvalues);
+    sink += pvalues[0];
+    report("chisq_batch", dim, n, start);
+
+    if (dim == 2)
+    {
+      start = chrono::steady_clock::now();
+      batch.fisherExactTests(counts, n, pvalues);
+      sink += pvalues[0];
+      report("fisher_batch", dim, n, start);
+    }
+  }
+  return (sink == 0 ? 1 : 0);
+}
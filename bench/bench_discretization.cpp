@@ -0,0 +1,157 @@
+//
+// File: bench_discretization.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Prob/AbstractDiscreteDistribution.h>
+#include <Bpp/Numeric/Prob/BetaDiscreteDistribution.h>
+#include <Bpp/Numeric/Prob/GammaDiscreteDistribution.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace bpp;
+using namespace std;
+
+// Throughput of the discretization of Gamma and Beta distributions, as
+// performed during the optimization of the shape parameter: alpha follows
+// a random walk and the distribution is discretized at each step.
+// The default path, with the scalar quantile functions, is compared to the
+// full-precision batched functions of RandomTools, with and without starting
+// from the quantiles of the previous step.
+// Output: one tab-separated line per method, with the number of discretizations,
+// the elapsed time in seconds and the throughput in discretizations per second.
+
+double sink = 0;
+
+class BatchedGamma:
+  public GammaDiscreteDistribution
+{
+private:
+  bool warmStart_;
+  mutable Vdouble probs_, quantiles_;
+
+public:
+  BatchedGamma(size_t n, double alpha, double beta, bool warmStart):
+    GammaDiscreteDistribution(n, alpha, beta), warmStart_(warmStart), probs_(), quantiles_()
+  {}
+
+  void qProbs(const Vdouble& x, Vdouble& quantiles) const
+  {
+    // Only the bounds are warm-started, the probabilities of the medians differ:
+    bool warm = warmStart_ && x == probs_;
+    probs_ = x;
+    RandomTools::qGamma(x, getParameterValue("alpha"), getParameterValue("beta"), quantiles_, warm);
+    quantiles = quantiles_;
+  }
+
+  void Expectations(const Vdouble& a, Vdouble& expectations) const
+  {
+    double alpha = getParameterValue("alpha"), beta = getParameterValue("beta");
+    RandomTools::pGamma(a, alpha + 1, beta, expectations);
+    for (size_t i = 0; i < a.size(); i++)
+      expectations[i] *= alpha / beta;
+  }
+};
+
+class BatchedBeta:
+  public BetaDiscreteDistribution
+{
+private:
+  bool warmStart_;
+  mutable Vdouble probs_, quantiles_;
+
+public:
+  BatchedBeta(size_t n, double alpha, double beta, bool warmStart):
+    BetaDiscreteDistribution(n, alpha, beta), warmStart_(warmStart), probs_(), quantiles_()
+  {}
+
+  void qProbs(const Vdouble& x, Vdouble& quantiles) const
+  {
+    bool warm = warmStart_ && x == probs_;
+    probs_ = x;
+    RandomTools::qBeta(x, getParameterValue("alpha"), getParameterValue("beta"), quantiles_, warm);
+    quantiles = quantiles_;
+  }
+
+  void Expectations(const Vdouble& a, Vdouble& expectations) const
+  {
+    double alpha = getParameterValue("alpha"), beta = getParameterValue("beta");
+    RandomTools::pBeta(a, alpha + 1, beta, expectations);
+    for (size_t i = 0; i < a.size(); i++)
+      expectations[i] *= alpha / (alpha + beta);
+  }
+};
+
+void run(const string& name, AbstractDiscreteDistribution& dist, size_t n)
+{
+  RandomTools::setSeed(1);
+  double alpha = 1.;
+  auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i)
+  {
+    alpha *= exp(RandomTools::randGaussian(0., 0.0025));
+    if (alpha < 0.1 || alpha > 10.) alpha = 1.;
+    dist.setParameterValue("alpha", alpha);
+    sink += dist.getCategory(0);
+  }
+  double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << name << "\t" << n << "\t" << s << "\t" << static_cast<double>(n) / s << endl;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = (argc > 1 ? static_cast<size_t>(stoul(argv[1])) : 20000);
+  size_t nbCategories = (argc > 2 ? static_cast<size_t>(stoul(argv[2])) : 8);
+  cout << "method\tdiscretizations\tseconds\tdiscretizations_per_second" << endl;
+
+  GammaDiscreteDistribution gammaScalar(nbCategories, 1., 1.);
+  run("gamma_scalar", gammaScalar, n);
+  BatchedGamma gammaBatched(nbCategories, 1., 1., false);
+  run("gamma_batched", gammaBatched, n);
+  BatchedGamma gammaWarm(nbCategories, 1., 1., true);
+  run("gamma_batched_warm", gammaWarm, n);
+  BetaDiscreteDistribution betaScalar(nbCategories, 1., 1.);
+  run("beta_scalar", betaScalar, n);
+  BatchedBeta betaBatched(nbCategories, 1., 1., false);
+  run("beta_batched", betaBatched, n);
+  BatchedBeta betaWarm(nbCategories, 1., 1., true);
+  run("beta_batched_warm", betaWarm, n);
+  return (sink == 0 ? 1 : 0);
+}
@@ -0,0 +1,278 @@
+//
+// File: bench_graph.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Graph/AssociationDAGraphImplObserver.h>
+#include <Bpp/Graph/AssociationTreeGraphImplObserver.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace bpp;
+using namespace std;
+
+// Time of the main operations of the graph layer on trees and DAGs of
+// increasing size, with the GlobalGraph and CompactGraph implementations.
+// Workloads: random trees (each node under a uniformly chosen former node),
+// balanced binary trees, caterpillar trees (a path with one leaf on each
+// node), and random DAGs (each node under one or two former nodes).
+// Usage: bench_graph [maxNodes [workload]], sizes going from 10^3 to maxNodes.
+// Output: one tab-separated line per operation, with the workload, the
+// implementation, the number of nodes, the operation, the number of times
+// it was performed, the elapsed time in seconds and the peak resident set
+// size of the process so far in kB (0 when not available).
+// For the peak memory of a single workload, run it alone in a process.
+
+typedef AssociationTreeGlobalGraphObserver<unsigned int, double> TreeGlobalObserver;
+typedef AssociationTreeCompactGraphObserver<unsigned int, double> TreeCompactObserver;
+typedef AssociationDAGlobalGraphObserver<unsigned int, double> DAGlobalObserver;
+typedef AssociationDAGCompactGraphObserver<unsigned int, double> DAGCompactObserver;
+
+int status = 0;
+size_t sink = 0;
+
+size_t getPeakRSS()
+{
+#if defined(_WIN32)
+  return 0;
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+class Timer
+{
+private:
+  string workload_;
+  string impl_;
+  size_t nbNodes_;
+  chrono::steady_clock::time_point start_;
+
+public:
+  Timer(const string& workload, const string& impl, size_t nbNodes) :
+    workload_(workload), impl_(impl), nbNodes_(nbNodes), start_(chrono::steady_clock::now()) {}
+
+  void start() { start_ = chrono::steady_clock::now(); }
+
+  // print the time since the last start, and start again
+  void report(const string& operation, size_t count)
+  {
+    double s = chrono::duration<double>(chrono::steady_clock::now() - start_).count();
+    cout << workload_ << "\t" << impl_ << "\t" << nbNodes_ << "\t" << operation << "\t" << count << "\t" << s << "\t" << getPeakRSS() << endl;
+    start_ = chrono::steady_clock::now();
+  }
+};
+
+size_t pick(size_t n)
+{
+  return RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(n);
+}
+
+template<class Obs>
+void benchTree(const string& workload, const string& impl, const vector<size_t>& fathers)
+{
+  size_t n = fathers.size();
+  vector<shared_ptr<unsigned int> > nodes(n);
+  vector<shared_ptr<double> > branches(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    nodes[i] = make_shared<unsigned int>(static_cast<unsigned int>(i));
+    branches[i] = make_shared<double>(1.);
+  }
+  Timer timer(workload, impl, n);
+
+  {
+    timer.start();
+    Obs tree(true);
+    tree.createNode(nodes[0]);
+    for (size_t i = 1; i < n; i++)
+      tree.createNode(nodes[fathers[i]], nodes[i], branches[i]);
+    timer.report("build", 1);
+  }
+
+  timer.start();
+  Obs tree(true);
+  tree.createNodesFromFathers(nodes, fathers, branches);
+  timer.report("build_bulk", 1);
+
+  if (!tree.getGraph()->isTree())
+    status = 1;
+  timer.report("is_tree", 1);
+
+  sink += tree.getGraph()->getTreeIndex().getNumberOfNodes();
+  timer.report("index", 1);
+
+  sink += tree.getLeavesUnderNode(tree.getRoot()).size();
+  timer.report("leaves", 1);
+
+  sink += *tree.MRCA(nodes[pick(n)], nodes[pick(n)]);
+  timer.report("mrca_table", 1);
+
+  size_t nbQueries = 100000;
+  for (size_t i = 0; i < nbQueries; i++)
+    sink += *tree.MRCA(nodes[pick(n)], nodes[pick(n)]);
+  timer.report("mrca", nbQueries);
+
+  size_t nbSubtrees = 10;
+  for (size_t i = 0; i < nbSubtrees; i++)
+    sink += tree.getSubtreeNodes(nodes[pick(n)]).size();
+  timer.report("subtree_nodes", nbSubtrees);
+
+  size_t nbReroots = 100;
+  for (size_t i = 0; i < nbReroots; i++)
+    tree.rootAt(nodes[pick(n)]);
+  sink += tree.getDepth(nodes[0]);
+  timer.report("root_at", nbReroots);
+
+  for (size_t i = 0; i < n; i++)
+    sink += *tree.getNodeFromGraphid(tree.getNodeGraphid(nodes[i]));
+  timer.report("lookup", 2 * n);
+
+  Obs copy(tree);
+  sink += copy.getNumberOfNodes();
+  timer.report("copy", 1);
+}
+
+template<class Obs>
+void benchDAG(const string& workload, const string& impl, size_t n, const vector<pair<size_t, size_t> >& links)
+{
+  vector<shared_ptr<unsigned int> > nodes(n);
+  vector<shared_ptr<double> > branches(links.size());
+  for (size_t i = 0; i < n; i++)
+    nodes[i] = make_shared<unsigned int>(static_cast<unsigned int>(i));
+  for (size_t i = 0; i < links.size(); i++)
+    branches[i] = make_shared<double>(1.);
+  Timer timer(workload, impl, n);
+
+  {
+    timer.start();
+    Obs dag;
+    for (size_t i = 0; i < n; i++)
+      dag.createNode(nodes[i]);
+    for (size_t i = 0; i < links.size(); i++)
+      dag.link(nodes[links[i].first], nodes[links[i].second], branches[i]);
+    dag.setRoot(nodes[0]);
+    timer.report("build", 1);
+  }
+
+  timer.start();
+  Obs dag;
+  dag.createNodesAndLinks(nodes, links, branches);
+  dag.setRoot(nodes[0]);
+  timer.report("build_bulk", 1);
+
+  if (!dag.getGraph()->isDA())
+    status = 1;
+  timer.report("is_da", 1);
+
+  sink += dag.getGraph()->getTraversalSchedule().getNumberOfLevels();
+  timer.report("schedule", 1);
+
+  dag.getGraph()->parallelPostOrder([](Graph::NodeId node, unsigned int) { sink += node; }, 1);
+  timer.report("post_order", 1);
+
+  for (size_t i = 0; i < n; i++)
+    sink += *dag.getNodeFromGraphid(dag.getNodeGraphid(nodes[i]));
+  timer.report("lookup", 2 * n);
+
+  Obs copy(dag);
+  sink += copy.getNumberOfNodes();
+  timer.report("copy", 1);
+}
+
+int main(int argc, char** argv)
+{
+  size_t nMax = (argc > 1 ? static_cast<size_t>(stoul(argv[1])) : 100000);
+  string only = (argc > 2 ? argv[2] : "");
+  cout << "workload\timpl\tnodes\toperation\tcount\tseconds\tpeak_rss_kb" << endl;
+  for (size_t n = 1000; n <= nMax; n *= 10)
+  {
+    RandomTools::setSeed(1);
+    vector<size_t> fathers(n, 0);
+    if (only.empty() || only == "random")
+    {
+      for (size_t i = 1; i < n; i++)
+        fathers[i] = pick(i);
+      benchTree<TreeGlobalObserver>("random", "GlobalGraph", fathers);
+      benchTree<TreeCompactObserver>("random", "CompactGraph", fathers);
+    }
+    if (only.empty() || only == "balanced")
+    {
+      for (size_t i = 1; i < n; i++)
+        fathers[i] = (i - 1) / 2;
+      benchTree<TreeGlobalObserver>("balanced", "GlobalGraph", fathers);
+      benchTree<TreeCompactObserver>("balanced", "CompactGraph", fathers);
+    }
+    if (only.empty() || only == "caterpillar")
+    {
+      for (size_t i = 1; i < n; i++)
+        fathers[i] = (i % 2 == 0) ? i - 2 : i - 1;
+      benchTree<TreeGlobalObserver>("caterpillar", "GlobalGraph", fathers);
+      benchTree<TreeCompactObserver>("caterpillar", "CompactGraph", fathers);
+    }
+    if (only.empty() || only == "dag")
+    {
+      vector<pair<size_t, size_t> > links;
+      for (size_t i = 1; i < n; i++)
+      {
+        size_t first = pick(i);
+        links.push_back(pair<size_t, size_t>(first, i));
+        size_t second = pick(i);
+        if (second != first && RandomTools::flipCoin())
+          links.push_back(pair<size_t, size_t>(second, i));
+      }
+      benchDAG<DAGlobalObserver>("dag", "GlobalGraph", n, links);
+      benchDAG<DAGCompactObserver>("dag", "CompactGraph", n, links);
+    }
+  }
+  return status;
+}
@@ -0,0 +1,84 @@
+//
+// File: bench_kde.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/VectorTools.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace bpp;
+using namespace std;
+
+// Time of the estimation of continuous entropy and mutual information on
+// Gaussian samples of increasing size, using adaptive kernel density estimation.
+// Arguments: the largest sample size, the tolerance of the densities (0 for
+// the exact estimator) and the number of threads.
+// Output: one tab-separated line per estimate, with the sample size,
+// the elapsed time in seconds and the estimated value.
+
+int main(int argc, char** argv)
+{
+  size_t nMax = (argc > 1 ? static_cast<size_t>(stoul(argv[1])) : 100000);
+  double tolerance = (argc > 2 ? stod(argv[2]) : 1e-3);
+  unsigned int nbThreads = (argc > 3 ? static_cast<unsigned int>(stoul(argv[3])) : 1);
+  cout << "estimate\tn\tseconds\tvalue" << endl;
+  RandomTools::setSeed(1);
+  int status = 0;
+  for (size_t n = 1000; n <= nMax; n *= 10)
+  {
+    vector<double> v1(n), v2(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      v1[i] = RandomTools::randGaussian(0., 1.);
+      v2[i] = 0.5 * v1[i] + RandomTools::randGaussian(0., 0.75);
+    }
+    auto start = chrono::steady_clock::now();
+    double h = VectorTools::shannonContinuous<double, double>(v1, exp(1.), tolerance, nbThreads);
+    double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "entropy\t" << n << "\t" << s << "\t" << h << endl;
+    start = chrono::steady_clock::now();
+    double mi = VectorTools::miContinuous<double, double>(v1, v2, exp(1.), tolerance, nbThreads);
+    s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "mutual_information\t" << n << "\t" << s << "\t" << mi << endl;
+    if (std::isnan(h) || std::isnan(mi)) status = 1;
+  }
+  return status;
+}
@@ -0,0 +1,104 @@
+//
+// File: bench_random.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/Random/Uniform01K.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+// Throughput of the bulk random generation functions, compared to successive
+// calls to the one-value functions.
+// Output: one tab-separated line per method, with the number of draws,
+// the elapsed time in seconds and the throughput in millions of draws per second.
+
+double sink = 0;
+
+void run(const string& name, size_t n, const function<void (vector<double>&)>& f)
+{
+  vector<double> v(n);
+  f(v); //Warm-up
+  auto start = chrono::steady_clock::now();
+  f(v);
+  double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  for (size_t i = 0; i < n; i += 997)
+    sink += v[i];
+  cout << name << "\t" << n << "\t" << s << "\t" << static_cast<double>(n) / s / 1e6 << endl;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = (argc > 1 ? static_cast<size_t>(stoul(argv[1])) : 10000000);
+  RandomTools::setSeed(1);
+  Uniform01K knuth(1);
+  cout << "method\tdraws\tseconds\tMdraws_per_second" << endl;
+
+  run("uniform_Uniform01K_per_call", n, [&knuth](vector<double>& v) {
+      for (size_t i = 0; i < v.size(); ++i) v[i] = RandomTools::giveRandomNumberBetweenZeroAndEntry(1., knuth);
+    });
+  run("uniform_per_call", n, [](vector<double>& v) {
+      for (size_t i = 0; i < v.size(); ++i) v[i] = RandomTools::giveRandomNumberBetweenZeroAndEntry(1.);
+    });
+  run("uniform_bulk", n, [](vector<double>& v) { RandomTools::fillUniform(v.data(), v.size()); });
+
+  run("gaussian_per_call", n, [](vector<double>& v) {
+      for (size_t i = 0; i < v.size(); ++i) v[i] = RandomTools::randGaussian(0., 1.);
+    });
+  run("gaussian_bulk", n, [](vector<double>& v) { RandomTools::fillGaussian(v.data(), v.size()); });
+
+  run("exponential_per_call", n, [](vector<double>& v) {
+      for (size_t i = 0; i < v.size(); ++i) v[i] = RandomTools::randExponential(1.);
+    });
+  run("exponential_bulk", n, [](vector<double>& v) { RandomTools::fillExponential(v.data(), v.size()); });
+
+  for (double alpha : {0.5, 2.5}) {
+    string a = (alpha < 1 ? "0.5" : "2.5");
+    run("gamma" + a + "_per_call", n, [alpha](vector<double>& v) {
+        for (size_t i = 0; i < v.size(); ++i) v[i] = RandomTools::randGamma(alpha);
+      });
+    run("gamma" + a + "_bulk", n, [alpha](vector<double>& v) { RandomTools::fillGamma(v.data(), v.size(), alpha); });
+  }
+  cerr << "checksum: " << sink << endl;
+  return 0;
+}
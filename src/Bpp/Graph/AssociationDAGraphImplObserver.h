@@ -64,6 +64,9 @@ public:
   typedef typename Graph::NodeId NodeGraphid;
   typedef typename Graph::EdgeId EdgeGraphid;
 
+  typedef typename AssociationGraphImplObserver<N, E, DAGraphImpl>::NodeObjectRange NodeObjectRange;
+  typedef typename AssociationGraphImplObserver<N, E, DAGraphImpl>::EdgeObjectRange EdgeObjectRange;
+
 public:
   /**
    * Constructor
@@ -157,7 +160,17 @@ public:
 
   std::vector<std::shared_ptr<N> > getFathers(const std::shared_ptr<N>  node) const
   {
-    return this->getNodesFromGraphid(this->getGraph()->getFathers(this->getNodeGraphid(node)));
+    return this->objectsOf_(fatherRange(node));
+  }
+
+  /**
+   * Get a range on the fathers of a node, see
+   * AssociationGraphImplObserver::incomingNeighborRange.
+   */
+
+  NodeObjectRange fatherRange(const std::shared_ptr<N> node) const
+  {
+    return this->nodeObjectRange_(this->getGraph()->fatherRange(this->getNodeGraphid(node)));
   }
 
   std::vector<NodeIndex> getFathers(const NodeIndex node) const
@@ -195,7 +208,17 @@ public:
 
   std::vector<std::shared_ptr<N> > getSons(const std::shared_ptr<N> node) const
   {
-    return this->getNodesFromGraphid(this->getGraph()->getSons(this->getNodeGraphid(node)));
+    return this->objectsOf_(sonRange(node));
+  }
+
+  /**
+   * Get a range on the sons of a node, see
+   * AssociationGraphImplObserver::outgoingNeighborRange.
+   */
+
+  NodeObjectRange sonRange(const std::shared_ptr<N> node) const
+  {
+    return this->nodeObjectRange_(this->getGraph()->sonRange(this->getNodeGraphid(node)));
   }
 
   std::vector<NodeIndex> getSons(const NodeIndex node) const
@@ -409,6 +432,9 @@ public:
 template<class N, class E>
 using AssociationDAGlobalGraphObserver =  AssociationDAGraphImplObserver<N, E, DAGlobalGraph>;
 
+template<class N, class E>
+using AssociationDAGCompactGraphObserver =  AssociationDAGraphImplObserver<N, E, DAGCompactGraph>;
+
 /********************/
 }
 
@@ -46,6 +46,7 @@
 #include <memory>
 #include <ostream>
 #include <fstream>
+#include <functional>
 #include <type_traits>
 #include <vector>
 #include <algorithm>
@@ -54,10 +55,54 @@
 #include "../Exceptions.h"
 #include "../Text/TextTools.h"
 #include "AssociationGraphObserver.h"
+#include "BinaryGraphFormat.h"
+#include "CompactGraph.h"
 #include "GlobalGraph.h"
+#include "PointerHashMap.h"
 
 namespace bpp
 {
+/**
+ * @brief An iterator on the objects associated to a range of graph ids.
+ *
+ * Ids are mapped to objects when the iterator is dereferenced, and ids
+ * with no associated object are skipped.
+ */
+template<class IdIterator, class T>
+class AssociatedObjectIterator
+{
+private:
+  IdIterator it_;
+  IdIterator end_;
+  const std::vector<std::shared_ptr<T> >* objects_;
+
+  bool isAssociated_() const
+  {
+    size_t id = static_cast<size_t>(*it_);
+    return id < objects_->size() && (*objects_)[id];
+  }
+
+  void skip_() { while (it_ != end_ && !isAssociated_()) ++it_; }
+
+public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef std::shared_ptr<T> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const value_type* pointer;
+  typedef const value_type& reference;
+
+  AssociatedObjectIterator(IdIterator it, IdIterator end, const std::vector<std::shared_ptr<T> >& objects) :
+    it_(it), end_(end), objects_(&objects) { skip_(); }
+
+  reference operator*() const { return (*objects_)[static_cast<size_t>(*it_)]; }
+
+  AssociatedObjectIterator& operator++() { ++it_; skip_(); return *this; }
+  AssociatedObjectIterator operator++(int) { AssociatedObjectIterator tmp(*this); ++*this; return tmp; }
+
+  bool operator==(const AssociatedObjectIterator& other) const { return it_ == other.it_; }
+  bool operator!=(const AssociatedObjectIterator& other) const { return it_ != other.it_; }
+};
+
 template<class N, class E, class GraphImpl>
 class AssociationGraphImplObserver : public virtual AssociationGraphObserver<N, E>
 {
@@ -70,6 +115,13 @@ public:
 
   using Eref = std::shared_ptr<E>;
   using Nref = std::shared_ptr<N>;
+
+  /**
+   * Ranges on the objects associated to the neighbors of a node, see
+   * nodeObjectRange_ and edgeObjectRange_.
+   */
+  typedef GraphRange<AssociatedObjectIterator<typename GraphImpl::NeighborRange::iterator, N> > NodeObjectRange;
+  typedef GraphRange<AssociatedObjectIterator<typename GraphImpl::EdgeRange::iterator, E> > EdgeObjectRange;
   
 protected:
   /**
@@ -101,12 +153,12 @@ private:
   /**
    * Can find a Node with the corresponding object.
    */
-  std::map<Nref, NodeGraphid> NToGraphid_;
+  PointerHashMap<N, NodeGraphid> NToGraphid_;
 
   /**
    * Can find an Edge with the corresponding object.
    */
-  std::map<Eref, EdgeGraphid> EToGraphid_;
+  PointerHashMap<E, EdgeGraphid> EToGraphid_;
 
   /*
    * @}
@@ -131,12 +183,12 @@ private:
   /**
    * Can find a Node index with the corresponding object.
    */
-  std::map<Nref, NodeIndex> NToIndex_;
+  PointerHashMap<N, NodeIndex> NToIndex_;
 
   /**
    * Can find an Edge index with the corresponding object.
    */
-  std::map<Eref, EdgeIndex> EToIndex_;
+  PointerHashMap<E, EdgeIndex> EToIndex_;
 
   /*
    * @}
@@ -214,11 +266,9 @@ private:
     switch (type)
     {
     case OUTGOING:
-      neighbors = getGraph()->getOutgoingNeighbors(node);
-      break;
+      return objectsOf_(nodeObjectRange_(getGraph()->outgoingNeighborRange(node)));
     case INCOMING:
-      neighbors = getGraph()->getIncomingNeighbors(node);
-      break;
+      return objectsOf_(nodeObjectRange_(getGraph()->incomingNeighborRange(node)));
     case BOTH:
       neighbors = getGraph()->getNeighbors(node);
     }
@@ -237,17 +287,39 @@ private:
     switch (type)
     {
     case OUTGOING:
-      edges = getGraph()->getOutgoingEdges(node);
-      break;
+      return objectsOf_(edgeObjectRange_(getGraph()->outgoingEdgeRange(node)));
     case INCOMING:
-      edges = getGraph()->getIncomingEdges(node);
-      break;
+      return objectsOf_(edgeObjectRange_(getGraph()->incomingEdgeRange(node)));
     case BOTH:
       edges = getGraph()->getEdges(node);
     }
     return getEdgesFromGraphid(edges);
   }
 
+protected:
+  /**
+   * Map a range of graph ids to the associated objects, lazily.
+   * @{
+   */
+  NodeObjectRange nodeObjectRange_(const typename GraphImpl::NeighborRange& nodes) const
+  {
+    typedef typename NodeObjectRange::iterator iterator;
+    return NodeObjectRange(iterator(nodes.begin(), nodes.end(), graphidToN_), iterator(nodes.end(), nodes.end(), graphidToN_));
+  }
+
+  EdgeObjectRange edgeObjectRange_(const typename GraphImpl::EdgeRange& edges) const
+  {
+    typedef typename EdgeObjectRange::iterator iterator;
+    return EdgeObjectRange(iterator(edges.begin(), edges.end(), graphidToE_), iterator(edges.end(), edges.end(), graphidToE_));
+  }
+
+  template<class Range>
+  static std::vector<typename Range::value_type> objectsOf_(const Range& range)
+  {
+    return std::vector<typename Range::value_type>(range.begin(), range.end());
+  }
+  /** @} */
+
 public:
   /**
    * Constructor
@@ -289,12 +361,21 @@ public:
 
   /**
    * Copy Constructor
+   *
+   * The node and edge objects are copied, and the copy observes its own
+   * copy of the graph. Graph implementations share their topology between
+   * copies until one of them is modified, so that the graph itself is
+   * cheap to copy. The observer is not: each object is cloned and the maps
+   * between objects, ids and indexes are rebuilt, in time linear in the
+   * number of objects. Share the observer itself (eg through a shared_ptr)
+   * when the objects do not need to be copied.
+   *
    * @param graphObserver the graphObserver to be copied
    */
 
   template<class N2, class E2>
   AssociationGraphImplObserver(AssociationGraphImplObserver<N2, E2, GraphImpl> const& graphObserver) :
-    subjectGraph_(graphObserver.getGraph()),
+    subjectGraph_(std::shared_ptr<GraphImpl>(new GraphImpl(*graphObserver.getGraph()))),
     graphidToN_(graphObserver.graphidToN_.size()),
     graphidToE_(graphObserver.graphidToE_.size()),
     NToGraphid_(),
@@ -304,6 +385,11 @@ public:
     NToIndex_(),
     EToIndex_()
   {
+    NToGraphid_.reserve(graphObserver.NToGraphid_.size());
+    NToIndex_.reserve(graphObserver.NToIndex_.size());
+    EToGraphid_.reserve(graphObserver.EToGraphid_.size());
+    EToIndex_.reserve(graphObserver.EToIndex_.size());
+
     for (const auto& itN:graphObserver.NToGraphid_)
     {
       Nref node(AssociationGraphObserver<N, E>::template copy<N2, N>(*itN.first));
@@ -340,7 +426,7 @@ public:
   }
 
   AssociationGraphImplObserver(AssociationGraphImplObserver<N, E, GraphImpl> const& graphObserver) :
-    subjectGraph_(graphObserver.subjectGraph_),
+    subjectGraph_(std::shared_ptr<GraphImpl>(new GraphImpl(*graphObserver.subjectGraph_))),
     graphidToN_(graphObserver.graphidToN_.size()),
     graphidToE_(graphObserver.graphidToE_.size()),
     NToGraphid_(),
@@ -350,6 +436,11 @@ public:
     NToIndex_(),
     EToIndex_()
   {
+    NToGraphid_.reserve(graphObserver.NToGraphid_.size());
+    NToIndex_.reserve(graphObserver.NToIndex_.size());
+    EToGraphid_.reserve(graphObserver.EToGraphid_.size());
+    EToIndex_.reserve(graphObserver.EToIndex_.size());
+
     for (const auto& itN:graphObserver.NToGraphid_)
     {
       Nref node(AssociationGraphObserver<N, E>::template copy<N, N>(*itN.first));
@@ -393,10 +484,23 @@ public:
 
   AssociationGraphImplObserver<N, E, GraphImpl>& operator=(bpp::AssociationGraphImplObserver<N, E, GraphImpl> const& graphObserver)
   {
-    this->graphidToN_.resize(graphObserver.graphidToN_.size());
-    this->graphidToE_.resize(graphObserver.graphidToE_.size());
-    this->indexToN_.resize(graphObserver.indexToN_.size());
-    this->indexToE_.resize(graphObserver.indexToE_.size());
+    if (this == &graphObserver)
+      return *this;
+
+    this->graphidToN_.assign(graphObserver.graphidToN_.size(), Nref());
+    this->graphidToE_.assign(graphObserver.graphidToE_.size(), Eref());
+    this->indexToN_.assign(graphObserver.indexToN_.size(), Nref());
+    this->indexToE_.assign(graphObserver.indexToE_.size(), Eref());
+
+    NToGraphid_.clear();
+    NToIndex_.clear();
+    EToGraphid_.clear();
+    EToIndex_.clear();
+
+    NToGraphid_.reserve(graphObserver.NToGraphid_.size());
+    NToIndex_.reserve(graphObserver.NToIndex_.size());
+    EToGraphid_.reserve(graphObserver.EToGraphid_.size());
+    EToIndex_.reserve(graphObserver.EToIndex_.size());
 
     for (const auto& itN:graphObserver.NToGraphid_)
     {
@@ -430,8 +534,8 @@ public:
       }
     }
 
-    this->subjectGraph_ = graphObserver.getGraph();
-
+    this->getGraph()->unregisterObserver(this);
+    this->subjectGraph_ = std::shared_ptr<GraphImpl>(new GraphImpl(*graphObserver.getGraph()));
     this->getGraph()->registerObserver(this);
 
     return *this;
@@ -505,6 +609,92 @@ public:
     link(objectOriginNode, newNodeObject, newEdgeObject);
   }
 
+  /**
+   * Creates nodes and links between them in one pass, from an edge list.
+   *
+   * This is much faster than successive calls to createNode and link
+   * when building a large graph: the graph is built at once, and the
+   * objects are associated without intermediate checks.
+   *
+   * @param nodeObjects the objects of the new nodes, which must not be
+   *        in the graph yet
+   * @param links the links to create, as pairs of positions in nodeObjects.
+   *        If directed graph: first -> second.
+   * @param edgeObjects the objects of the new edges, in the order of links.
+   *        May be empty, or contain null pointers, for edges with no object.
+   * @param withIndexes if true, the new nodes and edges are also given
+   *        indexes, following the highest existing ones.
+   */
+  void createNodesAndLinks(const std::vector<Nref>& nodeObjects, const std::vector<std::pair<size_t, size_t> >& links, const std::vector<Eref>& edgeObjects, bool withIndexes = false)
+  {
+    if (!edgeObjects.empty() && edgeObjects.size() != links.size())
+      throw Exception("AssociationGraphImplObserver::createNodesAndLinks : " + TextTools::toString(edgeObjects.size()) + " edge objects for " + TextTools::toString(links.size()) + " links.");
+    for (const auto& nodeObject : nodeObjects)
+    {
+      if (!nodeObject)
+        throw Exception("AssociationGraphImplObserver::createNodesAndLinks : null node object.");
+      if (hasNode(nodeObject))
+        throw Exception("AssociationGraphImplObserver::createNodesAndLinks : node already exists: " + nodeToString(nodeObject));
+    }
+    for (const auto& edgeObject : edgeObjects)
+    {
+      if (edgeObject && hasEdge(edgeObject))
+        throw Exception("AssociationGraphImplObserver::createNodesAndLinks : edge already exists: " + edgeToString(edgeObject));
+    }
+
+    std::vector<NodeGraphid> newNodes;
+    std::vector<EdgeGraphid> newEdges;
+    getGraph()->createNodesAndLinks(nodeObjects.size(), links, newNodes, newEdges);
+
+    if (!newNodes.empty() && graphidToN_.size() < static_cast<size_t>(newNodes.back()) + 1)
+      graphidToN_.resize(static_cast<size_t>(newNodes.back()) + 1);
+    NToGraphid_.reserve(NToGraphid_.size() + nodeObjects.size());
+    size_t firstNodeIndex = indexToN_.size();
+    if (withIndexes)
+    {
+      indexToN_.resize(firstNodeIndex + nodeObjects.size());
+      NToIndex_.reserve(NToIndex_.size() + nodeObjects.size());
+    }
+    for (size_t i = 0; i < nodeObjects.size(); i++)
+    {
+      if (NToGraphid_.count(nodeObjects[i]))
+        throw Exception("AssociationGraphImplObserver::createNodesAndLinks : the same node object is given twice: " + nodeToString(nodeObjects[i]));
+      graphidToN_[newNodes[i]] = nodeObjects[i];
+      NToGraphid_[nodeObjects[i]] = newNodes[i];
+      if (withIndexes)
+      {
+        indexToN_[firstNodeIndex + i] = nodeObjects[i];
+        NToIndex_[nodeObjects[i]] = static_cast<NodeIndex>(firstNodeIndex + i);
+      }
+    }
+
+    if (edgeObjects.empty())
+      return;
+    if (!newEdges.empty() && graphidToE_.size() < static_cast<size_t>(*std::max_element(newEdges.begin(), newEdges.end())) + 1)
+      graphidToE_.resize(static_cast<size_t>(*std::max_element(newEdges.begin(), newEdges.end())) + 1);
+    EToGraphid_.reserve(EToGraphid_.size() + edgeObjects.size());
+    size_t firstEdgeIndex = indexToE_.size();
+    if (withIndexes)
+    {
+      indexToE_.resize(firstEdgeIndex + edgeObjects.size());
+      EToIndex_.reserve(EToIndex_.size() + edgeObjects.size());
+    }
+    for (size_t i = 0; i < edgeObjects.size(); i++)
+    {
+      if (!edgeObjects[i])
+        continue;
+      if (EToGraphid_.count(edgeObjects[i]))
+        throw Exception("AssociationGraphImplObserver::createNodesAndLinks : the same edge object is given twice: " + edgeToString(edgeObjects[i]));
+      graphidToE_[newEdges[i]] = edgeObjects[i];
+      EToGraphid_[edgeObjects[i]] = newEdges[i];
+      if (withIndexes)
+      {
+        indexToE_[firstEdgeIndex + i] = edgeObjects[i];
+        EToIndex_[edgeObjects[i]] = static_cast<EdgeIndex>(firstEdgeIndex + i);
+      }
+    }
+  }
+
 public:
   /**
    * Creates a link between two existing nodes.
@@ -619,17 +809,15 @@ public:
    */
   void dissociateNode(Nref  nodeObject)
   {
-    typename std::map<Nref, NodeGraphid>::iterator nodeToForget = NToGraphid_.find(nodeObject);
-    graphidToN_.at(nodeToForget->second) = 00;
-    NToGraphid_.erase(nodeToForget);
+    graphidToN_.at(getNodeGraphid(nodeObject)) = 00;
+    NToGraphid_.erase(nodeObject);
   }
 
 
   void dissociateEdge(Eref  edgeObject)
   {
-    typename std::map<Eref, EdgeGraphid>::iterator edgeToForget = EToGraphid_.find(edgeObject);
-    graphidToE_.at(edgeToForget->second) = 00;
-    EToGraphid_.erase(edgeToForget);
+    graphidToE_.at(getEdgeGraphid(edgeObject)) = 00;
+    EToGraphid_.erase(edgeObject);
   }
 
 
@@ -640,7 +828,7 @@ public:
    */
   NodeGraphid getNodeGraphid(const Nref  nodeObject) const
   {
-    typename std::map<Nref, NodeGraphid>::const_iterator found = NToGraphid_.find(nodeObject);
+    auto found = NToGraphid_.find(nodeObject);
     if (found == NToGraphid_.end())
       throw Exception("Unexisting node object: " + TextTools::toString(nodeObject));
     return found->second;
@@ -654,12 +842,38 @@ public:
    */
   EdgeGraphid getEdgeGraphid(const Eref  edgeObject) const
   {
-    typename std::map<Eref, EdgeGraphid>::const_iterator found = EToGraphid_.find(edgeObject);
+    auto found = EToGraphid_.find(edgeObject);
     if (found == EToGraphid_.end())
       throw Exception("Unexisting edge object: " + TextTools::toString(edgeObject));
     return found->second;
   }
 
+  /**
+   * @name Batch conversions, into buffers of the caller.
+   *
+   * The output vector is resized to the size of the input.
+   * @throw Exception if an object is not associated to the graph.
+   * @{
+   */
+  void getNodeGraphids(const std::vector<Nref>& nodeObjects, std::vector<NodeGraphid>& nodes) const
+  {
+    nodes.resize(nodeObjects.size());
+    for (size_t i = 0; i < nodeObjects.size(); i++)
+    {
+      nodes[i] = getNodeGraphid(nodeObjects[i]);
+    }
+  }
+
+  void getEdgeGraphids(const std::vector<Eref>& edgeObjects, std::vector<EdgeGraphid>& edges) const
+  {
+    edges.resize(edgeObjects.size());
+    for (size_t i = 0; i < edgeObjects.size(); i++)
+    {
+      edges[i] = getEdgeGraphid(edgeObjects[i]);
+    }
+  }
+  /** @} */
+
 
   /**
    * Transforms an (a list of) id(s) into an (a list of) object(s)
@@ -678,20 +892,42 @@ public:
     return graphidToN_.at(node);
   }
 
-  std::vector<Nref > getNodesFromGraphid(std::vector<NodeGraphid> nodes) const
+  std::vector<Nref > getNodesFromGraphid(const std::vector<NodeGraphid>& nodes) const
   {
     std::vector<Nref > nodeObjects;
-    for (typename std::vector<NodeGraphid>::iterator currNode = nodes.begin(); currNode != nodes.end(); currNode++)
+    getNodesFromGraphid(nodes, nodeObjects);
+    return nodeObjects;
+  }
+
+  /**
+   * @name Batch conversions, into buffers of the caller.
+   *
+   * The output vector is cleared and filled, so that its memory is reused
+   * from one call to the other. Ids with no associated object are skipped.
+   * @{
+   */
+  void getNodesFromGraphid(const std::vector<NodeGraphid>& nodes, std::vector<Nref>& nodeObjects) const
+  {
+    nodeObjects.clear();
+    nodeObjects.reserve(nodes.size());
+    for (auto node : nodes)
     {
-      if (*currNode > graphidToN_.size())
-        continue;
-      Nref  foundNodeObject = graphidToN_.at(*currNode);
-      if (!foundNodeObject)
-        continue;
-      nodeObjects.push_back(foundNodeObject);
+      if (node < graphidToN_.size() && graphidToN_[node])
+        nodeObjects.push_back(graphidToN_[node]);
+    }
+  }
+
+  void getEdgesFromGraphid(const std::vector<EdgeGraphid>& edges, std::vector<Eref>& edgeObjects) const
+  {
+    edgeObjects.clear();
+    edgeObjects.reserve(edges.size());
+    for (auto edge : edges)
+    {
+      if (edge < graphidToE_.size() && graphidToE_[edge])
+        edgeObjects.push_back(graphidToE_[edge]);
     }
-    return nodeObjects;
   }
+  /** @} */
 
   Eref getEdgeFromGraphid(EdgeGraphid edge)
   {
@@ -709,18 +945,10 @@ public:
     return graphidToE_.at(edge);
   }
 
-  std::vector<Eref > getEdgesFromGraphid(std::vector<EdgeGraphid> edges) const
+  std::vector<Eref > getEdgesFromGraphid(const std::vector<EdgeGraphid>& edges) const
   {
     std::vector<Eref > edgeObjects;
-    for (const auto& currEdge:edges)
-    {
-      if (currEdge > graphidToE_.size())
-        continue;
-      Eref foundEdgeObject = graphidToE_.at(currEdge);
-      if (!foundEdgeObject)
-        continue;
-      edgeObjects.push_back(foundEdgeObject);
-    }
+    getEdgesFromGraphid(edges, edgeObjects);
     return edgeObjects;
   }
 
@@ -776,22 +1004,30 @@ public:
    */
   NodeIndex getNodeIndex(const Nref  nodeObject) const
   {
-    typename std::map<Nref, typename AssociationGraphObserver<N, E>::NodeIndex>::const_iterator found = NToIndex_.find(nodeObject);
+    auto found = NToIndex_.find(nodeObject);
     if (found == NToIndex_.end())
       throw Exception("getNodeIndex: Node object has no index : " + nodeToString(nodeObject));
 
     return found->second;
   }
 
-  std::vector<NodeIndex> getNodeIndexes(std::vector<Nref > nodes) const
+  std::vector<NodeIndex> getNodeIndexes(const std::vector<Nref >& nodes) const
   {
-    std::vector<NodeIndex> nodeIndexes(nodes.size());
-    
-    std::transform(nodes.begin(), nodes.end(), nodeIndexes.begin(), [this](const Nref& nodeObject){return this->getNodeIndex(nodeObject);});
-
+    std::vector<NodeIndex> nodeIndexes;
+    getNodeIndexes(nodes, nodeIndexes);
     return nodeIndexes;
   }
 
+  /**
+   * Batch conversion, into a buffer of the caller, which is resized to
+   * the size of the input.
+   */
+  void getNodeIndexes(const std::vector<Nref >& nodes, std::vector<NodeIndex>& nodeIndexes) const
+  {
+    nodeIndexes.resize(nodes.size());
+    std::transform(nodes.begin(), nodes.end(), nodeIndexes.begin(), [this](const Nref& nodeObject){return this->getNodeIndex(nodeObject);});
+  }
+
   /**
    * Return the associated Node index
    * @param edgeObject object which to return the node index
@@ -805,13 +1041,21 @@ public:
     return found->second;
   }
 
-  std::vector<EdgeIndex> getEdgeIndexes(std::vector<Eref > edges) const
+  std::vector<EdgeIndex> getEdgeIndexes(const std::vector<Eref >& edges) const
   {
-    std::vector<EdgeIndex> edgeIndexes(edges.size());
+    std::vector<EdgeIndex> edgeIndexes;
+    getEdgeIndexes(edges, edgeIndexes);
+    return edgeIndexes;
+  }
 
+  /**
+   * Batch conversion, into a buffer of the caller, which is resized to
+   * the size of the input.
+   */
+  void getEdgeIndexes(const std::vector<Eref >& edges, std::vector<EdgeIndex>& edgeIndexes) const
+  {
+    edgeIndexes.resize(edges.size());
     std::transform(edges.begin(), edges.end(), edgeIndexes.begin(), [this](const Eref& edgeObject){return this->getEdgeIndex(edgeObject);});
-
-    return edgeIndexes;
   }
 
   /**
@@ -874,8 +1118,8 @@ public:
     if (NToIndex_.find(nodeObject)!=NToIndex_.end())
       throw Exception("AssociationGraphImplObserver::addNodeIndex : nodeObject has already an index: " + nodeToString(nodeObject));
 
-    NodeIndex index=indexToN_.size();
-    for (auto i=0;i<indexToN_.size();i++)
+    NodeIndex index=static_cast<NodeIndex>(indexToN_.size());
+    for (NodeIndex i=0;i<indexToN_.size();i++)
       if (!indexToN_.at(i))
       {
         index=i;
@@ -903,8 +1147,8 @@ public:
     if (EToIndex_.find(edgeObject)!=EToIndex_.end())
       throw Exception("AssociationGraphImplObserver::addEdgeIndex : edgeObject has already an index: " + edgeToString(edgeObject));
 
-    EdgeIndex index=indexToE_.size();
-    for (auto i=0;i<indexToE_.size();i++)
+    EdgeIndex index=static_cast<EdgeIndex>(indexToE_.size());
+    for (EdgeIndex i=0;i<indexToE_.size();i++)
       if (!indexToE_.at(i))
       {
         index=i;
@@ -1034,6 +1278,83 @@ public:
     out << "}";
   }
 
+  /**
+   * @brief Write the graph, with the indexes and the objects, in the
+   * binary format of BinaryGraphFormat.
+   *
+   * @param path the name of the file
+   * @param nodeWriter a function serializing a node object in a string.
+   *        If empty, the node objects and indexes are not written.
+   * @param edgeWriter the same for the edge objects.
+   */
+  void writeBinary(const std::string& path,
+                   const std::function<void (const N&, std::string&)>& nodeWriter,
+                   const std::function<void (const E&, std::string&)>& edgeWriter) const
+  {
+    BinaryGraphFormat::ObjectWriter writeNode;
+    BinaryGraphFormat::ObjectWriter writeEdge;
+    if (nodeWriter)
+      writeNode = [this, &nodeWriter](uint32_t id, uint32_t& index, std::string& data)
+      {
+        Nref nodeObject = getNodeFromGraphid(id);
+        if (!nodeObject)
+          return false;
+        if (hasNodeIndex(nodeObject))
+          index = getNodeIndex(nodeObject);
+        nodeWriter(*nodeObject, data);
+        return true;
+      };
+    if (edgeWriter)
+      writeEdge = [this, &edgeWriter](uint32_t id, uint32_t& index, std::string& data)
+      {
+        Eref edgeObject = getEdgeFromGraphid(id);
+        if (!edgeObject)
+          return false;
+        if (hasEdgeIndex(edgeObject))
+          index = getEdgeIndex(edgeObject);
+        edgeWriter(*edgeObject, data);
+        return true;
+      };
+    BinaryGraphFormat::write(*getGraph(), path, writeNode, writeEdge);
+  }
+
+  /**
+   * @brief Read a graph written by writeBinary in this empty observer.
+   *
+   * The graph ids are the same as in the written graph.
+   *
+   * @param path the name of the file
+   * @param nodeReader a function building a node object from its
+   *        serialization. If empty, the node objects are not read.
+   * @param edgeReader the same for the edge objects.
+   */
+  void readBinary(const std::string& path,
+                  const std::function<Nref (const char*, size_t)>& nodeReader,
+                  const std::function<Eref (const char*, size_t)>& edgeReader)
+  {
+    if (getNumberOfNodes() != 0)
+      throw Exception("AssociationGraphImplObserver::readBinary : the graph must be empty.");
+    BinaryGraphFormat::ObjectReader readNode;
+    BinaryGraphFormat::ObjectReader readEdge;
+    if (nodeReader)
+      readNode = [this, &nodeReader](uint32_t id, uint32_t index, const char* data, size_t size)
+      {
+        Nref nodeObject = nodeReader(data, size);
+        associateNode(nodeObject, id);
+        if (index != BinaryGraphFormat::NO_INDEX)
+          setNodeIndex(nodeObject, index);
+      };
+    if (edgeReader)
+      readEdge = [this, &edgeReader](uint32_t id, uint32_t index, const char* data, size_t size)
+      {
+        Eref edgeObject = edgeReader(data, size);
+        associateEdge(edgeObject, id);
+        if (index != BinaryGraphFormat::NO_INDEX)
+          setEdgeIndex(edgeObject, index);
+      };
+    BinaryGraphFormat::read(path, *getGraph(), readNode, readEdge);
+  }
+
   /**
    * @name Iterators on Nodes
    *
@@ -1044,7 +1365,7 @@ public:
     virtual public AssociationGraphObserver<N, E>::NodeIterator
   {
 private:
-    NodesIteratorClass<GraphIterator, is_const> it_;
+    typename GraphImpl::template NodesIterator<GraphIterator, is_const> it_;
     const AssociationGraphImplObserver<N, E, GraphImpl>& agio_;
 
 public:
@@ -1155,9 +1476,38 @@ public:
    */
   std::vector<Nref > getOutgoingNeighbors(const Nref  node) const
   {
-    return getNodesFromGraphid(getGraph()->getOutgoingNeighbors(getNodeGraphid(node)));
+    return objectsOf_(outgoingNeighborRange(node));
   }
 
+  /**
+   * @name Ranges on the objects associated to the neighbors of a node.
+   *
+   * Graph ids are mapped to objects while browsing, with no copy of the
+   * neighbors. Neighbors with no associated object are skipped.
+   * The ranges are invalidated by any modification of the topology.
+   * @{
+   */
+  NodeObjectRange outgoingNeighborRange(const Nref node) const
+  {
+    return nodeObjectRange_(getGraph()->outgoingNeighborRange(getNodeGraphid(node)));
+  }
+
+  NodeObjectRange incomingNeighborRange(const Nref node) const
+  {
+    return nodeObjectRange_(getGraph()->incomingNeighborRange(getNodeGraphid(node)));
+  }
+
+  EdgeObjectRange outgoingEdgeRange(const Nref node) const
+  {
+    return edgeObjectRange_(getGraph()->outgoingEdgeRange(getNodeGraphid(node)));
+  }
+
+  EdgeObjectRange incomingEdgeRange(const Nref node) const
+  {
+    return edgeObjectRange_(getGraph()->incomingEdgeRange(getNodeGraphid(node)));
+  }
+  /** @} */
+
   std::vector<NodeIndex> getOutgoingNeighbors(NodeIndex node) const
   {
     return getNodeIndexes(getOutgoingNeighbors(getNode(node)));
@@ -1171,7 +1521,7 @@ public:
    */
   std::vector<Eref > getOutgoingEdges(const Nref  node) const
   {
-    return getEdgesFromGraphid(getGraph()->getOutgoingEdges(getNodeGraphid(node)));
+    return objectsOf_(outgoingEdgeRange(node));
   }
 
   std::vector<EdgeIndex> getOutgoingEdges(NodeIndex node) const
@@ -1188,7 +1538,7 @@ public:
 
   std::vector<Nref > getIncomingNeighbors(const Nref  node) const
   {
-    return getNodesFromGraphid(getGraph()->getIncomingNeighbors(getNodeGraphid(node)));
+    return objectsOf_(incomingNeighborRange(node));
   }
 
   std::vector<NodeIndex> getIncomingNeighbors(NodeIndex node) const
@@ -1206,7 +1556,7 @@ public:
 
   std::vector<Eref > getIncomingEdges(const Nref  node) const
   {
-    return getEdgesFromGraphid(getGraph()->getIncomingEdges(getNodeGraphid(node)));
+    return objectsOf_(incomingEdgeRange(node));
   }
 
   std::vector<EdgeIndex> getIncomingEdges(NodeIndex node) const
@@ -1334,7 +1684,7 @@ public:
     public AssociationGraphObserver<N, E>::EdgeIterator
   {
   private:
-    EdgesIteratorClass<GraphIterator, is_const> it_;
+    typename GraphImpl::template EdgesIterator<GraphIterator, is_const> it_;
     const AssociationGraphImplObserver<N, E, GraphImpl>& agio_;
     
   public:
@@ -1577,5 +1927,8 @@ public:
 
 template<class N, class E>
 using AssociationGlobalGraphObserver = AssociationGraphImplObserver<N, E, GlobalGraph>;
+
+template<class N, class E>
+using AssociationCompactGraphObserver = AssociationGraphImplObserver<N, E, CompactGraph>;
 }
 #endif // BPP_GRAPH_ASSOCIATIONGRAPHIMPLOBSERVER_H
@@ -215,10 +215,10 @@ public:
   virtual const std::shared_ptr<N>  getNodeFromGraphid(NodeGraphid) const = 0;
   virtual std::shared_ptr<N>  getNodeFromGraphid(NodeGraphid) = 0;
 
-  virtual std::vector<std::shared_ptr<N> > getNodesFromGraphid(std::vector<NodeGraphid> ) const = 0;
+  virtual std::vector<std::shared_ptr<N> > getNodesFromGraphid(const std::vector<NodeGraphid>& ) const = 0;
   virtual std::shared_ptr<E>  getEdgeFromGraphid(EdgeGraphid) = 0;
   virtual const std::shared_ptr<E>  getEdgeFromGraphid(EdgeGraphid) const = 0;
-  virtual std::vector<std::shared_ptr<E> > getEdgesFromGraphid(std::vector<EdgeGraphid> ) const = 0;
+  virtual std::vector<std::shared_ptr<E> > getEdgesFromGraphid(const std::vector<EdgeGraphid>& ) const = 0;
 
 
   /**
@@ -251,7 +251,7 @@ public:
    */
 
   virtual NodeIndex getNodeIndex(const std::shared_ptr<N>  nodeObject) const = 0;
-  virtual std::vector<NodeIndex> getNodeIndexes(std::vector<std::shared_ptr<N> > nodeObjects) const = 0;
+  virtual std::vector<NodeIndex> getNodeIndexes(const std::vector<std::shared_ptr<N> >& nodeObjects) const = 0;
 
 
   /**
@@ -260,7 +260,7 @@ public:
    * @return a node index
    */
   virtual EdgeIndex getEdgeIndex(const std::shared_ptr<E>  edgeObject) const = 0;
-  virtual std::vector<EdgeIndex> getEdgeIndexes(std::vector<std::shared_ptr<E> > edgeObjects) const = 0;
+  virtual std::vector<EdgeIndex> getEdgeIndexes(const std::vector<std::shared_ptr<E> >& edgeObjects) const = 0;
 
   /**
    * Set an index associated to a node
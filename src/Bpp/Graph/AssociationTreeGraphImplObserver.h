@@ -65,6 +65,9 @@ public:
 
   typedef typename Graph::EdgeId EdgeGraphid;
 
+  typedef typename AssociationGraphImplObserver<N, E, TreeGraphImpl>::NodeObjectRange NodeObjectRange;
+  typedef typename AssociationGraphImplObserver<N, E, TreeGraphImpl>::EdgeObjectRange EdgeObjectRange;
+
 public:
   /**
    * Constructor
@@ -129,6 +132,53 @@ public:
   AssociationTreeGraphImplObserver<N, E, TreeGraphImpl>* clone() const { return new AssociationTreeGraphImplObserver<N, E, TreeGraphImpl>(*this); }
 
 
+  /**
+   * Creates a tree from a parent array, in one pass.
+   *
+   * If the tree was empty, the root of the new nodes becomes its root.
+   * See AssociationGraphImplObserver::createNodesAndLinks.
+   *
+   * @param nodeObjects the objects of the new nodes
+   * @param fathers for each node, the position of its father in
+   *        nodeObjects. The root, and only the root, is its own father.
+   * @param branchObjects the branches leading to each node, by position.
+   *        The branch of the root is ignored. May be empty.
+   * @param withIndexes if true, the new nodes and branches are also given
+   *        indexes.
+   */
+  void createNodesFromFathers(const std::vector<std::shared_ptr<N> >& nodeObjects, const std::vector<size_t>& fathers, const std::vector<std::shared_ptr<E> >& branchObjects, bool withIndexes = false)
+  {
+    if (fathers.size() != nodeObjects.size() || (!branchObjects.empty() && branchObjects.size() != nodeObjects.size()))
+      throw Exception("AssociationTreeGraphImplObserver::createNodesFromFathers : the fathers and branches must be given for each node.");
+
+    std::vector<std::pair<size_t, size_t> > branches;
+    std::vector<std::shared_ptr<E> > edgeObjects;
+    branches.reserve(nodeObjects.size());
+    if (!branchObjects.empty())
+      edgeObjects.reserve(nodeObjects.size());
+    size_t root = nodeObjects.size();
+    for (size_t i = 0; i < fathers.size(); i++)
+    {
+      if (fathers[i] == i)
+      {
+        if (root != nodeObjects.size())
+          throw Exception("AssociationTreeGraphImplObserver::createNodesFromFathers : several roots, at positions " + TextTools::toString(root) + " and " + TextTools::toString(i) + ".");
+        root = i;
+        continue;
+      }
+      branches.push_back(std::pair<size_t, size_t>(fathers[i], i));
+      if (!branchObjects.empty())
+        edgeObjects.push_back(branchObjects[i]);
+    }
+    if (!nodeObjects.empty() && root == nodeObjects.size())
+      throw Exception("AssociationTreeGraphImplObserver::createNodesFromFathers : no root.");
+
+    bool wasEmpty = this->getGraph()->getNumberOfNodes() == 0;
+    this->createNodesAndLinks(nodeObjects, branches, edgeObjects, withIndexes);
+    if (wasEmpty && !nodeObjects.empty())
+      this->setRoot(nodeObjects[root]);
+  }
+
   /**
    * Is the graph a tree? A tree must be acyclic and with no isolated node.
    * @return true if valid tree
@@ -204,7 +254,17 @@ public:
 
   std::vector<std::shared_ptr<N> > getSons(const std::shared_ptr<N>  node) const
   {
-    return this->getNodesFromGraphid(this->getGraph()->getSons(this->getNodeGraphid(node)));
+    return this->objectsOf_(sonRange(node));
+  }
+
+  /**
+   * Get a range on the sons of a node, see
+   * AssociationGraphImplObserver::outgoingNeighborRange.
+   */
+
+  NodeObjectRange sonRange(const std::shared_ptr<N> node) const
+  {
+    return this->nodeObjectRange_(this->getGraph()->sonRange(this->getNodeGraphid(node)));
   }
 
   std::vector<NodeIndex> getSons(const NodeIndex node) const
@@ -220,7 +280,17 @@ public:
 
   std::vector<std::shared_ptr<E> > getBranches(const std::shared_ptr<N>  node) const
   {
-    return this->getEdgesFromGraphid(this->getGraph()->getBranches(this->getNodeGraphid(node)));
+    return this->objectsOf_(branchRange(node));
+  }
+
+  /**
+   * Get a range on the branches to the sons of a node, see
+   * AssociationGraphImplObserver::outgoingEdgeRange.
+   */
+
+  EdgeObjectRange branchRange(const std::shared_ptr<N> node) const
+  {
+    return this->edgeObjectRange_(this->getGraph()->branchRange(this->getNodeGraphid(node)));
   }
 
   std::vector<EdgeIndex> getBranches(const NodeIndex node) const
@@ -437,12 +507,43 @@ public:
     return this->getNodeFromGraphid(this->getGraph()->MRCA(vNid));
   }
 
+  /**
+   * Return, in a rooted tree, the MRCA node of two nodes
+   */
+
+  std::shared_ptr<N> MRCA(const std::shared_ptr<N> nodeA, const std::shared_ptr<N> nodeB) const
+  {
+    return this->getNodeFromGraphid(this->getGraph()->MRCA(this->getNodeGraphid(nodeA), this->getNodeGraphid(nodeB)));
+  }
+
+  /**
+   * @return true if ancestor is on the path from node to the root,
+   * node included.
+   */
+
+  bool isAncestor(const std::shared_ptr<N> ancestor, const std::shared_ptr<N> node) const
+  {
+    return this->getGraph()->isAncestor(this->getNodeGraphid(ancestor), this->getNodeGraphid(node));
+  }
+
+  /**
+   * @return the number of branches between a node and the root.
+   */
+
+  unsigned int getDepth(const std::shared_ptr<N> node) const
+  {
+    return this->getGraph()->getDepth(this->getNodeGraphid(node));
+  }
+
 };
 
 /********************/
 
 template<class N, class E>
 using AssociationTreeGlobalGraphObserver =  AssociationTreeGraphImplObserver<N, E, TreeGlobalGraph>;
+
+template<class N, class E>
+using AssociationTreeCompactGraphObserver =  AssociationTreeGraphImplObserver<N, E, TreeCompactGraph>;
 }
 
 
@@ -0,0 +1,722 @@
+//
+// File: BinaryGraphFormat.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project..
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "../Exceptions.h"
+#include "../Text/TextTools.h"
+#include "BinaryGraphFormat.h"
+
+// From the STL:
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace bpp;
+using namespace std;
+
+const uint32_t BinaryGraphFormat::FORMAT_VERSION = 1;
+const uint32_t BinaryGraphFormat::NO_INDEX = numeric_limits<uint32_t>::max();
+
+namespace
+{
+  const char GRAPH_MAGIC[8] = { 'B', 'P', 'P', 'G', 'R', 'A', 'P', 'H' };
+  const size_t HEADER_SIZE = 48;
+
+  const uint32_t FLAG_DIRECTED = 1;
+  const uint32_t FLAG_NODE_OBJECTS = 2;
+  const uint32_t FLAG_EDGE_OBJECTS = 4;
+  const uint32_t KNOWN_FLAGS = FLAG_DIRECTED | FLAG_NODE_OBJECTS | FLAG_EDGE_OBJECTS;
+
+  const uint64_t NO_OBJECT = numeric_limits<uint64_t>::max();
+
+  uint32_t getU32(const unsigned char* p)
+  {
+    uint32_t v = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+      v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+  }
+
+  uint64_t getU64(const unsigned char* p)
+  {
+    uint64_t v = 0;
+    for (unsigned int i = 0; i < 8; ++i)
+      v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+  }
+
+  bool isLittleEndianHost()
+  {
+    uint32_t one = 1;
+    unsigned char first;
+    memcpy(&first, &one, 1);
+    return first == 1;
+  }
+
+  /**
+   * Buffered writer of little-endian values, keeping track of the position
+   * in the file for alignment. The file is removed on destruction, unless
+   * it has been kept.
+   */
+  class FileWriter
+  {
+  private:
+    string path_;
+    FILE* file_;
+    vector<unsigned char> buffer_;
+    uint64_t position_;
+    bool kept_;
+
+  public:
+    explicit FileWriter(const string& path) :
+      path_(path),
+      file_(fopen(path.c_str(), "wb")),
+      buffer_(),
+      position_(0),
+      kept_(false)
+    {
+      if (!file_)
+        throw IOException("BinaryGraphFormat::write. Cannot open file " + path);
+      buffer_.reserve(1 << 20);
+    }
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    ~FileWriter()
+    {
+      if (file_)
+        fclose(file_);
+      if (!kept_)
+        remove(path_.c_str());
+    }
+
+    void putU32(uint32_t v)
+    {
+      for (unsigned int i = 0; i < 4; ++i)
+        buffer_.push_back(static_cast<unsigned char>((v >> (8 * i)) & 0xFF));
+      position_ += 4;
+      flushIfFull_();
+    }
+
+    void putU64(uint64_t v)
+    {
+      for (unsigned int i = 0; i < 8; ++i)
+        buffer_.push_back(static_cast<unsigned char>((v >> (8 * i)) & 0xFF));
+      position_ += 8;
+      flushIfFull_();
+    }
+
+    void putBytes(const void* data, size_t size)
+    {
+      const unsigned char* bytes = static_cast<const unsigned char*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+      position_ += size;
+      flushIfFull_();
+    }
+
+    void align()
+    {
+      while (position_ % 8 != 0)
+      {
+        buffer_.push_back(0);
+        position_++;
+      }
+    }
+
+    void close()
+    {
+      flush_();
+      int error = fclose(file_);
+      file_ = 0;
+      if (error != 0)
+        throw IOException("BinaryGraphFormat::write. Cannot write file " + path_);
+    }
+
+    /**
+     * Do not remove the file, eg once it has been renamed.
+     */
+    void keep() { kept_ = true; }
+
+  private:
+    void flushIfFull_()
+    {
+      if (buffer_.size() >= (1 << 20))
+        flush_();
+    }
+
+    void flush_()
+    {
+      if (!buffer_.empty() && fwrite(&buffer_[0], 1, buffer_.size(), file_) != buffer_.size())
+        throw IOException("BinaryGraphFormat::write. Cannot write file " + path_);
+      buffer_.clear();
+    }
+  };
+
+  /**
+   * The content of a file, memory-mapped when possible, and read otherwise.
+   * The memory is released with the last copy of data.
+   */
+  struct FileContent
+  {
+    shared_ptr<const void> data;
+    size_t size;
+
+    FileContent() : data(), size(0) {}
+  };
+
+  FileContent loadFile(const string& path)
+  {
+    FileContent content;
+#if !defined(_WIN32)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw IOException("BinaryGraphFormat::read. Cannot open file " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw IOException("BinaryGraphFormat::read. Cannot read the size of file " + path);
+    }
+    content.size = static_cast<size_t>(st.st_size);
+    if (content.size < HEADER_SIZE)
+    {
+      close(fd);
+      throw IOException("BinaryGraphFormat::read. File " + path + " is too short to be a graph file.");
+    }
+    void* map = mmap(0, content.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+      throw IOException("BinaryGraphFormat::read. Cannot map file " + path);
+    size_t size = content.size;
+    content.data = shared_ptr<const void>(map, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+#else
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+      throw IOException("BinaryGraphFormat::read. Cannot open file " + path);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < static_cast<long>(HEADER_SIZE))
+    {
+      fclose(file);
+      throw IOException("BinaryGraphFormat::read. File " + path + " is too short to be a graph file.");
+    }
+    content.size = static_cast<size_t>(size);
+    // 8 bytes aligned storage, as for a mapping
+    shared_ptr<vector<uint64_t> > buffer = make_shared<vector<uint64_t> >((content.size + 7) / 8);
+    size_t nbRead = fread(&(*buffer)[0], 1, content.size, file);
+    fclose(file);
+    if (nbRead != content.size)
+      throw IOException("BinaryGraphFormat::read. Cannot read file " + path);
+    content.data = shared_ptr<const void>(buffer, &(*buffer)[0]);
+#endif
+    return content;
+  }
+
+  /**
+   * The sections of a graph file, checked for consistency.
+   */
+  struct GraphFileLayout
+  {
+    bool directed;
+    uint32_t flags;
+    uint32_t root;
+    uint32_t highestNodeId;
+    uint32_t highestEdgeId;
+    size_t nbNodes;
+    size_t nbEdges;
+    // one past the highest edge id in the file
+    size_t nbEdgeIds;
+
+    const unsigned char* nodes;
+    const unsigned char* edges;
+    const unsigned char* outOffsets;
+    const unsigned char* outNeighbors;
+    const unsigned char* inOffsets;
+    const unsigned char* inNeighbors;
+    size_t objectsBegin;
+
+    GraphFileLayout() :
+      directed(false), flags(0), root(0), highestNodeId(0), highestEdgeId(0),
+      nbNodes(0), nbEdges(0), nbEdgeIds(1),
+      nodes(0), edges(0), outOffsets(0), outNeighbors(0), inOffsets(0), inNeighbors(0),
+      objectsBegin(0) {}
+  };
+
+  /**
+   * Bound-checked access to the content of a file.
+   */
+  class FileCursor
+  {
+  private:
+    const unsigned char* data_;
+    size_t size_;
+    size_t position_;
+    string path_;
+
+  public:
+    FileCursor(const FileContent& content, const string& path) :
+      data_(static_cast<const unsigned char*>(content.data.get())),
+      size_(content.size),
+      position_(0),
+      path_(path)
+    {}
+
+    FileCursor(const FileCursor&) = delete;
+    FileCursor& operator=(const FileCursor&) = delete;
+
+    size_t getPosition() const { return position_; }
+
+    void setPosition(size_t position) { position_ = position; }
+
+    /**
+     * Skip n items of the given size, and return the first one.
+     */
+    const unsigned char* take(uint64_t n, size_t itemSize)
+    {
+      if (n > (size_ - position_) / itemSize)
+        corrupted("the file is truncated");
+      const unsigned char* begin = data_ + position_;
+      position_ += static_cast<size_t>(n) * itemSize;
+      return begin;
+    }
+
+    uint32_t takeU32() { return getU32(take(1, 4)); }
+
+    uint64_t takeU64() { return getU64(take(1, 8)); }
+
+    void align()
+    {
+      position_ = min(size_, (position_ + 7) / 8 * 8);
+    }
+
+    void corrupted(const string& reason) const
+    {
+      throw IOException("BinaryGraphFormat::read. Corrupted graph file " + path_ + ": " + reason + ".");
+    }
+  };
+
+  /**
+   * Find the nodes of an edge in the edge section, sorted by id.
+   */
+  bool findEdge(const GraphFileLayout& layout, uint32_t id, uint32_t& first, uint32_t& second)
+  {
+    size_t low = 0;
+    size_t high = layout.nbEdges;
+    while (low < high)
+    {
+      size_t middle = low + (high - low) / 2;
+      uint32_t middleId = getU32(layout.edges + 12 * middle);
+      if (middleId == id)
+      {
+        first = getU32(layout.edges + 12 * middle + 4);
+        second = getU32(layout.edges + 12 * middle + 8);
+        return true;
+      }
+      if (middleId < id)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return false;
+  }
+
+  /**
+   * Check the offsets and the neighbors of one direction of the CSR section:
+   * the neighbors of each node are existing nodes in increasing order, and
+   * their edges are existing edges between the same nodes.
+   */
+  void checkNeighbors(const FileCursor& cursor, const GraphFileLayout& layout, bool outgoing, const vector<char>& nodeExists)
+  {
+    const unsigned char* offsets = outgoing ? layout.outOffsets : layout.inOffsets;
+    const unsigned char* neighbors = outgoing ? layout.outNeighbors : layout.inNeighbors;
+    size_t nbIds = nodeExists.size();
+    if (getU64(offsets) != 0)
+      cursor.corrupted("bad neighbor offsets");
+    for (size_t i = 0; i < nbIds; i++)
+    {
+      uint64_t begin = getU64(offsets + 8 * i);
+      uint64_t end = getU64(offsets + 8 * (i + 1));
+      if (end < begin || (!nodeExists[i] && end != begin))
+        cursor.corrupted("bad neighbor offsets");
+      for (uint64_t j = begin; j < end; j++)
+      {
+        uint32_t node = getU32(neighbors + 8 * j);
+        uint32_t edge = getU32(neighbors + 8 * j + 4);
+        if (node >= nbIds || !nodeExists[node])
+          cursor.corrupted("unknown neighbor");
+        // the neighbors are searched by dichotomy
+        if (j > begin && node <= getU32(neighbors + 8 * (j - 1)))
+          cursor.corrupted("unsorted neighbors");
+        uint32_t first, second;
+        if (!findEdge(layout, edge, first, second))
+          cursor.corrupted("unknown neighbor edge");
+        uint32_t father = outgoing ? static_cast<uint32_t>(i) : node;
+        uint32_t son = outgoing ? node : static_cast<uint32_t>(i);
+        if (!(first == father && second == son) && (layout.directed || !(first == son && second == father)))
+          cursor.corrupted("neighbor edge with other nodes");
+      }
+    }
+  }
+
+  GraphFileLayout readLayout(const FileContent& content, const string& path)
+  {
+    FileCursor cursor(content, path);
+    GraphFileLayout layout;
+
+    // header
+    if (memcmp(cursor.take(1, 8), GRAPH_MAGIC, 8) != 0)
+      throw IOException("BinaryGraphFormat::read. File " + path + " is not a graph file.");
+    uint32_t version = cursor.takeU32();
+    if (version == 0 || version > BinaryGraphFormat::FORMAT_VERSION)
+      throw IOException("BinaryGraphFormat::read. Unsupported version " + TextTools::toString(version) + " of graph file " + path);
+    layout.flags = cursor.takeU32();
+    if (layout.flags & ~KNOWN_FLAGS)
+      cursor.corrupted("unknown flags");
+    layout.directed = (layout.flags & FLAG_DIRECTED) != 0;
+    layout.root = cursor.takeU32();
+    layout.highestNodeId = cursor.takeU32();
+    layout.highestEdgeId = cursor.takeU32();
+    cursor.takeU32();
+    uint64_t nbNodes = cursor.takeU64();
+    uint64_t nbEdges = cursor.takeU64();
+    size_t nbIds = layout.highestNodeId;
+
+    // the sizes of all the sections are checked against the size of the
+    // file before anything is allocated
+    layout.nodes = cursor.take(nbNodes, 4);
+    layout.nbNodes = static_cast<size_t>(nbNodes);
+    cursor.align();
+    layout.edges = cursor.take(nbEdges, 12);
+    layout.nbEdges = static_cast<size_t>(nbEdges);
+    cursor.align();
+    layout.outOffsets = cursor.take(static_cast<uint64_t>(nbIds) + 1, 8);
+    layout.outNeighbors = cursor.take(getU64(layout.outOffsets + 8 * nbIds), 8);
+    layout.inOffsets = cursor.take(static_cast<uint64_t>(nbIds) + 1, 8);
+    layout.inNeighbors = cursor.take(getU64(layout.inOffsets + 8 * nbIds), 8);
+    layout.objectsBegin = cursor.getPosition();
+
+    // nodes, in increasing order, below the highest id
+    vector<char> nodeExists(nbIds, 0);
+    for (size_t i = 0; i < layout.nbNodes; i++)
+    {
+      uint32_t node = getU32(layout.nodes + 4 * i);
+      if (node >= nbIds || (i > 0 && node <= getU32(layout.nodes + 4 * (i - 1))))
+        cursor.corrupted("bad node ids");
+      nodeExists[node] = 1;
+    }
+    if (layout.nbNodes == 0 ? layout.root != 0 : (layout.root >= nbIds || !nodeExists[layout.root]))
+      cursor.corrupted("unknown root");
+
+    // edges, in increasing order, up to the highest id, between existing nodes
+    for (size_t i = 0; i < layout.nbEdges; i++)
+    {
+      const unsigned char* edge = layout.edges + 12 * i;
+      uint32_t id = getU32(edge);
+      uint32_t first = getU32(edge + 4);
+      uint32_t second = getU32(edge + 8);
+      if ((i > 0 && id <= getU32(edge - 12)) || id > layout.highestEdgeId || first >= nbIds || !nodeExists[first] || second >= nbIds || !nodeExists[second])
+        cursor.corrupted("bad edges");
+    }
+    if (layout.nbEdges > 0)
+      layout.nbEdgeIds = static_cast<size_t>(getU32(layout.edges + 12 * (layout.nbEdges - 1))) + 1;
+
+    checkNeighbors(cursor, layout, true, nodeExists);
+    checkNeighbors(cursor, layout, false, nodeExists);
+    return layout;
+  }
+
+  /**
+   * Call the readers on the object records of the file.
+   */
+  void readObjects(const FileContent& content, const string& path, const GraphFileLayout& layout, const BinaryGraphFormat::ObjectReader& nodeReader, const BinaryGraphFormat::ObjectReader& edgeReader)
+  {
+    FileCursor cursor(content, path);
+    cursor.setPosition(layout.objectsBegin);
+    for (unsigned int part = 0; part < 2; part++)
+    {
+      bool isNode = part == 0;
+      if (!(layout.flags & (isNode ? FLAG_NODE_OBJECTS : FLAG_EDGE_OBJECTS)))
+        continue;
+      const BinaryGraphFormat::ObjectReader& reader = isNode ? nodeReader : edgeReader;
+      size_t nbRecords = isNode ? layout.nbNodes : layout.nbEdges;
+      for (size_t i = 0; i < nbRecords; i++)
+      {
+        uint32_t id = isNode ? getU32(layout.nodes + 4 * i) : getU32(layout.edges + 12 * i);
+        uint32_t index = cursor.takeU32();
+        uint64_t size = cursor.takeU64();
+        if (size == NO_OBJECT)
+          continue;
+        const unsigned char* data = cursor.take(size, 1);
+        if (reader)
+          reader(id, index, reinterpret_cast<const char*>(data), static_cast<size_t>(size));
+      }
+    }
+  }
+
+  void writeObjects(FileWriter& out, const vector<uint32_t>& ids, const BinaryGraphFormat::ObjectWriter& writer)
+  {
+    string data;
+    for (auto id : ids)
+    {
+      data.clear();
+      uint32_t index = BinaryGraphFormat::NO_INDEX;
+      bool hasObject = writer(id, index, data);
+      out.putU32(index);
+      out.putU64(hasObject ? data.size() : NO_OBJECT);
+      if (hasObject)
+        out.putBytes(data.data(), data.size());
+    }
+  }
+}
+
+/******************************************************************************/
+
+template<class GraphImpl>
+void BinaryGraphFormat::write_(const GraphImpl& graph, uint32_t highestNodeId, uint32_t highestEdgeId, const string& path, const ObjectWriter& nodeWriter, const ObjectWriter& edgeWriter)
+{
+  vector<Graph::NodeId> nodes = graph.getAllNodes();
+  vector<Graph::EdgeId> edges = graph.getAllEdges();
+  sort(nodes.begin(), nodes.end());
+  sort(edges.begin(), edges.end());
+
+  if (!nodes.empty() && !graph.hasNode_(graph.getRoot()))
+    throw Exception("BinaryGraphFormat::write : the root is not a node of the graph.");
+
+  string tmpPath = path + ".tmp";
+  FileWriter out(tmpPath);
+
+  // header
+  uint32_t flags = (graph.isDirected() ? FLAG_DIRECTED : 0) | (nodeWriter ? FLAG_NODE_OBJECTS : 0) | (edgeWriter ? FLAG_EDGE_OBJECTS : 0);
+  out.putBytes(GRAPH_MAGIC, 8);
+  out.putU32(FORMAT_VERSION);
+  out.putU32(flags);
+  out.putU32(nodes.empty() ? 0 : graph.getRoot());
+  out.putU32(highestNodeId);
+  out.putU32(highestEdgeId);
+  out.putU32(0);
+  out.putU64(nodes.size());
+  out.putU64(edges.size());
+
+  for (auto node : nodes)
+    out.putU32(node);
+  out.align();
+
+  for (auto edge : edges)
+  {
+    pair<Graph::NodeId, Graph::NodeId> ends = graph.getNodes(edge);
+    out.putU32(edge);
+    out.putU32(ends.first);
+    out.putU32(ends.second);
+  }
+  out.align();
+
+  // neighbors, in CSR layout
+  for (unsigned int direction = 0; direction < 2; direction++)
+  {
+    bool outgoing = direction == 0;
+    uint64_t offset = 0;
+    out.putU64(offset);
+    for (Graph::NodeId node = 0; node < highestNodeId; node++)
+    {
+      if (graph.hasNode_(node))
+        offset += (outgoing ? graph.outgoingNeighborRange(node) : graph.incomingNeighborRange(node)).size();
+      out.putU64(offset);
+    }
+    for (auto node : nodes)
+    {
+      typename GraphImpl::NeighborRange neighbors = outgoing ? graph.outgoingNeighborRange(node) : graph.incomingNeighborRange(node);
+      typename GraphImpl::EdgeRange neighborEdges = outgoing ? graph.outgoingEdgeRange(node) : graph.incomingEdgeRange(node);
+      typename GraphImpl::EdgeRange::iterator itEdge = neighborEdges.begin();
+      for (auto neighbor : neighbors)
+      {
+        out.putU32(neighbor);
+        out.putU32(*itEdge);
+        ++itEdge;
+      }
+    }
+  }
+
+  if (nodeWriter)
+    writeObjects(out, vector<uint32_t>(nodes.begin(), nodes.end()), nodeWriter);
+  if (edgeWriter)
+    writeObjects(out, vector<uint32_t>(edges.begin(), edges.end()), edgeWriter);
+  out.close();
+
+#if defined(_WIN32)
+  remove(path.c_str());
+#endif
+  if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    throw IOException("BinaryGraphFormat::write. Cannot rename " + tmpPath + " to " + path);
+  out.keep();
+}
+
+void BinaryGraphFormat::write(const GlobalGraph& graph, const string& path, const ObjectWriter& nodeWriter, const ObjectWriter& edgeWriter)
+{
+  write_(graph, graph.getHighestNodeID(), graph.getHighestEdgeID(), path, nodeWriter, edgeWriter);
+}
+
+void BinaryGraphFormat::write(const CompactGraph& graph, const string& path, const ObjectWriter& nodeWriter, const ObjectWriter& edgeWriter)
+{
+  write_(graph, graph.getHighestNodeID(), graph.getHighestEdgeID(), path, nodeWriter, edgeWriter);
+}
+
+/******************************************************************************/
+
+void BinaryGraphFormat::read(const string& path, GlobalGraph& graph, const ObjectReader& nodeReader, const ObjectReader& edgeReader)
+{
+  if (graph.getNumberOfNodes() != 0 || graph.getNumberOfEdges() != 0)
+    throw Exception("BinaryGraphFormat::read : the graph must be empty.");
+
+  FileContent content = loadFile(path);
+  GraphFileLayout layout = readLayout(content, path);
+
+  // ids are in increasing order: insert at the end
+  shared_ptr<GlobalGraph::nodeStructureType> nodeStructure = make_shared<GlobalGraph::nodeStructureType>();
+  for (size_t i = 0; i < layout.nbNodes; i++)
+  {
+    GlobalGraph::Node node = getU32(layout.nodes + 4 * i);
+    GlobalGraph::nodeStructureType::mapped_type& row = nodeStructure->emplace_hint(nodeStructure->end(), node, GlobalGraph::nodeStructureType::mapped_type())->second;
+    for (unsigned int direction = 0; direction < 2; direction++)
+    {
+      const unsigned char* offsets = direction == 0 ? layout.outOffsets : layout.inOffsets;
+      const unsigned char* neighbors = direction == 0 ? layout.outNeighbors : layout.inNeighbors;
+      map<GlobalGraph::Node, GlobalGraph::Edge>& relations = direction == 0 ? row.first : row.second;
+      uint64_t end = getU64(offsets + 8 * (node + 1));
+      for (uint64_t j = getU64(offsets + 8 * node); j < end; j++)
+        relations.emplace_hint(relations.end(), getU32(neighbors + 8 * j), getU32(neighbors + 8 * j + 4));
+    }
+  }
+
+  shared_ptr<GlobalGraph::edgeStructureType> edgeStructure = make_shared<GlobalGraph::edgeStructureType>();
+  for (size_t i = 0; i < layout.nbEdges; i++)
+  {
+    const unsigned char* edge = layout.edges + 12 * i;
+    edgeStructure->emplace_hint(edgeStructure->end(), getU32(edge), pair<GlobalGraph::Node, GlobalGraph::Node>(getU32(edge + 4), getU32(edge + 8)));
+  }
+
+  graph.directed_ = layout.directed;
+  graph.highestNodeID_ = layout.highestNodeId;
+  graph.highestEdgeID_ = layout.highestEdgeId;
+  graph.root_ = layout.root;
+  graph.setStructure_(nodeStructure, edgeStructure);
+  graph.topologyHasChanged_();
+
+  readObjects(content, path, layout, nodeReader, edgeReader);
+}
+
+void BinaryGraphFormat::read(const string& path, CompactGraph& graph, const ObjectReader& nodeReader, const ObjectReader& edgeReader)
+{
+  if (graph.getNumberOfNodes() != 0 || graph.getNumberOfEdges() != 0)
+    throw Exception("BinaryGraphFormat::read : the graph must be empty.");
+
+  FileContent content = loadFile(path);
+  GraphFileLayout layout = readLayout(content, path);
+  size_t nbIds = layout.highestNodeId;
+
+  vector<char> nodeExists(nbIds, 0);
+  for (size_t i = 0; i < layout.nbNodes; i++)
+    nodeExists[getU32(layout.nodes + 4 * i)] = 1;
+
+  vector<pair<CompactGraph::Node, CompactGraph::Node> > edgeNodes(layout.nbEdgeIds);
+  vector<char> edgeExists(layout.nbEdgeIds, 0);
+  for (size_t i = 0; i < layout.nbEdges; i++)
+  {
+    const unsigned char* edge = layout.edges + 12 * i;
+    uint32_t id = getU32(edge);
+    edgeExists[id] = 1;
+    edgeNodes[id] = pair<CompactGraph::Node, CompactGraph::Node>(getU32(edge + 4), getU32(edge + 8));
+  }
+
+  // the neighbors are used in place when they have the layout of the host
+  shared_ptr<CompactGraph::FrozenNeighbors> frozen = make_shared<CompactGraph::FrozenNeighbors>();
+  if (isLittleEndianHost() && sizeof(size_t) == 8 && sizeof(CompactGraph::Neighbor) == 8 && sizeof(CompactGraph::Node) == 4)
+  {
+    frozen->outOffsets = reinterpret_cast<const size_t*>(layout.outOffsets);
+    frozen->outArray = reinterpret_cast<const CompactGraph::Neighbor*>(layout.outNeighbors);
+    frozen->inOffsets = reinterpret_cast<const size_t*>(layout.inOffsets);
+    frozen->inArray = reinterpret_cast<const CompactGraph::Neighbor*>(layout.inNeighbors);
+    frozen->mapping = content.data;
+  }
+  else
+  {
+    for (unsigned int direction = 0; direction < 2; direction++)
+    {
+      const unsigned char* offsets = direction == 0 ? layout.outOffsets : layout.inOffsets;
+      const unsigned char* neighbors = direction == 0 ? layout.outNeighbors : layout.inNeighbors;
+      vector<size_t>& offsetsStorage = direction == 0 ? frozen->outOffsetsStorage : frozen->inOffsetsStorage;
+      vector<CompactGraph::Neighbor>& arrayStorage = direction == 0 ? frozen->outArrayStorage : frozen->inArrayStorage;
+      offsetsStorage.resize(nbIds + 1);
+      for (size_t i = 0; i <= nbIds; i++)
+        offsetsStorage[i] = static_cast<size_t>(getU64(offsets + 8 * i));
+      arrayStorage.resize(offsetsStorage[nbIds]);
+      for (size_t j = 0; j < arrayStorage.size(); j++)
+        arrayStorage[j] = CompactGraph::Neighbor(getU32(neighbors + 8 * j), getU32(neighbors + 8 * j + 4));
+    }
+    frozen->useStorage();
+  }
+
+  graph.directed_ = layout.directed;
+  graph.highestNodeID_ = layout.highestNodeId;
+  graph.highestEdgeID_ = layout.highestEdgeId;
+  graph.root_ = layout.root;
+  graph.nodeExists_.swap(nodeExists);
+  graph.numberOfNodes_ = layout.nbNodes;
+  graph.edgeNodes_.swap(edgeNodes);
+  graph.edgeExists_.swap(edgeExists);
+  graph.numberOfEdges_ = layout.nbEdges;
+  vector<vector<CompactGraph::Neighbor> >().swap(graph.outNeighbors_);
+  vector<vector<CompactGraph::Neighbor> >().swap(graph.inNeighbors_);
+  graph.frozenNeighbors_ = frozen;
+  graph.frozen_ = true;
+  graph.topologyHasChanged_();
+
+  readObjects(content, path, layout, nodeReader, edgeReader);
+}
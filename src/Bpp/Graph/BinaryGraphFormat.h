@@ -0,0 +1,155 @@
+//
+// File: BinaryGraphFormat.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project..
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _BINARY_GRAPH_FORMAT_H_
+#define _BINARY_GRAPH_FORMAT_H_
+
+#include "CompactGraph.h"
+#include "GlobalGraph.h"
+
+// From the STL:
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace bpp
+{
+/**
+ * @brief Read and write the topology of graphs in a binary file.
+ *
+ * The file stores the directedness, the root, the highest ids, the ids of
+ * the nodes and the edges of a graph, so that a graph read from a file has
+ * the same ids as the graph that was written.
+ *
+ * Format (all integers are stored in little-endian order, and each section
+ * starts at a multiple of 8 bytes):
+ * - a header: the magic string "BPPGRAPH", the format version (uint32), the
+ *   flags (uint32), the root, the highest node id and the highest edge id
+ *   (uint32), a reserved uint32, the numbers of nodes and of edges (uint64);
+ * - the ids of the nodes, in increasing order (uint32);
+ * - the edges, in increasing order of ids, each as its id, its first and its
+ *   second node (uint32);
+ * - the neighbors of the nodes, in the compressed sparse row (CSR) layout of
+ *   a frozen CompactGraph: for outgoing then incoming neighbors, the offsets
+ *   of the neighbors of each node id (uint64), followed by the array of the
+ *   neighbors, each as a node and an edge id (uint32);
+ * - optionally, records for the objects attached to nodes, then to edges:
+ *   for each node (resp. edge) in the order above, an index (uint32,
+ *   NO_INDEX if none), the size of the object (uint64, NO_OBJECT if none)
+ *   and its bytes.
+ *
+ * Before a graph is built, the reader checks the sizes of the sections
+ * against the size of the file, the ids of the nodes, of the edges and of
+ * the root, and that the neighbors of each node are sorted and linked by
+ * the edges of the edge section.
+ *
+ * Files are memory-mapped when read. A CompactGraph read from a file is
+ * frozen, and when the host is little-endian with 64 bits sizes, its
+ * neighbor arrays are used in place in the mapped file, with no copy: the
+ * mapping is released when the graph and all its copies are thawed or
+ * destroyed. Other graphs are built from the content of the file.
+ *
+ * Object records are written and read through callbacks, so that any kind of
+ * object can be stored, see AssociationGraphImplObserver::writeBinary.
+ */
+class BinaryGraphFormat
+{
+public:
+  static const uint32_t FORMAT_VERSION;
+
+  /**
+   * Index stored for the objects with no index.
+   */
+  static const uint32_t NO_INDEX;
+
+  /**
+   * Serialize the object attached to a node or an edge id.
+   * Returns false if there is no object, otherwise appends its bytes to
+   * data, and sets its index (NO_INDEX if none).
+   */
+  typedef std::function<bool (uint32_t id, uint32_t& index, std::string& data)> ObjectWriter;
+
+  /**
+   * Read the object attached to a node or an edge id, from size bytes.
+   * Only called for ids with an object.
+   */
+  typedef std::function<void (uint32_t id, uint32_t index, const char* data, size_t size)> ObjectReader;
+
+public:
+  /**
+   * @brief Write a graph to a file.
+   *
+   * The file is written under a temporary name, then renamed, so that a
+   * complete file is always present. The temporary file is removed if the
+   * writing fails.
+   *
+   * @param graph      The graph to write.
+   * @param path       The path of the file.
+   * @param nodeWriter If not empty, called for each node to write the object records.
+   * @param edgeWriter If not empty, called for each edge to write the object records.
+   * @throw IOException If the file cannot be written.
+   * @throw Exception If the root is not a node of a non-empty graph.
+   */
+  static void write(const GlobalGraph& graph, const std::string& path, const ObjectWriter& nodeWriter = ObjectWriter(), const ObjectWriter& edgeWriter = ObjectWriter());
+
+  static void write(const CompactGraph& graph, const std::string& path, const ObjectWriter& nodeWriter = ObjectWriter(), const ObjectWriter& edgeWriter = ObjectWriter());
+
+  /**
+   * @brief Read a graph from a file.
+   *
+   * @param path       The path of the file.
+   * @param graph      [out] An empty graph, which takes the topology of the file.
+   * @param nodeReader If not empty, called for each node object record of the file.
+   * @param edgeReader If not empty, called for each edge object record of the file.
+   * @throw IOException If the file cannot be read, is not a graph file of a
+   * supported version, or is inconsistent.
+   * @throw Exception If the graph is not empty.
+   */
+  static void read(const std::string& path, GlobalGraph& graph, const ObjectReader& nodeReader = ObjectReader(), const ObjectReader& edgeReader = ObjectReader());
+
+  static void read(const std::string& path, CompactGraph& graph, const ObjectReader& nodeReader = ObjectReader(), const ObjectReader& edgeReader = ObjectReader());
+
+private:
+  template<class GraphImpl>
+  static void write_(const GraphImpl& graph, uint32_t highestNodeId, uint32_t highestEdgeId, const std::string& path, const ObjectWriter& nodeWriter, const ObjectWriter& edgeWriter);
+};
+} // end of namespace bpp.
+
+#endif // _BINARY_GRAPH_FORMAT_H_
@@ -0,0 +1,1148 @@
+//
+// File: CompactGraph.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../Exceptions.h"
+#include "../Text/TextTools.h"
+#include "CompactGraph.h"
+#include "GraphObserver.h"
+
+// From the STL:
+#include <algorithm>
+#include <limits>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+struct NeighborIsLess
+{
+  bool operator()(const CompactGraph::Neighbor& neighbor, CompactGraph::Node node) const
+  {
+    return neighbor.first < node;
+  }
+};
+
+const CompactGraph::Neighbor* findNeighbor(const CompactGraph::Neighbor* begin, const CompactGraph::Neighbor* end, CompactGraph::Node node)
+{
+  const CompactGraph::Neighbor* found = lower_bound(begin, end, node, NeighborIsLess());
+  return (found != end && found->first == node) ? found : end;
+}
+
+/**
+ * Insert a neighbor in a sorted array. An existing relation is only
+ * replaced if overwrite is true, as with std::map::insert and operator[].
+ */
+void insertNeighbor(vector<CompactGraph::Neighbor>& neighbors, CompactGraph::Node node, CompactGraph::Edge edge, bool overwrite)
+{
+  vector<CompactGraph::Neighbor>::iterator found = lower_bound(neighbors.begin(), neighbors.end(), node, NeighborIsLess());
+  if (found != neighbors.end() && found->first == node)
+  {
+    if (overwrite)
+      found->second = edge;
+  }
+  else
+    neighbors.insert(found, CompactGraph::Neighbor(node, edge));
+}
+
+bool eraseNeighbor(vector<CompactGraph::Neighbor>& neighbors, CompactGraph::Node node)
+{
+  vector<CompactGraph::Neighbor>::iterator found = lower_bound(neighbors.begin(), neighbors.end(), node, NeighborIsLess());
+  if (found == neighbors.end() || found->first != node)
+    return false;
+  neighbors.erase(found);
+  return true;
+}
+}
+
+CompactGraph::CompactGraph(bool directed) :
+  directed_(directed),
+  observers_(),
+  highestNodeID_(0),
+  highestEdgeID_(0),
+  root_(0),
+  nodeExists_(),
+  numberOfNodes_(0),
+  edgeNodes_(1),
+  edgeExists_(1, 0),
+  numberOfEdges_(0),
+  frozen_(false),
+  outNeighbors_(),
+  inNeighbors_(),
+  frozenNeighbors_()
+{}
+
+CompactGraph::CompactGraph(const CompactGraph& gg) :
+  directed_(gg.directed_),
+  observers_(),
+  highestNodeID_(gg.highestNodeID_),
+  highestEdgeID_(gg.highestEdgeID_),
+  root_(gg.root_),
+  nodeExists_(gg.nodeExists_),
+  numberOfNodes_(gg.numberOfNodes_),
+  edgeNodes_(gg.edgeNodes_),
+  edgeExists_(gg.edgeExists_),
+  numberOfEdges_(gg.numberOfEdges_),
+  frozen_(gg.frozen_),
+  outNeighbors_(gg.outNeighbors_),
+  inNeighbors_(gg.inNeighbors_),
+  frozenNeighbors_(gg.frozenNeighbors_)
+{}
+
+CompactGraph& CompactGraph::operator=(const CompactGraph& gg)
+{
+  directed_ = gg.directed_;
+  highestNodeID_ = gg.highestNodeID_;
+  highestEdgeID_ = gg.highestEdgeID_;
+  root_ = gg.root_;
+  nodeExists_ = gg.nodeExists_;
+  numberOfNodes_ = gg.numberOfNodes_;
+  edgeNodes_ = gg.edgeNodes_;
+  edgeExists_ = gg.edgeExists_;
+  numberOfEdges_ = gg.numberOfEdges_;
+  frozen_ = gg.frozen_;
+  outNeighbors_ = gg.outNeighbors_;
+  inNeighbors_ = gg.inNeighbors_;
+  frozenNeighbors_ = gg.frozenNeighbors_;
+
+  return *this;
+}
+
+/**********************************************/
+
+void CompactGraph::freeze()
+{
+  if (frozen_)
+    return;
+
+  size_t nbIds = nodeExists_.size();
+  std::shared_ptr<FrozenNeighbors> frozen = std::make_shared<FrozenNeighbors>();
+  vector<size_t>& outOffsets = frozen->outOffsetsStorage;
+  vector<size_t>& inOffsets = frozen->inOffsetsStorage;
+  outOffsets.assign(nbIds + 1, 0);
+  inOffsets.assign(nbIds + 1, 0);
+  for (size_t i = 0; i < nbIds; i++)
+  {
+    outOffsets[i + 1] = outOffsets[i] + outNeighbors_[i].size();
+    inOffsets[i + 1] = inOffsets[i] + inNeighbors_[i].size();
+  }
+
+  vector<Neighbor>& outArray = frozen->outArrayStorage;
+  vector<Neighbor>& inArray = frozen->inArrayStorage;
+  outArray.reserve(outOffsets[nbIds]);
+  inArray.reserve(inOffsets[nbIds]);
+  for (size_t i = 0; i < nbIds; i++)
+  {
+    outArray.insert(outArray.end(), outNeighbors_[i].begin(), outNeighbors_[i].end());
+    inArray.insert(inArray.end(), inNeighbors_[i].begin(), inNeighbors_[i].end());
+  }
+  frozen->useStorage();
+
+  vector<vector<Neighbor> >().swap(outNeighbors_);
+  vector<vector<Neighbor> >().swap(inNeighbors_);
+  frozenNeighbors_ = frozen;
+  frozen_ = true;
+}
+
+void CompactGraph::thaw()
+{
+  if (!frozen_)
+    return;
+
+  // the frozen arrays may be shared with copies of this graph: they are
+  // copied, never modified
+  const FrozenNeighbors& frozen = *frozenNeighbors_;
+  size_t nbIds = nodeExists_.size();
+  outNeighbors_.resize(nbIds);
+  inNeighbors_.resize(nbIds);
+  for (size_t i = 0; i < nbIds; i++)
+  {
+    outNeighbors_[i].assign(frozen.outArray + frozen.outOffsets[i], frozen.outArray + frozen.outOffsets[i + 1]);
+    inNeighbors_[i].assign(frozen.inArray + frozen.inOffsets[i], frozen.inArray + frozen.inOffsets[i + 1]);
+  }
+
+  frozenNeighbors_.reset();
+  frozen_ = false;
+}
+
+void CompactGraph::getNeighborRange_(CompactGraph::Node node, bool outgoing, const CompactGraph::Neighbor*& begin, const CompactGraph::Neighbor*& end) const
+{
+  if (!hasNode_(node))
+    throw Exception("The requested node is not in the structure.");
+
+  if (frozen_)
+  {
+    const size_t* offsets = outgoing ? frozenNeighbors_->outOffsets : frozenNeighbors_->inOffsets;
+    const Neighbor* array = outgoing ? frozenNeighbors_->outArray : frozenNeighbors_->inArray;
+    begin = array + offsets[node];
+    end = array + offsets[node + 1];
+  }
+  else
+  {
+    const vector<Neighbor>& neighbors = outgoing ? outNeighbors_[node] : inNeighbors_[node];
+    begin = neighbors.data();
+    end = begin + neighbors.size();
+  }
+}
+
+vector<CompactGraph::Neighbor>& CompactGraph::mutableNeighbors_(CompactGraph::Node node, bool outgoing)
+{
+  thaw();
+  return outgoing ? outNeighbors_[node] : inNeighbors_[node];
+}
+
+/**********************************************/
+
+void CompactGraph::nodeMustExist_(CompactGraph::Node node, string name) const
+{
+  if (!hasNode_(node))
+    throw Exception("This node must exist: " + TextTools::toString(node) + " as " + name + ".");
+}
+
+void CompactGraph::edgeMustExist_(CompactGraph::Edge edge, string name) const
+{
+  if (!hasEdge_(edge))
+    throw Exception("This edge must exist: " + TextTools::toString(edge) + " as " + name + ".");
+}
+
+CompactGraph::Edge CompactGraph::link(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  // which ID is available?
+  CompactGraph::Edge edgeID = ++highestEdgeID_;
+
+  // writing the new relation to the structure
+  linkInNodeStructure_(nodeA, nodeB, edgeID);
+  if (!directed_)
+  {
+    linkInNodeStructure_(nodeB, nodeA, edgeID);
+  }
+  linkInEdgeStructure_(nodeA, nodeB, edgeID);
+  return edgeID;
+}
+
+void CompactGraph::link(Graph::NodeId nodeA, Graph::NodeId nodeB, CompactGraph::Edge edgeID)
+{
+  if (hasEdge_(edgeID))
+    throw Exception("CompactGraph::link : already existing edgeId " + TextTools::toString(edgeID));
+
+  // writing the new relation to the structure
+  linkInNodeStructure_(nodeA, nodeB, edgeID);
+  if (!directed_)
+  {
+    linkInNodeStructure_(nodeB, nodeA, edgeID);
+  }
+  linkInEdgeStructure_(nodeA, nodeB, edgeID);
+}
+
+void CompactGraph::createNodesAndLinks(size_t nbNodes, const vector<pair<size_t, size_t> >& links, vector<Graph::NodeId>& newNodes, vector<Graph::EdgeId>& newEdges)
+{
+  for (const auto& currLink : links)
+  {
+    if (currLink.first >= nbNodes || currLink.second >= nbNodes)
+      throw Exception("CompactGraph::createNodesAndLinks : link between unknown nodes " + TextTools::toString(currLink.first) + " and " + TextTools::toString(currLink.second));
+  }
+
+  thaw();
+  size_t firstNode = highestNodeID_;
+  highestNodeID_ = static_cast<Node>(firstNode + nbNodes);
+  nodeExists_.resize(highestNodeID_, 1);
+  outNeighbors_.resize(highestNodeID_);
+  inNeighbors_.resize(highestNodeID_);
+  numberOfNodes_ += nbNodes;
+  newNodes.resize(nbNodes);
+  for (size_t i = 0; i < nbNodes; i++)
+    newNodes[i] = static_cast<Node>(firstNode + i);
+
+  size_t firstEdge = static_cast<size_t>(highestEdgeID_) + 1;
+  highestEdgeID_ = static_cast<Edge>(highestEdgeID_ + links.size());
+  if (edgeExists_.size() < firstEdge + links.size())
+  {
+    edgeExists_.resize(firstEdge + links.size(), 0);
+    edgeNodes_.resize(firstEdge + links.size());
+  }
+  newEdges.resize(links.size());
+  for (size_t i = 0; i < links.size(); i++)
+  {
+    Node nodeA = newNodes[links[i].first];
+    Node nodeB = newNodes[links[i].second];
+    Edge edge = static_cast<Edge>(firstEdge + i);
+    if (edgeExists_[edge])
+      throw Exception("CompactGraph::createNodesAndLinks : already existing edgeId " + TextTools::toString(edge));
+    edgeExists_[edge] = 1;
+    edgeNodes_[edge] = pair<Node, Node>(nodeA, nodeB);
+    outNeighbors_[nodeA].push_back(Neighbor(nodeB, edge));
+    inNeighbors_[nodeB].push_back(Neighbor(nodeA, edge));
+    if (!directed_ && nodeA != nodeB)
+    {
+      outNeighbors_[nodeB].push_back(Neighbor(nodeA, edge));
+      inNeighbors_[nodeA].push_back(Neighbor(nodeB, edge));
+    }
+    newEdges[i] = edge;
+  }
+  numberOfEdges_ += links.size();
+
+  // the new nodes are only linked together: sort their neighbors
+  for (size_t i = firstNode; i < highestNodeID_; i++)
+  {
+    for (vector<Neighbor>* neighbors : {&outNeighbors_[i], &inNeighbors_[i]})
+    {
+      sort(neighbors->begin(), neighbors->end());
+      for (size_t j = 1; j < neighbors->size(); j++)
+        if ((*neighbors)[j].first == (*neighbors)[j - 1].first)
+          throw Exception("CompactGraph::createNodesAndLinks : nodes linked twice " + TextTools::toString(i) + " and " + TextTools::toString((*neighbors)[j].first));
+    }
+  }
+
+  this->topologyHasChanged_();
+}
+
+vector<CompactGraph::Edge> CompactGraph::unlink(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  // unlinking in the structure
+  vector<CompactGraph::Edge> deletedEdges; // what edges ID are affected by this unlinking
+  deletedEdges.push_back(unlinkInNodeStructure_(nodeA, nodeB));
+
+  for (auto& currEdgeToDelete : deletedEdges)
+    unlinkInEdgeStructure_(currEdgeToDelete);
+
+  // telling the observers
+  notifyDeletedEdges(deletedEdges);
+
+  return deletedEdges;
+}
+
+void CompactGraph::switchNodes(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  nodeMustExist_(nodeA, "first node");
+  nodeMustExist_(nodeB, "second node");
+
+  Graph::NodeId father, son;
+
+  // Forwards
+  vector<Neighbor>& outA = mutableNeighbors_(nodeA, true);
+  const Neighbor* foundForwardRelation = findNeighbor(outA.data(), outA.data() + outA.size(), nodeB);
+  if (foundForwardRelation == outA.data() + outA.size())
+  {
+    vector<Neighbor>& outB = mutableNeighbors_(nodeB, true);
+    foundForwardRelation = findNeighbor(outB.data(), outB.data() + outB.size(), nodeA);
+    if (foundForwardRelation == outB.data() + outB.size())
+      throw Exception("CompactGraph::exchangeNodes : no edge between nodes " + TextTools::toString(nodeA) + " and " + TextTools::toString(nodeB));
+    father = nodeB;
+    son = nodeA;
+  }
+  else
+  {
+    father = nodeA;
+    son = nodeB;
+  }
+
+  // Edge
+  CompactGraph::Edge foundEdge = foundForwardRelation->second;
+
+  // Exchange
+  eraseNeighbor(mutableNeighbors_(father, true), son);
+  eraseNeighbor(mutableNeighbors_(son, false), father);
+
+  insertNeighbor(mutableNeighbors_(son, true), father, foundEdge, true);
+  insertNeighbor(mutableNeighbors_(father, false), son, foundEdge, true);
+
+  edgeNodes_[foundEdge] = pair<Node, Node>(son, father);
+
+  this->topologyHasChanged_();
+}
+
+void CompactGraph::unlinkInEdgeStructure_(CompactGraph::Edge edge)
+{
+  if (!hasEdge_(edge))
+    throw Exception("CompactGraph::unlinkInEdgeStructure_ : no edge to erase " + TextTools::toString(edge));
+
+  edgeExists_[edge] = 0;
+  numberOfEdges_--;
+  this->topologyHasChanged_();
+}
+
+void CompactGraph::linkInEdgeStructure_(CompactGraph::Node nodeA, CompactGraph::Node nodeB, CompactGraph::Edge edge)
+{
+  if (edge >= edgeExists_.size())
+  {
+    edgeExists_.resize(static_cast<size_t>(edge) + 1, 0);
+    edgeNodes_.resize(static_cast<size_t>(edge) + 1);
+  }
+  if (!edgeExists_[edge])
+    numberOfEdges_++;
+  edgeExists_[edge] = 1;
+  edgeNodes_[edge] = pair<Node, Node>(nodeA, nodeB);
+  this->topologyHasChanged_();
+}
+
+CompactGraph::Edge CompactGraph::unlinkInNodeStructure_(CompactGraph::Node nodeA, CompactGraph::Node nodeB)
+{
+  nodeMustExist_(nodeA, "first node");
+  nodeMustExist_(nodeB, "second node");
+
+  // Forward
+  vector<Neighbor>& outA = mutableNeighbors_(nodeA, true);
+  const Neighbor* foundForwardRelation = findNeighbor(outA.data(), outA.data() + outA.size(), nodeB);
+  if (foundForwardRelation == outA.data() + outA.size())
+    throw Exception("CompactGraph::unlinkInNodeStructure_ : no edge to erase " + TextTools::toString(nodeA) + "->" + TextTools::toString(nodeB));
+
+  CompactGraph::Edge foundEdge = foundForwardRelation->second;
+  eraseNeighbor(outA, nodeB);
+
+  // Backwards
+  if (!eraseNeighbor(mutableNeighbors_(nodeB, false), nodeA))
+    throw Exception("CompactGraph::unlinkInNodeStructure_ : no edge to erase " + TextTools::toString(nodeB) + "<-" + TextTools::toString(nodeA));
+
+  // an undirected relation is stored in both directions
+  if (!directed_)
+  {
+    eraseNeighbor(mutableNeighbors_(nodeB, true), nodeA);
+    eraseNeighbor(mutableNeighbors_(nodeA, false), nodeB);
+  }
+
+  this->topologyHasChanged_();
+  return foundEdge;
+}
+
+void CompactGraph::linkInNodeStructure_(CompactGraph::Node nodeA, CompactGraph::Node nodeB, CompactGraph::Edge edge)
+{
+  if (hasNode_(nodeA))
+    insertNeighbor(mutableNeighbors_(nodeA, true), nodeB, edge, false);
+
+  if (hasNode_(nodeB))
+    insertNeighbor(mutableNeighbors_(nodeB, false), nodeA, edge, false);
+
+  this->topologyHasChanged_();
+}
+
+Graph::NodeId CompactGraph::createNode()
+{
+  thaw();
+  CompactGraph::Node newNode = highestNodeID_++;
+  nodeExists_.resize(highestNodeID_, 0);
+  outNeighbors_.resize(highestNodeID_);
+  inNeighbors_.resize(highestNodeID_);
+  nodeExists_[newNode] = 1;
+  numberOfNodes_++;
+  this->topologyHasChanged_();
+
+  return newNode;
+}
+
+Graph::NodeId CompactGraph::createNodeFromNode(Graph::NodeId origin)
+{
+  Graph::NodeId newNode = createNode();
+  link(origin, newNode);
+  this->topologyHasChanged_();
+  return newNode;
+}
+
+Graph::NodeId CompactGraph::createNodeOnEdge(Graph::EdgeId edge)
+{
+  // origin must be an existing edge
+  edgeMustExist_(edge, "");
+
+  Graph::NodeId newNode = createNode();
+
+  // determining the nodes on the border of the edge
+  pair<CompactGraph::Node, CompactGraph::Node> nodes = edgeNodes_[edge];
+  CompactGraph::Node nodeA = nodes.first;
+  CompactGraph::Node nodeB = nodes.second;
+
+  unlink(nodeA, nodeB);
+  link(nodeA, newNode);
+  link(newNode, nodeB);
+  this->topologyHasChanged_();
+  return newNode;
+}
+
+Graph::NodeId CompactGraph::createNodeFromEdge(Graph::NodeId origin)
+{
+  // origin must be an existing edge
+  edgeMustExist_(origin, "origin edge");
+
+  // splitting the edge
+  Graph::NodeId anchor = createNodeOnEdge(origin);
+
+  Graph::NodeId newNode = createNodeFromNode(anchor);
+  this->topologyHasChanged_();
+  return newNode;
+}
+
+/*********************************************/
+
+void CompactGraph::registerObserver(GraphObserver* observer)
+{
+  if (!observers_.insert(observer).second)
+    throw (Exception("This GraphObserver was already an observer of this Graph"));
+}
+
+void CompactGraph::unregisterObserver(GraphObserver* observer)
+{
+  if (!observers_.erase(observer))
+    throw (Exception("This GraphObserver was not an observer of this Graph"));
+}
+
+/**********************************************/
+
+vector<CompactGraph::Node> CompactGraph::getNeighbors_(CompactGraph::Node node, bool outgoing) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, outgoing, begin, end);
+
+  vector<CompactGraph::Node> result;
+  result.reserve(static_cast<size_t>(end - begin));
+  for (const Neighbor* it = begin; it != end; it++)
+    result.push_back(it->first);
+
+  return result;
+}
+
+vector<CompactGraph::Edge> CompactGraph::getEdges_(CompactGraph::Node node, bool outgoing) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, outgoing, begin, end);
+
+  vector<CompactGraph::Edge> result;
+  result.reserve(static_cast<size_t>(end - begin));
+  for (const Neighbor* it = begin; it != end; it++)
+    result.push_back(it->second);
+
+  return result;
+}
+
+CompactGraph::NeighborRange CompactGraph::outgoingNeighborRange(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, true, begin, end);
+  return NeighborRange(NeighborRange::iterator(begin), NeighborRange::iterator(end));
+}
+
+CompactGraph::NeighborRange CompactGraph::incomingNeighborRange(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, false, begin, end);
+  return NeighborRange(NeighborRange::iterator(begin), NeighborRange::iterator(end));
+}
+
+CompactGraph::EdgeRange CompactGraph::outgoingEdgeRange(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, true, begin, end);
+  return EdgeRange(EdgeRange::iterator(begin), EdgeRange::iterator(end));
+}
+
+CompactGraph::EdgeRange CompactGraph::incomingEdgeRange(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, false, begin, end);
+  return EdgeRange(EdgeRange::iterator(begin), EdgeRange::iterator(end));
+}
+
+CompactGraph::NodeRange CompactGraph::nodeRange() const
+{
+  return NodeRange(ExistingIdIterator(nodeExists_, 0), ExistingIdIterator(nodeExists_, nodeExists_.size()));
+}
+
+vector<Graph::NodeId> CompactGraph::getIncomingNeighbors(Graph::NodeId node) const
+{
+  return getNeighbors_(node, false);
+}
+
+vector<Graph::EdgeId> CompactGraph::getIncomingEdges(Graph::NodeId node) const
+{
+  return getEdges_(node, false);
+}
+
+vector<Graph::NodeId> CompactGraph::getOutgoingNeighbors(Graph::NodeId node) const
+{
+  return getNeighbors_(node, true);
+}
+
+vector<Graph::EdgeId> CompactGraph::getOutgoingEdges(Graph::NodeId node) const
+{
+  return getEdges_(node, true);
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::allNodesIterator()
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::ALLGRAPHITER, false>(*this));
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::allNodesIterator() const
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::ALLGRAPHITER, true>(*this));
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::outgoingNeighborNodesIterator(Graph::NodeId node)
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, false>(*this, node));
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::outgoingNeighborNodesIterator(Graph::NodeId node) const
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, true>(*this, node));
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::incomingNeighborNodesIterator(Graph::NodeId node)
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::INCOMINGNEIGHBORITER, false>(*this, node));
+}
+
+unique_ptr<Graph::NodeIterator> CompactGraph::incomingNeighborNodesIterator(Graph::NodeId node) const
+{
+  return unique_ptr<Graph::NodeIterator>(new CompactNodesIteratorClass<Graph::INCOMINGNEIGHBORITER, true>(*this, node));
+}
+
+size_t CompactGraph::getDegree(Graph::NodeId node) const
+{
+  if (!hasNode_(node))
+    throw Exception("CompactGraph::getDegree : Node " + TextTools::toString(node) + " does not exist.");
+
+  return isDirected() ? getNumberOfOutgoingNeighbors(node) + getNumberOfIncomingNeighbors(node) : getNumberOfOutgoingNeighbors(node);
+}
+
+bool CompactGraph::isLeaf(Graph::NodeId node) const
+{
+  if (!hasNode_(node))
+    throw Exception("CompactGraph::isLeaf : Node " + TextTools::toString(node) + " does not exist.");
+
+  const Neighbor* outBegin;
+  const Neighbor* outEnd;
+  const Neighbor* inBegin;
+  const Neighbor* inEnd;
+  getNeighborRange_(node, true, outBegin, outEnd);
+  getNeighborRange_(node, false, inBegin, inEnd);
+  size_t nbOut = static_cast<size_t>(outEnd - outBegin);
+  size_t nbIn = static_cast<size_t>(inEnd - inBegin);
+
+  return (!isDirected() && (nbOut <= 1))
+         || (isDirected() && (
+               (nbOut + nbIn <= 1)
+               || (nbOut == 1 && nbIn == 1 && outBegin->first == inBegin->first)));
+}
+
+size_t CompactGraph::getNumberOfNeighbors(Graph::NodeId node) const
+{
+  if (isDirected())
+    return getNumberOfOutgoingNeighbors(node) + getNumberOfIncomingNeighbors(node);
+  else
+    return getNumberOfOutgoingNeighbors(node);
+}
+
+size_t CompactGraph::getNumberOfOutgoingNeighbors(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, true, begin, end);
+  return static_cast<size_t>(end - begin);
+}
+
+size_t CompactGraph::getNumberOfIncomingNeighbors(Graph::NodeId node) const
+{
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, false, begin, end);
+  return static_cast<size_t>(end - begin);
+}
+
+vector<Graph::NodeId> CompactGraph::getNeighbors(Graph::NodeId node) const
+{
+  vector<Graph::NodeId> result = getNeighbors_(node, false);
+  vector<Graph::NodeId> neighborsToInsert = getNeighbors_(node, true);
+  result.insert(result.end(), neighborsToInsert.begin(), neighborsToInsert.end());
+  return result;
+}
+
+pair<Graph::NodeId, Graph::NodeId> CompactGraph::getNodes(Graph::EdgeId edge) const
+{
+  edgeMustExist_(edge);
+  return edgeNodes_[edge];
+}
+
+Graph::NodeId CompactGraph::getTop(Graph::EdgeId edge) const
+{
+  return getNodes(edge).first;
+}
+
+Graph::NodeId CompactGraph::getBottom(Graph::EdgeId edge) const
+{
+  return getNodes(edge).second;
+}
+
+void CompactGraph::deleteNode(Graph::NodeId node)
+{
+  // checking the node
+  nodeMustExist_(node, "node to delete");
+  isolate_(node);
+  thaw();
+
+  nodeExists_[node] = 0;
+  numberOfNodes_--;
+  vector<Neighbor>().swap(outNeighbors_[node]);
+  vector<Neighbor>().swap(inNeighbors_[node]);
+
+  this->topologyHasChanged_();
+}
+
+void CompactGraph::isolate_(CompactGraph::Node node)
+{
+  vector<Graph::NodeId> oneighbors = getOutgoingNeighbors(node);
+  for (auto& currNeighbor : oneighbors)
+    unlink(node, currNeighbor);
+
+  vector<Graph::NodeId> ineighbors = getIncomingNeighbors(node);
+  for (auto& currNeighbor : ineighbors)
+    unlink(currNeighbor, node);
+}
+
+vector<Graph::EdgeId> CompactGraph::getAllEdges() const
+{
+  vector<Graph::EdgeId> listOfEdges;
+  listOfEdges.reserve(numberOfEdges_);
+  for (Edge edge = 0; edge < edgeExists_.size(); edge++)
+    if (edgeExists_[edge])
+      listOfEdges.push_back(edge);
+
+  return listOfEdges;
+}
+
+Graph::EdgeId CompactGraph::getAnyEdge(Graph::NodeId nodeA, Graph::NodeId nodeB) const
+{
+  try
+  {
+    // trying in the given order A->B
+    return getEdge(nodeA, nodeB);
+  }
+  catch (Exception& e)
+  {
+    // didn’t work, hence trying in the opposite order B->A
+    return getEdge(nodeB, nodeA);
+  }
+}
+
+vector<Graph::NodeId> CompactGraph::getAllLeaves() const
+{
+  vector<Graph::NodeId> listOfLeaves;
+  for (Node node = 0; node < nodeExists_.size(); node++)
+    if (nodeExists_[node] && this->isLeaf(node))
+      listOfLeaves.push_back(node);
+
+  return listOfLeaves;
+}
+
+set<Graph::NodeId> CompactGraph::getSetOfAllLeaves() const
+{
+  set<Graph::NodeId> listOfLeaves;
+  for (Node node = 0; node < nodeExists_.size(); node++)
+    if (nodeExists_[node] && this->isLeaf(node))
+      listOfLeaves.insert(listOfLeaves.end(), node);
+
+  return listOfLeaves;
+}
+
+vector<Graph::NodeId> CompactGraph::getAllNodes() const
+{
+  vector<Graph::NodeId> listOfNodes;
+  listOfNodes.reserve(numberOfNodes_);
+  for (Node node = 0; node < nodeExists_.size(); node++)
+    if (nodeExists_[node])
+      listOfNodes.push_back(node);
+
+  return listOfNodes;
+}
+
+vector<Graph::NodeId> CompactGraph::getAllInnerNodes() const
+{
+  vector<Graph::NodeId> listOfInNodes;
+  for (Node node = 0; node < nodeExists_.size(); node++)
+    if (nodeExists_[node] && this->getDegree(node) >= 2)
+      listOfInNodes.push_back(node);
+
+  return listOfInNodes;
+}
+
+void CompactGraph::fillListOfLeaves_(CompactGraph::Node startingNode, vector<CompactGraph::Node>& foundLeaves, CompactGraph::Node originNode, unsigned int maxRecursions) const
+{
+  const vector<Graph::NodeId> neighbors = getNeighbors(startingNode);
+  if (neighbors.size() > 1)
+  {
+    if (maxRecursions > 0)
+      for (const auto& currNeighbor : neighbors)
+        if (currNeighbor != originNode)
+          fillListOfLeaves_(currNeighbor, foundLeaves, startingNode, maxRecursions - 1);
+  }
+  else
+    foundLeaves.push_back(startingNode);
+}
+
+vector<Graph::NodeId> CompactGraph::getLeavesFromNode(Graph::NodeId node, unsigned int maxDepth) const
+{
+  vector<Graph::NodeId> listOfLeaves;
+  fillListOfLeaves_(node, listOfLeaves, node, maxDepth);
+  return listOfLeaves;
+}
+
+void CompactGraph::nodeToDot_(CompactGraph::Node node, ostream& out, set<pair<Node, Node> >& alreadyFigured) const
+{
+  out << node;
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(node, true, begin, end);
+  bool flag(false);
+  for (const Neighbor* currChild = begin; currChild != end; currChild++)
+  {
+    if (alreadyFigured.find(pair<Node, Node>(node, currChild->first)) != alreadyFigured.end() || (!directed_ && alreadyFigured.find(pair<Node, Node>(currChild->first, node)) != alreadyFigured.end()))
+      continue;
+    alreadyFigured.insert(pair<Node, Node>(node, currChild->first));
+    if (flag)
+      out << node;
+    out << (directed_ ? " -> " : " -- ");
+    nodeToDot_(currChild->first, out, alreadyFigured);
+    flag = true;
+  }
+  if (!flag)
+    out << ";\n   ";
+}
+
+bool CompactGraph::isTree() const
+{
+  nodeMustExist_(root_, "root");
+
+  // depth-first browsing from the root, each node coming with its origin
+  vector<char> metNodes(nodeExists_.size(), 0);
+  size_t nbMetNodes = 0;
+  vector<pair<Node, Node> > toVisit(1, pair<Node, Node>(root_, root_));
+  while (!toVisit.empty())
+  {
+    Node node = toVisit.back().first;
+    Node originNode = toVisit.back().second;
+    toVisit.pop_back();
+
+    if (metNodes[node])
+      return false;
+    metNodes[node] = 1;
+    nbMetNodes++;
+
+    const Neighbor* begin;
+    const Neighbor* end;
+    getNeighborRange_(node, true, begin, end);
+    for (const Neighbor* it = begin; it != end; it++)
+      if (it->first != originNode)
+        toVisit.push_back(pair<Node, Node>(it->first, node));
+  }
+
+  // now they have only been met at most once, they have to be met at least once
+  return nbMetNodes == numberOfNodes_;
+}
+
+bool CompactGraph::isDA() const
+{
+  // Algo: remove recursively all nodes with no sons from graph,
+  // keeping track of the number of remaining sons of each node
+  vector<size_t> nbSons(nodeExists_.size(), 0);
+  vector<Node> sinks;
+  for (Node node = 0; node < nodeExists_.size(); node++)
+  {
+    if (!nodeExists_[node])
+      continue;
+    nbSons[node] = getNumberOfOutgoingNeighbors(node);
+    if (nbSons[node] == 0)
+      sinks.push_back(node);
+  }
+
+  if (sinks.empty())
+    return false;
+
+  size_t nbRemoved = 0;
+  while (!sinks.empty())
+  {
+    Node node = sinks.back();
+    sinks.pop_back();
+    nbRemoved++;
+
+    const Neighbor* begin;
+    const Neighbor* end;
+    getNeighborRange_(node, false, begin, end);
+    for (const Neighbor* it = begin; it != end; it++)
+      if (--nbSons[it->first] == 0)
+        sinks.push_back(it->first);
+  }
+
+  return nbRemoved == numberOfNodes_;
+}
+
+void CompactGraph::orientate()
+{
+  if (!isDirected())
+    makeDirected();
+
+  CompactGraph gg(*this);
+  gg.observers_.clear();
+
+  // Algo: remove recursively all nodes from graph, starting with
+  // root_
+
+  Graph::NodeId node = root_;
+  set<Graph::NodeId> nextNodes;
+  nextNodes.insert(node);
+
+  while (gg.getNumberOfNodes() != 0)
+  {
+    // look for the next node to be treated
+    Graph::NodeId nbgg = 0;
+
+    // first node with one neighbor (ie no choice on orientation)
+
+    set<Graph::NodeId>::iterator it = nextNodes.begin();
+    for ( ; it != nextNodes.end(); it++)
+    {
+      if (gg.getNumberOfNeighbors(*it) <= 1)
+        break;
+    }
+
+    // if none, look for node wih minimum number of fathers
+    if (it == nextNodes.end())
+    {
+      size_t nbF = numeric_limits<size_t>::infinity();
+      it = nextNodes.begin();
+
+      for ( ; it != nextNodes.end(); it++)
+      {
+        size_t nbFi = gg.getNumberOfIncomingNeighbors(*it);
+        if (nbF == 0)
+        {
+          nbgg = *it;
+          break;
+        }
+        else
+        {
+          if (nbFi < nbF)
+          {
+            nbgg = *it;
+            nbF = nbFi;
+          }
+        }
+      }
+    }
+    else
+      nbgg = *it;
+
+    // next orient edges from this node and catch neighbors
+    vector<Graph::NodeId> vL = gg.getIncomingNeighbors(nbgg);
+    for (auto& it2 : vL)
+    {
+      switchNodes(nbgg, it2);
+      nextNodes.insert(it2);
+    }
+
+    vL = gg.getOutgoingNeighbors(nbgg);
+    for (auto& it2 : vL)
+      nextNodes.insert(it2);
+
+    gg.deleteNode(nbgg);
+    nextNodes.erase(nbgg);
+  }
+}
+
+void CompactGraph::setRoot(Graph::NodeId newRoot)
+{
+  nodeMustExist_(newRoot, "new root");
+  root_ = newRoot;
+}
+
+void CompactGraph::makeDirected()
+{
+  if (directed_)
+    return;
+  thaw();
+
+  // copy each relation once, without the reciprocal link
+  // (first met, first kept)
+  // eg: A - B in undirected is represented as A->B and B->A
+  //     in directed, becomes A->B only, with A <= B
+  vector<vector<Neighbor> > undirectedStructure;
+  undirectedStructure.swap(outNeighbors_);
+  outNeighbors_.resize(undirectedStructure.size());
+  for (auto& it : inNeighbors_)
+    it.clear();
+
+  for (Node nodeA = 0; nodeA < undirectedStructure.size(); nodeA++)
+  {
+    for (const auto& currRelation : undirectedStructure[nodeA])
+    {
+      Node nodeB = currRelation.first;
+      Edge edge = currRelation.second;
+      if (nodeA <= nodeB)
+      {
+        linkInNodeStructure_(nodeA, nodeB, edge);
+        edgeNodes_[edge] = pair<Node, Node>(nodeA, nodeB);
+      }
+    }
+  }
+  directed_ = true;
+  this->topologyHasChanged_();
+}
+
+void CompactGraph::makeUndirected()
+{
+  if (!directed_)
+    return;
+  if (containsReciprocalRelations())
+    throw Exception("Cannot make an undirected graph from a directed one containing reciprocal relations.");
+  thaw();
+
+  // copy each relation twice, making the reciprocal link
+  // eg: A - B in directed is represented as A->B
+  //     in undirected, becomes A->B and B->A
+  for (Node nodeA = 0; nodeA < outNeighbors_.size(); nodeA++)
+  {
+    for (const auto& currRelation : inNeighbors_[nodeA])
+      insertNeighbor(outNeighbors_[nodeA], currRelation.first, currRelation.second, false);
+    inNeighbors_[nodeA] = outNeighbors_[nodeA];
+  }
+  directed_ = false;
+  this->topologyHasChanged_();
+}
+
+bool CompactGraph::containsReciprocalRelations() const
+{
+  if (!directed_)
+    throw Exception("Cannot state reciprocal link in an undirected graph.");
+  for (Node nodeA = 0; nodeA < nodeExists_.size(); nodeA++)
+  {
+    if (!nodeExists_[nodeA])
+      continue;
+    const Neighbor* begin;
+    const Neighbor* end;
+    getNeighborRange_(nodeA, true, begin, end);
+    for (const Neighbor* it = begin; it != end; it++)
+    {
+      Node nodeB = it->first;
+      if (nodeB == nodeA || !hasNode_(nodeB))
+        continue;
+      const Neighbor* backBegin;
+      const Neighbor* backEnd;
+      getNeighborRange_(nodeB, true, backBegin, backEnd);
+      if (findNeighbor(backBegin, backEnd, nodeA) != backEnd)
+        return true;
+    }
+  }
+  return false;
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::allEdgesIterator()
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::ALLGRAPHITER, false>(*this));
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::outgoingEdgesIterator(Graph::NodeId node)
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, false>(*this, node));
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::incomingEdgesIterator(Graph::NodeId node)
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, false>(*this, node));
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::allEdgesIterator() const
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::ALLGRAPHITER, true>(*this));
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::outgoingEdgesIterator(Graph::NodeId node) const
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, true>(*this, node));
+}
+
+unique_ptr<Graph::EdgeIterator> CompactGraph::incomingEdgesIterator(Graph::NodeId node) const
+{
+  return unique_ptr<Graph::EdgeIterator>(new CompactEdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, true>(*this, node));
+}
+
+Graph::EdgeId CompactGraph::getEdge(Graph::NodeId nodeA, Graph::NodeId nodeB) const
+{
+  if (!hasNode_(nodeA))
+    throw (Exception("The fist node was not the origin of an edge."));
+  const Neighbor* begin;
+  const Neighbor* end;
+  getNeighborRange_(nodeA, true, begin, end);
+  const Neighbor* secondNodeFound = findNeighbor(begin, end, nodeB);
+  if (secondNodeFound == end)
+    throw (Exception("The second node was not in a relation with the first one."));
+  return secondNodeFound->second;
+}
+
+vector<Graph::EdgeId> CompactGraph::getEdges(Graph::NodeId node) const
+{
+  vector<Graph::EdgeId> result = getEdges_(node, false);
+  vector<Graph::EdgeId> edgesToInsert = getEdges_(node, true);
+  result.insert(result.end(), edgesToInsert.begin(), edgesToInsert.end());
+  return result;
+}
+
+void CompactGraph::outputToDot(ostream& out, const string& name) const
+{
+  out << (directed_ ? "digraph" : "graph") << " " << name << " {\n   ";
+  set<pair<Node, Node> > alreadyFigured;
+  nodeToDot_(root_, out, alreadyFigured);
+  for (Node node = 0; node < nodeExists_.size(); node++)
+    if (nodeExists_[node] && node != root_)
+      nodeToDot_(node, out, alreadyFigured);
+  out << "\r}" << endl;
+}
+
+void CompactGraph::notifyDeletedEdges(const vector<Graph::EdgeId>& edgesToDelete) const
+{
+  for (auto& currObserver : observers_)
+    currObserver->deletedEdgesUpdate(edgesToDelete);
+}
+
+void CompactGraph::notifyDeletedNodes(const vector<Graph::NodeId>& nodesToDelete) const
+{
+  for (auto& currObserver : observers_)
+    currObserver->deletedNodesUpdate(nodesToDelete);
+}
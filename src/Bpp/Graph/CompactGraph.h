@@ -0,0 +1,599 @@
+//
+// File: CompactGraph.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _COMPACT_GRAPH_H_
+#define _COMPACT_GRAPH_H_
+
+#include "../Clonable.h"
+#include "Graph.h"
+#include "GraphRange.h"
+
+// From the STL:
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+template<class T, bool is_const>
+class CompactNodesIteratorClass;
+
+template<class T, bool is_const>
+class CompactEdgesIteratorClass;
+
+class CompactNeighborIteratorClass;
+
+/**
+ * @brief A graph implementation with dense ids and contiguous adjacency arrays.
+ *
+ * CompactGraph is an alternative to GlobalGraph for large graphs, with the same
+ * interface and the same semantics, so that it can be used as the GraphImpl
+ * parameter of TreeGraphImpl, DAGraphImpl and of the Association*GraphImplObserver
+ * templates.
+ *
+ * Nodes and edges are indexed by their ids in vectors. The neighbors of a node
+ * are stored as (node, edge) pairs sorted by node id, so that neighbors are
+ * listed in the same order as with GlobalGraph.
+ *
+ * The graph has two states:
+ * - thawed (the default), where each node has its own arrays of outgoing
+ *   and incoming neighbors, which can be modified;
+ * - frozen, where all the neighbors are stored in two contiguous arrays, in
+ *   compressed sparse row (CSR) layout, with one offset per node.
+ *
+ * freeze() switches to the frozen state, which is more compact and faster to
+ * browse, once the topology has been built. Any modification of the topology
+ * thaws the graph, which can also be done explicitly with thaw().
+ *
+ * Copies of a frozen graph share its arrays until they are thawed, so that
+ * copying a large frozen topology is cheap.
+ */
+class CompactGraph :
+  public virtual Graph,
+  public virtual Clonable
+{
+public:
+  typedef Graph::NodeId Node;
+  typedef Graph::EdgeId Edge;
+
+  /**
+   * A neighbor, and the edge leading to it.
+   */
+  typedef std::pair<Node, Edge> Neighbor;
+
+  template<class T, bool is_const>
+  using NodesIterator = CompactNodesIteratorClass<T, is_const>;
+
+  template<class T, bool is_const>
+  using EdgesIterator = CompactEdgesIteratorClass<T, is_const>;
+
+  /**
+   * Ranges on the arrays of this implementation, see GraphRange.
+   */
+  typedef GraphRange<AdjacencyIterator<const Neighbor*, NeighborNodeAccessor> > NeighborRange;
+  typedef GraphRange<AdjacencyIterator<const Neighbor*, NeighborEdgeAccessor> > EdgeRange;
+  typedef GraphRange<ExistingIdIterator> NodeRange;
+
+private:
+  bool directed_;
+
+  std::set<GraphObserver*> observers_;
+
+  /**
+   * Highest used available ID for a Node.
+   */
+  Node highestNodeID_;
+
+  /**
+   * Highest used available ID for an Edge.
+   */
+  Edge highestEdgeID_;
+
+  Node root_;
+
+  /**
+   * @name Nodes and edges, indexed by their ids.
+   *
+   * @{
+   */
+  std::vector<char> nodeExists_;
+  size_t numberOfNodes_;
+  std::vector<std::pair<Node, Node> > edgeNodes_;
+  std::vector<char> edgeExists_;
+  size_t numberOfEdges_;
+  /** @} */
+
+  bool frozen_;
+
+  /**
+   * @name Neighbors in the thawed state, one array per node.
+   *
+   * For an undirected graph, outgoing and incoming neighbors are the same.
+   * @{
+   */
+  std::vector<std::vector<Neighbor> > outNeighbors_;
+  std::vector<std::vector<Neighbor> > inNeighbors_;
+  /** @} */
+
+  /**
+   * Neighbors in the frozen state.
+   *
+   * The neighbors of node i are stored in [offsets[i], offsets[i + 1][.
+   */
+  struct FrozenNeighbors
+  {
+    /**
+     * Views on the arrays, which are stored either in the vectors below,
+     * or in a memory region kept alive by mapping (see BinaryGraphFormat).
+     */
+    const size_t* outOffsets;
+    const Neighbor* outArray;
+    const size_t* inOffsets;
+    const Neighbor* inArray;
+
+    std::vector<size_t> outOffsetsStorage;
+    std::vector<Neighbor> outArrayStorage;
+    std::vector<size_t> inOffsetsStorage;
+    std::vector<Neighbor> inArrayStorage;
+    std::shared_ptr<const void> mapping;
+
+    FrozenNeighbors() :
+      outOffsets(0), outArray(0), inOffsets(0), inArray(0),
+      outOffsetsStorage(), outArrayStorage(), inOffsetsStorage(), inArrayStorage(),
+      mapping() {}
+
+    FrozenNeighbors(const FrozenNeighbors&) = delete;
+    FrozenNeighbors& operator=(const FrozenNeighbors&) = delete;
+
+    /**
+     * Point the views to the vectors.
+     */
+    void useStorage()
+    {
+      outOffsets = outOffsetsStorage.data();
+      outArray = outArrayStorage.data();
+      inOffsets = inOffsetsStorage.data();
+      inArray = inArrayStorage.data();
+    }
+  };
+
+  /**
+   * The frozen neighbors are never modified, so they are shared between
+   * copies of a frozen graph. Each copy gets its own arrays when it is
+   * thawed.
+   */
+  std::shared_ptr<const FrozenNeighbors> frozenNeighbors_;
+
+  /**
+   * Some types of Graphs need to know if they have been modified
+   * But for a Graph, it does nothing.
+   */
+  virtual void topologyHasChanged_() const {}
+
+  void linkInNodeStructure_(Node nodeA, Node nodeB, Edge edge);
+  void linkInEdgeStructure_(Node nodeA, Node nodeB, Edge edge);
+  Edge unlinkInNodeStructure_(Node nodeA, Node nodeB);
+  void unlinkInEdgeStructure_(Edge edge);
+
+protected:
+  Node getHighestNodeID() const { return highestNodeID_; }
+  Edge getHighestEdgeID() const { return highestEdgeID_; }
+
+  /**
+   * Check that a node exists. If not, throw an exception.
+   * @param node node that has to be checked
+   * @param name common name to give to the user in case of failure (eg: "first node")
+   */
+  void nodeMustExist_(Node node, std::string name = "") const;
+
+  /**
+   * Check that a edge exists. If not, throw an exception.
+   * @param edge edge that has to be checked
+   * @param name common name to give to the user in case of failure (eg: "first node")
+   */
+  void edgeMustExist_(Edge edge, std::string name = "") const;
+
+  bool hasNode_(Node node) const { return node < nodeExists_.size() && nodeExists_[node]; }
+
+  bool hasEdge_(Edge edge) const { return edge < edgeExists_.size() && edgeExists_[edge]; }
+
+  /**
+   * Get the neighbors of an existing node, as a contiguous range.
+   * The range is invalidated by any modification of the topology.
+   * @param node the node
+   * @param outgoing if true, outgoing neighbors; else incoming
+   * @param begin [out] the first neighbor
+   * @param end [out] past the last neighbor
+   */
+  void getNeighborRange_(Node node, bool outgoing, const Neighbor*& begin, const Neighbor*& end) const;
+
+private:
+  std::vector<Neighbor>& mutableNeighbors_(Node node, bool outgoing);
+
+  std::vector<Node> getNeighbors_(Node node, bool outgoing = true) const;
+  std::vector<Edge> getEdges_(Node node, bool outgoing = true) const;
+
+  void isolate_(Node node);
+
+  void fillListOfLeaves_(Node startingNode, std::vector<Node>& foundLeaves, Node originNode, unsigned int maxRecursions) const;
+
+  void nodeToDot_(Node node, std::ostream& out, std::set<std::pair<Node, Node> >& alreadyFigured) const;
+
+public:
+  /**
+   * Constructor
+   * @param directed true if the graph is directed.
+   */
+  CompactGraph(bool directed = false);
+
+  CompactGraph(const CompactGraph& gg);
+
+  CompactGraph& operator=(const CompactGraph& gg);
+
+  CompactGraph* clone() const { return new CompactGraph(*this); }
+
+  ~CompactGraph() {}
+
+  /**
+   * @name Freeze and thaw.
+   *
+   * @{
+   */
+
+  /**
+   * @brief Store all the neighbors in contiguous arrays.
+   */
+  void freeze();
+
+  /**
+   * @brief Store the neighbors of each node in its own array, so that
+   * the topology can be modified.
+   */
+  void thaw();
+
+  bool isFrozen() const { return frozen_; }
+  /** @} */
+
+protected:
+  void setRoot(Graph::NodeId newRoot);
+
+public:
+  Graph::NodeId getRoot() const { return root_; }
+
+  void makeDirected();
+
+  void makeUndirected();
+
+  Graph::NodeId createNode();
+
+  Graph::NodeId createNodeFromNode(Graph::NodeId origin);
+
+  Graph::NodeId createNodeOnEdge(Graph::EdgeId edge);
+
+  Graph::NodeId createNodeFromEdge(Graph::NodeId origin);
+
+protected:
+  Graph::EdgeId link(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+  void link(Graph::NodeId nodeA, Graph::NodeId nodeB, Graph::EdgeId edgeID);
+
+  void createNodesAndLinks(size_t nbNodes, const std::vector<std::pair<size_t, size_t> >& links, std::vector<Graph::NodeId>& newNodes, std::vector<Graph::EdgeId>& newEdges);
+
+  /**
+   * Switch the edge  between two existing nodes.
+   * @param nodeA source node (or first node if undirected)
+   * @param nodeB target node (or second node if undirected)
+   */
+  void switchNodes(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+  std::vector<Graph::EdgeId> unlink(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+public:
+  void deleteNode(Graph::NodeId node);
+
+  void registerObserver(GraphObserver* observer);
+
+  void unregisterObserver(GraphObserver* observer);
+
+  template<typename T, bool is_const>
+  friend class CompactNodesIteratorClass;
+
+  template<typename T, bool is_const>
+  friend class CompactEdgesIteratorClass;
+
+  friend class CompactNeighborIteratorClass;
+
+  std::unique_ptr<Graph::NodeIterator> allNodesIterator();
+  std::unique_ptr<Graph::NodeIterator> allNodesIterator() const;
+
+  std::unique_ptr<Graph::NodeIterator> outgoingNeighborNodesIterator(NodeId node);
+  std::unique_ptr<Graph::NodeIterator> outgoingNeighborNodesIterator(NodeId node) const;
+
+  std::unique_ptr<Graph::NodeIterator> incomingNeighborNodesIterator(NodeId node);
+  std::unique_ptr<Graph::NodeIterator> incomingNeighborNodesIterator(NodeId node) const;
+
+  size_t getNumberOfNodes() const { return numberOfNodes_; }
+
+  size_t getNumberOfEdges() const { return numberOfEdges_; }
+
+  size_t getDegree(Graph::NodeId node) const;
+
+  bool isLeaf(Graph::NodeId node) const;
+
+  size_t getNumberOfNeighbors(Graph::NodeId node) const;
+
+  size_t getNumberOfOutgoingNeighbors(Graph::NodeId node) const;
+
+  size_t getNumberOfIncomingNeighbors(Graph::NodeId node) const;
+
+  std::vector<Graph::NodeId> getNeighbors(Graph::NodeId node) const;
+
+  std::vector<Graph::NodeId> getOutgoingNeighbors(Graph::NodeId node) const;
+
+  std::vector<Graph::NodeId> getIncomingNeighbors(Graph::NodeId node) const;
+
+  /**
+   * @name Ranges on the neighbors of a node, with no copy.
+   *
+   * Usable in range-based for loops, until the next modification of the
+   * topology.
+   * @{
+   */
+  NeighborRange outgoingNeighborRange(Graph::NodeId node) const;
+  NeighborRange incomingNeighborRange(Graph::NodeId node) const;
+  EdgeRange outgoingEdgeRange(Graph::NodeId node) const;
+  EdgeRange incomingEdgeRange(Graph::NodeId node) const;
+  NodeRange nodeRange() const;
+  /** @} */
+
+  std::vector<Graph::NodeId> getLeavesFromNode(Graph::NodeId node, unsigned int maxDepth) const;
+
+  std::vector<Graph::NodeId> getAllLeaves() const;
+
+  std::set<NodeId> getSetOfAllLeaves() const;
+
+  std::vector<Graph::NodeId> getAllNodes() const;
+
+  std::vector<Graph::NodeId> getAllInnerNodes() const;
+
+  std::pair<Graph::NodeId, Graph::NodeId> getNodes(Graph::EdgeId edge) const;
+
+  Graph::NodeId getTop(Graph::EdgeId edge) const;
+
+  Graph::NodeId getBottom(Graph::EdgeId edge) const;
+
+  /**
+   * Is the graph a tree?
+   * Linear in the number of nodes.
+   * @return false if a node is met more than one time browsing the graph
+   */
+  bool isTree() const;
+
+  /**
+   * Is the graph directed acyclic?
+   * Linear in the number of nodes and edges.
+   */
+  bool isDA() const;
+
+  void orientate();
+
+  bool isDirected() const { return directed_; }
+
+  bool containsReciprocalRelations() const;
+
+  std::unique_ptr<EdgeIterator> allEdgesIterator();
+  std::unique_ptr<EdgeIterator> allEdgesIterator() const;
+
+  std::unique_ptr<EdgeIterator> outgoingEdgesIterator(NodeId node);
+  std::unique_ptr<EdgeIterator> outgoingEdgesIterator(NodeId node) const;
+
+  std::unique_ptr<EdgeIterator> incomingEdgesIterator(NodeId node);
+  std::unique_ptr<EdgeIterator> incomingEdgesIterator(NodeId node) const;
+
+  std::vector<Graph::EdgeId> getEdges(Graph::NodeId node) const;
+
+  std::vector<Graph::EdgeId> getOutgoingEdges(Graph::NodeId node) const;
+
+  std::vector<Graph::EdgeId> getIncomingEdges(Graph::NodeId node) const;
+
+  Graph::EdgeId getEdge(Graph::NodeId nodeA, Graph::NodeId nodeB) const;
+
+  Graph::EdgeId getAnyEdge(Graph::NodeId nodeA, Graph::NodeId nodeB) const;
+
+  std::vector<Graph::EdgeId> getAllEdges() const;
+
+  void notifyDeletedEdges(const std::vector<Graph::EdgeId>& edgesToDelete) const;
+
+  void notifyDeletedNodes(const std::vector<Graph::NodeId>& nodesToDelete) const;
+
+  void outputToDot(std::ostream& out, const std::string& name) const;
+
+  template<class N, class E, class GraphImpl>
+  friend class AssociationGraphImplObserver;
+  friend class BinaryGraphFormat;
+};
+
+/************************************************/
+/* ITERATORS */
+/************************************************/
+
+/**
+ * @brief Iterators on the nodes of a CompactGraph.
+ *
+ * Iterators on neighbors are invalidated by any modification of the topology.
+ */
+template<class T, bool is_const>
+class CompactNodesIteratorClass
+{};
+
+template<bool is_const>
+class CompactNodesIteratorClass<Graph::ALLGRAPHITER, is_const> :
+  public virtual Graph::NodeIterator
+{
+private:
+  const std::vector<char>& exists_;
+  Graph::NodeId it_;
+
+public:
+  CompactNodesIteratorClass(const CompactGraph& gg) :
+    exists_(gg.nodeExists_), it_(0) { start(); }
+
+  void next() { for (it_++; !end() && !exists_[it_]; it_++) {} }
+  bool end() const { return it_ >= exists_.size(); }
+  void start() { for (it_ = 0; !end() && !exists_[it_]; it_++) {} }
+  Graph::NodeId operator*() { return it_; }
+};
+
+/**
+ * @brief Iterator on a contiguous range of neighbors.
+ */
+class CompactNeighborIteratorClass
+{
+protected:
+  const CompactGraph::Neighbor* it_;
+  const CompactGraph::Neighbor* begin_;
+  const CompactGraph::Neighbor* end_;
+
+public:
+  CompactNeighborIteratorClass(const CompactGraph& gg, Graph::NodeId node, bool outgoing) :
+    it_(0), begin_(0), end_(0)
+  {
+    gg.getNeighborRange_(node, outgoing, begin_, end_);
+    it_ = begin_;
+  }
+
+  CompactNeighborIteratorClass(const CompactNeighborIteratorClass&) = default;
+  CompactNeighborIteratorClass& operator=(const CompactNeighborIteratorClass&) = default;
+  virtual ~CompactNeighborIteratorClass() {}
+
+  void next() { it_++; }
+  bool end() const { return it_ == end_; }
+  void start() { it_ = begin_; }
+};
+
+template<bool is_const>
+class CompactNodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const> :
+  public CompactNeighborIteratorClass,
+  public virtual Graph::NodeIterator
+{
+public:
+  CompactNodesIteratorClass(const CompactGraph& gg, Graph::NodeId node) :
+    CompactNeighborIteratorClass(gg, node, true) {}
+
+  void next() { CompactNeighborIteratorClass::next(); }
+  bool end() const { return CompactNeighborIteratorClass::end(); }
+  void start() { CompactNeighborIteratorClass::start(); }
+  Graph::NodeId operator*() { return it_->first; }
+};
+
+template<bool is_const>
+class CompactNodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const> :
+  public CompactNeighborIteratorClass,
+  public virtual Graph::NodeIterator
+{
+public:
+  CompactNodesIteratorClass(const CompactGraph& gg, Graph::NodeId node) :
+    CompactNeighborIteratorClass(gg, node, false) {}
+
+  void next() { CompactNeighborIteratorClass::next(); }
+  bool end() const { return CompactNeighborIteratorClass::end(); }
+  void start() { CompactNeighborIteratorClass::start(); }
+  Graph::NodeId operator*() { return it_->first; }
+};
+
+/**
+ * @brief Iterators on the edges of a CompactGraph.
+ */
+template<class T, bool is_const>
+class CompactEdgesIteratorClass
+{};
+
+template<bool is_const>
+class CompactEdgesIteratorClass<Graph::ALLGRAPHITER, is_const> :
+  public virtual Graph::EdgeIterator
+{
+private:
+  const std::vector<char>& exists_;
+  Graph::EdgeId it_;
+
+public:
+  CompactEdgesIteratorClass(const CompactGraph& gg) :
+    exists_(gg.edgeExists_), it_(0) { start(); }
+
+  void next() { for (it_++; !end() && !exists_[it_]; it_++) {} }
+  bool end() const { return it_ >= exists_.size(); }
+  void start() { for (it_ = 0; !end() && !exists_[it_]; it_++) {} }
+  Graph::EdgeId operator*() { return it_; }
+};
+
+template<bool is_const>
+class CompactEdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const> :
+  public CompactNeighborIteratorClass,
+  public virtual Graph::EdgeIterator
+{
+public:
+  CompactEdgesIteratorClass(const CompactGraph& gg, Graph::NodeId node) :
+    CompactNeighborIteratorClass(gg, node, true) {}
+
+  void next() { CompactNeighborIteratorClass::next(); }
+  bool end() const { return CompactNeighborIteratorClass::end(); }
+  void start() { CompactNeighborIteratorClass::start(); }
+  Graph::EdgeId operator*() { return it_->second; }
+};
+
+template<bool is_const>
+class CompactEdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const> :
+  public CompactNeighborIteratorClass,
+  public virtual Graph::EdgeIterator
+{
+public:
+  CompactEdgesIteratorClass(const CompactGraph& gg, Graph::NodeId node) :
+    CompactNeighborIteratorClass(gg, node, false) {}
+
+  void next() { CompactNeighborIteratorClass::next(); }
+  bool end() const { return CompactNeighborIteratorClass::end(); }
+  void start() { CompactNeighborIteratorClass::start(); }
+  Graph::EdgeId operator*() { return it_->second; }
+};
+} // end of namespace bpp.
+
+#endif // _COMPACT_GRAPH_H_
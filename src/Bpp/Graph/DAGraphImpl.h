@@ -40,14 +40,19 @@
 #ifndef _DA_GRAPH_IMPL_H_
 #define _DA_GRAPH_IMPL_H_
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <ostream>
+#include <set>
 
 
 #include "DAGraph.h"
+#include "CompactGraph.h"
 #include "GlobalGraph.h"
+#include "GraphTraversalSchedule.h"
 
 #include "../Exceptions.h"
 #include "../Numeric/VectorTools.h"
@@ -64,14 +69,81 @@ protected:
    * Is the graph a DAG? Set to false when structure is modified, true after validation.
    */
 
-  mutable bool isValid_;
+  mutable std::atomic<bool> isValid_;
 
   /**
    * Is the graph rooted? Set to false when structure is modified,
    * true after validation.
    */
 
-  mutable bool isRooted_;
+  mutable std::atomic<bool> isRooted_;
+
+  /**
+   * @name Incremental validation.
+   *
+   * Once the graph has been found acyclic, the edits performed with
+   * createNode, link, unlink and deleteNode are recorded, so that the
+   * next validation only checks the new edges that may close a cycle.
+   * Any other modification of the topology stops the recording, and
+   * the next validation browses the whole graph.
+   * @{
+   */
+  mutable bool incremental_;
+
+  // sons of new edges that may close a cycle
+  mutable std::vector<Graph::NodeId> linkedNodes_;
+
+  // number of recorded edits in progress
+  unsigned int nbRecordedEdits_;
+
+  /**
+   * Marks an edit in progress. If the edit is not completed,
+   * eg because an exception was thrown, the recording is stopped.
+   */
+  class RecordedEdit_
+  {
+private:
+    DAGraphImpl<GraphImpl>& dag_;
+    bool done_;
+
+public:
+    RecordedEdit_(DAGraphImpl<GraphImpl>& dag) : dag_(dag), done_(false) { dag_.nbRecordedEdits_++; }
+    ~RecordedEdit_()
+    {
+      dag_.nbRecordedEdits_--;
+      if (!done_)
+        dag_.resetEdits_(false);
+    }
+    void done() { done_ = true; }
+  };
+
+  // record a new edge
+  void recordLink_(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+  // forget the recorded edits, and start recording again or not
+  void resetEdits_(bool incremental) const;
+
+  // check the recorded edits, false if the graph could not be proven acyclic
+  bool validateEdits_() const;
+  /** @} */
+
+  /**
+   * Schedule of the parallel traversals, built when needed, and dropped
+   * at each modification of the topology.
+   */
+  mutable GraphTraversalSchedule schedule_;
+
+  mutable std::atomic<bool> hasSchedule_;
+
+  /**
+   * Guards the lazy validation and build of the schedule, so that const
+   * queries and traversals may be run concurrently, as long as the graph
+   * is not modified meanwhile.
+   */
+  mutable std::mutex cacheMutex_;
+
+  // copy the validation state and the schedule of another DAG
+  void copyCache_(const DAGraphImpl<GraphImpl>& dag);
 
   // unvalidate the DAG
   virtual void topologyHasChanged_() const;
@@ -104,6 +176,20 @@ protected:
 
   void orientGraphFrom_(std::set<Graph::NodeId>& metNodes, Graph::NodeId localRoot);
 
+  /**
+   * @name Modifications of the topology, recorded for incremental validation.
+   * @{
+   */
+  Graph::EdgeId link(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+  void link(Graph::NodeId nodeA, Graph::NodeId nodeB, Graph::EdgeId edgeID);
+
+  std::vector<Graph::EdgeId> unlink(Graph::NodeId nodeA, Graph::NodeId nodeB);
+  /** @} */
+
+  template<class N, class E, class GraphImpl2>
+  friend class AssociationGraphImplObserver;
+
 public:
   /**
    * bool is only for inheritance from observers, useless.
@@ -112,12 +198,56 @@ public:
 
   DAGraphImpl(bool b = true);
 
+  DAGraphImpl(const DAGraphImpl<GraphImpl>& dag);
+
+  DAGraphImpl<GraphImpl>& operator=(const DAGraphImpl<GraphImpl>& dag);
+
   /**
    * Is the graph a DAG?
    * @return true if valid DAG
    */
   bool isValid() const;
 
+  /**
+   * @name Modifications of the topology, recorded for incremental validation.
+   * @{
+   */
+  Graph::NodeId createNode();
+
+  Graph::NodeId createNodeFromNode(Graph::NodeId origin);
+
+  Graph::NodeId createNodeOnEdge(Graph::EdgeId edge);
+
+  Graph::NodeId createNodeFromEdge(Graph::EdgeId origin);
+
+  void deleteNode(Graph::NodeId node);
+  /** @} */
+
+  /**
+   * @name Parallel traversals.
+   *
+   * A task is run on each node of the DAG, once it has been run on all
+   * the sons of the node (post-order) or on all its fathers (pre-order).
+   * Independent parts of the graph are processed concurrently.
+   *
+   * @param task      The task, called with a node and the index of the thread in [0, nbThreads[.
+   * @param nbThreads The maximum number of threads to use (0 means all available threads).
+   * @see GraphTraversalSchedule
+   * @{
+   */
+  void parallelPostOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads = 1) const;
+
+  void parallelPreOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads = 1) const;
+
+  /**
+   * @brief Get the schedule of the traversals, built if needed.
+   *
+   * The reference is valid until the next modification of the topology.
+   * @throw Exception if the graph is not a valid DAG.
+   */
+  const GraphTraversalSchedule& getTraversalSchedule() const;
+  /** @} */
+
   /**
    * Is the DAG rooted?
    *
@@ -145,6 +275,13 @@ public:
 
   std::vector<Graph::NodeId> getFathers(Graph::NodeId nodeid) const;
 
+  /**
+   * Get a range on the father nodes of a node, with no copy.
+   * It is invalidated by any modification of the topology.
+   */
+
+  typename GraphImpl::NeighborRange fatherRange(Graph::NodeId node) const { return GraphImpl::incomingNeighborRange(node); }
+
   /**
    * @brief Get the number of fathers nodes
    */
@@ -185,6 +322,17 @@ public:
 
   std::vector<Graph::NodeId> getSons(Graph::NodeId node) const;
 
+  /**
+   * Get ranges on the sons of a node and on the branches to them, with
+   * no copy. They are invalidated by any modification of the topology.
+   * @{
+   */
+
+  typename GraphImpl::NeighborRange sonRange(Graph::NodeId node) const { return GraphImpl::outgoingNeighborRange(node); }
+
+  typename GraphImpl::EdgeRange branchRange(Graph::NodeId node) const { return GraphImpl::outgoingEdgeRange(node); }
+  /** @} */
+
   /**
    * @brief Get the number of sons node
    */
@@ -244,6 +392,8 @@ public:
 
 typedef DAGraphImpl<GlobalGraph> DAGlobalGraph;
 
+typedef DAGraphImpl<CompactGraph> DAGCompactGraph;
+
 /*****************/
 
 
@@ -251,13 +401,62 @@ template<class GraphImpl>
 DAGraphImpl<GraphImpl>::DAGraphImpl(bool b) :
   GraphImpl(true),
   isValid_(false),
-  isRooted_(false)
+  isRooted_(false),
+  incremental_(false),
+  linkedNodes_(),
+  nbRecordedEdits_(0),
+  schedule_(),
+  hasSchedule_(false),
+  cacheMutex_()
 {}
 
+template<class GraphImpl>
+DAGraphImpl<GraphImpl>::DAGraphImpl(const DAGraphImpl<GraphImpl>& dag) :
+  GraphImpl(dag),
+  isValid_(false),
+  isRooted_(false),
+  incremental_(false),
+  linkedNodes_(),
+  nbRecordedEdits_(0),
+  schedule_(),
+  hasSchedule_(false),
+  cacheMutex_()
+{
+  copyCache_(dag);
+}
+
+template<class GraphImpl>
+DAGraphImpl<GraphImpl>& DAGraphImpl<GraphImpl>::operator=(const DAGraphImpl<GraphImpl>& dag)
+{
+  if (this != &dag)
+  {
+    GraphImpl::operator=(dag);
+    nbRecordedEdits_ = 0;
+    copyCache_(dag);
+  }
+  return *this;
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::copyCache_(const DAGraphImpl<GraphImpl>& dag)
+{
+  // the other DAG may be building its schedule in a const query
+  std::lock_guard<std::mutex> lock(dag.cacheMutex_);
+  isValid_ = dag.isValid_.load();
+  isRooted_ = dag.isRooted_.load();
+  incremental_ = dag.incremental_;
+  linkedNodes_ = dag.linkedNodes_;
+  schedule_ = dag.schedule_;
+  hasSchedule_ = dag.hasSchedule_.load();
+}
+
 
 template<class GraphImpl>
 bool DAGraphImpl<GraphImpl>::isValid() const
 {
+  if (isValid_)
+    return true;
+  std::lock_guard<std::mutex> lock(cacheMutex_);
   return isValid_ || validate_();
 }
 
@@ -312,16 +511,14 @@ size_t DAGraphImpl<GraphImpl>::getNumberOfFathers(Graph::NodeId node) const
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::addFather(Graph::NodeId node, Graph::NodeId fatherNode)
 {
-  GraphImpl::link(fatherNode, node);
-  topologyHasChanged_();
+  link(fatherNode, node);
   isRooted_ = false;
 }
 
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::addFather(Graph::NodeId node, Graph::NodeId fatherNode, Graph::EdgeId edge)
 {
-  GraphImpl::link(fatherNode, node, edge);
-  topologyHasChanged_();
+  link(fatherNode, node, edge);
   isRooted_ = false;
 }
 
@@ -342,7 +539,7 @@ void DAGraphImpl<GraphImpl>::removeFather(Graph::NodeId node, Graph::NodeId fath
   if (getNumberOfIncomingNeighbors(node) == 1)
     isRooted_ = false;
 
-  GraphImpl::unlink(father, node);
+  unlink(father, node);
 }
 
 template<class GraphImpl>
@@ -357,12 +554,12 @@ std::vector<Graph::NodeId> DAGraphImpl<GraphImpl>::getLeavesUnderNode(Graph::Nod
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::fillListOfLeaves_(Graph::NodeId startingNode, std::vector<Graph::NodeId>& foundLeaves) const
 {
-  const std::vector<Graph::NodeId> sons = getSons(startingNode);
+  typename GraphImpl::NeighborRange sons = sonRange(startingNode);
   if (sons.size() > 1)
   {
-    for (std::vector<Graph::NodeId>::const_iterator currNeighbor = sons.begin(); currNeighbor != sons.end(); currNeighbor++)
+    for (Graph::NodeId son : sons)
     {
-      fillListOfLeaves_(*currNeighbor, foundLeaves);
+      fillListOfLeaves_(son, foundLeaves);
     }
   }
   else
@@ -389,14 +586,193 @@ void DAGraphImpl<GraphImpl>::mustBeValid_() const
 template<class GraphImpl>
 bool DAGraphImpl<GraphImpl>::validate_() const
 {
+  if (incremental_ && validateEdits_())
+  {
+    isValid_ = true;
+    resetEdits_(true);
+    return true;
+  }
+
   isValid_ = GraphImpl::isDA();
+  resetEdits_(isValid_);
   return isValid_;
 }
 
+template<class GraphImpl>
+bool DAGraphImpl<GraphImpl>::validateEdits_() const
+{
+  // The graph was acyclic: a cycle contains the last edge linked to it,
+  // so it is found browsing the nodes below the son of this edge.
+  // Beyond the size of the graph, browsing the whole graph is cheaper.
+  if (GraphImpl::getNumberOfNodes() == 0)
+    return false;
+  size_t maxNbSteps = GraphImpl::getNumberOfNodes() + GraphImpl::getNumberOfEdges();
+  size_t nbSteps = 0;
+  // metNodes[n] is the rank (from 1) of the last linked node below which n was met
+  std::vector<size_t> metNodes(GraphImpl::getHighestNodeID(), 0);
+  std::vector<Graph::NodeId> toVisit;
+  for (size_t i = 0; i < linkedNodes_.size(); i++)
+  {
+    Graph::NodeId node = linkedNodes_[i];
+    if (!GraphImpl::hasNode_(node))
+      continue;
+    toVisit.assign(1, node);
+    while (!toVisit.empty())
+    {
+      Graph::NodeId currNode = toVisit.back();
+      toVisit.pop_back();
+      for (auto son : GraphImpl::outgoingNeighborRange(currNode))
+      {
+        if (son == node || ++nbSteps > maxNbSteps)
+          return false;
+        if (metNodes[son] != i + 1)
+        {
+          metNodes[son] = i + 1;
+          toVisit.push_back(son);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::recordLink_(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  if (!incremental_)
+    return;
+  if (!GraphImpl::hasNode_(nodeA) || !GraphImpl::hasNode_(nodeB))
+  {
+    resetEdits_(false);
+    return;
+  }
+  // an edge to a node with no son cannot close a cycle
+  if (nodeA == nodeB || GraphImpl::getNumberOfOutgoingNeighbors(nodeB) != 0)
+  {
+    linkedNodes_.push_back(nodeB);
+    // beyond this size, browsing the whole graph is cheaper
+    if (linkedNodes_.size() > GraphImpl::getNumberOfNodes())
+      resetEdits_(false);
+  }
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::resetEdits_(bool incremental) const
+{
+  incremental_ = incremental;
+  linkedNodes_.clear();
+}
+
+template<class GraphImpl>
+const GraphTraversalSchedule& DAGraphImpl<GraphImpl>::getTraversalSchedule() const
+{
+  mustBeValid_();
+  if (!hasSchedule_)
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    // built meanwhile by another query
+    if (!hasSchedule_)
+    {
+      schedule_.build(*this);
+      hasSchedule_ = true;
+    }
+  }
+  return schedule_;
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::parallelPostOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads) const
+{
+  getTraversalSchedule().runPostOrder(task, nbThreads);
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::parallelPreOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads) const
+{
+  getTraversalSchedule().runPreOrder(task, nbThreads);
+}
+
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::topologyHasChanged_() const
 {
   isValid_ = false;
+  hasSchedule_ = false;
+  // modifications that are not recorded
+  if (nbRecordedEdits_ == 0 && incremental_)
+    resetEdits_(false);
+}
+
+template<class GraphImpl>
+Graph::NodeId DAGraphImpl<GraphImpl>::createNode()
+{
+  RecordedEdit_ edit(*this);
+  Graph::NodeId node = GraphImpl::createNode();
+  edit.done();
+  return node;
+}
+
+template<class GraphImpl>
+Graph::NodeId DAGraphImpl<GraphImpl>::createNodeFromNode(Graph::NodeId origin)
+{
+  RecordedEdit_ edit(*this);
+  Graph::NodeId node = GraphImpl::createNodeFromNode(origin);
+  edit.done();
+  return node;
+}
+
+template<class GraphImpl>
+Graph::NodeId DAGraphImpl<GraphImpl>::createNodeOnEdge(Graph::EdgeId edge)
+{
+  RecordedEdit_ edit(*this);
+  Graph::NodeId node = GraphImpl::createNodeOnEdge(edge);
+  edit.done();
+  return node;
+}
+
+template<class GraphImpl>
+Graph::NodeId DAGraphImpl<GraphImpl>::createNodeFromEdge(Graph::EdgeId origin)
+{
+  RecordedEdit_ edit(*this);
+  Graph::NodeId node = GraphImpl::createNodeFromEdge(origin);
+  edit.done();
+  return node;
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::deleteNode(Graph::NodeId node)
+{
+  RecordedEdit_ edit(*this);
+  GraphImpl::deleteNode(node);
+  edit.done();
+}
+
+template<class GraphImpl>
+Graph::EdgeId DAGraphImpl<GraphImpl>::link(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  RecordedEdit_ edit(*this);
+  Graph::EdgeId edge = GraphImpl::link(nodeA, nodeB);
+  recordLink_(nodeA, nodeB);
+  edit.done();
+  return edge;
+}
+
+template<class GraphImpl>
+void DAGraphImpl<GraphImpl>::link(Graph::NodeId nodeA, Graph::NodeId nodeB, Graph::EdgeId edgeID)
+{
+  RecordedEdit_ edit(*this);
+  GraphImpl::link(nodeA, nodeB, edgeID);
+  recordLink_(nodeA, nodeB);
+  edit.done();
+}
+
+template<class GraphImpl>
+std::vector<Graph::EdgeId> DAGraphImpl<GraphImpl>::unlink(Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  // removing an edge cannot close a cycle
+  RecordedEdit_ edit(*this);
+  std::vector<Graph::EdgeId> edges = GraphImpl::unlink(nodeA, nodeB);
+  edit.done();
+  return edges;
 }
 
 
@@ -415,15 +791,13 @@ size_t DAGraphImpl<GraphImpl>::getNumberOfSons(Graph::NodeId node) const
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::addSon(Graph::NodeId node, Graph::NodeId sonNode)
 {
-  GraphImpl::link(node, sonNode);
-  topologyHasChanged_();
+  link(node, sonNode);
 }
 
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::addSon(Graph::NodeId node, Graph::NodeId sonNode, Graph::EdgeId edge)
 {
-  GraphImpl::link(node, sonNode, edge);
-  topologyHasChanged_();
+  link(node, sonNode, edge);
 }
 
 
@@ -442,7 +816,7 @@ std::vector<Graph::NodeId> DAGraphImpl<GraphImpl>::removeSons(Graph::NodeId node
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::removeSon(Graph::NodeId node, Graph::NodeId son)
 {
-  GraphImpl::unlink(node, son);
+  unlink(node, son);
 }
 
 
@@ -497,21 +871,19 @@ template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::fillSubtreeMetNodes_(std::vector<Graph::NodeId>& metNodes, Graph::NodeId localRoot) const
 {
   metNodes.push_back(localRoot);
-  std::vector<Graph::NodeId> sons = GraphImpl::getOutgoingNeighbors(localRoot);
-  for (std::vector<Graph::NodeId>::iterator currSon = sons.begin(); currSon != sons.end(); currSon++)
+  for (Graph::NodeId son : sonRange(localRoot))
   {
-    fillSubtreeMetNodes_(metNodes, *currSon);
+    fillSubtreeMetNodes_(metNodes, son);
   }
 }
 
 template<class GraphImpl>
 void DAGraphImpl<GraphImpl>::fillSubtreeMetEdges_(std::vector<Graph::EdgeId>& metEdges, Graph::NodeId localRoot) const
 {
-  std::vector<Graph::EdgeId> edgesToSons = GraphImpl::getOutgoingEdges(localRoot);
-  for (std::vector<Graph::EdgeId>::iterator currEdgeToSon = edgesToSons.begin(); currEdgeToSon != edgesToSons.end(); currEdgeToSon++)
+  for (Graph::EdgeId edgeToSon : branchRange(localRoot))
   {
-    metEdges.push_back(*currEdgeToSon);
-    fillSubtreeMetEdges_(metEdges, GraphImpl::getBottom(*currEdgeToSon));
+    metEdges.push_back(edgeToSon);
+    fillSubtreeMetEdges_(metEdges, GraphImpl::getBottom(edgeToSon));
   }
 }
 }
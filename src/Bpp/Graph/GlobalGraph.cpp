@@ -39,6 +39,7 @@
 */
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -56,45 +57,74 @@ GlobalGraph::GlobalGraph(bool directed_p) :
   observers_(set<GraphObserver*>()),
   highestNodeID_(0),
   highestEdgeID_(0),
-  nodeStructure_(nodeStructureType()),
-  edgeStructure_(edgeStructureType()),
+  nodeStructure_(std::make_shared<nodeStructureType>()),
+  edgeStructure_(std::make_shared<edgeStructureType>()),
+  nbOwners_(std::make_shared<std::atomic<unsigned int> >(1)),
   root_(0)
 {}
 
 
 GlobalGraph::GlobalGraph(const GlobalGraph& gg) :
   directed_(gg.directed_),
-  observers_(gg.observers_),
+  observers_(),
   highestNodeID_(gg.highestNodeID_),
   highestEdgeID_(gg.highestEdgeID_),
   nodeStructure_(gg.nodeStructure_),
   edgeStructure_(gg.edgeStructure_),
+  nbOwners_(gg.nbOwners_),
   root_(gg.root_)
-{}
+{
+  nbOwners_->fetch_add(1, std::memory_order_relaxed);
+}
 
 GlobalGraph& GlobalGraph::operator=(const GlobalGraph& gg)
 {
   directed_ = gg.directed_;
-  observers_ = gg.observers_;
   highestNodeID_ = gg.highestNodeID_;
   highestEdgeID_ = gg.highestEdgeID_;
-  nodeStructure_ = gg.nodeStructure_;
-  edgeStructure_ = gg.edgeStructure_;
+  if (nbOwners_ != gg.nbOwners_)
+  {
+    leaveStructure_();
+    nodeStructure_ = gg.nodeStructure_;
+    edgeStructure_ = gg.edgeStructure_;
+    nbOwners_ = gg.nbOwners_;
+    nbOwners_->fetch_add(1, std::memory_order_relaxed);
+  }
   root_ = gg.root_;
 
   return *this;
 }
 
 
+void GlobalGraph::detachStructure_()
+{
+  if (nbOwners_->load(std::memory_order_acquire) > 1)
+    setStructure_(std::make_shared<nodeStructureType>(*nodeStructure_), std::make_shared<edgeStructureType>(*edgeStructure_));
+}
+
+void GlobalGraph::leaveStructure_()
+{
+  if (nbOwners_)
+    nbOwners_->fetch_sub(1, std::memory_order_release);
+}
+
+void GlobalGraph::setStructure_(const std::shared_ptr<nodeStructureType>& nodeStructure, const std::shared_ptr<edgeStructureType>& edgeStructure)
+{
+  leaveStructure_();
+  nodeStructure_ = nodeStructure;
+  edgeStructure_ = edgeStructure;
+  nbOwners_ = std::make_shared<std::atomic<unsigned int> >(1);
+}
+
 void GlobalGraph::nodeMustExist_(const GlobalGraph::Node& node, string name) const
 {
-  if (nodeStructure_.find(node) == nodeStructure_.end())
+  if (nodeStructure_->find(node) == nodeStructure_->end())
     throw Exception("This node must exist: " + TextTools::toString(node) + " as " + name + ".");
 }
 
 void GlobalGraph::edgeMustExist_(const GlobalGraph::Edge& edge, string name) const
 {
-  if (edgeStructure_.find(edge) == edgeStructure_.end())
+  if (edgeStructure_->find(edge) == edgeStructure_->end())
     throw Exception("This edge must exist: " + TextTools::toString(edge) + " as " + name + ".");
 }
 
@@ -116,7 +146,7 @@ GlobalGraph::Edge GlobalGraph::link(Graph::NodeId nodeA, Graph::NodeId nodeB)
 
 void GlobalGraph::link(Graph::NodeId nodeA, Graph::NodeId nodeB, GlobalGraph::Edge edgeID)
 {
-  if (edgeStructure_.find(edgeID) != edgeStructure_.end())
+  if (edgeStructure_->find(edgeID) != edgeStructure_->end())
     throw Exception("GlobalGraph::link : already existing edgeId " + TextTools::toString(edgeID));
 
   // writing the new relation to the structure
@@ -145,10 +175,11 @@ vector<GlobalGraph::Edge> GlobalGraph::unlink(Graph::NodeId nodeA, Graph::NodeId
 
 void GlobalGraph::switchNodes(Graph::NodeId nodeA, Graph::NodeId nodeB)
 {
+  detachStructure_();
   Graph::NodeId father, son;
 
-  nodeStructureType::iterator nodeARow = nodeStructure_.find(nodeA);
-  nodeStructureType::iterator nodeBRow = nodeStructure_.find(nodeB);
+  nodeStructureType::iterator nodeARow = nodeStructure_->find(nodeA);
+  nodeStructureType::iterator nodeBRow = nodeStructure_->find(nodeB);
   nodeStructureType::iterator nodeSonRow, nodeFatherRow;
 
   // Forwards
@@ -188,14 +219,57 @@ void GlobalGraph::switchNodes(Graph::NodeId nodeA, Graph::NodeId nodeB)
   nodeFatherRow->second.second[son] = foundEdge;
 
 
-//    std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator ita = nodeStructure_.find(nodeA);
+//    std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator ita = nodeStructure_->find(nodeA);
 
-  edgeStructure_[foundEdge] = pair<Node, Node>(son, father);
+  (*edgeStructure_)[foundEdge] = pair<Node, Node>(son, father);
 
   this->topologyHasChanged_();
 }
 
 
+void GlobalGraph::createNodesAndLinks(size_t nbNodes, const vector<pair<size_t, size_t> >& links, vector<Graph::NodeId>& newNodes, vector<Graph::EdgeId>& newEdges)
+{
+  for (const auto& currLink : links)
+  {
+    if (currLink.first >= nbNodes || currLink.second >= nbNodes)
+      throw Exception("GlobalGraph::createNodesAndLinks : link between unknown nodes " + TextTools::toString(currLink.first) + " and " + TextTools::toString(currLink.second));
+  }
+
+  detachStructure_();
+
+  // new ids are higher than all the existing ones: insert at the end
+  newNodes.resize(nbNodes);
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    newNodes[i] = highestNodeID_++;
+    nodeStructure_->emplace_hint(nodeStructure_->end(), newNodes[i], nodeStructureType::mapped_type());
+  }
+
+  newEdges.resize(links.size());
+  for (size_t i = 0; i < links.size(); i++)
+  {
+    Node nodeA = newNodes[links[i].first];
+    Node nodeB = newNodes[links[i].second];
+    Edge edge = ++highestEdgeID_;
+    if (!edgeStructure_->insert(edgeStructureType::value_type(edge, pair<Node, Node>(nodeA, nodeB))).second)
+      throw Exception("GlobalGraph::createNodesAndLinks : already existing edgeId " + TextTools::toString(edge));
+
+    nodeStructureType::mapped_type& rowA = nodeStructure_->find(nodeA)->second;
+    nodeStructureType::mapped_type& rowB = nodeStructure_->find(nodeB)->second;
+    if (!rowA.first.insert(pair<Node, Edge>(nodeB, edge)).second)
+      throw Exception("GlobalGraph::createNodesAndLinks : nodes linked twice " + TextTools::toString(nodeA) + " and " + TextTools::toString(nodeB));
+    rowB.second.insert(pair<Node, Edge>(nodeA, edge));
+    if (!directed_)
+    {
+      rowB.first.insert(pair<Node, Edge>(nodeA, edge));
+      rowA.second.insert(pair<Node, Edge>(nodeB, edge));
+    }
+    newEdges[i] = edge;
+  }
+
+  this->topologyHasChanged_();
+}
+
 GlobalGraph::Node GlobalGraph::getHighestNodeID() const
 {
   return highestNodeID_;
@@ -209,25 +283,28 @@ GlobalGraph::Edge GlobalGraph::getHighestEdgeID() const
 
 void GlobalGraph::unlinkInEdgeStructure_(const GlobalGraph::Edge& edge)
 {
-  edgeStructureType::iterator foundEdge = edgeStructure_.find(edge);
-  if (foundEdge == edgeStructure_.end())
+  detachStructure_();
+  edgeStructureType::iterator foundEdge = edgeStructure_->find(edge);
+  if (foundEdge == edgeStructure_->end())
     throw Exception("GlobalGraph::unlinkInEdgeStructure_ : no edge to erase " + TextTools::toString(edge));
 
-  edgeStructure_.erase(foundEdge);
+  edgeStructure_->erase(foundEdge);
   this->topologyHasChanged_();
 }
 
 void GlobalGraph::linkInEdgeStructure_(const GlobalGraph::Node& nodeA, const GlobalGraph::Node& nodeB, const GlobalGraph::Edge& edge)
 {
-  edgeStructure_[edge] = pair<Node, Node>(nodeA, nodeB);
+  detachStructure_();
+  (*edgeStructure_)[edge] = pair<Node, Node>(nodeA, nodeB);
   this->topologyHasChanged_();
 }
 
 
 unsigned int GlobalGraph::unlinkInNodeStructure_(const GlobalGraph::Node& nodeA, const GlobalGraph::Node& nodeB)
 {
+  detachStructure_();
   // Forward
-  nodeStructureType::iterator nodeARow = nodeStructure_.find(nodeA);
+  nodeStructureType::iterator nodeARow = nodeStructure_->find(nodeA);
   map<GlobalGraph::Node, GlobalGraph::Edge>::iterator foundForwardRelation = nodeARow->second.first.find(nodeB);
   if (foundForwardRelation == nodeARow->second.first.end())
     throw Exception("GlobalGraph::unlinkInNodeStructure_ : no edge to erase " + TextTools::toString(nodeA) + "->" + TextTools::toString(nodeB));
@@ -236,7 +313,7 @@ unsigned int GlobalGraph::unlinkInNodeStructure_(const GlobalGraph::Node& nodeA,
   nodeARow->second.first.erase(foundForwardRelation);
 
   // Backwards
-  nodeStructureType::iterator nodeBRow = nodeStructure_.find(nodeB);
+  nodeStructureType::iterator nodeBRow = nodeStructure_->find(nodeB);
   map<GlobalGraph::Node, GlobalGraph::Edge>::iterator foundBackwardsRelation = nodeBRow->second.second.find(nodeA);
   if (foundBackwardsRelation == nodeBRow->second.first.end())
     throw Exception("GlobalGraph::unlinkInNodeStructure_ : no edge to erase " + TextTools::toString(nodeB) + "<-" + TextTools::toString(nodeA));
@@ -249,23 +326,25 @@ unsigned int GlobalGraph::unlinkInNodeStructure_(const GlobalGraph::Node& nodeA,
 
 void GlobalGraph::linkInNodeStructure_(const GlobalGraph::Node& nodeA, const GlobalGraph::Node& nodeB, const GlobalGraph::Edge& edge)
 {
-  std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator ita = nodeStructure_.find(nodeA);
+  detachStructure_();
+  std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator ita = nodeStructure_->find(nodeA);
 
-  if (ita != nodeStructure_.end())
+  if (ita != nodeStructure_->end())
     ita->second.first.insert( pair<GlobalGraph::Node, GlobalGraph::Edge>(nodeB, edge));
 
-  std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator itb = nodeStructure_.find(nodeB);
+  std::map<GlobalGraph::Node, std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> > >::iterator itb = nodeStructure_->find(nodeB);
 
-  if (itb != nodeStructure_.end())
-    nodeStructure_.find(nodeB)->second.second.insert( pair<GlobalGraph::Node, GlobalGraph::Edge>(nodeA, edge));
+  if (itb != nodeStructure_->end())
+    nodeStructure_->find(nodeB)->second.second.insert( pair<GlobalGraph::Node, GlobalGraph::Edge>(nodeA, edge));
 
   this->topologyHasChanged_();
 }
 
 Graph::NodeId GlobalGraph::createNode()
 {
+  detachStructure_();
   GlobalGraph::Node newNode = highestNodeID_++;
-  nodeStructure_[newNode] = std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> >();
+  (*nodeStructure_)[newNode] = std::pair<std::map<GlobalGraph::Node, GlobalGraph::Edge>, std::map<GlobalGraph::Node, GlobalGraph::Edge> >();
   this->topologyHasChanged_();
 
   return newNode;
@@ -287,7 +366,7 @@ Graph::NodeId GlobalGraph::createNodeOnEdge(Graph::EdgeId edge)
   Graph::NodeId newNode = createNode();
 
   // determining the nodes on the border of the edge
-  pair<GlobalGraph::Node, GlobalGraph::Node> nodes = edgeStructure_[edge];
+  pair<GlobalGraph::Node, GlobalGraph::Node> nodes = edgeStructure_->at(edge);
   GlobalGraph::Node nodeA = nodes.first;
   GlobalGraph::Node nodeB = nodes.second;
 
@@ -330,13 +409,19 @@ void GlobalGraph::unregisterObserver(GraphObserver* observer)
 
 /**********************************************/
 
-std::vector< GlobalGraph::Node > GlobalGraph::getNeighbors_(const GlobalGraph::Node& node, bool outgoing) const
+const std::map<GlobalGraph::Node, GlobalGraph::Edge>& GlobalGraph::getAdjacency_(const GlobalGraph::Node& node, bool outgoing) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw (Exception("The requested node is not in the structure."));
-  const std::map<GlobalGraph::Node, GlobalGraph::Edge>& forOrBack = (outgoing ? foundNode->second.first : foundNode->second.second);
+  return outgoing ? foundNode->second.first : foundNode->second.second;
+}
+
+std::vector< GlobalGraph::Node > GlobalGraph::getNeighbors_(const GlobalGraph::Node& node, bool outgoing) const
+{
+  const std::map<GlobalGraph::Node, GlobalGraph::Edge>& forOrBack = getAdjacency_(node, outgoing);
   vector<GlobalGraph::Node> result;
+  result.reserve(forOrBack.size());
   for (auto& currNeighbor : forOrBack)
     result.push_back(currNeighbor.first);
 
@@ -345,18 +430,45 @@ std::vector< GlobalGraph::Node > GlobalGraph::getNeighbors_(const GlobalGraph::N
 
 std::vector< GlobalGraph::Edge > GlobalGraph::getEdges_(const GlobalGraph::Node& node, bool outgoing) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
-    throw (Exception("The requested node is not in the structure."));
-  const std::map<GlobalGraph::Node, GlobalGraph::Edge>& forOrBack = (outgoing ? foundNode->second.first : foundNode->second.second);
+  const std::map<GlobalGraph::Node, GlobalGraph::Edge>& forOrBack = getAdjacency_(node, outgoing);
 
   vector<GlobalGraph::Edge> result;
+  result.reserve(forOrBack.size());
   for (const auto& currNeighbor : forOrBack)
     result.push_back(currNeighbor.second);
 
   return result;
 }
 
+GlobalGraph::NeighborRange GlobalGraph::outgoingNeighborRange(Graph::NodeId node) const
+{
+  const std::map<Node, Edge>& forOrBack = getAdjacency_(node, true);
+  return NeighborRange(NeighborRange::iterator(forOrBack.begin()), NeighborRange::iterator(forOrBack.end()));
+}
+
+GlobalGraph::NeighborRange GlobalGraph::incomingNeighborRange(Graph::NodeId node) const
+{
+  const std::map<Node, Edge>& forOrBack = getAdjacency_(node, false);
+  return NeighborRange(NeighborRange::iterator(forOrBack.begin()), NeighborRange::iterator(forOrBack.end()));
+}
+
+GlobalGraph::EdgeRange GlobalGraph::outgoingEdgeRange(Graph::NodeId node) const
+{
+  const std::map<Node, Edge>& forOrBack = getAdjacency_(node, true);
+  return EdgeRange(EdgeRange::iterator(forOrBack.begin()), EdgeRange::iterator(forOrBack.end()));
+}
+
+GlobalGraph::EdgeRange GlobalGraph::incomingEdgeRange(Graph::NodeId node) const
+{
+  const std::map<Node, Edge>& forOrBack = getAdjacency_(node, false);
+  return EdgeRange(EdgeRange::iterator(forOrBack.begin()), EdgeRange::iterator(forOrBack.end()));
+}
+
+GlobalGraph::NodeRange GlobalGraph::nodeRange() const
+{
+  return NodeRange(NodeRange::iterator(nodeStructure_->begin()), NodeRange::iterator(nodeStructure_->end()));
+}
+
 vector< Graph::NodeId > GlobalGraph::getIncomingNeighbors(Graph::NodeId node) const
 {
   return getNeighbors_(node, false);
@@ -413,20 +525,20 @@ std::unique_ptr<Graph::NodeIterator> GlobalGraph::incomingNeighborNodesIterator(
 
 size_t GlobalGraph::getNumberOfNodes() const
 {
-  return nodeStructure_.size();
+  return nodeStructure_->size();
 }
 
 
 size_t GlobalGraph::getNumberOfEdges() const
 {
-  return edgeStructure_.size();
+  return edgeStructure_->size();
 }
 
 
 size_t GlobalGraph::getDegree(const Graph::NodeId node) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw Exception("GlobalGraph::getDegree : Node " + TextTools::toString(node) + " does not exist.");
 
   return isDirected() ? foundNode->second.first.size() + foundNode->second.second.size() : foundNode->second.first.size();
@@ -435,8 +547,8 @@ size_t GlobalGraph::getDegree(const Graph::NodeId node) const
 
 bool GlobalGraph::isLeaf(const Graph::NodeId node) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw Exception("GlobalGraph::isLeaf : Node " + TextTools::toString(node) + " does not exist.");
 
   return (!isDirected() && (foundNode->second.first.size() <= 1))
@@ -448,8 +560,8 @@ bool GlobalGraph::isLeaf(const Graph::NodeId node) const
 
 size_t GlobalGraph::getNumberOfNeighbors(const Graph::NodeId node) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw (Exception("The requested node is not in the structure."));
 
   if (isDirected())
@@ -460,16 +572,16 @@ size_t GlobalGraph::getNumberOfNeighbors(const Graph::NodeId node) const
 
 size_t GlobalGraph::getNumberOfOutgoingNeighbors(const Graph::NodeId node) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw (Exception("The requested node is not in the structure."));
   return foundNode->second.first.size();
 }
 
 size_t GlobalGraph::getNumberOfIncomingNeighbors(const Graph::NodeId node) const
 {
-  nodeStructureType::const_iterator foundNode = nodeStructure_.find(node);
-  if (foundNode == nodeStructure_.end())
+  nodeStructureType::const_iterator foundNode = nodeStructure_->find(node);
+  if (foundNode == nodeStructure_->end())
     throw (Exception("The requested node is not in the structure."));
   return foundNode->second.second.size();
 }
@@ -488,7 +600,7 @@ vector< Graph::NodeId > GlobalGraph::getNeighbors(const Graph::NodeId node) cons
 std::pair<Graph::NodeId, Graph::NodeId> GlobalGraph::getNodes(Graph::EdgeId edge) const
 {
   edgeMustExist_(edge);
-  edgeStructureType::const_iterator found = edgeStructure_.find(edge);
+  edgeStructureType::const_iterator found = edgeStructure_->find(edge);
   return found->second;
 }
 
@@ -508,11 +620,12 @@ void GlobalGraph::deleteNode(Graph::NodeId node)
   nodeMustExist_(node, "node to delete");
   isolate_(node);
 
-  nodeStructureType::iterator found = nodeStructure_.find(node);
-  if (found == nodeStructure_.end())
+  detachStructure_();
+  nodeStructureType::iterator found = nodeStructure_->find(node);
+  if (found == nodeStructure_->end())
     throw Exception("GlobalGraph::deleteNode : no node to erase " + TextTools::toString(node));
 
-  nodeStructure_.erase(found);
+  nodeStructure_->erase(found);
 
   this->topologyHasChanged_();
 }
@@ -531,7 +644,7 @@ void GlobalGraph::isolate_(GlobalGraph::Node& node)
 vector<Graph::EdgeId> GlobalGraph::getAllEdges() const
 {
   vector<Graph::EdgeId> listOfEdges;
-  for (const auto& it : edgeStructure_)
+  for (const auto& it : *edgeStructure_)
     listOfEdges.push_back(it.first);
 
   return listOfEdges;
@@ -554,7 +667,7 @@ Graph::EdgeId GlobalGraph::getAnyEdge(Graph::NodeId nodeA, Graph::NodeId nodeB)
 vector<Graph::NodeId> GlobalGraph::getAllLeaves() const
 {
   vector<Graph::NodeId> listOfLeaves;
-  for (const auto& it : nodeStructure_)
+  for (const auto& it : *nodeStructure_)
     if (this->isLeaf(it.first))
       listOfLeaves.push_back(it.first);
 
@@ -564,7 +677,7 @@ vector<Graph::NodeId> GlobalGraph::getAllLeaves() const
 set<Graph::NodeId> GlobalGraph::getSetOfAllLeaves() const
 {
   set<Graph::NodeId> listOfLeaves;
-  for (const auto& it : nodeStructure_)
+  for (const auto& it : *nodeStructure_)
     if (this->isLeaf(it.first))
       listOfLeaves.insert(it.first);
 
@@ -574,7 +687,7 @@ set<Graph::NodeId> GlobalGraph::getSetOfAllLeaves() const
 vector<Graph::NodeId> GlobalGraph::getAllNodes() const
 {
   vector<Graph::NodeId> listOfNodes;
-  for (const auto& it : nodeStructure_)
+  for (const auto& it : *nodeStructure_)
     listOfNodes.push_back(it.first);
 
   return listOfNodes;
@@ -583,7 +696,7 @@ vector<Graph::NodeId> GlobalGraph::getAllNodes() const
 vector<Graph::NodeId> GlobalGraph::getAllInnerNodes() const
 {
   vector<Graph::NodeId> listOfInNodes;
-  for (const auto& it : nodeStructure_)
+  for (const auto& it : *nodeStructure_)
     if (this->getDegree(it.first) >= 2)
       listOfInNodes.push_back(it.first);
 
@@ -616,7 +729,7 @@ std::vector<Graph::NodeId> GlobalGraph::getLeavesFromNode(const Graph::NodeId no
 void GlobalGraph::nodeToDot_(const GlobalGraph::Node& node, ostream& out,  std::set<std::pair<Node, Node> >& alreadyFigured) const
 {
   out << node;
-  const std::map<Node, Edge>& children = nodeStructure_.at(node).first;
+  const std::map<Node, Edge>& children = nodeStructure_->at(node).first;
   bool flag(false);
   for (const auto& currChild : children)
   {
@@ -635,73 +748,62 @@ void GlobalGraph::nodeToDot_(const GlobalGraph::Node& node, ostream& out,  std::
 
 bool GlobalGraph::isTree() const
 {
-  set<GlobalGraph::Node> metNodes;
-  bool nodesAreMetOnlyOnce = nodesAreMetOnlyOnce_(root_, metNodes, root_);
+  nodeMustExist_(root_, "root");
 
-  if (!nodesAreMetOnlyOnce)
-    return false;
+  // depth-first browsing from the root, each node coming with its origin
+  vector<char> metNodes(highestNodeID_, 0);
+  size_t nbMetNodes = 0;
+  vector<pair<Node, Node> > toVisit(1, pair<Node, Node>(root_, root_));
+  while (!toVisit.empty())
+  {
+    Node node = toVisit.back().first;
+    Node originNode = toVisit.back().second;
+    toVisit.pop_back();
 
-  // now they have only been met at most once, they have to be met at least once
-  for (const auto& currNode:nodeStructure_)
-    if (metNodes.find(currNode.first) == metNodes.end())
+    if (metNodes[node])
       return false;
-  
-  return true;
-}
-
+    metNodes[node] = 1;
+    nbMetNodes++;
 
-bool GlobalGraph::nodesAreMetOnlyOnce_(const GlobalGraph::Node& node, set< GlobalGraph::Node >& metNodes, const GlobalGraph::Node& originNode) const
-{
-  // insert().second <=> not yet in the set
-  if (!metNodes.insert(node).second)
-    return false;
-  
-  vector<Graph::NodeId> neighbors = getOutgoingNeighbors(node);
-  for (auto currNeighbor:neighbors)
-  {
-    if (currNeighbor == originNode)
-      continue;
-    if (!nodesAreMetOnlyOnce_(currNeighbor, metNodes, node))
-      return false;
+    for (const auto& currNeighbor : nodeStructure_->find(node)->second.first)
+      if (currNeighbor.first != originNode)
+        toVisit.push_back(pair<Node, Node>(currNeighbor.first, node));
   }
-  return true;
+
+  // now they have only been met at most once, they have to be met at least once
+  return nbMetNodes == nodeStructure_->size();
 }
 
 bool GlobalGraph::isDA() const
 {
-  GlobalGraph gg(*this);
+  // Algo: remove recursively all nodes with no sons from graph,
+  // keeping track of the number of remaining sons of each node
 
-  gg.observers_.clear();
-  // Algo: remove recursively all nodes with no sons from graph
-
-  std::vector<Graph::NodeId> vL;
-
-  std::unique_ptr<Graph::NodeIterator> it = gg.allNodesIterator();
-  for ( ; !it->end(); it->next())
+  vector<size_t> nbSons(highestNodeID_, 0);
+  vector<const nodeStructureType::value_type*> sinks;
+  for (const auto& currNode : *nodeStructure_)
   {
-    if (gg.getNumberOfOutgoingNeighbors(**it) == 0)
-      vL.push_back(**it);
+    nbSons[currNode.first] = currNode.second.first.size();
+    if (nbSons[currNode.first] == 0)
+      sinks.push_back(&currNode);
   }
 
-  while (vL.size() != 0)
-  {
-    for (auto& it2 : vL)
-      gg.deleteNode(it2);
-
-    if (gg.getNumberOfNodes() == 0)
-      return true;
+  if (sinks.empty())
+    return false;
 
-    vL.clear();
+  size_t nbRemoved = 0;
+  while (!sinks.empty())
+  {
+    const nodeStructureType::value_type* sink = sinks.back();
+    sinks.pop_back();
+    nbRemoved++;
 
-    it = gg.allNodesIterator();
-    for ( ; !it->end(); it->next())
-    {
-      if (gg.getNumberOfOutgoingNeighbors(**it) == 0)
-        vL.push_back(**it);
-    }
+    for (const auto& currFather : sink->second.second)
+      if (--nbSons[currFather.first] == 0)
+        sinks.push_back(&*nodeStructure_->find(currFather.first));
   }
 
-  return false;
+  return nbRemoved == nodeStructure_->size();
 }
 
 
@@ -799,8 +901,9 @@ void GlobalGraph::makeDirected()
   if (directed_)
     return;
   // save and clean the undirectedStructure
-  nodeStructureType undirectedStructure = nodeStructure_;
-  for (auto& it : nodeStructure_)
+  detachStructure_();
+  nodeStructureType undirectedStructure = *nodeStructure_;
+  for (auto& it : *nodeStructure_)
     it.second = std::pair<std::map<Node, Edge>, std::map<Node, Edge> >();
 
   // copy each relation once, without the reciprocal link
@@ -831,8 +934,9 @@ void GlobalGraph::makeUndirected()
   if (containsReciprocalRelations())
     throw Exception("Cannot make an undirected graph from a directed one containing reciprocal relations.");
   // save and clean the undirectedStructure
-  nodeStructureType directedStructure = nodeStructure_;
-  for (auto& it : nodeStructure_)
+  detachStructure_();
+  nodeStructureType directedStructure = *nodeStructure_;
+  for (auto& it : *nodeStructure_)
     it.second = std::pair<std::map<Node, Edge>, std::map<Node, Edge> >();
 
   // copy each relation twice, making the reciprocal link
@@ -858,7 +962,7 @@ bool GlobalGraph::containsReciprocalRelations() const
   if (!directed_)
     throw Exception("Cannot state reciprocal link in an undirected graph.");
   std::set<pair<Node, Node> > alreadyMetRelations;
-  for (const auto& currNodeRow : nodeStructure_)
+  for (const auto& currNodeRow : *nodeStructure_)
   {
     Node nodeA = currNodeRow.first;
     for (const auto& currRelation : currNodeRow.second.first)
@@ -903,8 +1007,8 @@ std::unique_ptr<Graph::EdgeIterator> GlobalGraph::incomingEdgesIterator(Graph::N
 
 Graph::EdgeId GlobalGraph::getEdge(Graph::NodeId nodeA, Graph::NodeId nodeB) const
 {
-  nodeStructureType::const_iterator firstNodeFound = nodeStructure_.find(nodeA);
-  if (firstNodeFound == nodeStructure_.end())
+  nodeStructureType::const_iterator firstNodeFound = nodeStructure_->find(nodeA);
+  if (firstNodeFound == nodeStructure_->end())
     throw (Exception("The fist node was not the origin of an edge."));
   map<Node, Edge>::const_iterator secondNodeFound = firstNodeFound->second.first.find(nodeB);
   if (secondNodeFound == firstNodeFound->second.first.end())
@@ -928,7 +1032,7 @@ void GlobalGraph::outputToDot(ostream& out, const std::string& name) const
   out << (directed_ ? "digraph" : "graph") << " " << name << " {\n   ";
   set<pair<Node, Node> > alreadyFigured;
   nodeToDot_(root_, out, alreadyFigured);
-  for (const auto& node: nodeStructure_)
+  for (const auto& node: *nodeStructure_)
     if (node.first!=root_)
       nodeToDot_(node.first, out, alreadyFigured);
   out << "\r}" << endl;
@@ -43,13 +43,23 @@
 
 #include "../Clonable.h"
 
+#include <atomic>
 #include <set>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include "Graph.h"
+#include "GraphRange.h"
 
 namespace bpp
 {
+template<class T, bool is_const>
+class NodesIteratorClass;
+
+template<class T, bool is_const>
+class EdgesIteratorClass;
+
 class GlobalGraph :
   public virtual Graph,
   public virtual Clonable
@@ -79,6 +89,22 @@ public:
    */
   typedef std::map<Edge, std::pair<Node, Node> > edgeStructureType;
 
+  /**
+   * Iterators on this implementation, used by the graph observers.
+   */
+  template<class T, bool is_const>
+  using NodesIterator = NodesIteratorClass<T, is_const>;
+
+  template<class T, bool is_const>
+  using EdgesIterator = EdgesIteratorClass<T, is_const>;
+
+  /**
+   * Ranges on the structure of this implementation, see GraphRange.
+   */
+  typedef GraphRange<AdjacencyIterator<std::map<Node, Edge>::const_iterator, NeighborNodeAccessor> > NeighborRange;
+  typedef GraphRange<AdjacencyIterator<std::map<Node, Edge>::const_iterator, NeighborEdgeAccessor> > EdgeRange;
+  typedef GraphRange<AdjacencyIterator<nodeStructureType::const_iterator, NeighborNodeAccessor> > NodeRange;
+
 private:
   /**
    * is the graph directed
@@ -102,15 +128,28 @@ private:
   /**
    * Nodes and their relations.
    * see nodeStructureType documentation
+   *
+   * The structures are shared between copies of the graph, and copied
+   * only when one of them is modified (see detachStructure_).
    */
 
-  nodeStructureType nodeStructure_;
+  std::shared_ptr<nodeStructureType> nodeStructure_;
 
   /**
    * Edges and their relations in the forward direction..
    * see edgeStructureType documentation
    */
-  edgeStructureType edgeStructure_;
+  std::shared_ptr<edgeStructureType> edgeStructure_;
+
+  /**
+   * Number of graphs sharing the structures.
+   *
+   * A graph leaving the structures decrements it with release ordering, and
+   * a graph about to modify them reads it with acquire ordering, so that
+   * copies can be handed to other threads: a graph that finds itself the
+   * only owner sees all the reads of the former owners completed.
+   */
+  std::shared_ptr<std::atomic<unsigned int> > nbOwners_;
 
   /**
    * Usualy the first node of a graph. Used for algorithmic purposes.
@@ -132,6 +171,19 @@ private:
    */
   void notify_();
 
+  /**
+   * Make the structures of this graph its own before modifying them,
+   * copying them if they are still shared with other graphs.
+   * Must be called by any method that modifies the structures.
+   */
+  void detachStructure_();
+
+  // stop sharing the structures
+  void leaveStructure_();
+
+  // take new structures, owned by this graph only
+  void setStructure_(const std::shared_ptr<nodeStructureType>& nodeStructure, const std::shared_ptr<edgeStructureType>& edgeStructure);
+
   /**
    * Creates a link between two existing nodes. If directed graph: nodeA -> nodeB.
    * Private version of link, does not check for the reciprocity.
@@ -198,7 +250,19 @@ protected:
    */
   void edgeMustExist_(const Edge& edge, std::string name = "") const;
 
+  /**
+   * Does a node exist?
+   */
+  bool hasNode_(const Node& node) const { return nodeStructure_->find(node) != nodeStructure_->end(); }
+
 private:
+  /**
+   * Get the outgoing or incoming relations of a node.
+   * @param node node to  in or outgoing relations
+   * @param outgoing boolean: if true, outgoing; else incoming
+   */
+  const std::map<Node, Edge>& getAdjacency_(const Node& node, bool outgoing) const;
+
   /**
    * Private version of getIncomingNeighbors or getOutgoingNeighbors.
    * Common code of these function shared here.
@@ -232,14 +296,6 @@ private:
 
   void fillListOfLeaves_(const Node& startingNode, std::vector<Node>& foundLeaves, const Node& originNode, unsigned int maxRecursions) const;
 
-  /**
-   * Check that nodes are only met once to define if the graph is cyclic.
-   * @param node the node to explore
-   * @param metNodes a set containing all the nodes we met
-   * @param originNode the node where we come from, not to explore
-   */
-  bool nodesAreMetOnlyOnce_(const Node& node, std::set<Node>& metNodes, const Node& originNode) const;
-
   /**
    * output a node to DOT format (recursive)
    */
@@ -265,7 +321,7 @@ public:
 
   GlobalGraph* clone() const {return new GlobalGraph(*this); }
 
-  ~GlobalGraph() {}
+  ~GlobalGraph() { leaveStructure_(); }
 
 protected:
   /**
@@ -364,6 +420,20 @@ protected:
 
   void link(Graph::NodeId nodeA, Graph::NodeId nodeB, GlobalGraph::Edge edgeID);
 
+  /**
+   * Creates nodes and links between them, in one pass.
+   * This is much faster than successive calls to createNode and link
+   * when building a large graph, and the topology change is signaled
+   * only once.
+   * @param nbNodes the number of nodes to create
+   * @param links the links to create, as pairs of positions in the new
+   *        nodes. If directed graph: first -> second.
+   * @param newNodes [out] the new nodes, by position
+   * @param newEdges [out] the new edges, in the order of links
+   */
+
+  void createNodesAndLinks(size_t nbNodes, const std::vector<std::pair<size_t, size_t> >& links, std::vector<Graph::NodeId>& newNodes, std::vector<Graph::EdgeId>& newEdges);
+
   /**
    * Switch the edge  between two existing nodes.
    *
@@ -522,6 +592,20 @@ public:
    */
   std::vector<Graph::NodeId> getIncomingNeighbors(Graph::NodeId node) const;
 
+  /**
+   * @name Ranges on the neighbors of a node, with no copy.
+   *
+   * Usable in range-based for loops, until the next modification of the
+   * topology.
+   * @{
+   */
+  NeighborRange outgoingNeighborRange(Graph::NodeId node) const;
+  NeighborRange incomingNeighborRange(Graph::NodeId node) const;
+  EdgeRange outgoingEdgeRange(Graph::NodeId node) const;
+  EdgeRange incomingEdgeRange(Graph::NodeId node) const;
+  NodeRange nodeRange() const;
+  /** @} */
+
   /**
    * Get the leaves of a graph, ie, nodes with only one neighbor,
    * starting from a peculiar node.
@@ -591,6 +675,7 @@ public:
 
   /**
    * Is the graph a tree?
+   * Linear in the number of nodes, the graph is browsed iteratively from the root.
    * @return false if a node is met more than one time browsing the graph
    */
 
@@ -598,7 +683,9 @@ public:
 
   /**
    * Is the graph directed acyclic?
-   * @return true if an edge is met more than one time browsing the graph
+   * Linear in the number of nodes and edges: nodes with no son are
+   * removed recursively, counting the remaining sons of each node.
+   * @return true if all nodes could be removed
    */
 
   bool isDA() const;
@@ -732,6 +819,8 @@ public:
 
   template<class N, class E, class GraphImpl>
   friend class AssociationGraphImplObserver;
+
+  friend class BinaryGraphFormat;
 };
 
 
@@ -766,14 +855,14 @@ private:
 
 public:
   template<bool B = is_const>
-  NodesIteratorClass<Graph::ALLGRAPHITER, is_const>(const GlobalGraph &gg, typename std::enable_if<B>::type * = 0) : it_(gg.nodeStructure_.begin()),
-    begin_(gg.nodeStructure_.begin()),
-    end_(gg.nodeStructure_.end()) {}
+  NodesIteratorClass<Graph::ALLGRAPHITER, is_const>(const GlobalGraph &gg, typename std::enable_if<B>::type * = 0) : it_(gg.nodeStructure_->begin()),
+    begin_(gg.nodeStructure_->begin()),
+    end_(gg.nodeStructure_->end()) {}
 
   template<bool B = is_const>
-  NodesIteratorClass<Graph::ALLGRAPHITER, is_const>(GlobalGraph & gg, typename std::enable_if<!B>::type * = 0) : it_(gg.nodeStructure_.begin()),
-    begin_(gg.nodeStructure_.begin()),
-    end_(gg.nodeStructure_.end()) {}
+  NodesIteratorClass<Graph::ALLGRAPHITER, is_const>(GlobalGraph & gg, typename std::enable_if<!B>::type * = 0) : it_(gg.nodeStructure_->begin()),
+    begin_(gg.nodeStructure_->begin()),
+    end_(gg.nodeStructure_->end()) {}
 
   ~NodesIteratorClass<Graph::ALLGRAPHITER, is_const>(){}
 
@@ -840,9 +929,9 @@ class NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const> :
   virtual public Graph::NodeIterator
 {
 public:
-  NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.first) {}
+  NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.first) {}
 
-  NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.first) {}
+  NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.first) {}
 
   ~NodesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(){}
 
@@ -860,9 +949,9 @@ class NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const> :
   virtual public Graph::NodeIterator
 {
 public:
-  NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.second) {}
+  NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.second) {}
 
-  NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.second) {}
+  NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.second) {}
 
   ~NodesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(){}
 
@@ -896,14 +985,14 @@ private:
 
 public:
   template<bool B = is_const>
-  EdgesIteratorClass<Graph::ALLGRAPHITER, is_const>(const GlobalGraph &gg, typename std::enable_if<B>::type * = 0) : it_(gg.edgeStructure_.begin()),
-    begin_(gg.edgeStructure_.begin()),
-    end_(gg.edgeStructure_.end()) {}
+  EdgesIteratorClass<Graph::ALLGRAPHITER, is_const>(const GlobalGraph &gg, typename std::enable_if<B>::type * = 0) : it_(gg.edgeStructure_->begin()),
+    begin_(gg.edgeStructure_->begin()),
+    end_(gg.edgeStructure_->end()) {}
 
   template<bool B = is_const>
-  EdgesIteratorClass<Graph::ALLGRAPHITER, is_const>(GlobalGraph & gg, typename std::enable_if<!B>::type * = 0) : it_(gg.edgeStructure_.begin()),
-    begin_(gg.edgeStructure_.begin()),
-    end_(gg.edgeStructure_.end()) {}
+  EdgesIteratorClass<Graph::ALLGRAPHITER, is_const>(GlobalGraph & gg, typename std::enable_if<!B>::type * = 0) : it_(gg.edgeStructure_->begin()),
+    begin_(gg.edgeStructure_->begin()),
+    end_(gg.edgeStructure_->end()) {}
 
   ~EdgesIteratorClass<Graph::ALLGRAPHITER, is_const>(){}
 
@@ -921,9 +1010,9 @@ class EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const> :
   public Graph::EdgeIterator
 {
 public:
-  EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.first) {}
+  EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.first) {}
 
-  EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.first) {}
+  EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.first) {}
 
   ~EdgesIteratorClass<Graph::OUTGOINGNEIGHBORITER, is_const>(){}
 
@@ -940,9 +1029,9 @@ class EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const> :
   public Graph::EdgeIterator
 {
 public:
-  EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.second) {}
+  EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(const GlobalGraph &gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.second) {}
 
-  EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_.find(node)->second.second) {}
+  EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(GlobalGraph & gg, GlobalGraph::NodeId node) : NeighborIteratorClass<is_const>(gg.nodeStructure_->find(node)->second.second) {}
 
   ~EdgesIteratorClass<Graph::INCOMINGNEIGHBORITER, is_const>(){}
 
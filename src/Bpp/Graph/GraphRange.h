@@ -0,0 +1,162 @@
+//
+// File: GraphRange.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _GRAPH_RANGE_H_
+#define _GRAPH_RANGE_H_
+
+#include "Graph.h"
+
+// From the STL:
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A pair of iterators, to be used in range-based for loops.
+ *
+ * Ranges are returned by value by the graph implementations, and browse
+ * their storage directly: no allocation nor virtual call is done.
+ * A range is invalidated by any modification of the topology of its graph.
+ */
+template<class Iterator>
+class GraphRange
+{
+private:
+  Iterator begin_;
+  Iterator end_;
+
+public:
+  typedef Iterator iterator;
+  typedef Iterator const_iterator;
+  typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+  GraphRange(Iterator begin, Iterator end) : begin_(begin), end_(end) {}
+
+  Iterator begin() const { return begin_; }
+  Iterator end() const { return end_; }
+
+  bool empty() const { return begin_ == end_; }
+
+  /**
+   * @return the number of elements, in linear time.
+   */
+  size_t size() const { return static_cast<size_t>(std::distance(begin_, end_)); }
+};
+
+/**
+ * @brief An iterator on the ids of an adjacency structure.
+ *
+ * The underlying iterator browses (node, edge) pairs, the accessor
+ * selects the id to return.
+ */
+template<class BaseIterator, class Accessor>
+class AdjacencyIterator
+{
+private:
+  BaseIterator it_;
+
+public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef typename Accessor::value_type value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const value_type* pointer;
+  typedef value_type reference;
+
+  AdjacencyIterator() : it_() {}
+  explicit AdjacencyIterator(BaseIterator it) : it_(it) {}
+
+  value_type operator*() const { return Accessor::get(*it_); }
+
+  AdjacencyIterator& operator++() { ++it_; return *this; }
+  AdjacencyIterator operator++(int) { AdjacencyIterator tmp(*this); ++it_; return tmp; }
+
+  bool operator==(const AdjacencyIterator& other) const { return it_ == other.it_; }
+  bool operator!=(const AdjacencyIterator& other) const { return it_ != other.it_; }
+};
+
+/**
+ * @brief Accessors to the neighbor node and to the edge of a (node, edge) pair.
+ */
+struct NeighborNodeAccessor
+{
+  typedef Graph::NodeId value_type;
+  template<class Pair>
+  static value_type get(const Pair& pair) { return pair.first; }
+};
+
+struct NeighborEdgeAccessor
+{
+  typedef Graph::EdgeId value_type;
+  template<class Pair>
+  static value_type get(const Pair& pair) { return pair.second; }
+};
+
+/**
+ * @brief An iterator on the ids flagged as existing in a vector.
+ */
+class ExistingIdIterator
+{
+private:
+  const std::vector<char>* flags_;
+  size_t id_;
+
+  void skip_() { while (id_ < flags_->size() && !(*flags_)[id_]) id_++; }
+
+public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef Graph::NodeId value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const value_type* pointer;
+  typedef value_type reference;
+
+  ExistingIdIterator(const std::vector<char>& flags, size_t id) : flags_(&flags), id_(id) { skip_(); }
+
+  value_type operator*() const { return static_cast<value_type>(id_); }
+
+  ExistingIdIterator& operator++() { id_++; skip_(); return *this; }
+  ExistingIdIterator operator++(int) { ExistingIdIterator tmp(*this); ++*this; return tmp; }
+
+  bool operator==(const ExistingIdIterator& other) const { return id_ == other.id_; }
+  bool operator!=(const ExistingIdIterator& other) const { return id_ != other.id_; }
+};
+} // end of namespace bpp.
+
+#endif // _GRAPH_RANGE_H_
@@ -0,0 +1,308 @@
+//
+// File: GraphTraversalSchedule.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../Exceptions.h"
+#include "../Text/TextTools.h"
+#include "../Utils/ThreadTools.h"
+#include "GraphTraversalSchedule.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * Nodes ready to be processed by a worker.
+ */
+struct ReadyQueue
+{
+  std::mutex mutex;
+  std::deque<size_t> positions;
+
+  ReadyQueue() : mutex(), positions() {}
+};
+
+/**
+ * Take the last node of the queue of a worker, or else the first node of
+ * the queue of another worker.
+ */
+bool takeReadyNode(vector<ReadyQueue>& queues, size_t worker, size_t& position)
+{
+  {
+    lock_guard<std::mutex> lock(queues[worker].mutex);
+    if (!queues[worker].positions.empty())
+    {
+      position = queues[worker].positions.back();
+      queues[worker].positions.pop_back();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues.size(); i++)
+  {
+    ReadyQueue& other = queues[(worker + i) % queues.size()];
+    lock_guard<std::mutex> lock(other.mutex);
+    if (!other.positions.empty())
+    {
+      position = other.positions.front();
+      other.positions.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Wakes up the workers waiting for ready nodes, or for the end of the run.
+ */
+struct Wakeup
+{
+  std::mutex mutex;
+  std::condition_variable condition;
+  // nodes pushed in the queues and not taken yet
+  atomic<size_t> nbQueued;
+  atomic<size_t> nbRemaining;
+  bool failed;
+
+  Wakeup(size_t queued, size_t remaining) :
+    mutex(), condition(), nbQueued(queued), nbRemaining(remaining), failed(false) {}
+
+  bool over() const { return nbRemaining.load() == 0 || failed; }
+};
+}
+
+GraphTraversalSchedule::GraphTraversalSchedule() :
+  order_(),
+  position_(),
+  sonOffsets_(),
+  sons_(),
+  fatherOffsets_(),
+  fathers_(),
+  levels_(),
+  nbLevels_(0)
+{}
+
+void GraphTraversalSchedule::clear()
+{
+  *this = GraphTraversalSchedule();
+}
+
+void GraphTraversalSchedule::build(const Graph& graph)
+{
+  const size_t none = numeric_limits<size_t>::max();
+  vector<Graph::NodeId> nodes = graph.getAllNodes();
+  size_t nbNodes = nodes.size();
+  size_t size = nodes.empty() ? 0 : static_cast<size_t>(*max_element(nodes.begin(), nodes.end())) + 1;
+
+  // Kahn's algorithm: a node is ordered once all its fathers are.
+  vector<size_t> nbFathers(size, 0);
+  vector<Graph::NodeId> ready;
+  for (auto node : nodes)
+  {
+    nbFathers[node] = graph.getNumberOfIncomingNeighbors(node);
+    if (nbFathers[node] == 0)
+      ready.push_back(node);
+  }
+
+  order_.clear();
+  order_.reserve(nbNodes);
+  position_.assign(size, none);
+  vector<unsigned int> levelOfNode(size, 0);
+  nbLevels_ = 0;
+  while (!ready.empty())
+  {
+    Graph::NodeId node = ready.back();
+    ready.pop_back();
+    position_[node] = order_.size();
+    order_.push_back(node);
+    nbLevels_ = max(nbLevels_, levelOfNode[node] + 1);
+    for (auto son : graph.getOutgoingNeighbors(node))
+    {
+      levelOfNode[son] = max(levelOfNode[son], levelOfNode[node] + 1);
+      if (--nbFathers[son] == 0)
+        ready.push_back(son);
+    }
+  }
+  if (order_.size() != nbNodes)
+  {
+    clear();
+    throw Exception("GraphTraversalSchedule::build: the graph is not acyclic.");
+  }
+
+  // dependencies, as positions
+  sonOffsets_.assign(1, 0);
+  sonOffsets_.reserve(nbNodes + 1);
+  sons_.clear();
+  fatherOffsets_.assign(1, 0);
+  fatherOffsets_.reserve(nbNodes + 1);
+  fathers_.clear();
+  levels_.resize(nbNodes);
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    Graph::NodeId node = order_[i];
+    for (auto son : graph.getOutgoingNeighbors(node))
+      sons_.push_back(position_[son]);
+    sonOffsets_.push_back(sons_.size());
+    for (auto father : graph.getIncomingNeighbors(node))
+      fathers_.push_back(position_[father]);
+    fatherOffsets_.push_back(fathers_.size());
+    levels_[i] = levelOfNode[node];
+  }
+}
+
+unsigned int GraphTraversalSchedule::getLevel(Graph::NodeId node) const
+{
+  if (node >= position_.size() || position_[node] == numeric_limits<size_t>::max())
+    throw Exception("GraphTraversalSchedule::getLevel: node " + TextTools::toString(node) + " is not in the schedule.");
+  return levels_[position_[node]];
+}
+
+void GraphTraversalSchedule::runPostOrder(const Task& task, unsigned int nbThreads) const
+{
+  run_(task, nbThreads, true);
+}
+
+void GraphTraversalSchedule::runPreOrder(const Task& task, unsigned int nbThreads) const
+{
+  run_(task, nbThreads, false);
+}
+
+void GraphTraversalSchedule::run_(const Task& task, unsigned int nbThreads, bool postOrder) const
+{
+  size_t nbNodes = order_.size();
+  if (nbThreads == 0)
+    nbThreads = ThreadTools::getNumberOfAvailableThreads();
+  if (nbThreads > nbNodes)
+    nbThreads = static_cast<unsigned int>(max(nbNodes, static_cast<size_t>(1)));
+
+  // the topological order is a valid schedule for a single thread
+  if (nbThreads == 1)
+  {
+    if (postOrder)
+      for (size_t i = nbNodes; i > 0; i--)
+        task(order_[i - 1], 0);
+    else
+      for (size_t i = 0; i < nbNodes; i++)
+        task(order_[i], 0);
+    return;
+  }
+
+  // a node waits for its sons in post-order, for its fathers in pre-order
+  const vector<size_t>& waitedOffsets = postOrder ? sonOffsets_ : fatherOffsets_;
+  const vector<size_t>& nextOffsets = postOrder ? fatherOffsets_ : sonOffsets_;
+  const vector<size_t>& next = postOrder ? fathers_ : sons_;
+
+  unique_ptr<atomic<size_t>[]> nbWaited(new atomic<size_t>[nbNodes]);
+  vector<ReadyQueue> queues(nbThreads);
+  size_t nbReady = 0;
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    size_t pos = postOrder ? nbNodes - 1 - i : i;
+    nbWaited[pos] = waitedOffsets[pos + 1] - waitedOffsets[pos];
+    if (nbWaited[pos] == 0)
+      queues[nbReady++ % nbThreads].positions.push_back(pos);
+  }
+
+  // idle workers sleep until a node is ready, eg along a chain of nodes
+  Wakeup wakeup(nbReady, nbNodes);
+  ThreadTools::parallelFor(nbThreads, nbThreads, [&](size_t worker, unsigned int threadId) {
+      try
+      {
+        size_t pos;
+        vector<size_t> nextReady;
+        while (true)
+        {
+          if (!takeReadyNode(queues, worker, pos))
+          {
+            unique_lock<std::mutex> lock(wakeup.mutex);
+            wakeup.condition.wait(lock, [&wakeup]() { return wakeup.nbQueued.load() > 0 || wakeup.over(); });
+            if (wakeup.over())
+              break;
+            continue;
+          }
+          wakeup.nbQueued.fetch_sub(1);
+          task(order_[pos], threadId);
+          nextReady.clear();
+          for (size_t k = nextOffsets[pos]; k < nextOffsets[pos + 1]; k++)
+            if (nbWaited[next[k]].fetch_sub(1) == 1)
+              nextReady.push_back(next[k]);
+          if (!nextReady.empty())
+          {
+            // counted before being pushed, so that the count never underflows
+            {
+              lock_guard<std::mutex> lock(wakeup.mutex);
+              wakeup.nbQueued.fetch_add(nextReady.size());
+            }
+            lock_guard<std::mutex> lock(queues[worker].mutex);
+            queues[worker].positions.insert(queues[worker].positions.end(), nextReady.begin(), nextReady.end());
+          }
+          if (wakeup.nbRemaining.fetch_sub(1) == 1)
+          {
+            { lock_guard<std::mutex> lock(wakeup.mutex); }
+            wakeup.condition.notify_all();
+          }
+          else
+          {
+            // this worker takes one of the new nodes, the others are offered
+            for (size_t i = 1; i < nextReady.size(); i++)
+              wakeup.condition.notify_one();
+          }
+        }
+      }
+      catch (...)
+      {
+        // stop the other workers, which would wait for this node forever
+        {
+          lock_guard<std::mutex> lock(wakeup.mutex);
+          wakeup.failed = true;
+        }
+        wakeup.condition.notify_all();
+        throw;
+      }
+    });
+}
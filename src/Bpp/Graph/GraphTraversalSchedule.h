@@ -0,0 +1,161 @@
+//
+// File: GraphTraversalSchedule.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _GRAPH_TRAVERSAL_SCHEDULE_H_
+#define _GRAPH_TRAVERSAL_SCHEDULE_H_
+
+#include "Graph.h"
+
+// From the STL:
+#include <functional>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A schedule to run tasks on the nodes of a directed acyclic graph,
+ * on several threads.
+ *
+ * The schedule is computed once from the topology of the graph: nodes are
+ * sorted in topological order (fathers before sons), and the dependencies
+ * between nodes are stored in contiguous arrays.
+ *
+ * Tasks can then be run:
+ * - in post-order: a node is processed once all its sons are done, as in
+ *   the dynamic programming from the leaves of a tree to its root;
+ * - in pre-order: a node is processed once all its fathers are done.
+ *
+ * Each worker thread keeps its own queue of nodes ready to be processed,
+ * and takes work from the queues of the other threads when its own queue
+ * is empty, so that independent subtrees are processed concurrently.
+ * Workers with no node to process sleep until one is ready.
+ * The threads are those of ThreadTools::parallelFor, and a single thread
+ * is used unless more are asked for.
+ *
+ * The schedule does not follow the modifications of the graph, it has to
+ * be built again.
+ *
+ * @see TreeGraphImpl and DAGraphImpl, which build it when needed.
+ */
+class GraphTraversalSchedule
+{
+public:
+  /**
+   * A task, called with a node and the index of the thread in [0, nbThreads[.
+   */
+  typedef std::function<void (Graph::NodeId, unsigned int)> Task;
+
+private:
+  /**
+   * Nodes in topological order, and position of each node in this order.
+   */
+  std::vector<Graph::NodeId> order_;
+  std::vector<size_t> position_;
+
+  /**
+   * Positions of the sons and of the fathers of the node at position i,
+   * in [offsets[i], offsets[i + 1][.
+   */
+  std::vector<size_t> sonOffsets_;
+  std::vector<size_t> sons_;
+  std::vector<size_t> fatherOffsets_;
+  std::vector<size_t> fathers_;
+
+  /**
+   * Length of the longest path from a node with no father, per position.
+   */
+  std::vector<unsigned int> levels_;
+  unsigned int nbLevels_;
+
+public:
+  GraphTraversalSchedule();
+
+  /**
+   * @brief Compute the schedule of a directed graph, in linear time.
+   *
+   * @throw Exception if the graph is not acyclic.
+   */
+  void build(const Graph& graph);
+
+  /**
+   * @brief Free the memory of the schedule.
+   */
+  void clear();
+
+  size_t getNumberOfNodes() const { return order_.size(); }
+
+  /**
+   * @return the nodes in topological order, fathers before sons.
+   */
+  const std::vector<Graph::NodeId>& getTopologicalOrder() const { return order_; }
+
+  /**
+   * @return the length of the longest path from a node with no father to a node.
+   */
+  unsigned int getLevel(Graph::NodeId node) const;
+
+  /**
+   * @return the number of levels, ie the number of nodes of the longest path.
+   */
+  unsigned int getNumberOfLevels() const { return nbLevels_; }
+
+  /**
+   * @brief Run a task on each node, after the task has been run on all its sons.
+   *
+   * If a task throws an exception, the remaining nodes are skipped and the
+   * first exception is rethrown in the calling thread.
+   *
+   * @param task      The task.
+   * @param nbThreads The maximum number of threads to use (0 means all available threads).
+   */
+  void runPostOrder(const Task& task, unsigned int nbThreads = 1) const;
+
+  /**
+   * @brief Run a task on each node, after the task has been run on all its fathers.
+   *
+   * @see runPostOrder
+   */
+  void runPreOrder(const Task& task, unsigned int nbThreads = 1) const;
+
+private:
+  void run_(const Task& task, unsigned int nbThreads, bool postOrder) const;
+};
+} // end of namespace bpp.
+
+#endif // _GRAPH_TRAVERSAL_SCHEDULE_H_
@@ -0,0 +1,271 @@
+//
+// File: PointerHashMap.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _POINTER_HASH_MAP_H_
+#define _POINTER_HASH_MAP_H_
+
+// From the STL:
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A hash map from shared objects to values, with open addressing.
+ *
+ * Keys are hashed on the address of the object they point to, and entries
+ * are stored in a single array, with linear probing, so that a lookup is a
+ * few contiguous memory accesses instead of the pointer comparisons along
+ * the branches of a std::map.
+ *
+ * Keys are stored as shared pointers, so that mapped objects are kept
+ * alive as in a std::map. A null pointer is a valid key.
+ *
+ * The interface is a subset of the interface of std::map, but the order
+ * of iteration is unspecified, and insertions and removals invalidate
+ * iterators.
+ */
+template<class T, class V>
+class PointerHashMap
+{
+public:
+  typedef std::shared_ptr<T> key_type;
+  typedef V mapped_type;
+  typedef std::pair<key_type, V> value_type;
+
+private:
+  std::vector<value_type> slots_;
+  std::vector<char> used_;
+  size_t size_;
+
+public:
+  /**
+   * @brief An iterator on the entries, in unspecified order.
+   */
+  class const_iterator
+  {
+private:
+    const PointerHashMap* map_;
+    size_t slot_;
+
+    void skip_() { while (slot_ < map_->slots_.size() && !map_->used_[slot_]) slot_++; }
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename PointerHashMap::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    const_iterator(const PointerHashMap& map, size_t slot) : map_(&map), slot_(slot) { skip_(); }
+
+    reference operator*() const { return map_->slots_[slot_]; }
+    pointer operator->() const { return &map_->slots_[slot_]; }
+
+    const_iterator& operator++() { slot_++; skip_(); return *this; }
+    const_iterator operator++(int) { const_iterator tmp(*this); ++*this; return tmp; }
+
+    bool operator==(const const_iterator& other) const { return slot_ == other.slot_; }
+    bool operator!=(const const_iterator& other) const { return slot_ != other.slot_; }
+  };
+
+  typedef const_iterator iterator;
+
+  PointerHashMap() : slots_(), used_(), size_(0) {}
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  void clear()
+  {
+    slots_.clear();
+    used_.clear();
+    size_ = 0;
+  }
+
+  /**
+   * @brief Prepare the map for a number of entries, so that they are
+   * inserted with no rehashing.
+   */
+  void reserve(size_t nbEntries)
+  {
+    if (2 * nbEntries > slots_.size())
+      rehash_(capacityFor_(nbEntries));
+  }
+
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, slots_.size()); }
+
+  const_iterator find(const key_type& key) const
+  {
+    size_t slot = 0;
+    return findSlot_(key.get(), slot) ? const_iterator(*this, slot) : end();
+  }
+
+  size_t count(const key_type& key) const
+  {
+    size_t slot = 0;
+    return findSlot_(key.get(), slot) ? 1 : 0;
+  }
+
+  /**
+   * @throw std::out_of_range if the key is not in the map, as std::map::at.
+   */
+  const V& at(const key_type& key) const
+  {
+    size_t slot = 0;
+    if (!findSlot_(key.get(), slot))
+      throw std::out_of_range("PointerHashMap::at: key not found.");
+    return slots_[slot].second;
+  }
+
+  V& operator[](const key_type& key)
+  {
+    size_t slot = 0;
+    if (findSlot_(key.get(), slot))
+      return slots_[slot].second;
+
+    // keep the load factor under 1/2
+    if (2 * (size_ + 1) > slots_.size())
+    {
+      rehash_(capacityFor_(size_ + 1));
+      findSlot_(key.get(), slot);
+    }
+    slots_[slot] = value_type(key, V());
+    used_[slot] = 1;
+    size_++;
+    return slots_[slot].second;
+  }
+
+  /**
+   * @return the number of removed entries (0 or 1).
+   */
+  size_t erase(const key_type& key)
+  {
+    size_t slot = 0;
+    if (!findSlot_(key.get(), slot))
+      return 0;
+
+    // Backward shift: the following entries of the probe sequence are
+    // moved back, so that no lookup stops on the freed slot.
+    size_t mask = slots_.size() - 1;
+    size_t next = (slot + 1) & mask;
+    while (used_[next])
+    {
+      size_t home = hash_(slots_[next].first.get()) & mask;
+      // move the entry if its home is not in ]slot, next]
+      if (((next - home) & mask) >= ((next - slot) & mask))
+      {
+        slots_[slot] = std::move(slots_[next]);
+        slot = next;
+      }
+      next = (next + 1) & mask;
+    }
+    slots_[slot] = value_type();
+    used_[slot] = 0;
+    size_--;
+    return 1;
+  }
+
+private:
+  static size_t hash_(const T* pointer)
+  {
+    // finalizer of MurmurHash3, to spread the aligned addresses
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  static size_t capacityFor_(size_t nbEntries)
+  {
+    size_t capacity = 16;
+    while (capacity < 2 * nbEntries)
+      capacity *= 2;
+    return capacity;
+  }
+
+  /**
+   * @return true if the key is found at slot, else false with slot set
+   * to the free slot where it can be inserted.
+   */
+  bool findSlot_(const T* pointer, size_t& slot) const
+  {
+    if (slots_.empty())
+      return false;
+    size_t mask = slots_.size() - 1;
+    for (slot = hash_(pointer) & mask; used_[slot]; slot = (slot + 1) & mask)
+    {
+      if (slots_[slot].first.get() == pointer)
+        return true;
+    }
+    return false;
+  }
+
+  void rehash_(size_t capacity)
+  {
+    std::vector<value_type> oldSlots(capacity);
+    std::vector<char> oldUsed(capacity, 0);
+    oldSlots.swap(slots_);
+    oldUsed.swap(used_);
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < oldSlots.size(); i++)
+    {
+      if (!oldUsed[i])
+        continue;
+      size_t slot = hash_(oldSlots[i].first.get()) & mask;
+      while (used_[slot])
+        slot = (slot + 1) & mask;
+      slots_[slot] = std::move(oldSlots[i]);
+      used_[slot] = 1;
+    }
+  }
+};
+} // end of namespace bpp.
+
+#endif // _POINTER_HASH_MAP_H_
@@ -40,6 +40,9 @@
 #ifndef _TREEGRAPH_IMPL_H_
 #define _TREEGRAPH_IMPL_H_
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -47,7 +50,10 @@
 
 
 #include "TreeGraph.h"
+#include "CompactGraph.h"
 #include "GlobalGraph.h"
+#include "GraphTraversalSchedule.h"
+#include "TreeIndex.h"
 
 #include "../Exceptions.h"
 #include "../Numeric/VectorTools.h"
@@ -63,7 +69,106 @@ namespace bpp
     /**
      * Is the graph a tree? Set to false when structure is modified, true after validation.
      */
-    mutable bool isValid_;
+    mutable std::atomic<bool> isValid_;
+
+    /**
+     * @name Incremental validation.
+     *
+     * Once the tree has been found valid and rooted, the edits performed
+     * with createNode, link, unlink and deleteNode are recorded, so that
+     * the next validation only checks the nodes they affected.
+     * Any other modification of the topology stops the recording, and
+     * the next validation browses the whole tree.
+     * @{
+     */
+    mutable bool incremental_;
+
+    // nodes whose number of fathers may have changed
+    mutable std::vector<Graph::NodeId> editedNodes_;
+
+    // sons of new branches that may close a cycle
+    mutable std::vector<Graph::NodeId> linkedNodes_;
+
+    // number of recorded edits in progress
+    unsigned int nbRecordedEdits_;
+
+    /**
+     * Marks an edit in progress. If the edit is not completed,
+     * eg because an exception was thrown, the recording is stopped.
+     */
+    class RecordedEdit_
+    {
+    private:
+      TreeGraphImpl<GraphImpl>& tree_;
+      bool done_;
+
+    public:
+      RecordedEdit_(TreeGraphImpl<GraphImpl>& tree) : tree_(tree), done_(false) { tree_.nbRecordedEdits_++; }
+      ~RecordedEdit_()
+      {
+        tree_.nbRecordedEdits_--;
+        if (!done_)
+          tree_.resetEdits_(false);
+      }
+      void done() { done_ = true; }
+    };
+
+    // record a node whose fathers may have changed
+    void recordEditedNode_(Graph::NodeId node);
+
+    // record a new branch
+    void recordLink_(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+    // forget the recorded edits, and start recording again or not
+    void resetEdits_(bool incremental) const;
+
+    // check the recorded edits, false if the tree could not be proven valid
+    bool validateEdits_() const;
+    /** @} */
+
+    /**
+     * @name Index of the rooted tree.
+     *
+     * The index is built when a query needs it, and dropped at each
+     * modification of the topology, except rootAt and setFather, which
+     * update it. Queries fall back to browsing the graph when the tree
+     * is not rooted or not valid.
+     * @{
+     */
+    mutable TreeIndex index_;
+
+    mutable std::atomic<bool> hasIndex_;
+
+    mutable std::atomic<bool> hasMRCATable_;
+
+    // the tree could not be indexed, not tried again until the next modification
+    mutable std::atomic<bool> cannotIndex_;
+
+    // build the index if possible, false if the tree cannot be indexed
+    bool useIndex_() const;
+
+    // same, with the table for MRCA queries
+    bool useMRCAIndex_() const;
+    /** @} */
+
+    /**
+     * Schedule of the parallel traversals, built when needed, and dropped
+     * at each modification of the topology.
+     */
+    mutable GraphTraversalSchedule schedule_;
+
+    mutable std::atomic<bool> hasSchedule_;
+
+    /**
+     * Guards the lazy validation and builds of the index and of the
+     * schedule, so that const
+     * queries may be run concurrently, as long as the tree is not
+     * modified meanwhile.
+     */
+    mutable std::mutex cacheMutex_;
+
+    // copy the validation state and the index of another tree
+    void copyCache_(const TreeGraphImpl<GraphImpl>& tree);
 
     // unvalidate the tree
     void topologyHasChanged_() const;
@@ -83,6 +188,14 @@ namespace bpp
      */
     void propagateDirection_(Graph::NodeId node);
 
+    /**
+     * Move a subtree of a valid rooted tree to a new father, keeping the
+     * tree valid and updating the index.
+     * @return false if the tree is not valid and rooted, or if the new
+     * father is in the subtree.
+     */
+    bool moveSubtree_(Graph::NodeId node, Graph::NodeId fatherNode, const Graph::EdgeId* edgeId);
+
     // recursive function for getSubtreeNodes
     void fillSubtreeMetNodes_(std::vector<Graph::NodeId>& metNodes, Graph::NodeId localRoot) const;
 
@@ -92,17 +205,53 @@ namespace bpp
     // recursive function for getLeavesUnderNode
     void fillListOfLeaves_(Graph::NodeId startingNode, std::vector<Graph::NodeId>& foundLeaves) const;
 
+  protected:
+    /**
+     * @name Modifications of the topology, recorded for incremental validation.
+     * @{
+     */
+    Graph::EdgeId link(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+    void link(Graph::NodeId nodeA, Graph::NodeId nodeB, Graph::EdgeId edgeID);
+
+    std::vector<Graph::EdgeId> unlink(Graph::NodeId nodeA, Graph::NodeId nodeB);
+
+    void setRoot(Graph::NodeId newRoot);
+    /** @} */
+
+    template<class N, class E, class GraphImpl2>
+    friend class AssociationGraphImplObserver;
+
   public:
     TreeGraphImpl();
 
     TreeGraphImpl(bool rooted = true);
 
+    TreeGraphImpl(const TreeGraphImpl<GraphImpl>& tree);
+
+    TreeGraphImpl<GraphImpl>& operator=(const TreeGraphImpl<GraphImpl>& tree);
+
     /**
      * Is the graph a tree? A tree must be acyclic and with no isolated node.
      * @return true if valid tree
      */
     bool isValid() const;
 
+    /**
+     * @name Modifications of the topology, recorded for incremental validation.
+     * @{
+     */
+    Graph::NodeId createNode();
+
+    Graph::NodeId createNodeFromNode(Graph::NodeId origin);
+
+    Graph::NodeId createNodeOnEdge(Graph::EdgeId edge);
+
+    Graph::NodeId createNodeFromEdge(Graph::EdgeId origin);
+
+    void deleteNode(Graph::NodeId node);
+    /** @} */
+
     /**
      * Is the tree rooted?
      *
@@ -157,6 +306,16 @@ namespace bpp
 
     std::vector<Graph::EdgeId> getBranches(Graph::NodeId node) const;
 
+    /**
+     * Get ranges on the sons of a node and on the branches to them, with
+     * no copy. They are invalidated by any modification of the topology.
+     * @{
+     */
+    typename GraphImpl::NeighborRange sonRange(Graph::NodeId node) const { return GraphImpl::outgoingNeighborRange(node); }
+
+    typename GraphImpl::EdgeRange branchRange(Graph::NodeId node) const { return GraphImpl::outgoingEdgeRange(node); }
+    /** @} */
+
     /**
      * Get a iterator on the sons node of a node
      */
@@ -181,6 +340,9 @@ namespace bpp
 
     /**
      * set the father node of a node in a rooted tree
+     *
+     * When the tree is valid and fatherNode is not in the subtree of
+     * node (SPR move), the tree stays valid and its index is updated.
      */
 
     void setFather(Graph::NodeId node, Graph::NodeId fatherNode);
@@ -208,6 +370,9 @@ namespace bpp
 
     /**
      * Re-root the tree with the new root
+     *
+     * In a rooted tree, only the branches from the new root to the former
+     * one are reversed, and the tree index is updated.
      */
 
     void rootAt(Graph::NodeId newRoot);
@@ -223,6 +388,10 @@ namespace bpp
     /**
      * Set a node as a new outgroup in a rooted tree, will make a root between
      * the given node and its father.
+     *
+     * A root with two sons is moved there, the branches to its sons being
+     * joined. Otherwise a new root is created, and the former one is kept
+     * as an inner node.
      */
 
     void setOutGroup(Graph::NodeId newOutGroup);
@@ -252,7 +421,56 @@ namespace bpp
      */
 
     Graph::NodeId MRCA(const std::vector<Graph::NodeId>& nodes) const;
-    
+
+    /**
+     * @brief Compute the MRCA of two nodes, in constant time once the
+     * tree is indexed.
+     */
+    Graph::NodeId MRCA(Graph::NodeId nodeA, Graph::NodeId nodeB) const;
+
+    /**
+     * @return true if ancestor is on the path from node to the root,
+     * node included.
+     */
+    bool isAncestor(Graph::NodeId ancestor, Graph::NodeId node) const;
+
+    /**
+     * @return the number of branches between a node and the root.
+     */
+    unsigned int getDepth(Graph::NodeId node) const;
+
+    /**
+     * @brief Get the index of the rooted tree, built if needed.
+     *
+     * The reference is valid until the next modification of the topology.
+     * @throw Exception if the tree is not rooted or not valid.
+     */
+    const TreeIndex& getTreeIndex() const;
+
+    /**
+     * @name Parallel traversals.
+     *
+     * A task is run on each node of the rooted tree, once it has been run
+     * on all the sons of the node (post-order) or on its father
+     * (pre-order). Independent subtrees are processed concurrently.
+     *
+     * @param task      The task, called with a node and the index of the thread in [0, nbThreads[.
+     * @param nbThreads The maximum number of threads to use (0 means all available threads).
+     * @see GraphTraversalSchedule
+     * @{
+     */
+    void parallelPostOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads = 1) const;
+
+    void parallelPreOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads = 1) const;
+
+    /**
+     * @brief Get the schedule of the traversals, built if needed.
+     *
+     * The reference is valid until the next modification of the topology.
+     * @throw Exception if the tree is not rooted or not valid.
+     */
+    const GraphTraversalSchedule& getTraversalSchedule() const;
+    /** @} */
   };
 
 
@@ -260,36 +478,109 @@ namespace bpp
 
   typedef TreeGraphImpl<GlobalGraph> TreeGlobalGraph;
 
+  typedef TreeGraphImpl<CompactGraph> TreeCompactGraph;
+
 /*****************/
 
 
   template<class GraphImpl>
   TreeGraphImpl<GraphImpl>::TreeGraphImpl(bool rooted) :
     GraphImpl(rooted),
-    isValid_(false)
+    isValid_(false),
+    incremental_(false),
+    editedNodes_(),
+    linkedNodes_(),
+    nbRecordedEdits_(0),
+    index_(),
+    hasIndex_(false),
+    hasMRCATable_(false),
+    cannotIndex_(false),
+    schedule_(),
+    hasSchedule_(false),
+    cacheMutex_()
   {}
 
+  template<class GraphImpl>
+  TreeGraphImpl<GraphImpl>::TreeGraphImpl(const TreeGraphImpl<GraphImpl>& tree) :
+    GraphImpl(tree),
+    isValid_(false),
+    incremental_(false),
+    editedNodes_(),
+    linkedNodes_(),
+    nbRecordedEdits_(0),
+    index_(),
+    hasIndex_(false),
+    hasMRCATable_(false),
+    cannotIndex_(false),
+    schedule_(),
+    hasSchedule_(false),
+    cacheMutex_()
+  {
+    copyCache_(tree);
+  }
+
+  template<class GraphImpl>
+  TreeGraphImpl<GraphImpl>& TreeGraphImpl<GraphImpl>::operator=(const TreeGraphImpl<GraphImpl>& tree)
+  {
+    if (this != &tree)
+    {
+      GraphImpl::operator=(tree);
+      nbRecordedEdits_ = 0;
+      copyCache_(tree);
+    }
+    return *this;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::copyCache_(const TreeGraphImpl<GraphImpl>& tree)
+  {
+    // the other tree may be building its index in a const query
+    std::lock_guard<std::mutex> lock(tree.cacheMutex_);
+    isValid_ = tree.isValid_.load();
+    incremental_ = tree.incremental_;
+    editedNodes_ = tree.editedNodes_;
+    linkedNodes_ = tree.linkedNodes_;
+    index_ = tree.index_;
+    hasIndex_ = tree.hasIndex_.load();
+    hasMRCATable_ = tree.hasMRCATable_.load();
+    cannotIndex_ = tree.cannotIndex_.load();
+    schedule_ = tree.schedule_;
+    hasSchedule_ = tree.hasSchedule_.load();
+  }
+
 
   template<class GraphImpl>
   bool TreeGraphImpl<GraphImpl>::isValid() const
   {
+    if (isValid_)
+      return true;
+    std::lock_guard<std::mutex> lock(cacheMutex_);
     return isValid_ || validate_();
   }
 
   template<class GraphImpl>
   Graph::NodeId TreeGraphImpl<GraphImpl>::getFatherOfNode(Graph::NodeId node) const
   {
-    std::vector<Graph::NodeId> incomers = getIncomingNeighbors(node);
-    if (incomers.size() > 1)
-      throw Exception("TreeGraphImpl<GraphImpl>::getFather: more than one father for Node " + TextTools::toString(node) + " : " + VectorTools::paste(incomers, ",") + ". Should never happen since validity has been controlled. Please report this bug.");
-    if (incomers.size() == 0)
+    if (hasIndex_ && index_.hasNode(node))
+    {
+      if (!index_.hasFather(node))
+        throw Exception("TreeGraphImpl<GraphImpl>::getFather: node " + TextTools::toString(node) + " has no father.");
+      return index_.getFather(node);
+    }
+    typename GraphImpl::NeighborRange incomers = GraphImpl::incomingNeighborRange(node);
+    if (incomers.empty())
       throw Exception("TreeGraphImpl<GraphImpl>::getFather: node " + TextTools::toString(node) + " has no father.");
+    typename GraphImpl::NeighborRange::iterator father = incomers.begin();
+    if (++father != incomers.end())
+      throw Exception("TreeGraphImpl<GraphImpl>::getFather: more than one father for Node " + TextTools::toString(node) + " : " + VectorTools::paste(getIncomingNeighbors(node), ",") + ". Should never happen since validity has been controlled. Please report this bug.");
     return *incomers.begin();
   }
 
   template<class GraphImpl>
   Graph::EdgeId TreeGraphImpl<GraphImpl>::getEdgeToFather(Graph::NodeId node) const
   {
+    if (hasIndex_ && index_.hasNode(node) && index_.hasFather(node))
+      return index_.getEdgeToFather(node);
     Graph::NodeId father = getFatherOfNode(node);
     return GraphImpl::getEdge(father, node);
   }
@@ -297,6 +588,8 @@ namespace bpp
   template<class GraphImpl>
   bool TreeGraphImpl<GraphImpl>::hasFather(Graph::NodeId node) const
   {
+    if (hasIndex_ && index_.hasNode(node))
+      return index_.hasFather(node);
     return GraphImpl::getNumberOfIncomingNeighbors(node) >= 1;
   }
 
@@ -310,23 +603,38 @@ namespace bpp
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::fillListOfLeaves_(Graph::NodeId startingNode, std::vector<Graph::NodeId>& foundLeaves) const
   {
-    const std::vector<Graph::NodeId> sons = getSons(startingNode);
-    if (sons.size() > 1)
+    // Depth-first browsing, each node coming with its origin: in an
+    // unrooted tree, the sons of a node include the node it is reached from.
+    std::vector<std::pair<Graph::NodeId, Graph::NodeId> > toVisit(1, std::pair<Graph::NodeId, Graph::NodeId>(startingNode, startingNode));
+    while (!toVisit.empty())
     {
-      for (std::vector<Graph::NodeId>::const_iterator currNeighbor = sons.begin(); currNeighbor != sons.end(); currNeighbor++)
+      Graph::NodeId node = toVisit.back().first;
+      Graph::NodeId origin = toVisit.back().second;
+      toVisit.pop_back();
+      if (isLeaf(node))
       {
-        fillListOfLeaves_(*currNeighbor, foundLeaves);
+        foundLeaves.push_back(node);
+        continue;
       }
-    }
-    else
-    {
-      foundLeaves.push_back(startingNode);
+      size_t first = toVisit.size();
+      for (Graph::NodeId son : sonRange(node))
+        if (son != origin)
+          toVisit.push_back(std::pair<Graph::NodeId, Graph::NodeId>(son, node));
+      // sons are visited in order
+      std::reverse(toVisit.begin() + static_cast<std::ptrdiff_t>(first), toVisit.end());
     }
   }
 
   template<class GraphImpl>
   std::vector<Graph::NodeId> TreeGraphImpl<GraphImpl>::getLeavesUnderNode(Graph::NodeId node) const
   {
+    if (useIndex_())
+    {
+      const std::vector<Graph::NodeId>& leaves = index_.getLeaves();
+      return std::vector<Graph::NodeId>(leaves.begin() + static_cast<std::ptrdiff_t>(index_.getLeavesBegin(node)),
+                                        leaves.begin() + static_cast<std::ptrdiff_t>(index_.getLeavesEnd(node)));
+    }
+
     std::vector<Graph::NodeId> foundLeaves;
     fillListOfLeaves_(node, foundLeaves);
 
@@ -356,14 +664,261 @@ namespace bpp
   template<class GraphImpl>
   bool TreeGraphImpl<GraphImpl>::validate_() const
   {
+    if (incremental_ && validateEdits_())
+    {
+      isValid_ = true;
+      resetEdits_(true);
+      return true;
+    }
+
     isValid_ = GraphImpl::isTree();
+    // a rooted tree with one father per node can be checked incrementally
+    resetEdits_(isValid_ && GraphImpl::isDirected() && GraphImpl::getNumberOfEdges() + 1 == GraphImpl::getNumberOfNodes());
     return isValid_;
   }
 
+  template<class GraphImpl>
+  bool TreeGraphImpl<GraphImpl>::validateEdits_() const
+  {
+    // The tree was rooted with one father per node: it is still a tree if
+    // the nodes that were edited have one father, and if no cycle was made.
+    Graph::NodeId root = GraphImpl::getRoot();
+    size_t nbNodes = GraphImpl::getNumberOfNodes();
+    if (!GraphImpl::isDirected() || !GraphImpl::hasNode_(root) || GraphImpl::getNumberOfIncomingNeighbors(root) != 0
+        || GraphImpl::getNumberOfEdges() + 1 != nbNodes)
+      return false;
+
+    for (auto node : editedNodes_)
+      if (node != root && GraphImpl::hasNode_(node) && GraphImpl::getNumberOfIncomingNeighbors(node) != 1)
+        return false;
+
+    // A cycle contains the last branch linked to it, so it is found
+    // going up from the son of this branch.
+    // Beyond nbNodes steps, browsing the whole tree is cheaper.
+    size_t nbSteps = 0;
+    for (auto node : linkedNodes_)
+    {
+      if (!GraphImpl::hasNode_(node))
+        continue;
+      Graph::NodeId currNode = node;
+      while (currNode != root)
+      {
+        currNode = getFatherOfNode(currNode);
+        if (currNode == node || ++nbSteps > nbNodes)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::recordEditedNode_(Graph::NodeId node)
+  {
+    if (!incremental_)
+      return;
+    editedNodes_.push_back(node);
+    // beyond this size, browsing the whole tree is cheaper
+    if (editedNodes_.size() > GraphImpl::getNumberOfNodes() + 1)
+      resetEdits_(false);
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::recordLink_(Graph::NodeId nodeA, Graph::NodeId nodeB)
+  {
+    if (!incremental_)
+      return;
+    if (!GraphImpl::hasNode_(nodeA) || !GraphImpl::hasNode_(nodeB))
+    {
+      resetEdits_(false);
+      return;
+    }
+    recordEditedNode_(nodeB);
+    // a branch to a node with no son cannot close a cycle
+    if (incremental_ && (nodeA == nodeB || GraphImpl::getNumberOfOutgoingNeighbors(nodeB) != 0))
+      linkedNodes_.push_back(nodeB);
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::resetEdits_(bool incremental) const
+  {
+    incremental_ = incremental;
+    editedNodes_.clear();
+    linkedNodes_.clear();
+  }
+
+  template<class GraphImpl>
+  bool TreeGraphImpl<GraphImpl>::useIndex_() const
+  {
+    if (hasIndex_)
+      return true;
+    if (cannotIndex_ || !GraphImpl::isDirected() || !isValid())
+      return false;
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    // built meanwhile by another query
+    if (hasIndex_ || cannotIndex_)
+      return hasIndex_;
+    index_.build(*this);
+    // a valid tree may have been rooted on a son
+    if (index_.getNumberOfNodes() == GraphImpl::getNumberOfNodes())
+      hasIndex_ = true;
+    else
+      cannotIndex_ = true;
+    return hasIndex_;
+  }
+
+  template<class GraphImpl>
+  bool TreeGraphImpl<GraphImpl>::useMRCAIndex_() const
+  {
+    if (!useIndex_())
+      return false;
+    if (hasMRCATable_)
+      return true;
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!index_.hasMRCATable())
+      index_.buildMRCATable();
+    hasMRCATable_ = true;
+    return true;
+  }
+
+  template<class GraphImpl>
+  const TreeIndex& TreeGraphImpl<GraphImpl>::getTreeIndex() const
+  {
+    mustBeRooted_();
+    if (!useIndex_())
+      throw Exception("TreeGraphImpl<GraphImpl>::getTreeIndex: The tree is not valid.");
+    return index_;
+  }
+
+  template<class GraphImpl>
+  const GraphTraversalSchedule& TreeGraphImpl<GraphImpl>::getTraversalSchedule() const
+  {
+    mustBeRooted_();
+    mustBeValid_();
+    if (!hasSchedule_)
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex_);
+      // built meanwhile by another query
+      if (!hasSchedule_)
+      {
+        schedule_.build(*this);
+        hasSchedule_ = true;
+      }
+    }
+    return schedule_;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::parallelPostOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads) const
+  {
+    getTraversalSchedule().runPostOrder(task, nbThreads);
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::parallelPreOrder(const GraphTraversalSchedule::Task& task, unsigned int nbThreads) const
+  {
+    getTraversalSchedule().runPreOrder(task, nbThreads);
+  }
+
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::topologyHasChanged_() const
   {
     isValid_ = false;
+    hasIndex_ = false;
+    hasMRCATable_ = false;
+    cannotIndex_ = false;
+    hasSchedule_ = false;
+    // modifications that are not recorded
+    if (nbRecordedEdits_ == 0 && incremental_)
+      resetEdits_(false);
+  }
+
+  template<class GraphImpl>
+  Graph::NodeId TreeGraphImpl<GraphImpl>::createNode()
+  {
+    RecordedEdit_ edit(*this);
+    Graph::NodeId node = GraphImpl::createNode();
+    recordEditedNode_(node);
+    edit.done();
+    return node;
+  }
+
+  template<class GraphImpl>
+  Graph::NodeId TreeGraphImpl<GraphImpl>::createNodeFromNode(Graph::NodeId origin)
+  {
+    RecordedEdit_ edit(*this);
+    Graph::NodeId node = GraphImpl::createNodeFromNode(origin);
+    edit.done();
+    return node;
+  }
+
+  template<class GraphImpl>
+  Graph::NodeId TreeGraphImpl<GraphImpl>::createNodeOnEdge(Graph::EdgeId edge)
+  {
+    RecordedEdit_ edit(*this);
+    Graph::NodeId node = GraphImpl::createNodeOnEdge(edge);
+    edit.done();
+    return node;
+  }
+
+  template<class GraphImpl>
+  Graph::NodeId TreeGraphImpl<GraphImpl>::createNodeFromEdge(Graph::EdgeId origin)
+  {
+    RecordedEdit_ edit(*this);
+    Graph::NodeId node = GraphImpl::createNodeFromEdge(origin);
+    edit.done();
+    return node;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::deleteNode(Graph::NodeId node)
+  {
+    RecordedEdit_ edit(*this);
+    GraphImpl::deleteNode(node);
+    edit.done();
+  }
+
+  template<class GraphImpl>
+  Graph::EdgeId TreeGraphImpl<GraphImpl>::link(Graph::NodeId nodeA, Graph::NodeId nodeB)
+  {
+    RecordedEdit_ edit(*this);
+    Graph::EdgeId edge = GraphImpl::link(nodeA, nodeB);
+    recordLink_(nodeA, nodeB);
+    edit.done();
+    return edge;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::link(Graph::NodeId nodeA, Graph::NodeId nodeB, Graph::EdgeId edgeID)
+  {
+    RecordedEdit_ edit(*this);
+    GraphImpl::link(nodeA, nodeB, edgeID);
+    recordLink_(nodeA, nodeB);
+    edit.done();
+  }
+
+  template<class GraphImpl>
+  std::vector<Graph::EdgeId> TreeGraphImpl<GraphImpl>::unlink(Graph::NodeId nodeA, Graph::NodeId nodeB)
+  {
+    RecordedEdit_ edit(*this);
+    std::vector<Graph::EdgeId> edges = GraphImpl::unlink(nodeA, nodeB);
+    recordEditedNode_(nodeB);
+    edit.done();
+    return edges;
+  }
+
+  template<class GraphImpl>
+  void TreeGraphImpl<GraphImpl>::setRoot(Graph::NodeId newRoot)
+  {
+    if (newRoot != GraphImpl::getRoot())
+    {
+      resetEdits_(false);
+      hasIndex_ = false;
+      hasMRCATable_ = false;
+      cannotIndex_ = false;
+    }
+    GraphImpl::setRoot(newRoot);
   }
 
   template<class GraphImpl>
@@ -372,55 +927,108 @@ namespace bpp
     if (!isValid())
       throw Exception("TreeGraphImpl::rootAt: Tree is not Valid.");
 
-    GraphImpl::makeDirected();
-    // set the new root on the Graph
-    GraphImpl::setRoot(newRoot);
-    // change edge direction between the new node and the former one
+    if (!GraphImpl::isDirected())
+    {
+      GraphImpl::makeDirected();
+      // set the new root on the Graph
+      setRoot(newRoot);
+      // change edge direction between the new node and the former one
+      propagateDirection_(newRoot);
+      return;
+    }
+
+    // A valid rooted tree stays valid once the path from the new root
+    // to the former one is reversed.
+    bool incremental = incremental_;
+    bool indexed = hasIndex_;
     propagateDirection_(newRoot);
+    GraphImpl::setRoot(newRoot);
+    isValid_ = true;
+    resetEdits_(incremental);
+    if (indexed)
+    {
+      index_.reroot(*this, newRoot);
+      hasIndex_ = true;
+    }
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::propagateDirection_(Graph::NodeId node)
   {
-    if (hasFather(node))
+    std::vector<Graph::NodeId> path(1, node);
+    while (hasFather(path.back()))
+      path.push_back(getFatherOfNode(path.back()));
+    // from the top, as the fathers are read on the graph
+    for (size_t i = path.size() - 1; i > 0; i--)
+      GraphImpl::switchNodes(path[i], path[i - 1]);
+  }
+
+  template<class GraphImpl>
+  bool TreeGraphImpl<GraphImpl>::moveSubtree_(Graph::NodeId node, Graph::NodeId fatherNode, const Graph::EdgeId* edgeId)
+  {
+    if (!isValid_ || !GraphImpl::isDirected() || !GraphImpl::hasNode_(fatherNode) || !hasFather(node))
+      return false;
+    if (hasIndex_)
+    {
+      if (index_.isAncestor(node, fatherNode))
+        return false;
+    }
+    else
     {
-      NodeId father = getFatherOfNode(node);
-      propagateDirection_(father);
-      GraphImpl::switchNodes(father, node);
+      for (Graph::NodeId nodeUp = fatherNode; nodeUp != GraphImpl::getRoot(); nodeUp = getFatherOfNode(nodeUp))
+        if (nodeUp == node)
+          return false;
     }
+
+    // if an exception is thrown, the tree is left unvalidated
+    bool incremental = incremental_;
+    bool indexed = hasIndex_;
+    GraphImpl::unlink(getFatherOfNode(node), node);
+    if (edgeId)
+      GraphImpl::link(fatherNode, node, *edgeId);
+    else
+      GraphImpl::link(fatherNode, node);
+    isValid_ = true;
+    resetEdits_(incremental);
+    if (indexed)
+    {
+      index_.moveSubtree(*this, node);
+      hasIndex_ = true;
+    }
+    return true;
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::setFather(Graph::NodeId node, Graph::NodeId fatherNode)
   {
+    if (moveSubtree_(node, fatherNode, 0))
+      return;
     if (hasFather(node))
-      GraphImpl::unlink(getFatherOfNode(node), node);
-    GraphImpl::link(fatherNode, node);
-    topologyHasChanged_();
+      unlink(getFatherOfNode(node), node);
+    link(fatherNode, node);
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::setFather(Graph::NodeId node, Graph::NodeId fatherNode, Graph::EdgeId edgeId)
   {
+    if (moveSubtree_(node, fatherNode, &edgeId))
+      return;
     if (hasFather(node))
-      GraphImpl::unlink(getFatherOfNode(node), node);
-    GraphImpl::link(fatherNode, node, edgeId);
-    topologyHasChanged_();
+      unlink(getFatherOfNode(node), node);
+    link(fatherNode, node, edgeId);
   }
 
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::addSon(Graph::NodeId node, Graph::NodeId sonNode)
   {
-    GraphImpl::link(node, sonNode);
-    topologyHasChanged_();
+    link(node, sonNode);
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::addSon(Graph::NodeId node, Graph::NodeId sonNode, Graph::EdgeId edgeId)
   {
-    GraphImpl::link(node, sonNode, edgeId);
-    topologyHasChanged_();
+    link(node, sonNode, edgeId);
   }
 
   template<class GraphImpl>
@@ -496,17 +1104,40 @@ namespace bpp
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::removeSon(Graph::NodeId node, Graph::NodeId son)
   {
-    GraphImpl::unlink(node, son);
-    topologyHasChanged_();
+    unlink(node, son);
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::setOutGroup(Graph::NodeId newOutGroup)
   {
     mustBeRooted_();
-    deleteNode(GraphImpl::getRoot());
-
-    Graph::NodeId newRoot = GraphImpl::createNodeFromEdge(getEdge(getFatherOfNode(newOutGroup), newOutGroup));
+    mustBeValid_();
+    Graph::NodeId root = GraphImpl::getRoot();
+    Graph::NodeId father = getFatherOfNode(newOutGroup);
+    std::vector<Graph::NodeId> rootSons = getSons(root);
+    if (father == root && rootSons.size() == 2)
+      return;
+
+    // A root with two sons is moved between the outgroup and its father,
+    // joining its sons. Otherwise a new root is created there.
+    // The edits are recorded, so that the validation before rerooting
+    // only checks the modified nodes.
+    Graph::NodeId newRoot;
+    if (rootSons.size() == 2)
+    {
+      newRoot = root;
+      unlink(root, rootSons[0]);
+      unlink(root, rootSons[1]);
+      link(rootSons[0], rootSons[1]);
+      // no validation of the edits occurs before the next one
+      GraphImpl::setRoot(rootSons[0]);
+      father = getFatherOfNode(newOutGroup);
+    }
+    else
+      newRoot = createNode();
+    unlink(father, newOutGroup);
+    link(father, newRoot);
+    link(newRoot, newOutGroup);
     rootAt(newRoot);
   }
 
@@ -516,6 +1147,26 @@ namespace bpp
     GraphImpl::nodeMustExist_(nodeA);
     GraphImpl::nodeMustExist_(nodeB);
     std::vector<Graph::NodeId> path;
+
+    if (useMRCAIndex_())
+    {
+      Graph::NodeId ancestor = index_.MRCA(nodeA, nodeB);
+      path.reserve(index_.getDepth(nodeA) + index_.getDepth(nodeB) + 1 - 2 * index_.getDepth(ancestor));
+      for (Graph::NodeId nodeUp = nodeA; nodeUp != ancestor; nodeUp = index_.getFather(nodeUp))
+      {
+        path.push_back(nodeUp);
+      }
+      if (includeAncestor)
+        path.push_back(ancestor);
+      size_t middle = path.size();
+      for (Graph::NodeId nodeUp = nodeB; nodeUp != ancestor; nodeUp = index_.getFather(nodeUp))
+      {
+        path.push_back(nodeUp);
+      }
+      std::reverse(path.begin() + static_cast<std::ptrdiff_t>(middle), path.end());
+      return path;
+    }
+
     std::vector<Graph::NodeId> pathMatrix1;
     std::vector<Graph::NodeId> pathMatrix2;
 
@@ -564,6 +1215,22 @@ namespace bpp
   std::vector<Graph::EdgeId> TreeGraphImpl<GraphImpl>::getEdgePathBetweenTwoNodes(Graph::NodeId nodeA, Graph::NodeId nodeB) const
   {
     std::vector<Graph::EdgeId> path;
+    if (GraphImpl::hasNode_(nodeA) && GraphImpl::hasNode_(nodeB) && useMRCAIndex_())
+    {
+      Graph::NodeId ancestor = index_.MRCA(nodeA, nodeB);
+      for (Graph::NodeId nodeUp = nodeA; nodeUp != ancestor; nodeUp = index_.getFather(nodeUp))
+      {
+        path.push_back(index_.getEdgeToFather(nodeUp));
+      }
+      size_t middle = path.size();
+      for (Graph::NodeId nodeUp = nodeB; nodeUp != ancestor; nodeUp = index_.getFather(nodeUp))
+      {
+        path.push_back(index_.getEdgeToFather(nodeUp));
+      }
+      std::reverse(path.begin() + static_cast<std::ptrdiff_t>(middle), path.end());
+      return path;
+    }
+
     std::vector<Graph::NodeId> pathNodes = getNodePathBetweenTwoNodes(nodeA, nodeB, true);
     for (size_t currNodeNr = 0; currNodeNr + 1 < pathNodes.size(); currNodeNr++)
     {
@@ -576,6 +1243,13 @@ namespace bpp
   std::vector<Graph::NodeId> TreeGraphImpl<GraphImpl>::getSubtreeNodes(Graph::NodeId localRoot) const
   {
     mustBeValid_();
+    if (useIndex_())
+    {
+      const std::vector<Graph::NodeId>& preOrder = index_.getPreOrder();
+      return std::vector<Graph::NodeId>(preOrder.begin() + static_cast<std::ptrdiff_t>(index_.getPreOrderIndex(localRoot)),
+                                        preOrder.begin() + static_cast<std::ptrdiff_t>(index_.getSubtreeEnd(localRoot)));
+    }
+
     std::vector<Graph::EdgeId> metNodes;
     fillSubtreeMetNodes_(metNodes, localRoot);
     return metNodes;
@@ -586,6 +1260,20 @@ namespace bpp
   {
     mustBeValid_();
     std::vector<Graph::EdgeId> metEdges;
+    if (useIndex_())
+    {
+      // branches to the fathers of the nodes of the subtree, but its root
+      const std::vector<Graph::NodeId>& preOrder = index_.getPreOrder();
+      size_t end = index_.getSubtreeEnd(localRoot);
+      metEdges.reserve(end - index_.getPreOrderIndex(localRoot) - 1);
+      for (size_t i = index_.getPreOrderIndex(localRoot) + 1; i < end; i++)
+      {
+        metEdges.push_back(index_.getEdgeToFather(preOrder[i]));
+      }
+      return metEdges;
+    }
+
+
     fillSubtreeMetEdges_(metEdges, localRoot);
     return metEdges;
   }
@@ -595,21 +1283,19 @@ namespace bpp
   void TreeGraphImpl<GraphImpl>::fillSubtreeMetNodes_(std::vector<Graph::NodeId>& metNodes, Graph::NodeId localRoot) const
   {
     metNodes.push_back(localRoot);
-    std::vector<Graph::NodeId> sons = GraphImpl::getOutgoingNeighbors(localRoot);
-    for (std::vector<Graph::NodeId>::iterator currSon = sons.begin(); currSon != sons.end(); currSon++)
+    for (Graph::NodeId son : sonRange(localRoot))
     {
-      fillSubtreeMetNodes_(metNodes, *currSon);
+      fillSubtreeMetNodes_(metNodes, son);
     }
   }
 
   template<class GraphImpl>
   void TreeGraphImpl<GraphImpl>::fillSubtreeMetEdges_(std::vector<Graph::EdgeId>& metEdges, Graph::NodeId localRoot) const
   {
-    std::vector<Graph::EdgeId> edgesToSons = GraphImpl::getOutgoingEdges(localRoot);
-    for (std::vector<Graph::EdgeId>::iterator currEdgeToSon = edgesToSons.begin(); currEdgeToSon != edgesToSons.end(); currEdgeToSon++)
+    for (Graph::EdgeId edgeToSon : branchRange(localRoot))
     {
-      metEdges.push_back(*currEdgeToSon);
-      fillSubtreeMetEdges_(metEdges, GraphImpl::getBottom(*currEdgeToSon));
+      metEdges.push_back(edgeToSon);
+      fillSubtreeMetEdges_(metEdges, GraphImpl::getBottom(edgeToSon));
     }
   }
 
@@ -626,6 +1312,16 @@ namespace bpp
     if (nbnodes==1)
       return nodes[0];
 
+    if (useMRCAIndex_())
+    {
+      Graph::NodeId ancestor = nodes[0];
+      for (size_t i = 1; i < nbnodes; i++)
+      {
+        ancestor = index_.MRCA(ancestor, nodes[i]);
+      }
+      return ancestor;
+    }
+
     // Total counts
     std::map<Graph::NodeId, uint> counts;
 
@@ -675,6 +1371,46 @@ namespace bpp
 
     return sons->begin()->first;
   }
+
+  template<class GraphImpl>
+  Graph::NodeId TreeGraphImpl<GraphImpl>::MRCA(Graph::NodeId nodeA, Graph::NodeId nodeB) const
+  {
+    mustBeRooted_();
+    if (useMRCAIndex_())
+      return index_.MRCA(nodeA, nodeB);
+    return MRCA(std::vector<Graph::NodeId>{nodeA, nodeB});
+  }
+
+  template<class GraphImpl>
+  bool TreeGraphImpl<GraphImpl>::isAncestor(Graph::NodeId ancestor, Graph::NodeId node) const
+  {
+    mustBeRooted_();
+    if (useIndex_())
+      return index_.isAncestor(ancestor, node);
+
+    GraphImpl::nodeMustExist_(ancestor);
+    Graph::NodeId nodeUp = node;
+    while (nodeUp != ancestor && hasFather(nodeUp))
+    {
+      nodeUp = getFatherOfNode(nodeUp);
+    }
+    return nodeUp == ancestor;
+  }
+
+  template<class GraphImpl>
+  unsigned int TreeGraphImpl<GraphImpl>::getDepth(Graph::NodeId node) const
+  {
+    mustBeRooted_();
+    if (useIndex_())
+      return index_.getDepth(node);
+
+    unsigned int depth = 0;
+    for (Graph::NodeId nodeUp = node; hasFather(nodeUp); nodeUp = getFatherOfNode(nodeUp))
+    {
+      depth++;
+    }
+    return depth;
+  }
   
 }
 
@@ -0,0 +1,355 @@
+//
+// File: TreeIndex.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../Exceptions.h"
+#include "../Text/TextTools.h"
+#include "TreeIndex.h"
+
+// From the STL:
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace bpp;
+using namespace std;
+
+const Graph::NodeId TreeIndex::NONE = numeric_limits<Graph::NodeId>::max();
+
+TreeIndex::TreeIndex() :
+  root_(NONE),
+  father_(),
+  edgeToFather_(),
+  depth_(),
+  preOrder_(),
+  postOrder_(),
+  preIndex_(),
+  subtreeEnd_(),
+  leaves_(),
+  leavesBegin_(),
+  leavesEnd_(),
+  minDepthTable_(),
+  log2_()
+{}
+
+void TreeIndex::clear()
+{
+  *this = TreeIndex();
+}
+
+Graph::NodeId TreeIndex::checkNode_(Graph::NodeId node) const
+{
+  if (!hasNode(node))
+    throw Exception("TreeIndex: node " + TextTools::toString(node) + " is not in the tree.");
+  return node;
+}
+
+void TreeIndex::build(const Graph& tree)
+{
+  root_ = tree.getRoot();
+  vector<Graph::NodeId> nodes = tree.getAllNodes();
+  size_t size = nodes.empty() ? 0 : static_cast<size_t>(*max_element(nodes.begin(), nodes.end())) + 1;
+
+  father_.assign(size, NONE);
+  edgeToFather_.assign(size, NONE);
+  depth_.assign(size, 0);
+  preIndex_.assign(size, NONE);
+  subtreeEnd_.assign(size, 0);
+  leavesBegin_.assign(size, 0);
+  leavesEnd_.assign(size, 0);
+  preOrder_.clear();
+  preOrder_.reserve(nodes.size());
+  postOrder_.clear();
+  postOrder_.reserve(nodes.size());
+  leaves_.clear();
+  minDepthTable_.clear();
+  log2_.clear();
+
+  // Depth-first browsing, each node being visited once on the way down
+  // and once on the way up.
+  vector<pair<Graph::NodeId, bool> > toVisit(1, pair<Graph::NodeId, bool>(root_, false));
+  while (!toVisit.empty())
+  {
+    Graph::NodeId node = toVisit.back().first;
+    if (toVisit.back().second)
+    {
+      // way up
+      toVisit.pop_back();
+      subtreeEnd_[node] = preOrder_.size();
+      leavesEnd_[node] = leaves_.size();
+      postOrder_.push_back(node);
+      continue;
+    }
+
+    // way down
+    toVisit.back().second = true;
+    if (preIndex_[node] != NONE)
+      throw Exception("TreeIndex::build: node " + TextTools::toString(node) + " is met more than once from the root.");
+    preIndex_[node] = preOrder_.size();
+    preOrder_.push_back(node);
+    leavesBegin_[node] = leaves_.size();
+
+    vector<Graph::NodeId> sons = tree.getOutgoingNeighbors(node);
+    vector<Graph::EdgeId> branches = tree.getOutgoingEdges(node);
+    if (sons.empty())
+      leaves_.push_back(node);
+    // sons are pushed backwards, to be visited in order
+    for (size_t i = sons.size(); i > 0; i--)
+    {
+      Graph::NodeId son = sons[i - 1];
+      if (son >= size || preIndex_[son] != NONE)
+        throw Exception("TreeIndex::build: node " + TextTools::toString(son) + " is met more than once from the root.");
+      father_[son] = node;
+      edgeToFather_[son] = branches[i - 1];
+      depth_[son] = depth_[node] + 1;
+      toVisit.push_back(pair<Graph::NodeId, bool>(son, false));
+    }
+  }
+}
+
+void TreeIndex::buildMRCATable()
+{
+  // The MRCA of two nodes a and b, with a before b in preorder, is the
+  // father of the shallowest node among the positions ]pre(a), pre(b)].
+  size_t nbNodes = preOrder_.size();
+  minDepthTable_.clear();
+  log2_.assign(nbNodes + 1, 0);
+  for (size_t i = 2; i <= nbNodes; i++)
+    log2_[i] = static_cast<unsigned char>(log2_[i / 2] + 1);
+
+  if (nbNodes < 2)
+    return;
+
+  minDepthTable_.push_back(preOrder_);
+  for (size_t k = 1; (static_cast<size_t>(1) << k) <= nbNodes; k++)
+  {
+    const vector<Graph::NodeId>& previous = minDepthTable_[k - 1];
+    size_t half = static_cast<size_t>(1) << (k - 1);
+    vector<Graph::NodeId> level(nbNodes - 2 * half + 1);
+    for (size_t i = 0; i < level.size(); i++)
+    {
+      Graph::NodeId left = previous[i];
+      Graph::NodeId right = previous[i + half];
+      level[i] = (depth_[right] < depth_[left]) ? right : left;
+    }
+    minDepthTable_.push_back(level);
+  }
+}
+
+Graph::NodeId TreeIndex::MRCA(Graph::NodeId nodeA, Graph::NodeId nodeB) const
+{
+  size_t posA = preIndex_[checkNode_(nodeA)];
+  size_t posB = preIndex_[checkNode_(nodeB)];
+  if (posA == posB)
+    return nodeA;
+  if (!hasMRCATable())
+    throw Exception("TreeIndex::MRCA: the MRCA table is not built.");
+  if (posA > posB)
+    swap(posA, posB);
+
+  // minimum over [posA + 1, posB]
+  size_t k = log2_[posB - posA];
+  Graph::NodeId left = minDepthTable_[k][posA + 1];
+  Graph::NodeId right = minDepthTable_[k][posB + 1 - (static_cast<size_t>(1) << k)];
+  return father_[(depth_[right] < depth_[left]) ? right : left];
+}
+
+void TreeIndex::relayout_(const Graph& tree, Graph::NodeId regionRoot, Graph::NodeId top, const vector<Graph::NodeId>& expanded)
+{
+  size_t preBegin = preIndex_[regionRoot];
+  size_t regionSize = subtreeEnd_[regionRoot] - preBegin;
+  size_t postBegin = preBegin - depth_[regionRoot];
+  size_t leafBegin = leavesBegin_[regionRoot];
+  size_t leafEnd = leavesEnd_[regionRoot];
+  unsigned int topDepth = depth_[regionRoot];
+  vector<Graph::NodeId> ancestors;
+  if (topDepth > 0)
+    for (Graph::NodeId node = father_[regionRoot]; node != NONE; node = father_[node])
+      ancestors.push_back(node);
+
+  vector<Graph::NodeId> preOrder;
+  vector<Graph::NodeId> postOrder;
+  vector<Graph::NodeId> leaves;
+  preOrder.reserve(regionSize);
+  postOrder.reserve(regionSize);
+
+  // Expanded nodes are browsed depth-first, with their sons and the
+  // position of the next son to visit.
+  struct Visit
+  {
+    Graph::NodeId node;
+    vector<Graph::NodeId> sons;
+    vector<Graph::EdgeId> branches;
+    size_t next;
+  };
+  vector<Visit> toVisit;
+
+  Graph::NodeId node = top;
+  unsigned int depth = topDepth;
+  while (true)
+  {
+    if (node != NONE)
+    {
+      // way down in an expanded node
+      preIndex_[node] = preBegin + preOrder.size();
+      preOrder.push_back(node);
+      depth_[node] = depth;
+      leavesBegin_[node] = leafBegin + leaves.size();
+      Visit visit = { node, tree.getOutgoingNeighbors(node), tree.getOutgoingEdges(node), 0 };
+      if (visit.sons.empty())
+        leaves.push_back(node);
+      toVisit.push_back(visit);
+      node = NONE;
+    }
+    if (toVisit.empty())
+      break;
+
+    Visit& visit = toVisit.back();
+    if (visit.next == visit.sons.size())
+    {
+      // way up
+      subtreeEnd_[visit.node] = preBegin + preOrder.size();
+      leavesEnd_[visit.node] = leafBegin + leaves.size();
+      postOrder.push_back(visit.node);
+      toVisit.pop_back();
+      continue;
+    }
+
+    Graph::NodeId son = visit.sons[visit.next];
+    father_[son] = visit.node;
+    edgeToFather_[son] = visit.branches[visit.next];
+    visit.next++;
+    depth = depth_[visit.node] + 1;
+    if (binary_search(expanded.begin(), expanded.end(), son))
+    {
+      node = son;
+      continue;
+    }
+
+    // an unchanged subtree, moved as a block
+    size_t begin = preIndex_[son];
+    size_t end = subtreeEnd_[son];
+    size_t postStart = begin - depth_[son];
+    size_t sonLeavesBegin = leavesBegin_[son];
+    size_t sonLeavesEnd = leavesEnd_[son];
+    size_t preShift = preBegin + preOrder.size() - begin;
+    size_t leafShift = leafBegin + leaves.size() - sonLeavesBegin;
+    unsigned int depthShift = depth - depth_[son];
+    // shifts may be negative, modulo arithmetic on unsigned values
+    for (size_t i = begin; i < end; i++)
+    {
+      Graph::NodeId blockNode = preOrder_[i];
+      preIndex_[blockNode] += preShift;
+      subtreeEnd_[blockNode] += preShift;
+      depth_[blockNode] += depthShift;
+      leavesBegin_[blockNode] += leafShift;
+      leavesEnd_[blockNode] += leafShift;
+    }
+    preOrder.insert(preOrder.end(), preOrder_.begin() + static_cast<ptrdiff_t>(begin), preOrder_.begin() + static_cast<ptrdiff_t>(end));
+    postOrder.insert(postOrder.end(), postOrder_.begin() + static_cast<ptrdiff_t>(postStart), postOrder_.begin() + static_cast<ptrdiff_t>(postStart + end - begin));
+    leaves.insert(leaves.end(), leaves_.begin() + static_cast<ptrdiff_t>(sonLeavesBegin), leaves_.begin() + static_cast<ptrdiff_t>(sonLeavesEnd));
+  }
+
+  copy(preOrder.begin(), preOrder.end(), preOrder_.begin() + static_cast<ptrdiff_t>(preBegin));
+  copy(postOrder.begin(), postOrder.end(), postOrder_.begin() + static_cast<ptrdiff_t>(postBegin));
+
+  // a node may have become a leaf, or stopped being one
+  if (leaves.size() == leafEnd - leafBegin)
+    copy(leaves.begin(), leaves.end(), leaves_.begin() + static_cast<ptrdiff_t>(leafBegin));
+  else
+  {
+    leaves_.erase(leaves_.begin() + static_cast<ptrdiff_t>(leafBegin), leaves_.begin() + static_cast<ptrdiff_t>(leafEnd));
+    leaves_.insert(leaves_.begin() + static_cast<ptrdiff_t>(leafBegin), leaves.begin(), leaves.end());
+    size_t leafShift = leaves.size() - (leafEnd - leafBegin);
+    for (size_t i = preBegin + regionSize; i < preOrder_.size(); i++)
+    {
+      leavesBegin_[preOrder_[i]] += leafShift;
+      leavesEnd_[preOrder_[i]] += leafShift;
+    }
+    for (auto ancestor : ancestors)
+      leavesEnd_[ancestor] += leafShift;
+  }
+
+  minDepthTable_.clear();
+  log2_.clear();
+}
+
+void TreeIndex::reroot(const Graph& tree, Graph::NodeId newRoot)
+{
+  vector<Graph::NodeId> path;
+  for (Graph::NodeId node = checkNode_(newRoot); node != NONE; node = father_[node])
+    path.push_back(node);
+  Graph::NodeId formerRoot = path.back();
+  sort(path.begin(), path.end());
+
+  relayout_(tree, formerRoot, newRoot, path);
+  father_[newRoot] = NONE;
+  edgeToFather_[newRoot] = NONE;
+  root_ = newRoot;
+}
+
+void TreeIndex::moveSubtree(const Graph& tree, Graph::NodeId node)
+{
+  vector<Graph::NodeId> fathers = tree.getIncomingNeighbors(checkNode_(node));
+  if (fathers.size() != 1)
+    throw Exception("TreeIndex::moveSubtree: node " + TextTools::toString(node) + " must have one father.");
+  Graph::NodeId nodeA = checkNode_(father_[node]);
+  Graph::NodeId nodeB = checkNode_(fathers[0]);
+  if (isAncestor(node, nodeB))
+    throw Exception("TreeIndex::moveSubtree: node " + TextTools::toString(node) + " cannot be moved under its subtree.");
+
+  // the paths from both fathers to their MRCA
+  vector<Graph::NodeId> expanded;
+  while (nodeA != nodeB)
+  {
+    if (depth_[nodeA] >= depth_[nodeB])
+    {
+      expanded.push_back(nodeA);
+      nodeA = father_[nodeA];
+    }
+    else
+    {
+      expanded.push_back(nodeB);
+      nodeB = father_[nodeB];
+    }
+  }
+  expanded.push_back(nodeA);
+  sort(expanded.begin(), expanded.end());
+
+  relayout_(tree, nodeA, nodeA, expanded);
+}
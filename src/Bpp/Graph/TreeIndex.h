@@ -0,0 +1,254 @@
+//
+// File: TreeIndex.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for graphs. This file belongs to the Bio++ Project.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _TREE_INDEX_H_
+#define _TREE_INDEX_H_
+
+#include "Graph.h"
+
+// From the STL:
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief An index of a rooted tree, for constant time queries.
+ *
+ * The index is a snapshot of the topology of a tree, built in linear
+ * time from its root, and holding:
+ * - the father of each node, and the branch leading to it;
+ * - the depth of each node, in number of branches from the root;
+ * - the nodes in preorder and postorder, sons being met in the order of
+ *   the graph. The nodes of a subtree are contiguous in preorder, so
+ *   ancestor tests are two comparisons;
+ * - the leaves in preorder, with the range of the leaves under each node;
+ * - optionally, a sparse table for range minimum queries on depths along
+ *   the preorder, so that the MRCA of two nodes is found in constant time.
+ *
+ * Node ids are used as indices in arrays, which are as large as the highest
+ * node id of the tree.
+ *
+ * The index does not follow the modifications of the tree. It has to be
+ * built again, except after a rerooting or a subtree move, which can be
+ * applied to it with reroot() and moveSubtree().
+ *
+ * @see TreeGraphImpl, which builds it when needed.
+ */
+class TreeIndex
+{
+public:
+  /**
+   * Value of the ids of missing nodes and branches (eg the father of the root).
+   */
+  static const Graph::NodeId NONE;
+
+private:
+  Graph::NodeId root_;
+
+  std::vector<Graph::NodeId> father_;
+  std::vector<Graph::EdgeId> edgeToFather_;
+  std::vector<unsigned int> depth_;
+
+  std::vector<Graph::NodeId> preOrder_;
+  std::vector<Graph::NodeId> postOrder_;
+
+  /**
+   * Position of each node in preorder, and position past its subtree.
+   */
+  std::vector<size_t> preIndex_;
+  std::vector<size_t> subtreeEnd_;
+
+  /**
+   * Leaves in preorder, and range of the leaves under each node.
+   */
+  std::vector<Graph::NodeId> leaves_;
+  std::vector<size_t> leavesBegin_;
+  std::vector<size_t> leavesEnd_;
+
+  /**
+   * @name Sparse table for MRCA queries.
+   *
+   * Level k holds, for each preorder position i, the node of minimal
+   * depth among the positions [i, i + 2^k[.
+   * @{
+   */
+  std::vector<std::vector<Graph::NodeId> > minDepthTable_;
+  std::vector<unsigned char> log2_;
+  /** @} */
+
+public:
+  TreeIndex();
+
+  /**
+   * @brief Build the index of a rooted tree.
+   *
+   * The sparse table for MRCA queries is not built.
+   *
+   * @param tree a graph which is a tree directed from its root.
+   * @throw Exception if a node is met more than once from the root.
+   */
+  void build(const Graph& tree);
+
+  /**
+   * @brief Build the sparse table for MRCA queries, in O(n log n).
+   */
+  void buildMRCATable();
+
+  bool hasMRCATable() const { return !minDepthTable_.empty() || preOrder_.size() == 1; }
+
+  /**
+   * @brief Free the memory of the index.
+   */
+  void clear();
+
+  /**
+   * @name Incremental updates.
+   *
+   * These functions follow a modification of the tree that keeps it a
+   * rooted tree with the same nodes. Only the nodes whose sons changed
+   * are browsed in the tree, the other subtrees are moved as blocks in
+   * the arrays of the index. The MRCA table is dropped.
+   * @{
+   */
+
+  /**
+   * @brief Update the index once the tree has been rerooted at a node, by
+   * reversing the branches from this node to the former root.
+   *
+   * The nodes of the path are browsed in the tree, and the arrays of the
+   * index are rewritten in linear time.
+   */
+  void reroot(const Graph& tree, Graph::NodeId newRoot);
+
+  /**
+   * @brief Update the index once a subtree has been moved to a new father
+   * (SPR move, an NNI being two such moves).
+   *
+   * The paths from the former and the new fathers to their MRCA are
+   * browsed in the tree, and only the subtree of this MRCA is rewritten.
+   *
+   * @param tree the modified tree
+   * @param node the root of the moved subtree
+   */
+  void moveSubtree(const Graph& tree, Graph::NodeId node);
+  /** @} */
+
+  Graph::NodeId getRoot() const { return root_; }
+
+  size_t getNumberOfNodes() const { return preOrder_.size(); }
+
+  /**
+   * @return true if the node is in the index.
+   */
+  bool hasNode(Graph::NodeId node) const { return node < preIndex_.size() && preIndex_[node] != NONE; }
+
+  bool hasFather(Graph::NodeId node) const { return father_[checkNode_(node)] != NONE; }
+
+  /**
+   * @return the father of a node, NONE for the root.
+   */
+  Graph::NodeId getFather(Graph::NodeId node) const { return father_[checkNode_(node)]; }
+
+  /**
+   * @return the branch to the father of a node, NONE for the root.
+   */
+  Graph::EdgeId getEdgeToFather(Graph::NodeId node) const { return edgeToFather_[checkNode_(node)]; }
+
+  unsigned int getDepth(Graph::NodeId node) const { return depth_[checkNode_(node)]; }
+
+  const std::vector<Graph::NodeId>& getPreOrder() const { return preOrder_; }
+
+  const std::vector<Graph::NodeId>& getPostOrder() const { return postOrder_; }
+
+  /**
+   * @return the position of a node in preorder.
+   */
+  size_t getPreOrderIndex(Graph::NodeId node) const { return preIndex_[checkNode_(node)]; }
+
+  /**
+   * @return the position past the subtree of a node in preorder, so that
+   * the subtree is [getPreOrderIndex(node), getSubtreeEnd(node)[.
+   */
+  size_t getSubtreeEnd(Graph::NodeId node) const { return subtreeEnd_[checkNode_(node)]; }
+
+  size_t getSubtreeSize(Graph::NodeId node) const { return subtreeEnd_[checkNode_(node)] - preIndex_[node]; }
+
+  /**
+   * @return true if ancestor is on the path from node to the root,
+   * node included.
+   */
+  bool isAncestor(Graph::NodeId ancestor, Graph::NodeId node) const
+  {
+    size_t pos = preIndex_[checkNode_(node)];
+    return preIndex_[checkNode_(ancestor)] <= pos && pos < subtreeEnd_[ancestor];
+  }
+
+  /**
+   * @return the leaves (nodes with no son) in preorder.
+   */
+  const std::vector<Graph::NodeId>& getLeaves() const { return leaves_; }
+
+  /**
+   * @return the range of the leaves under a node, in getLeaves().
+   * @{
+   */
+  size_t getLeavesBegin(Graph::NodeId node) const { return leavesBegin_[checkNode_(node)]; }
+  size_t getLeavesEnd(Graph::NodeId node) const { return leavesEnd_[checkNode_(node)]; }
+  /** @} */
+
+  /**
+   * @return the most recent common ancestor of two nodes.
+   * @throw Exception if the sparse table was not built.
+   */
+  Graph::NodeId MRCA(Graph::NodeId nodeA, Graph::NodeId nodeB) const;
+
+private:
+  Graph::NodeId checkNode_(Graph::NodeId node) const;
+
+  /**
+   * Rewrite the part of the index covering the subtree of regionRoot,
+   * which holds the same nodes after the modification, now in the
+   * subtree of top. The sons of the expanded nodes (sorted) are read in
+   * the tree, the other subtrees are unchanged.
+   */
+  void relayout_(const Graph& tree, Graph::NodeId regionRoot, Graph::NodeId top, const std::vector<Graph::NodeId>& expanded);
+};
+} // end of namespace bpp.
+
+#endif // _TREE_INDEX_H_
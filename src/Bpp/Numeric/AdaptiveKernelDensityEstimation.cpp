@@ -40,11 +40,19 @@ knowledge of the CeCILL license and that you accept its terms.
 #include "AdaptiveKernelDensityEstimation.h"
 #include "Matrix/MatrixTools.h"
 #include "NumConstants.h"
+#include "VectorExceptions.h"
+#include "../Utils/ThreadTools.h"
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
 
 using namespace bpp;
 using namespace std;
 
-void AdaptiveKernelDensityEstimation::init_()
+const size_t AdaptiveKernelDensityEstimation::LEAF_SIZE = 32;
+
+void AdaptiveKernelDensityEstimation::init_(unsigned int nbThreads)
 {
   //Compute the covariance matrix of the sample:
   MatrixTools::covar(x_, covar_);
@@ -57,44 +65,64 @@ void AdaptiveKernelDensityEstimation::init_()
 
   //Compute the bandwidth:
   h_ = std::pow(4. / ((2 * static_cast<double>(r_) + 1.) * static_cast<double>(n_)), 1. / (static_cast<double>(r_) + 4.));
-  //Compute as much as we can in advance to simplify the density calculation:
+  //Compute as much as we can in advance to simplify the density calculation,
+  //including the normalizing constant of the kernel:
   c1_ = 1. / (std::sqrt(MatrixTools::det(covar_)) * static_cast<double>(n_) * std::pow(h_, static_cast<int>(r_)));
-  
-  //Now compute the local tuning of the bandwidth.
-  //First estimate the pilot density:
-  vector<double> xi(r_);
-  LinearMatrix<double> diff_xi(r_, 1);
-  LinearMatrix<double>  std_xi(r_, 1);
-  for (unsigned int i = 0; i < n_; i++)
-  {
-    //Get the current xi point to evaluate:
-    for(unsigned int k = 0; k < r_; k++)
-      xi[k] = x_(k, i);
-     
-    //Sum loop, over all xi's:
-    double sum = 0;
-    for (unsigned int j = 0; j < n_; j++)
+  c1_ *= std::pow(2. * NumConstants::PI(), -static_cast<double>(r_) / 2.);
+
+  //Whiten the sample once for all:
+  whitening_.resize(r_ * r_);
+  for (size_t k = 0; k < r_; k++)
+    for (size_t l = 0; l < r_; l++)
+      whitening_[k * r_ + l] = invSqrtCovar_(k, l);
+  z_.assign(n_ * r_, 0);
+  for (size_t i = 0; i < n_; i++)
+    for (size_t k = 0; k < r_; k++)
     {
-      for (unsigned int k = 0; k < r_; k++)
-        diff_xi(k, 0) = xi[k] - x_(k, j);
-      MatrixTools::mult(invSqrtCovar_, diff_xi, std_xi);
-      MatrixTools::scale(std_xi, 1. / h_);
-      sum += kernel_(std_xi);
+      double z = 0;
+      for (size_t l = 0; l < r_; l++)
+        z += whitening_[k * r_ + l] * (x_(l, i) - xMean_[l]);
+      z_[i * r_ + k] = z;
     }
-    pilot_[i] = c1_ * sum;
+
+  //Build the tree, and store the whitened points in tree order:
+  nodes_.clear();
+  boxes_.clear();
+  if (n_ > 0)
+  {
+    vector<size_t> index(n_);
+    for (size_t i = 0; i < n_; i++)
+      index[i] = i;
+    buildTree_(index, 0, n_);
+    vector<double> z(n_ * r_);
+    for (size_t i = 0; i < n_; i++)
+      copy(z_.begin() + static_cast<ptrdiff_t>(index[i] * r_), z_.begin() + static_cast<ptrdiff_t>((index[i] + 1) * r_), z.begin() + static_cast<ptrdiff_t>(i * r_));
+    z_.swap(z);
   }
 
+  //Now compute the local tuning of the bandwidth.
+  //First estimate the pilot density, with a constant bandwidth:
+  fill(lambda_.begin(), lambda_.end(), 1.);
+  fill(c2_.begin(), c2_.end(), 1.);
+  updateNodes_();
+  ThreadTools::parallelFor((n_ + LEAF_SIZE - 1) / LEAF_SIZE, nbThreads, [&](size_t b, unsigned int) {
+      vector<size_t> stack;
+      for (size_t i = b * LEAF_SIZE; i < min(n_, (b + 1) * LEAF_SIZE); i++)
+        pilot_[i] = c1_ * kernelSum_(&z_[i * r_], stack);
+    });
+
   //Compute the tuning parameters:
   double g = 0;
-  for (unsigned int i = 0; i < n_; i++)
+  for (size_t i = 0; i < n_; i++)
     g += std::log(pilot_[i]);
   g = std::exp(g / static_cast<double>(n_));
-  for (unsigned int i = 0; i < n_; i++)
+  for (size_t i = 0; i < n_; i++)
     lambda_[i] = std::pow(g / pilot_[i], gamma_);
 
   //Compute as much as we can in advance to simplify the density calculation:
-  for (unsigned int i = 0; i < n_; i++)
+  for (size_t i = 0; i < n_; i++)
     c2_[i] = std::pow(lambda_[i], - static_cast<double>(r_));
+  updateNodes_();
 }
 
 void AdaptiveKernelDensityEstimation::sampleMean_(const Matrix<double>& x, std::vector<double>& mean)
@@ -111,31 +139,228 @@ void AdaptiveKernelDensityEstimation::sampleMean_(const Matrix<double>& x, std::
   }
 }
 
-double AdaptiveKernelDensityEstimation::kernel_(const Matrix<double>& x)
+size_t AdaptiveKernelDensityEstimation::buildTree_(std::vector<size_t>& index, size_t begin, size_t end)
 {
-  //x is supposed to have only one column and r_ rows.
-  //We compute the scalar product of the column with itself:
-  double scalar = 0;
-  for (size_t i = 0; i < r_; i++)
-    scalar += std::pow(x(i, 0), 2.);
+  size_t id = nodes_.size();
+  nodes_.push_back(Node(begin, end));
+  size_t offset = boxes_.size();
+  boxes_.resize(offset + 2 * r_);
+  for (size_t k = 0; k < r_; k++)
+  {
+    double lo = z_[index[begin] * r_ + k];
+    double hi = lo;
+    for (size_t i = begin + 1; i < end; i++)
+    {
+      double z = z_[index[i] * r_ + k];
+      lo = min(lo, z);
+      hi = max(hi, z);
+    }
+    boxes_[offset + k] = lo;
+    boxes_[offset + r_ + k] = hi;
+  }
+  if (end - begin <= LEAF_SIZE)
+    return id;
+
+  //Split at the median of the widest dimension:
+  size_t dim = 0;
+  for (size_t k = 1; k < r_; k++)
+    if (boxes_[offset + r_ + k] - boxes_[offset + k] > boxes_[offset + r_ + dim] - boxes_[offset + dim])
+      dim = k;
+  size_t mid = begin + (end - begin) / 2;
+  nth_element(index.begin() + static_cast<ptrdiff_t>(begin), index.begin() + static_cast<ptrdiff_t>(mid), index.begin() + static_cast<ptrdiff_t>(end),
+      [&](size_t i, size_t j) { return z_[i * r_ + dim] < z_[j * r_ + dim]; });
+  size_t left = buildTree_(index, begin, mid);
+  size_t right = buildTree_(index, mid, end);
+  nodes_[id].left = left;
+  nodes_[id].right = right;
+  return id;
+}
+
+void AdaptiveKernelDensityEstimation::updateNodes_()
+{
+  invBandwidth2_.resize(n_);
+  for (size_t i = 0; i < n_; i++)
+    invBandwidth2_[i] = 1. / (h_ * h_ * lambda_[i] * lambda_[i]);
+  centers_.assign(nodes_.size() * r_, 0);
 
-  return std::pow(2. * NumConstants::PI(), -static_cast<double>(r_) / 2.) * std::exp(-0.5 * scalar);
+  //Children are always created after their parent:
+  for (size_t id = nodes_.size(); id > 0; id--)
+  {
+    Node& node = nodes_[id - 1];
+    double* center = &centers_[(id - 1) * r_];
+    if (node.left == 0)
+    {
+      node.weight = 0;
+      node.lambdaWeight = 0;
+      node.minLambda = lambda_[node.begin];
+      node.maxLambda = lambda_[node.begin];
+      for (size_t i = node.begin; i < node.end; i++)
+      {
+        double a = c2_[i] / (lambda_[i] * lambda_[i]);
+        node.weight += c2_[i];
+        node.lambdaWeight += a;
+        node.minLambda = min(node.minLambda, lambda_[i]);
+        node.maxLambda = max(node.maxLambda, lambda_[i]);
+        for (size_t k = 0; k < r_; k++)
+          center[k] += a * z_[i * r_ + k];
+      }
+      for (size_t k = 0; k < r_; k++)
+        center[k] /= node.lambdaWeight;
+      node.spread = 0;
+      for (size_t i = node.begin; i < node.end; i++)
+      {
+        double d2 = 0;
+        for (size_t k = 0; k < r_; k++)
+          d2 += (z_[i * r_ + k] - center[k]) * (z_[i * r_ + k] - center[k]);
+        node.spread += c2_[i] / (lambda_[i] * lambda_[i]) * d2;
+      }
+    }
+    else
+    {
+      const Node& left = nodes_[node.left];
+      const Node& right = nodes_[node.right];
+      const double* cl = &centers_[node.left * r_];
+      const double* cr = &centers_[node.right * r_];
+      node.weight = left.weight + right.weight;
+      node.lambdaWeight = left.lambdaWeight + right.lambdaWeight;
+      node.minLambda = min(left.minLambda, right.minLambda);
+      node.maxLambda = max(left.maxLambda, right.maxLambda);
+      double dl2 = 0;
+      double dr2 = 0;
+      for (size_t k = 0; k < r_; k++)
+      {
+        center[k] = (left.lambdaWeight * cl[k] + right.lambdaWeight * cr[k]) / node.lambdaWeight;
+        dl2 += (cl[k] - center[k]) * (cl[k] - center[k]);
+        dr2 += (cr[k] - center[k]) * (cr[k] - center[k]);
+      }
+      node.spread = left.spread + left.lambdaWeight * dl2 + right.spread + right.lambdaWeight * dr2;
+    }
+  }
 }
 
-double AdaptiveKernelDensityEstimation::kDensity(const std::vector<double>& x)
+double AdaptiveKernelDensityEstimation::kernelSum_(const double* q, std::vector<size_t>& stack) const
 {
-  LinearMatrix<double> diff_xi(r_, 1);
-  LinearMatrix<double> std_xi(r_, 1);
-  //Sum loop, over all xi's:
+  //Squared distance between the query point and the bounding box of a node:
+  auto minDist2 = [&](size_t id) {
+      const double* box = &boxes_[id * 2 * r_];
+      double d2 = 0;
+      for (size_t k = 0; k < r_; k++)
+      {
+        double d = max(max(box[k] - q[k], q[k] - box[r_ + k]), 0.);
+        d2 += d * d;
+      }
+      return d2;
+    };
+
+  //The error of an approximated node is bounded by half the gap between its bounds.
+  //The gap must not exceed the tolerance times the lower bound of the node, plus its share
+  //of the lower bound of the sum computed so far. Nearest nodes are visited first,
+  //so that far nodes can be truncated.
+  double h2 = h_ * h_;
+  double totalWeight = nodes_[0].weight;
   double sum = 0;
-  for(unsigned int j = 0; j < n_; j++)
+  double lowerSum = 0;
+  stack.clear();
+  stack.push_back(0);
+  while (!stack.empty())
   {
-    for(unsigned int k = 0; k < r_; k++)
-      diff_xi(k, 0) = x[k] - x_(k, j);
-    MatrixTools::mult(invSqrtCovar_, diff_xi, std_xi);
-    MatrixTools::scale(std_xi, 1. / (h_ * lambda_[j]));
-    sum += kernel_(std_xi) * c2_[j];
+    size_t id = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[id];
+    const double* box = &boxes_[id * 2 * r_];
+    const double* center = &centers_[id * r_];
+    double dmin2 = 0;
+    double dmax2 = 0;
+    double dc2 = 0;
+    for (size_t k = 0; k < r_; k++)
+    {
+      double dlo = q[k] - box[k];
+      double dhi = box[r_ + k] - q[k];
+      double d = max(max(-dlo, -dhi), 0.);
+      dmin2 += d * d;
+      d = max(fabs(dlo), fabs(dhi));
+      dmax2 += d * d;
+      d = q[k] - center[k];
+      dc2 += d * d;
+    }
+    double sLo = dmin2 / (h2 * node.maxLambda * node.maxLambda);
+    double sHi = dmax2 / (h2 * node.minLambda * node.minLambda);
+    double sBar = min(max((node.lambdaWeight * dc2 + node.spread) / (h2 * node.weight), sLo), sHi);
+    double fHi = exp(-0.5 * sLo);
+    double fLo = exp(-0.5 * sHi);
+    //The kernel is convex in s, hence the Jensen lower bound and the chord upper bound:
+    double lower = node.weight * exp(-0.5 * sBar);
+    double upper = sHi > sLo ? node.weight * (fHi * (sHi - sBar) + fLo * (sBar - sLo)) / (sHi - sLo) : node.weight * fHi;
+    if (upper - lower <= tolerance_ * (lower + node.weight / totalWeight * lowerSum))
+    {
+      sum += 0.5 * (lower + upper);
+      lowerSum += lower;
+    }
+    else if (node.left == 0)
+    {
+      double s = 0;
+      for (size_t i = node.begin; i < node.end; i++)
+      {
+        const double* z = &z_[i * r_];
+        double d2 = 0;
+        for (size_t k = 0; k < r_; k++)
+          d2 += (q[k] - z[k]) * (q[k] - z[k]);
+        s += c2_[i] * exp(-0.5 * d2 * invBandwidth2_[i]);
+      }
+      sum += s;
+      lowerSum += s;
+    }
+    else if (minDist2(node.left) <= minDist2(node.right))
+    {
+      stack.push_back(node.right);
+      stack.push_back(node.left);
+    }
+    else
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
   }
-  return c1_ * sum;  
+  return sum;
+}
+
+double AdaptiveKernelDensityEstimation::kDensity(const std::vector<double>& x) const
+{
+  if (x.size() != r_)
+    throw DimensionException("AdaptiveKernelDensityEstimation::kDensity. Wrong dimension for the query point.", x.size(), r_);
+  if (n_ == 0)
+    return 0;
+  vector<double> q(r_);
+  for (size_t k = 0; k < r_; k++)
+    for (size_t l = 0; l < r_; l++)
+      q[k] += whitening_[k * r_ + l] * (x[l] - xMean_[l]);
+  vector<size_t> stack;
+  return c1_ * kernelSum_(&q[0], stack);
+}
+
+void AdaptiveKernelDensityEstimation::kDensities(const Matrix<double>& x, std::vector<double>& densities, unsigned int nbThreads) const
+{
+  if (x.getNumberOfRows() != r_)
+    throw DimensionException("AdaptiveKernelDensityEstimation::kDensities. Wrong dimension for the query points.", x.getNumberOfRows(), r_);
+  size_t m = x.getNumberOfColumns();
+  densities.assign(m, 0);
+  if (n_ == 0)
+    return;
+  //Points are evaluated by blocks, to share the working buffers:
+  size_t blockSize = 256;
+  ThreadTools::parallelFor((m + blockSize - 1) / blockSize, nbThreads, [&](size_t b, unsigned int) {
+      vector<double> q(r_);
+      vector<size_t> stack;
+      for (size_t i = b * blockSize; i < min(m, (b + 1) * blockSize); i++)
+      {
+        for (size_t k = 0; k < r_; k++)
+        {
+          q[k] = 0;
+          for (size_t l = 0; l < r_; l++)
+            q[k] += whitening_[k * r_ + l] * (x(l, i) - xMean_[l]);
+        }
+        densities[i] = c1_ * kernelSum_(&q[0], stack);
+      }
+    });
 }
 
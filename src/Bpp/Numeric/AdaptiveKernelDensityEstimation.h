@@ -42,6 +42,9 @@
 
 #include "Matrix/Matrix.h"
 
+// From the STL:
+#include <vector>
+
 namespace bpp
 {
 
@@ -53,11 +56,48 @@ namespace bpp
  * The source for this method can be found is the appendix of the following paper:
  * Ivan Kojadinovic, _Computational Statistics and Data Analaysis_ (2004), 46:269-294 
  *
+ * The sample points are whitened once, using the inverse square root of the
+ * covariance matrix, and stored contiguously in the leaves of a KD-tree.
+ * Each node of the tree holds the bounding box of its points, their range of local
+ * bandwidths and the moments of their kernel weights. When evaluating a density,
+ * nodes are visited from the nearest to the farthest, and the contribution of a
+ * whole node is approximated when its lower and upper bounds are close enough.
+ * The kernel is hence only evaluated for the points close to the query point, and
+ * far nodes are truncated. The tolerance sets the maximum relative error of the
+ * density, a tolerance of 0 leading to the exact sum over all sample points.
+ * As the local bandwidths depend on the pilot density, which is estimated with the
+ * same tolerance, the error relative to the exact estimator can be larger in the tails.
+ * Densities for a batch of points can be evaluated in parallel with kDensities().
+ *
  * @author Julien Dutheil
  */
   class AdaptiveKernelDensityEstimation
   {
   private:
+    /**
+     * @brief A node of the KD-tree.
+     *
+     * Nodes hold the points [begin, end[ of the tree order. Internal nodes have two children.
+     * weight is the sum of the kernel weights w of the points, lambdaWeight the sum of
+     * w / lambda^2, center and spread the mean and sum of squared deviations
+     * of the points, weighted by w / lambda^2.
+     */
+    struct Node
+    {
+      size_t begin;
+      size_t end;
+      size_t left;
+      size_t right;
+      double weight;
+      double lambdaWeight;
+      double spread;
+      double minLambda;
+      double maxLambda;
+
+      Node(size_t b, size_t e):
+        begin(b), end(e), left(0), right(0), weight(0), lambdaWeight(0), spread(0), minLambda(0), maxLambda(0) {}
+    };
+
     RowMatrix<double> x_; //The original sample
     size_t n_;
     size_t r_;
@@ -65,11 +105,20 @@ namespace bpp
     RowMatrix<double> invSqrtCovar_; //The inverse of the square root of the covariance matrix, used for the linear transformation
     std::vector<double> xMean_;
     double gamma_; //Tune the effect of the pilot density.
+    double tolerance_; //The maximum relative error of the density.
     double c1_;
-    std::vector<double> c2_;
+    std::vector<double> c2_; //In tree order.
     double h_; //The bandwidth.
-    std::vector<double> lambda_; //The local tuning coefficient of the bandwidth.
-    std::vector<double> pilot_; //The pilot density
+    std::vector<double> lambda_; //The local tuning coefficient of the bandwidth, in tree order.
+    std::vector<double> pilot_; //The pilot density, in tree order.
+    std::vector<double> whitening_; //invSqrtCovar_, row-major.
+    std::vector<double> z_; //The whitened sample, centered, one row of r_ values per point, in tree order.
+    std::vector<double> invBandwidth2_; //1 / (h lambda)^2, in tree order.
+    std::vector<Node> nodes_;
+    std::vector<double> boxes_; //For each node, the r_ lower bounds followed by the r_ upper bounds.
+    std::vector<double> centers_; //For each node, the r_ coordinates of the center.
+
+    static const size_t LEAF_SIZE;
 
   public:
     /**
@@ -80,14 +129,19 @@ namespace bpp
      * maximizes the impact of the pilot density, and hence corresponds to the standard
      * Kernel Density Estimation method. A value in ]0,1] allows a local adjustement of
      * the bandwith. The 0.5 value is commonly used.
+     * @param tolerance The maximum relative error of the estimated densities,
+     * including the pilot density. The default 0 gives the exact estimator.
+     * @param nbThreads The maximum number of threads used to compute the pilot density
+     * (0 means all available threads).
      */
-    AdaptiveKernelDensityEstimation(const Matrix<double>& x, double gamma = 0.5):
+    AdaptiveKernelDensityEstimation(const Matrix<double>& x, double gamma = 0.5, double tolerance = 0, unsigned int nbThreads = 1):
       x_(x), n_(x.getNumberOfColumns()), r_(x.getNumberOfRows()),
-      covar_(), invSqrtCovar_(), xMean_(), gamma_(gamma),
+      covar_(), invSqrtCovar_(), xMean_(), gamma_(gamma), tolerance_(tolerance),
       c1_(0), c2_(x.getNumberOfColumns()), h_(0),
-      lambda_(x.getNumberOfColumns()), pilot_(x.getNumberOfColumns())
+      lambda_(x.getNumberOfColumns()), pilot_(x.getNumberOfColumns()),
+      whitening_(), z_(), invBandwidth2_(), nodes_(), boxes_(), centers_()
     {
-      init_();
+      init_(nbThreads);
     }
     virtual ~AdaptiveKernelDensityEstimation() {}
 
@@ -97,23 +151,46 @@ namespace bpp
      * @return The value of the estimated density for point x.
      * @param x The point where to estimate the density.
      */
-    double kDensity(const std::vector<double>& x);
+    double kDensity(const std::vector<double>& x) const;
+
+    /**
+     * @brief Estimate the density for a batch of points.
+     *
+     * @param x A matrix containing the points, one point per column, as for the sample.
+     * @param densities [out] The estimated densities, one per column of x.
+     * @param nbThreads The maximum number of threads to use (0 means all available threads).
+     */
+    void kDensities(const Matrix<double>& x, std::vector<double>& densities, unsigned int nbThreads = 1) const;
+
+    /**
+     * @brief Set the maximum relative error of the densities estimated from now on.
+     *
+     * The pilot density is not recomputed.
+     */
+    void setTolerance(double tolerance) { tolerance_ = tolerance; }
+
+    double getTolerance() const { return tolerance_; }
 
   private:
-    void init_();
+    void init_(unsigned int nbThreads);
 
     void sampleMean_(const Matrix<double>& x, std::vector<double>& mean);
-    
+
+    size_t buildTree_(std::vector<size_t>& index, size_t begin, size_t end);
+
     /**
-     * @brief The kernel function.
-     *
-     * For now a standard normal density is used, further options may be added later,
-     * including the possibility to use your own function.
-     *
-     * @param x The point for which to compute the density, as a matrix with 1 column and r_ rows.
-     * @return The value of the kernel function at the corresponding point.
+     * @brief Compute the bandwidth bounds and the weight moments of all nodes,
+     * from lambda_ and c2_.
+     */
+    void updateNodes_();
+
+    /**
+     * @return The sum over all sample points of the kernel weights times the
+     * standard normal kernel, without its normalizing constant.
+     * @param q The whitened query point.
+     * @param stack A working buffer.
      */
-    double kernel_(const Matrix<double>& x);
+    double kernelSum_(const double* q, std::vector<size_t>& stack) const;
 
   };
 
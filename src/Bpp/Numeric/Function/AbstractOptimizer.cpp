@@ -38,6 +38,7 @@
 */
 
 #include "AbstractOptimizer.h"
+#include "CheckpointListener.h"
 #include "../AutoParameter.h"
 #include "../../Text/TextTools.h"
 #include "../../App/ApplicationTools.h"
@@ -59,7 +60,7 @@ AbstractOptimizer::AbstractOptimizer(Function* function):
   constraintPolicy_(AutoParameter::CONSTRAINTS_KEEP),
   stopCondition_(0), defaultStopCondition_(0),
   verbose_(true), isInitialized_(false), startTime_(), listeners_(),
-  updateParameters_(false), stepChar_("*"),
+  updateParameters_(false), stepChar_("*"), metrics_(0),
   nbEvalMax_(1000000), nbEval_(0),
   currentValue_(0), tolIsReached_(false)
 {
@@ -80,6 +81,7 @@ AbstractOptimizer::AbstractOptimizer(const AbstractOptimizer& opt):
   listeners_(), //We do not copy listeners!
   updateParameters_(opt.updateParameters_),
   stepChar_(opt.stepChar_),
+  metrics_(0), //Metrics are bound to an instance, like listeners.
   nbEvalMax_(opt.nbEvalMax_),
   nbEval_(opt.nbEval_),
   currentValue_(opt.currentValue_),
@@ -145,6 +147,7 @@ AbstractOptimizer& AbstractOptimizer::operator=(const AbstractOptimizer& opt)
   listeners_.resize(0); //Reset listener list, do not copy it!
   updateParameters_       = opt.updateParameters_;
   stepChar_               = opt.stepChar_;
+  metrics_                = 0;
   return *this;
 }
 
@@ -153,6 +156,7 @@ AbstractOptimizer& AbstractOptimizer::operator=(const AbstractOptimizer& opt)
 void AbstractOptimizer::init(const ParameterList& params)
 {
   if (!function_) throw Exception("AbstractOptimizer::init. Optimizer currently has no function.");
+  OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::INITIALIZATION);
   //We do this in order to keep original constraints:
   parameters_ = params;
   //More secure, but too slow:
@@ -185,11 +189,29 @@ void AbstractOptimizer::init(const ParameterList& params)
 
 /******************************************************************************/
 
+bool AbstractOptimizer::initFromCheckpoint(const std::string& checkpointFile, const ParameterList& params)
+{
+  ParameterList pl(params);
+  bool restored = CheckpointListener::restoreParameters(checkpointFile, pl);
+  init(pl);
+  return restored;
+}
+
+/******************************************************************************/
+
 double AbstractOptimizer::step()
 {
+  OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::STEP);
+  if (metrics_) metrics_->count(OptimizationMetrics::STEPS);
   currentValue_ = doStep();
-  printPoint(parameters_, currentValue_);
-  fireOptimizationStepPerformed(OptimizationEvent(this));
+  {
+    OptimizationMetrics::ScopedTimer bookkeepingTimer(metrics_, OptimizationMetrics::BOOKKEEPING);
+    printPoint(parameters_, currentValue_);
+  }
+  {
+    OptimizationMetrics::ScopedTimer listenersTimer(metrics_, OptimizationMetrics::LISTENERS);
+    fireOptimizationStepPerformed(OptimizationEvent(this));
+  }
   if (listenerModifiesParameters())
   {
     if (!updateParameters_)
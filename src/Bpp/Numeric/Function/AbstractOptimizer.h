@@ -41,6 +41,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #define _ABSTRACTOPTIMIZER_H_
 
 #include "Optimizer.h"
+#include "OptimizationMetrics.h"
 
 namespace bpp
 {
@@ -123,6 +124,11 @@ class AbstractOptimizer:
 
     std::string stepChar_;
 
+    /**
+     * @brief The metrics recorder, if any (not owned).
+     */
+    OptimizationMetrics* metrics_;
+
   protected:
 
     /**
@@ -174,6 +180,22 @@ class AbstractOptimizer:
      * Store all parameters, call the doInit method, print to profiler, initialize timer and notify all listeners.
      */
     void init(const ParameterList& params);
+    /**
+     * @brief Initialize the optimizer from the latest snapshot of a checkpoint file.
+     *
+     * Parameters saved in the checkpoint file are set to their saved values,
+     * other parameters keep their values from params. The init() method is then
+     * called with the updated list, so that an optimization interrupted while a
+     * CheckpointListener was registered can be resumed.
+     *
+     * @param checkpointFile The checkpoint file written by a CheckpointListener.
+     * @param params         The initial values of parameters.
+     * @return 'true' if a snapshot was found and used, 'false' if the optimizer
+     * was initialized with params only.
+     * @throw Exception If the checkpoint file is invalid or if a problem occured during initialization.
+     * @see CheckpointListener
+     */
+    bool initFromCheckpoint(const std::string& checkpointFile, const ParameterList& params);
     /**
      * @brief Basic implementation.
      *
@@ -263,6 +285,22 @@ class AbstractOptimizer:
      * @return The character to be displayed during optimization.
      */
     const std::string& getOptimizationProgressCharacter() const { return stepChar_; }
+
+    /**
+     * @brief Attach a metrics recorder to this optimizer.
+     *
+     * Initialization, steps, line searches, listener notifications and
+     * bookkeeping (profiling output) will be timed.
+     * The recorder is not owned by the optimizer, and is not copied with it.
+     *
+     * @param metrics A pointer toward the recorder, or 0 (default) to disable metrics.
+     */
+    void setMetrics(OptimizationMetrics* metrics) { metrics_ = metrics; }
+
+    /**
+     * @return The metrics recorder attached to this optimizer, if any.
+     */
+    OptimizationMetrics* getMetrics() const { return metrics_; }
   
   protected:
 
@@ -139,12 +139,15 @@ double BfgsMultiDimensions::doStep()
   setDirection();
 
   getFunction()->enableFirstOrderDerivatives(false);
-  nbEval_ += OneDimensionOptimizationTools::lineSearch(f1dim_,
-                                                       getParameters_(), xi_,
-                                                       gradient_,
-                                                       // getStopCondition()->getTolerance(),
-                                                       0, 0,
-                                                       getVerbose() > 0 ? getVerbose() - 1 : 0);
+  {
+    OptimizationMetrics::ScopedTimer timer(getMetrics(), OptimizationMetrics::LINE_SEARCH);
+    nbEval_ += OneDimensionOptimizationTools::lineSearch(f1dim_,
+                                                         getParameters_(), xi_,
+                                                         gradient_,
+                                                         // getStopCondition()->getTolerance(),
+                                                         0, 0,
+                                                         getVerbose() > 0 ? getVerbose() - 1 : 0);
+  }
   getFunction()->enableFirstOrderDerivatives(true);
 
   for (i = 0; i < n; i++)
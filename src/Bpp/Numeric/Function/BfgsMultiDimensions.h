@@ -95,6 +95,11 @@ namespace bpp
     {
       return dynamic_cast<DerivableFirstOrder*>(AbstractOptimizer::getFunction());
     }
+    void setFunction(Function* function)
+    {
+      AbstractOptimizer::setFunction(function);
+      f1dim_.setFunction(function);
+    }
     void doInit(const ParameterList& params);
 
     double doStep();
@@ -0,0 +1,484 @@
+//
+// File: CheckpointListener.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "CheckpointListener.h"
+#include "../../Text/TextTools.h"
+
+// From the STL:
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+const uint32_t CheckpointListener::FORMAT_VERSION = 1;
+
+namespace
+{
+  const char CHECKPOINT_MAGIC[8] = { 'B', 'P', 'P', 'C', 'K', 'P', 'T', '\0' };
+
+  void putU32(vector<unsigned char>& buf, uint32_t v)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      buf.push_back(static_cast<unsigned char>((v >> (8 * i)) & 0xFF));
+  }
+
+  void putU64(vector<unsigned char>& buf, uint64_t v)
+  {
+    for (unsigned int i = 0; i < 8; ++i)
+      buf.push_back(static_cast<unsigned char>((v >> (8 * i)) & 0xFF));
+  }
+
+  void putDouble(vector<unsigned char>& buf, double d)
+  {
+    uint64_t v;
+    memcpy(&v, &d, sizeof(v));
+    putU64(buf, v);
+  }
+
+  uint32_t getU32(const unsigned char* p)
+  {
+    uint32_t v = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+      v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+  }
+
+  uint64_t getU64(const unsigned char* p)
+  {
+    uint64_t v = 0;
+    for (unsigned int i = 0; i < 8; ++i)
+      v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+  }
+
+  double getDouble(const unsigned char* p)
+  {
+    uint64_t v = getU64(p);
+    double d;
+    memcpy(&d, &v, sizeof(d));
+    return d;
+  }
+
+  // 64 bits FNV-1a hash, used as record checksum.
+  uint64_t checksum(const unsigned char* p, size_t n)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < n; ++i)
+    {
+      h ^= p[i];
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+}
+
+/******************************************************************************/
+
+CheckpointListener::CheckpointListener(const std::string& checkpointFile, unsigned int syncInterval, unsigned int maxRecords):
+  checkpointFile_(checkpointFile),
+  syncInterval_(syncInterval > 0 ? syncInterval : 1),
+  maxRecords_(maxRecords > 0 ? maxRecords : 1),
+  names_(),
+  nbSteps_(0),
+  staging_(),
+  pending_(),
+  writing_(),
+  hasPending_(false),
+  busy_(false),
+  syncRequested_(false),
+  stop_(false),
+  error_(),
+  mutex_(),
+  wakeWriter_(),
+  writerIdle_(),
+  writer_(),
+  file_(0),
+  nbRecords_(0),
+  nbUnsynced_(0),
+  buffer_()
+{}
+
+/******************************************************************************/
+
+CheckpointListener::~CheckpointListener()
+{
+  stopWriter_();
+}
+
+/******************************************************************************/
+
+void CheckpointListener::optimizationInitializationPerformed(const OptimizationEvent& event)
+{
+  // A new optimization starts a new checkpoint file:
+  stopWriter_();
+  throwIfError_();
+
+  const ParameterList& pl = event.getOptimizer()->getParameters();
+  names_ = pl.getParameterNames();
+  staging_.values.resize(names_.size());
+  pending_.values.resize(names_.size());
+  writing_.values.resize(names_.size());
+  nbSteps_ = 0;
+  nbRecords_ = 0;
+  nbUnsynced_ = 0;
+  hasPending_ = false;
+  busy_ = false;
+  syncRequested_ = false;
+  stop_ = false;
+
+  fillSnapshot_(*event.getOptimizer(), nbSteps_);
+  post_();
+  writer_ = thread(&CheckpointListener::writerLoop_, this);
+}
+
+/******************************************************************************/
+
+void CheckpointListener::optimizationStepPerformed(const OptimizationEvent& event)
+{
+  throwIfError_();
+  if (!writer_.joinable())
+    throw Exception("CheckpointListener::optimizationStepPerformed. Listener was not initialized.");
+  fillSnapshot_(*event.getOptimizer(), ++nbSteps_);
+  post_();
+}
+
+/******************************************************************************/
+
+void CheckpointListener::fillSnapshot_(const Optimizer& optimizer, uint64_t step)
+{
+  // Only read from the optimizer, no function evaluation or parameter list copy:
+  const ParameterList& pl = optimizer.getParameters();
+  if (pl.size() != staging_.values.size())
+    throw Exception("CheckpointListener::fillSnapshot_. The number of parameters changed during optimization.");
+  for (size_t i = 0; i < pl.size(); ++i)
+  {
+    staging_.values[i] = pl[i].getValue();
+  }
+  staging_.value = optimizer.getFunctionValue();
+  staging_.step = step;
+}
+
+/******************************************************************************/
+
+void CheckpointListener::post_()
+{
+  {
+    lock_guard<mutex> lock(mutex_);
+    swap(staging_, pending_);
+    hasPending_ = true;
+  }
+  wakeWriter_.notify_one();
+}
+
+/******************************************************************************/
+
+void CheckpointListener::flush()
+{
+  if (writer_.joinable())
+  {
+    unique_lock<mutex> lock(mutex_);
+    syncRequested_ = true;
+    wakeWriter_.notify_one();
+    writerIdle_.wait(lock, [this] { return !hasPending_ && !busy_ && !syncRequested_; });
+  }
+  throwIfError_();
+}
+
+/******************************************************************************/
+
+void CheckpointListener::stopWriter_()
+{
+  if (!writer_.joinable())
+    return;
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeWriter_.notify_one();
+  writer_.join();
+}
+
+/******************************************************************************/
+
+void CheckpointListener::throwIfError_()
+{
+  string error;
+  {
+    lock_guard<mutex> lock(mutex_);
+    error.swap(error_);
+  }
+  if (!error.empty())
+    throw IOException("CheckpointListener. " + error);
+}
+
+/******************************************************************************/
+
+void CheckpointListener::writerLoop_()
+{
+  unique_lock<mutex> lock(mutex_);
+  while (true)
+  {
+    wakeWriter_.wait(lock, [this] { return hasPending_ || syncRequested_ || stop_; });
+    bool write = hasPending_;
+    bool sync = !hasPending_ && (syncRequested_ || stop_);
+    if (write)
+    {
+      swap(pending_, writing_);
+      hasPending_ = false;
+    }
+    busy_ = true;
+    lock.unlock();
+
+    string error;
+    try
+    {
+      if (write)
+        writeRecord_(writing_);
+      if (sync && file_ && nbUnsynced_ > 0)
+      {
+        syncFile_(file_);
+        nbUnsynced_ = 0;
+      }
+    }
+    catch (exception& e)
+    {
+      error = e.what();
+    }
+
+    lock.lock();
+    busy_ = false;
+    if (!error.empty())
+      error_ = error;
+    if (sync)
+    {
+      syncRequested_ = false;
+      writerIdle_.notify_all();
+      if (stop_)
+        break;
+    }
+  }
+  lock.unlock();
+
+  if (file_)
+  {
+    fclose(file_);
+    file_ = 0;
+  }
+}
+
+/******************************************************************************/
+
+void CheckpointListener::writeRecord_(const OptimizationSnapshot& snapshot)
+{
+  if (!file_ || nbRecords_ >= maxRecords_)
+  {
+    rewriteFile_(&snapshot);
+    return;
+  }
+  encodeRecord_(snapshot);
+  if (fwrite(&buffer_[0], 1, buffer_.size(), file_) != buffer_.size() || fflush(file_) != 0)
+    throw IOException("Could not append record to file " + checkpointFile_ + ".");
+  nbRecords_++;
+  if (++nbUnsynced_ >= syncInterval_)
+  {
+    syncFile_(file_);
+    nbUnsynced_ = 0;
+  }
+}
+
+/******************************************************************************/
+
+void CheckpointListener::rewriteFile_(const OptimizationSnapshot* last)
+{
+  if (file_)
+  {
+    fclose(file_);
+    file_ = 0;
+  }
+  string tmpFile = checkpointFile_ + ".tmp";
+  FILE* tmp = fopen(tmpFile.c_str(), "wb");
+  if (!tmp)
+    throw IOException("Could not create file " + tmpFile + ".");
+  encodeHeader_();
+  bool ok = fwrite(&buffer_[0], 1, buffer_.size(), tmp) == buffer_.size();
+  if (ok && last)
+  {
+    encodeRecord_(*last);
+    ok = fwrite(&buffer_[0], 1, buffer_.size(), tmp) == buffer_.size();
+  }
+  ok = ok && fflush(tmp) == 0;
+  if (ok)
+    syncFile_(tmp);
+  ok = (fclose(tmp) == 0) && ok;
+  if (!ok)
+    throw IOException("Could not write file " + tmpFile + ".");
+#if defined(_WIN32)
+  // Windows does not allow to rename over an existing file.
+  remove(checkpointFile_.c_str());
+#endif
+  if (rename(tmpFile.c_str(), checkpointFile_.c_str()) != 0)
+    throw IOException("Could not rename " + tmpFile + " to " + checkpointFile_ + ".");
+
+  file_ = fopen(checkpointFile_.c_str(), "ab");
+  if (!file_)
+    throw IOException("Could not open file " + checkpointFile_ + " for appending.");
+  nbRecords_ = last ? 1 : 0;
+  nbUnsynced_ = 0;
+}
+
+/******************************************************************************/
+
+void CheckpointListener::encodeHeader_()
+{
+  buffer_.clear();
+  for (size_t i = 0; i < 8; ++i)
+    buffer_.push_back(static_cast<unsigned char>(CHECKPOINT_MAGIC[i]));
+  putU32(buffer_, FORMAT_VERSION);
+  putU32(buffer_, static_cast<uint32_t>(names_.size()));
+  for (size_t i = 0; i < names_.size(); ++i)
+  {
+    putU32(buffer_, static_cast<uint32_t>(names_[i].size()));
+    buffer_.insert(buffer_.end(), names_[i].begin(), names_[i].end());
+  }
+}
+
+/******************************************************************************/
+
+void CheckpointListener::encodeRecord_(const OptimizationSnapshot& snapshot)
+{
+  buffer_.clear();
+  putU64(buffer_, snapshot.step);
+  putDouble(buffer_, snapshot.value);
+  for (size_t i = 0; i < snapshot.values.size(); ++i)
+  {
+    putDouble(buffer_, snapshot.values[i]);
+  }
+  putU64(buffer_, checksum(&buffer_[0], buffer_.size()));
+}
+
+/******************************************************************************/
+
+void CheckpointListener::syncFile_(std::FILE* file)
+{
+#if defined(_WIN32)
+  _commit(_fileno(file));
+#else
+  fsync(fileno(file));
+#endif
+}
+
+/******************************************************************************/
+
+bool CheckpointListener::readLatestSnapshot(const std::string& checkpointFile, std::vector<std::string>& names, OptimizationSnapshot& snapshot)
+{
+  ifstream in(checkpointFile.c_str(), ios::in | ios::binary);
+  if (!in)
+    return false;
+  vector<unsigned char> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+  if (data.size() < 16 || memcmp(&data[0], CHECKPOINT_MAGIC, 8) != 0)
+    throw IOException("CheckpointListener::readLatestSnapshot. " + checkpointFile + " is not a checkpoint file.");
+  uint32_t version = getU32(&data[8]);
+  if (version != FORMAT_VERSION)
+    throw IOException("CheckpointListener::readLatestSnapshot. Unsupported checkpoint format version: " + TextTools::toString(version) + ".");
+  size_t n = getU32(&data[12]);
+  size_t pos = 16;
+  names.resize(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (pos + 4 > data.size())
+      throw IOException("CheckpointListener::readLatestSnapshot. Truncated header in " + checkpointFile + ".");
+    size_t len = getU32(&data[pos]);
+    pos += 4;
+    if (pos + len > data.size())
+      throw IOException("CheckpointListener::readLatestSnapshot. Truncated header in " + checkpointFile + ".");
+    names[i].assign(reinterpret_cast<const char*>(&data[0]) + pos, len);
+    pos += len;
+  }
+
+  // Scan records and keep the last valid one:
+  size_t recordSize = 8 * (n + 3);
+  const unsigned char* last = 0;
+  for (; pos + recordSize <= data.size(); pos += recordSize)
+  {
+    const unsigned char* rec = &data[pos];
+    if (checksum(rec, recordSize - 8) != getU64(rec + recordSize - 8))
+      break;
+    last = rec;
+  }
+  if (!last)
+    return false;
+
+  snapshot.step = getU64(last);
+  snapshot.value = getDouble(last + 8);
+  snapshot.values.resize(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    snapshot.values[i] = getDouble(last + 16 + 8 * i);
+  }
+  return true;
+}
+
+/******************************************************************************/
+
+bool CheckpointListener::restoreParameters(const std::string& checkpointFile, ParameterList& params)
+{
+  vector<string> names;
+  OptimizationSnapshot snapshot;
+  if (!readLatestSnapshot(checkpointFile, names, snapshot))
+    return false;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (params.hasParameter(names[i]))
+      params.setParameterValue(names[i], snapshot.values[i]);
+  }
+  return true;
+}
+
+/******************************************************************************/
@@ -0,0 +1,236 @@
+//
+// File: CheckpointListener.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _CHECKPOINTLISTENER_H_
+#define _CHECKPOINTLISTENER_H_
+
+#include "Optimizer.h"
+
+// From the STL:
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bpp
+{
+
+  /**
+   * @brief A snapshot of an optimization, as stored in a checkpoint file.
+   */
+  struct OptimizationSnapshot
+  {
+    /**
+     * @brief Number of the optimization step (0 for the initial point).
+     */
+    uint64_t step;
+
+    /**
+     * @brief Function value at this step.
+     */
+    double value;
+
+    /**
+     * @brief Parameter values, in the order of the parameter names of the checkpoint.
+     */
+    std::vector<double> values;
+
+    OptimizationSnapshot(): step(0), value(0), values() {}
+  };
+
+  /**
+   * @brief Save intermediate optimization results to a binary file, asynchronously.
+   *
+   * This listener is a successor of BackupListener for long optimizations.
+   * At each optimization step, the parameter values and the function value
+   * of the optimizer are copied into a preallocated buffer, which is then
+   * handed to a background thread in charge of all file operations.
+   * The optimizer never waits for the writer: if the previous snapshot is still
+   * being written when a new step is performed, only the most recent pending
+   * snapshot is kept.
+   *
+   * File format (integers and doubles are stored in little-endian order):
+   * - a header: the magic string "BPPCKPT" followed by a null byte, the format
+   *   version (uint32), the number n of parameters (uint32), then for each
+   *   parameter the length of its name (uint32) followed by its characters;
+   * - a sequence of records, each made of the step number (uint64), the function
+   *   value (double), the n parameter values (double) and a checksum of the
+   *   preceding record bytes (uint64).
+   *
+   * Records are appended to the file, which is synced to disk every
+   * syncInterval records. When the file holds more than maxRecords records, it is
+   * compacted: the header and the last record are written to a temporary file,
+   * which is synced and atomically renamed over the checkpoint file.
+   * The checkpoint file is created the same way when the optimizer is initialized,
+   * so that a valid file is always present on disk.
+   * A truncated or corrupted last record, e.g. after the process was killed, is
+   * ignored when reading the file.
+   *
+   * The latest snapshot can be reloaded with readLatestSnapshot(), or directly
+   * used to restart an optimization with AbstractOptimizer::initFromCheckpoint().
+   *
+   * I/O errors in the writer thread are reported as an IOException thrown
+   * at the next optimization step, or by flush().
+   */
+  class CheckpointListener:
+    public OptimizationListener
+  {
+  public:
+    static const uint32_t FORMAT_VERSION;
+
+  private:
+    std::string checkpointFile_;
+    unsigned int syncInterval_;
+    unsigned int maxRecords_;
+    std::vector<std::string> names_;
+    uint64_t nbSteps_;
+
+    /**
+     * @name Snapshot buffers.
+     *
+     * staging_ is only accessed by the optimizer thread, writing_ only by
+     * the writer thread, and pending_ is exchanged between them under mutex_.
+     * Buffers are swapped, never copied, so no allocation occurs after initialization.
+     * @{
+     */
+    OptimizationSnapshot staging_;
+    OptimizationSnapshot pending_;
+    OptimizationSnapshot writing_;
+    /** @} */
+
+    bool hasPending_;
+    bool busy_;
+    bool syncRequested_;
+    bool stop_;
+    std::string error_;
+    std::mutex mutex_;
+    std::condition_variable wakeWriter_;
+    std::condition_variable writerIdle_;
+    std::thread writer_;
+
+    /**
+     * @name Writer thread state.
+     *
+     * @{
+     */
+    std::FILE* file_;
+    unsigned int nbRecords_;
+    unsigned int nbUnsynced_;
+    std::vector<unsigned char> buffer_;
+    /** @} */
+
+  public:
+    /**
+     * @param checkpointFile The path of the checkpoint file.
+     * @param syncInterval   The number of records after which the file is synced to disk.
+     * @param maxRecords     The number of records after which the file is compacted.
+     */
+    CheckpointListener(const std::string& checkpointFile, unsigned int syncInterval = 10, unsigned int maxRecords = 1000);
+
+    CheckpointListener(const CheckpointListener&) = delete;
+    CheckpointListener& operator=(const CheckpointListener&) = delete;
+
+    /**
+     * @brief Write the last pending snapshot, sync the file and stop the writer thread.
+     */
+    virtual ~CheckpointListener();
+
+  public:
+    void optimizationInitializationPerformed(const OptimizationEvent& event);
+
+    void optimizationStepPerformed(const OptimizationEvent& event);
+
+    bool listenerModifiesParameters() const { return false; }
+
+  public:
+    /**
+     * @return The path of the checkpoint file.
+     */
+    const std::string& getCheckpointFile() const { return checkpointFile_; }
+
+    /**
+     * @brief Wait until all pending snapshots have been written and synced to disk.
+     *
+     * @throw IOException If the writer thread failed to write the file.
+     */
+    void flush();
+
+    /**
+     * @brief Read the latest valid snapshot from a checkpoint file.
+     *
+     * @param checkpointFile The path of the checkpoint file.
+     * @param names          [out] The names of the parameters in the snapshot.
+     * @param snapshot       [out] The latest snapshot.
+     * @return false if the file does not exist or contains no valid record.
+     * @throw IOException If the file is not a checkpoint file of a supported version.
+     */
+    static bool readLatestSnapshot(const std::string& checkpointFile, std::vector<std::string>& names, OptimizationSnapshot& snapshot);
+
+    /**
+     * @brief Update a parameter list with the latest snapshot of a checkpoint file.
+     *
+     * Parameters not present in the checkpoint keep their values.
+     *
+     * @param checkpointFile The path of the checkpoint file.
+     * @param params         [in,out] The parameters to update.
+     * @return false if the file does not exist or contains no valid record.
+     * @throw IOException If the file is not a checkpoint file of a supported version.
+     */
+    static bool restoreParameters(const std::string& checkpointFile, ParameterList& params);
+
+  private:
+    void fillSnapshot_(const Optimizer& optimizer, uint64_t step);
+    void post_();
+    void stopWriter_();
+    void writerLoop_();
+    void writeRecord_(const OptimizationSnapshot& snapshot);
+    void rewriteFile_(const OptimizationSnapshot* last);
+    void encodeHeader_();
+    void encodeRecord_(const OptimizationSnapshot& snapshot);
+    void throwIfError_();
+
+    static void syncFile_(std::FILE* file);
+  };
+
+} //end of namespace bpp.
+
+#endif //_CHECKPOINTLISTENER_H_
@@ -0,0 +1,370 @@
+//
+// File: CmaesMultiDimensions.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "CmaesMultiDimensions.h"
+#include "../Matrix/EigenValue.h"
+#include "../NumConstants.h"
+#include "../Random/RandomTools.h"
+#include "../../Utils/ThreadTools.h"
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+double CmaesMultiDimensions::CmaesStopCondition::getCurrentTolerance() const
+{
+  const CmaesMultiDimensions* cmaes = dynamic_cast<const CmaesMultiDimensions*>(optimizer_);
+  if (cmaes->order_.empty())
+    return NumConstants::VERY_BIG();
+  double fRange = cmaes->fx_[cmaes->order_[cmaes->mu_ - 1]] - cmaes->fx_[cmaes->order_[0]];
+  double maxD = *max_element(cmaes->D_.begin(), cmaes->D_.end());
+  return max(fRange, cmaes->sigma_ * maxD);
+}
+
+/******************************************************************************/
+
+CmaesMultiDimensions::CmaesMultiDimensions(Function* function, unsigned int nbThreads):
+  AbstractOptimizer(function),
+  nbThreads_(nbThreads), nbThreadsUsed_(1), populationSize_(0), initialStepSize_(0.3),
+  lambda_(0), mu_(0), weights_(),
+  mueff_(0), cc_(0), cs_(0), c1_(0), cmu_(0), damps_(0), chiN_(0),
+  mean_(), sigma_(0), pc_(), ps_(), C_(), B_(), D_(),
+  generation_(0), lastEigenUpdate_(0),
+  candidates_(), y_(), fx_(), order_(), bestValue_(0),
+  clones_()
+{
+  nbEvalMax_ = 100000;
+  setDefaultStopCondition_(new CmaesStopCondition(this));
+  setStopCondition(*getDefaultStopCondition());
+}
+
+/******************************************************************************/
+
+CmaesMultiDimensions::CmaesMultiDimensions(const CmaesMultiDimensions& opt):
+  AbstractOptimizer(opt),
+  nbThreads_(opt.nbThreads_), nbThreadsUsed_(opt.nbThreadsUsed_),
+  populationSize_(opt.populationSize_), initialStepSize_(opt.initialStepSize_),
+  lambda_(opt.lambda_), mu_(opt.mu_), weights_(opt.weights_),
+  mueff_(opt.mueff_), cc_(opt.cc_), cs_(opt.cs_), c1_(opt.c1_), cmu_(opt.cmu_),
+  damps_(opt.damps_), chiN_(opt.chiN_),
+  mean_(opt.mean_), sigma_(opt.sigma_), pc_(opt.pc_), ps_(opt.ps_),
+  C_(opt.C_), B_(opt.B_), D_(opt.D_),
+  generation_(opt.generation_), lastEigenUpdate_(opt.lastEigenUpdate_),
+  candidates_(opt.candidates_), y_(opt.y_), fx_(opt.fx_), order_(opt.order_),
+  bestValue_(opt.bestValue_),
+  clones_() //Function copies are never shared between optimizers.
+{
+  for (size_t t = 1; t < nbThreadsUsed_ && getFunction(); ++t)
+  {
+    clones_.push_back(shared_ptr<Function>(dynamic_cast<Function*>(getFunction()->clone())));
+  }
+}
+
+/******************************************************************************/
+
+CmaesMultiDimensions& CmaesMultiDimensions::operator=(const CmaesMultiDimensions& opt)
+{
+  AbstractOptimizer::operator=(opt);
+  nbThreads_       = opt.nbThreads_;
+  nbThreadsUsed_   = opt.nbThreadsUsed_;
+  populationSize_  = opt.populationSize_;
+  initialStepSize_ = opt.initialStepSize_;
+  lambda_          = opt.lambda_;
+  mu_              = opt.mu_;
+  weights_         = opt.weights_;
+  mueff_           = opt.mueff_;
+  cc_              = opt.cc_;
+  cs_              = opt.cs_;
+  c1_              = opt.c1_;
+  cmu_             = opt.cmu_;
+  damps_           = opt.damps_;
+  chiN_            = opt.chiN_;
+  mean_            = opt.mean_;
+  sigma_           = opt.sigma_;
+  pc_              = opt.pc_;
+  ps_              = opt.ps_;
+  C_               = opt.C_;
+  B_               = opt.B_;
+  D_               = opt.D_;
+  generation_      = opt.generation_;
+  lastEigenUpdate_ = opt.lastEigenUpdate_;
+  candidates_      = opt.candidates_;
+  y_               = opt.y_;
+  fx_              = opt.fx_;
+  order_           = opt.order_;
+  bestValue_       = opt.bestValue_;
+  clones_.clear();
+  for (size_t t = 1; t < nbThreadsUsed_ && getFunction(); ++t)
+  {
+    clones_.push_back(shared_ptr<Function>(dynamic_cast<Function*>(getFunction()->clone())));
+  }
+  return *this;
+}
+
+/******************************************************************************/
+
+void CmaesMultiDimensions::doInit(const ParameterList& params)
+{
+  size_t n = getParameters().size();
+  double dn = static_cast<double>(n);
+
+  // Strategy parameters:
+  lambda_ = populationSize_ > 0 ? populationSize_ : 4 + static_cast<size_t>(floor(3. * log(dn)));
+  if (lambda_ < 2)
+    lambda_ = 2;
+  mu_ = lambda_ / 2;
+  weights_.resize(mu_);
+  for (size_t i = 0; i < mu_; ++i)
+  {
+    weights_[i] = log(static_cast<double>(mu_) + 0.5) - log(static_cast<double>(i + 1));
+  }
+  double sw = VectorTools::sum(weights_);
+  double sw2 = 0;
+  for (size_t i = 0; i < mu_; ++i)
+  {
+    weights_[i] /= sw;
+    sw2 += weights_[i] * weights_[i];
+  }
+  mueff_ = 1. / sw2;
+  cc_    = (4. + mueff_ / dn) / (dn + 4. + 2. * mueff_ / dn);
+  cs_    = (mueff_ + 2.) / (dn + mueff_ + 5.);
+  c1_    = 2. / ((dn + 1.3) * (dn + 1.3) + mueff_);
+  cmu_   = min(1. - c1_, 2. * (mueff_ - 2. + 1. / mueff_) / ((dn + 2.) * (dn + 2.) + mueff_));
+  damps_ = 1. + 2. * max(0., sqrt((mueff_ - 1.) / (dn + 1.)) - 1.) + cs_;
+  chiN_  = sqrt(dn) * (1. - 1. / (4. * dn) + 1. / (21. * dn * dn));
+
+  // Initial distribution:
+  mean_.resize(n);
+  for (size_t j = 0; j < n; ++j)
+  {
+    mean_[j] = getParameters()[j].getValue();
+  }
+  sigma_ = initialStepSize_;
+  pc_.assign(n, 0.);
+  ps_.assign(n, 0.);
+  C_.resize(n, n);
+  B_.resize(n, n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = 0; j < n; ++j)
+    {
+      C_(i, j) = (i == j ? 1. : 0.);
+      B_(i, j) = (i == j ? 1. : 0.);
+    }
+  }
+  D_.assign(n, 1.);
+  generation_ = 0;
+  lastEigenUpdate_ = 0;
+
+  candidates_.assign(lambda_, getParameters());
+  y_.assign(lambda_, Vdouble(n));
+  fx_.assign(lambda_, 0.);
+  order_.clear();
+
+  // One function copy per additional thread:
+  nbThreadsUsed_ = nbThreads_ > 0 ? nbThreads_ : ThreadTools::getNumberOfAvailableThreads();
+  if (nbThreadsUsed_ > lambda_)
+    nbThreadsUsed_ = static_cast<unsigned int>(lambda_);
+  clones_.clear();
+  for (size_t t = 1; t < nbThreadsUsed_; ++t)
+  {
+    clones_.push_back(shared_ptr<Function>(dynamic_cast<Function*>(getFunction()->clone())));
+  }
+
+  bestValue_ = getFunction()->f(getParameters());
+}
+
+/******************************************************************************/
+
+double CmaesMultiDimensions::doStep()
+{
+  size_t n = mean_.size();
+  generation_++;
+
+  // Sample the new generation:
+  Vdouble z(n);
+  for (size_t k = 0; k < lambda_; ++k)
+  {
+    for (size_t j = 0; j < n; ++j)
+    {
+      z[j] = D_[j] * RandomTools::randGaussian(0., 1.);
+    }
+    ParameterList& pl = candidates_[k];
+    for (size_t i = 0; i < n; ++i)
+    {
+      double yi = 0;
+      for (size_t j = 0; j < n; ++j)
+      {
+        yi += B_(i, j) * z[j];
+      }
+      double x = mean_[i] + sigma_ * yi;
+      // Repair the candidate if it does not satisfy the constraint:
+      shared_ptr<Constraint> constraint = pl[i].getConstraint();
+      if (constraint && !constraint->isCorrect(x))
+        x = constraint->getAcceptedLimit(x);
+      pl[i].setValue(x);
+      y_[k][i] = (x - mean_[i]) / sigma_;
+    }
+  }
+
+  // Evaluate all candidates, in parallel:
+  ThreadTools::parallelFor(lambda_, nbThreadsUsed_, [this](size_t k, unsigned int t) {
+      Function* f = (t == 0 ? getFunction_() : clones_[t - 1].get());
+      double v = f->f(candidates_[k]);
+      fx_[k] = std::isnan(v) ? NumConstants::PINF() : v;
+    });
+  nbEval_ += static_cast<unsigned int>(lambda_);
+
+  order_.resize(lambda_);
+  for (size_t k = 0; k < lambda_; ++k)
+  {
+    order_[k] = k;
+  }
+  stable_sort(order_.begin(), order_.end(), [this](size_t a, size_t b) { return fx_[a] < fx_[b]; });
+
+  // Keep the best point found so far:
+  if (fx_[order_[0]] < bestValue_)
+  {
+    bestValue_ = fx_[order_[0]];
+    for (size_t j = 0; j < n; ++j)
+    {
+      getParameter_(j).setValue(candidates_[order_[0]][j].getValue());
+    }
+  }
+
+  // Move the mean (in units of sigma):
+  Vdouble yw(n, 0.);
+  for (size_t i = 0; i < mu_; ++i)
+  {
+    const Vdouble& yi = y_[order_[i]];
+    for (size_t j = 0; j < n; ++j)
+    {
+      yw[j] += weights_[i] * yi[j];
+    }
+  }
+  for (size_t j = 0; j < n; ++j)
+  {
+    mean_[j] += sigma_ * yw[j];
+  }
+
+  // Update evolution paths, using C^{-1/2} = B D^{-1} B^T:
+  Vdouble btyw(n, 0.);
+  for (size_t j = 0; j < n; ++j)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      btyw[j] += B_(i, j) * yw[i];
+    }
+    btyw[j] /= D_[j];
+  }
+  double csn = sqrt(cs_ * (2. - cs_) * mueff_);
+  double psNorm2 = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    double v = 0;
+    for (size_t j = 0; j < n; ++j)
+    {
+      v += B_(i, j) * btyw[j];
+    }
+    ps_[i] = (1. - cs_) * ps_[i] + csn * v;
+    psNorm2 += ps_[i] * ps_[i];
+  }
+  double psNorm = sqrt(psNorm2);
+  double hsig = (psNorm / sqrt(1. - pow(1. - cs_, 2. * generation_)) / chiN_ < 1.4 + 2. / (static_cast<double>(n) + 1.)) ? 1. : 0.;
+  double ccn = sqrt(cc_ * (2. - cc_) * mueff_);
+  for (size_t i = 0; i < n; ++i)
+  {
+    pc_[i] = (1. - cc_) * pc_[i] + hsig * ccn * yw[i];
+  }
+
+  // Adapt the covariance matrix:
+  double c1a = c1_ * (1. - (1. - hsig * hsig) * cc_ * (2. - cc_));
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = 0; j <= i; ++j)
+    {
+      double rankMu = 0;
+      for (size_t k = 0; k < mu_; ++k)
+      {
+        const Vdouble& yk = y_[order_[k]];
+        rankMu += weights_[k] * yk[i] * yk[j];
+      }
+      double cij = (1. - c1a - cmu_) * C_(i, j) + c1_ * pc_[i] * pc_[j] + cmu_ * rankMu;
+      C_(i, j) = cij;
+      C_(j, i) = cij;
+    }
+  }
+
+  // Adapt the step size:
+  sigma_ *= exp(min(1., (cs_ / damps_) * (psNorm / chiN_ - 1.)));
+
+  // The decomposition is O(n^3), it is only updated when C has changed significantly:
+  if (10. * static_cast<double>(generation_ - lastEigenUpdate_) * (c1_ + cmu_) * static_cast<double>(n) > 1.)
+    updateEigenDecomposition_();
+
+  // Set the function to the best point:
+  getFunction()->setParameters(getParameters());
+  return bestValue_;
+}
+
+/******************************************************************************/
+
+void CmaesMultiDimensions::updateEigenDecomposition_()
+{
+  size_t n = mean_.size();
+  EigenValue<double> eigen(C_);
+  const RowMatrix<double>& v = eigen.getV();
+  const Vdouble& d = eigen.getRealEigenValues();
+  for (size_t j = 0; j < n; ++j)
+  {
+    D_[j] = sqrt(max(d[j], NumConstants::VERY_TINY()));
+    for (size_t i = 0; i < n; ++i)
+    {
+      B_(i, j) = v(i, j);
+    }
+  }
+  lastEigenUpdate_ = generation_;
+}
+
+/******************************************************************************/
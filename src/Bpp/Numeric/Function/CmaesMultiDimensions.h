@@ -0,0 +1,229 @@
+//
+// File: CmaesMultiDimensions.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _CMAESMULTIDIMENSIONS_H_
+#define _CMAESMULTIDIMENSIONS_H_
+
+#include "AbstractOptimizer.h"
+#include "../Matrix/Matrix.h"
+#include "../VectorTools.h"
+
+// From the STL:
+#include <memory>
+
+namespace bpp
+{
+
+/**
+ * @brief Covariance Matrix Adaptation Evolution Strategy (CMA-ES).
+ *
+ * This derivative-free optimizer samples, at each step, a population of
+ * @f$\lambda@f$ candidate points from a multivariate normal distribution, and
+ * adapts the mean, the covariance matrix and the global step size of this
+ * distribution from the @f$\mu=\lambda/2@f$ best candidates.
+ * It is much more robust than DownhillSimplexMethod and PowellMultiDimensions
+ * on rugged or multimodal functions.
+ *
+ * The @f$\lambda@f$ candidates of a generation are independent, and are evaluated
+ * concurrently: each thread evaluates candidates on its own copy of the function,
+ * obtained with Function::clone() when the optimizer is initialized.
+ * The function must hence be cloneable, and its copies must not share mutable state.
+ * Random numbers are drawn in the calling thread only, so that results do not depend
+ * on the number of threads.
+ *
+ * Candidates which do not satisfy the constraint of a parameter (typically
+ * the bounds of an IntervalConstraint) are repaired by moving them to the
+ * closest accepted value, and the repaired point is used for the update of
+ * the distribution.
+ *
+ * Each step corresponds to one generation and performs @f$\lambda@f$ function evaluations.
+ * The current parameters of the optimizer are the best point found so far,
+ * and the function is set to this point at the end of each step.
+ *
+ * The implementation follows:
+ * <pre>
+ * N. Hansen (2016), The CMA Evolution Strategy: A Tutorial. arXiv:1604.00772.
+ * </pre>
+ */
+class CmaesMultiDimensions:
+  public AbstractOptimizer
+{
+  public:
+    /**
+     * @brief The tolerance is the largest of the range of the function values
+     * of the @f$\mu@f$ selected candidates, and of the largest standard deviation
+     * of the sampling distribution.
+     */
+    class CmaesStopCondition:
+      public AbstractOptimizationStopCondition
+    {
+      public:
+        CmaesStopCondition(CmaesMultiDimensions* cmaes):
+          AbstractOptimizationStopCondition(cmaes) {}
+        virtual ~CmaesStopCondition() {}
+
+        CmaesStopCondition* clone() const { return new CmaesStopCondition(*this); }
+
+      public:
+        bool isToleranceReached() const { return (getCurrentTolerance() < tolerance_); }
+        double getCurrentTolerance() const;
+    };
+
+  friend class CmaesStopCondition;
+
+  private:
+    unsigned int nbThreads_;
+    unsigned int nbThreadsUsed_;
+    size_t populationSize_;
+    double initialStepSize_;
+
+    // Strategy parameters:
+    size_t lambda_;
+    size_t mu_;
+    Vdouble weights_;
+    double mueff_, cc_, cs_, c1_, cmu_, damps_, chiN_;
+
+    // Distribution state:
+    Vdouble mean_;
+    double sigma_;
+    Vdouble pc_;
+    Vdouble ps_;
+    RowMatrix<double> C_;
+    RowMatrix<double> B_;
+    Vdouble D_;
+    unsigned int generation_;
+    unsigned int lastEigenUpdate_;
+
+    // Current generation:
+    std::vector<ParameterList> candidates_;
+    VVdouble y_;
+    Vdouble fx_;
+    std::vector<size_t> order_;
+    double bestValue_;
+
+    // One copy of the function for each additional thread:
+    std::vector< std::shared_ptr<Function> > clones_;
+
+  public:
+    /**
+     * @brief Build a new CMA-ES optimizer.
+     *
+     * @param function  A pointer toward the function to minimize.
+     * @param nbThreads The number of threads to use for the evaluation of candidates
+     * (0 means all available threads).
+     */
+    CmaesMultiDimensions(Function* function, unsigned int nbThreads = 0);
+
+    CmaesMultiDimensions(const CmaesMultiDimensions& opt);
+
+    CmaesMultiDimensions& operator=(const CmaesMultiDimensions& opt);
+
+    virtual ~CmaesMultiDimensions() {}
+
+    CmaesMultiDimensions* clone() const { return new CmaesMultiDimensions(*this); }
+
+  public:
+    void setFunction(Function* function)
+    {
+      AbstractOptimizer::setFunction(function);
+      clones_.clear();
+    }
+
+    void doInit(const ParameterList& params);
+
+    double doStep();
+
+    /**
+     * @brief Set the number of candidates per generation.
+     *
+     * @param lambda The population size. 0 (default) means @f$4+\lfloor 3\ln n\rfloor@f$,
+     * where @f$n@f$ is the number of parameters.
+     * Larger populations make the search more global, at the expense of more evaluations per step.
+     */
+    void setPopulationSize(size_t lambda) { populationSize_ = lambda; }
+
+    /**
+     * @return The number of candidates per generation, as set by the user (0 means default).
+     */
+    size_t getPopulationSize() const { return populationSize_; }
+
+    /**
+     * @brief Set the initial standard deviation of the sampling distribution.
+     *
+     * It should be of the order of the distance between the starting point and the optimum
+     * (default: 0.3).
+     *
+     * @param sigma The initial step size.
+     */
+    void setInitialStepSize(double sigma) { initialStepSize_ = sigma; }
+
+    /**
+     * @return The initial standard deviation of the sampling distribution.
+     */
+    double getInitialStepSize() const { return initialStepSize_; }
+
+    /**
+     * @brief Set the number of threads used to evaluate candidates.
+     *
+     * The change is effective at the next call to init().
+     *
+     * @param nbThreads The number of threads (0 means all available threads).
+     */
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    /**
+     * @return The number of threads used to evaluate candidates (0 means all available threads).
+     */
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+
+    /**
+     * @return The current global step size of the sampling distribution.
+     */
+    double getStepSize() const { return sigma_; }
+
+  protected:
+    /**
+     * @brief Recompute the eigen decomposition C = B D^2 B^T.
+     */
+    void updateEigenDecomposition_();
+};
+
+} //end of namespace bpp.
+
+#endif //_CMAESMULTIDIMENSIONS_H_
@@ -81,9 +81,12 @@ double ConjugateGradientMultiDimensions::doStep()
   size_t n = getParameters().size();
   //Loop over iterations.
   getFunction_()->enableFirstOrderDerivatives(false);
-  nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
-      getParameters_(), xi_, getStopCondition()->getTolerance(),
-      0, 0, getVerbose() > 0 ? getVerbose() - 1 : 0);
+  {
+    OptimizationMetrics::ScopedTimer timer(getMetrics(), OptimizationMetrics::LINE_SEARCH);
+    nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
+        getParameters_(), xi_, getStopCondition()->getTolerance(),
+        0, 0, getVerbose() > 0 ? getVerbose() - 1 : 0);
+  }
 
   getFunction_()->enableFirstOrderDerivatives(true);
   f = getFunction()->f(getParameters());
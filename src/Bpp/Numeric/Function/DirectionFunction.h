@@ -101,6 +101,7 @@ class DirectionFunction:
     std::string getConstraintPolicy() const { return constraintPolicy_; }
     void setMessageHandler(OutputStream* messenger) { messenger_ = messenger; }
     Function * getFunction() const { return function_; }
+    void setFunction(Function* function) { function_ = function; }
     /**
      * @return The set of parameters associated to the function, as specified by the init() method.
      */
@@ -51,6 +51,7 @@ knowledge of the CeCILL license and that you accept its terms.
 
 // From the STL:
 #include <cmath>
+#include <vector>
 
 namespace bpp
 {
@@ -176,6 +177,49 @@ class DerivableFirstOrder:
     }
 };
 
+/**
+ * @brief This is the abstract class for functions which are a sum of independent components.
+ *
+ * The value of such a function is
+ * @f[ f(\theta) = \sum_{i=0}^{n-1} f_i(\theta), @f]
+ * where each component @f$f_i@f$ typically corresponds to an independent block
+ * of data (a site, a sequence, a segment between two break points...).
+ * getValue() and getFirstOrderDerivative() refer to the full sum, while
+ * computeComponents() allows stochastic optimizers, such as
+ * StochasticGradientMultiDimensions, to only evaluate a subset of the components
+ * at each iteration.
+ */
+class SumDecomposableFunction:
+  public virtual DerivableFirstOrder
+{
+  public:
+    SumDecomposableFunction() {}
+    virtual ~SumDecomposableFunction() {}
+
+    SumDecomposableFunction* clone() const = 0;
+
+  public:
+
+    /**
+     * @return The number of components of the sum.
+     */
+    virtual size_t getNumberOfComponents() const = 0;
+
+    /**
+     * @brief Compute the sum of a subset of the components, and its gradient.
+     *
+     * The current point of the function may be modified by this method.
+     *
+     * @param parameters The parameter set where the components are evaluated.
+     * @param components The indices of the components to sum.
+     * @param gradient   [out] The gradient of the partial sum, with one entry for each
+     * parameter in the parameter set, in the same order. The vector is resized if needed.
+     * @return The sum of the selected components.
+     * @throw Exception If an error occured.
+     */
+    virtual double computeComponents(const ParameterList& parameters, const std::vector<size_t>& components, std::vector<double>& gradient) = 0;
+};
+
 /**
  * @brief This is the abstract class for second order derivable functions.
  * 
@@ -43,7 +43,10 @@ knowledge of the CeCILL license and that you accept its terms.
 /**************************************************************************/
 
 #include "MetaOptimizer.h"
+#include "../NumConstants.h"
+#include "../NumTools.h"
 #include "../../App/ApplicationTools.h"
+#include "../../Utils/ThreadTools.h"
 
 using namespace bpp;
 using namespace std;
@@ -62,7 +65,9 @@ MetaOptimizer::MetaOptimizer(
   AbstractOptimizer(function),
   optDesc_(desc), optParameters_(desc->getNumberOfOptimizers()),
   nbParameters_(desc->getNumberOfOptimizers()), n_(n),
-  precisionStep_(-1.), stepCount_(0), initialValue_(-1.)
+  precisionStep_(-1.), stepCount_(0), initialValue_(-1.),
+  nbThreads_(1), clones_(), sequentialSteps_(), sequentialBackoff_(),
+  nbConcurrentUpdates_(0), nbSequentialUpdates_(0)
 {
   setDefaultStopCondition_(new FunctionStopCondition(this));
   setStopCondition(*getDefaultStopCondition());
@@ -81,7 +86,13 @@ MetaOptimizer::MetaOptimizer(
   n_(opt.n_),
   precisionStep_(opt.precisionStep_),
   stepCount_(opt.stepCount_),
-  initialValue_(opt.initialValue_)
+  initialValue_(opt.initialValue_),
+  nbThreads_(opt.nbThreads_),
+  clones_(), //Function copies are never shared between optimizers.
+  sequentialSteps_(opt.sequentialSteps_),
+  sequentialBackoff_(opt.sequentialBackoff_),
+  nbConcurrentUpdates_(opt.nbConcurrentUpdates_),
+  nbSequentialUpdates_(opt.nbSequentialUpdates_)
 {}
 
 /**************************************************************************/
@@ -97,6 +108,12 @@ MetaOptimizer& MetaOptimizer::operator=(
   precisionStep_ = opt.precisionStep_;
   stepCount_     = opt.stepCount_;
   initialValue_  = opt.initialValue_;
+  nbThreads_     = opt.nbThreads_;
+  clones_.clear();
+  sequentialSteps_   = opt.sequentialSteps_;
+  sequentialBackoff_ = opt.sequentialBackoff_;
+  nbConcurrentUpdates_ = opt.nbConcurrentUpdates_;
+  nbSequentialUpdates_ = opt.nbSequentialUpdates_;
   return *this;
 }
 
@@ -134,6 +151,7 @@ void MetaOptimizer::doInit(const ParameterList& parameters)
     {
       Optimizer * opt = optDesc_->getOptimizer(i);
       dynamic_cast<AbstractOptimizer*>(opt)->updateParameters(updateParameters());
+      dynamic_cast<AbstractOptimizer*>(opt)->setMetrics(getMetrics());
       opt->setProfiler(getProfiler());
       opt->setMessageHandler(getMessageHandler());
       opt->setConstraintPolicy(getConstraintPolicy());
@@ -148,6 +166,12 @@ void MetaOptimizer::doInit(const ParameterList& parameters)
   initialValue_ = getFunction()->getValue();
   // Reset counter:
   stepCount_ = 1;
+  // Function copies are synchronized when used, but the set of parameters may have changed:
+  clones_.clear();
+  sequentialSteps_.clear();
+  sequentialBackoff_.clear();
+  nbConcurrentUpdates_ = 0;
+  nbSequentialUpdates_ = 0;
   // Recompute step if precision has changed:
   precisionStep_ = (log10(getStopCondition()->getTolerance()) - log10(initialValue_)) / n_;
 }
@@ -165,38 +189,63 @@ double MetaOptimizer::doStep()
     tol = initialValue_ * pow(10, stepCount_ * precisionStep_);
   }
   
-  for (unsigned int i = 0; i < optDesc_->getNumberOfOptimizers(); i++)
+  size_t nbOpt = optDesc_->getNumberOfOptimizers();
+  for (size_t i = 0; i < nbOpt; )
   {
-    if (nbParameters_[i] > 0)
+    // Look for consecutive independent optimizers:
+    size_t end = i + 1;
+    unsigned int group = optDesc_->getIndependenceGroup(i);
+    if (nbThreads_ != 1 && group > 0)
     {
-      if (getVerbose() > 1 && ApplicationTools::message)
+      while (end < nbOpt && optDesc_->getIndependenceGroup(end) == group)
+        end++;
+    }
+    size_t nbActive = 0;
+    for (size_t k = i; k < end; k++)
+    {
+      if (nbParameters_[k] > 0) nbActive++;
+    }
+
+    bool done = false;
+    if (nbActive > 1)
+    {
+      if (sequentialSteps_[group] > 0)
+        sequentialSteps_[group]--;
+      else if (runConcurrently_(i, end, tol))
+      {
+        sequentialBackoff_[group] = 0;
+        nbConcurrentUpdates_++;
+        done = true;
+      }
+      else
       {
-        (ApplicationTools::message->endLine() << optDesc_->getName(i)).endLine();
-        ApplicationTools::message->flush();
+        // Jacobi update failed, switch to Gauss-Seidel for a while:
+        unsigned int& backoff = sequentialBackoff_[group];
+        backoff = (backoff == 0 ? 1 : 2 * backoff);
+        sequentialSteps_[group] = backoff;
       }
-      if (optDesc_->requiresFirstOrderDerivatives(i))
-        dynamic_cast<DerivableFirstOrder*>(getFunction())->enableFirstOrderDerivatives(true);
-      if (optDesc_->requiresSecondOrderDerivatives(i))  
-        dynamic_cast<DerivableSecondOrder*>(getFunction())->enableSecondOrderDerivatives(true);
+      if (!done)
+        nbSequentialUpdates_++;
+    }
 
-      optParameters_[i].matchParametersValues(getParameters());
-      Optimizer * opt = optDesc_->getOptimizer(i);
-      opt->getStopCondition()->setTolerance(tol);
-      opt->init(optParameters_[i]);
-      if (optDesc_->getIterationType(i) == MetaOptimizerInfos::IT_TYPE_STEP)
-        opt->step();
-      else if (optDesc_->getIterationType(i) == MetaOptimizerInfos::IT_TYPE_FULL)
-        opt->optimize();
-      else throw Exception("MetaOptimizer::step. Unknown iteration type specified.");
-      nbEval_ += opt->getNumberOfEvaluations();
-      if (optDesc_->requiresFirstOrderDerivatives(i))
-        dynamic_cast<DerivableFirstOrder*>(getFunction())->enableFirstOrderDerivatives(false);
-      if (optDesc_->requiresSecondOrderDerivatives(i))  
-        dynamic_cast<DerivableSecondOrder*>(getFunction())->enableSecondOrderDerivatives(false);
-      if (getVerbose() > 1) cout << endl;
-      getParameters_().matchParametersValues(opt->getParameters());
+    for (size_t k = i; k < end; k++)
+    {
+      if (nbParameters_[k] > 0 && !done)
+      {
+        if (getVerbose() > 1 && ApplicationTools::message)
+        {
+          (ApplicationTools::message->endLine() << optDesc_->getName(k)).endLine();
+          ApplicationTools::message->flush();
+        }
+        runOptimizer_(k, getFunction(), tol);
+        Optimizer* opt = optDesc_->getOptimizer(k);
+        nbEval_ += opt->getNumberOfEvaluations();
+        if (getVerbose() > 1) cout << endl;
+        getParameters_().matchParametersValues(opt->getParameters());
+      }
+      tolTest += nbParameters_[k] > 0 ? 1 : 0;
     }
-    tolTest += nbParameters_[i] > 0 ? 1 : 0;
+    i = end;
   }
   tolIsReached_ = (tolTest == 1);
    
@@ -205,3 +254,117 @@ double MetaOptimizer::doStep()
 
 /**************************************************************************/
 
+void MetaOptimizer::runOptimizer_(size_t i, Function* function, double tol)
+{
+  if (optDesc_->requiresFirstOrderDerivatives(i))
+    dynamic_cast<DerivableFirstOrder*>(function)->enableFirstOrderDerivatives(true);
+  if (optDesc_->requiresSecondOrderDerivatives(i))  
+    dynamic_cast<DerivableSecondOrder*>(function)->enableSecondOrderDerivatives(true);
+
+  optParameters_[i].matchParametersValues(getParameters());
+  Optimizer* opt = optDesc_->getOptimizer(i);
+  opt->getStopCondition()->setTolerance(tol);
+  opt->init(optParameters_[i]);
+  if (optDesc_->getIterationType(i) == MetaOptimizerInfos::IT_TYPE_STEP)
+    opt->step();
+  else if (optDesc_->getIterationType(i) == MetaOptimizerInfos::IT_TYPE_FULL)
+    opt->optimize();
+  else throw Exception("MetaOptimizer::step. Unknown iteration type specified.");
+
+  if (optDesc_->requiresFirstOrderDerivatives(i))
+    dynamic_cast<DerivableFirstOrder*>(function)->enableFirstOrderDerivatives(false);
+  if (optDesc_->requiresSecondOrderDerivatives(i))  
+    dynamic_cast<DerivableSecondOrder*>(function)->enableSecondOrderDerivatives(false);
+}
+
+/**************************************************************************/
+
+bool MetaOptimizer::runConcurrently_(size_t begin, size_t end, double tol)
+{
+  vector<size_t> active;
+  for (size_t k = begin; k < end; k++)
+  {
+    if (nbParameters_[k] > 0)
+    {
+      active.push_back(k);
+      if (getVerbose() > 1 && ApplicationTools::message)
+        (ApplicationTools::message->endLine() << optDesc_->getName(k) << " (concurrent)").endLine();
+    }
+  }
+  clones_.resize(optDesc_->getNumberOfOptimizers());
+  for (size_t a = 0; a < active.size(); a++)
+  {
+    if (!clones_[active[a]])
+      clones_[active[a]].reset(dynamic_cast<Function*>(getFunction()->clone()));
+  }
+
+  // Output streams and metrics are not thread-safe, they are disabled during the concurrent run:
+  vector<OutputStream*> profilers(active.size()), handlers(active.size());
+  vector<unsigned int> verbose(active.size());
+  for (size_t a = 0; a < active.size(); a++)
+  {
+    Optimizer* opt = optDesc_->getOptimizer(active[a]);
+    profilers[a] = opt->getProfiler();
+    handlers[a]  = opt->getMessageHandler();
+    verbose[a]   = opt->getVerbose();
+    opt->setProfiler(0);
+    opt->setMessageHandler(0);
+    opt->setVerbose(0);
+    opt->setFunction(clones_[active[a]].get());
+    dynamic_cast<AbstractOptimizer*>(opt)->setMetrics(0);
+  }
+  auto restore = [&]() {
+      for (size_t a = 0; a < active.size(); a++)
+      {
+        Optimizer* opt = optDesc_->getOptimizer(active[a]);
+        opt->setFunction(getFunction());
+        opt->setProfiler(profilers[a]);
+        opt->setMessageHandler(handlers[a]);
+        opt->setVerbose(verbose[a]);
+        dynamic_cast<AbstractOptimizer*>(opt)->setMetrics(getMetrics());
+      }
+    };
+
+  try
+  {
+    ThreadTools::parallelFor(active.size(), nbThreads_, [&](size_t a, unsigned int) {
+        Function* f = clones_[active[a]].get();
+        // All copies start from the current point:
+        f->setParameters(getParameters());
+        runOptimizer_(active[a], f, tol);
+      });
+  }
+  catch (...)
+  {
+    restore();
+    throw;
+  }
+  restore();
+
+  // Merge all blocks at once:
+  size_t best = 0;
+  for (size_t a = 0; a < active.size(); a++)
+  {
+    nbEval_ += optDesc_->getOptimizer(active[a])->getNumberOfEvaluations();
+    if (clones_[active[a]]->getValue() < clones_[active[best]]->getValue())
+      best = a;
+  }
+  double bestValue = clones_[active[best]]->getValue();
+  ParameterList backup = getParameters();
+  for (size_t a = 0; a < active.size(); a++)
+  {
+    getParameters_().matchParametersValues(optDesc_->getOptimizer(active[a])->getParameters());
+  }
+  getFunction()->setParameters(getParameters());
+  double value = getFunction()->getValue();
+  if (value <= bestValue + NumConstants::TINY() * NumTools::abs(bestValue))
+    return true;
+
+  // The merged point is worse than one block alone: only keep the best block.
+  getParameters_().matchParametersValues(backup);
+  getParameters_().matchParametersValues(optDesc_->getOptimizer(active[best])->getParameters());
+  getFunction()->setParameters(getParameters());
+  return false;
+}
+
+/**************************************************************************/
@@ -46,6 +46,8 @@
 #include "AbstractOptimizer.h"
 
 // From the STL:
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace bpp
@@ -67,15 +69,17 @@ namespace bpp
     std::vector< std::vector<std::string> > parameterNames_;
     std::vector<unsigned short> derivatives_;
     std::vector<std::string> itTypes_;
+    std::vector<unsigned int> groups_;
 
   public:
-    MetaOptimizerInfos() : names_(), optimizers_(), parameterNames_(), derivatives_(), itTypes_() {}
+    MetaOptimizerInfos() : names_(), optimizers_(), parameterNames_(), derivatives_(), itTypes_(), groups_() {}
     MetaOptimizerInfos(const MetaOptimizerInfos& infos) :
       names_(infos.names_),
       optimizers_(infos.optimizers_),
       parameterNames_(infos.parameterNames_),
       derivatives_(infos.derivatives_),
-      itTypes_(infos.itTypes_)
+      itTypes_(infos.itTypes_),
+      groups_(infos.groups_)
     {
       for (unsigned int i = 0; i < optimizers_.size(); i++)
         optimizers_[i] = dynamic_cast<Optimizer*>(infos.optimizers_[i]->clone());
@@ -88,6 +92,7 @@ namespace bpp
       parameterNames_ = infos.parameterNames_;
       derivatives_    = infos.derivatives_;
       itTypes_        = infos.itTypes_;
+      groups_         = infos.groups_;
       for (unsigned int i = 0; i < optimizers_.size(); i++)
         optimizers_[i] = dynamic_cast<Optimizer *>(infos.optimizers_[i]->clone());
       return *this;
@@ -119,8 +124,45 @@ namespace bpp
       parameterNames_.push_back(params);
       derivatives_.push_back(derivatives);
       itTypes_.push_back(type);
+      groups_.push_back(0);
     }
 
+    /**
+     * @brief Declare a set of optimizers as conditionally independent.
+     *
+     * Optimizers are independent if, given the values of all other parameters,
+     * the optimum of the parameters of one optimizer does not depend on the values
+     * of the parameters of the others (for instance, parameters specific to distinct
+     * partitions of the data).
+     * When the MetaOptimizer uses several threads, consecutive optimizers of the
+     * same group are run concurrently on copies of the function, and their results
+     * are merged afterwards. The copies are given with Optimizer::setFunction(), so the
+     * optimizers must not keep any other pointer toward the function.
+     *
+     * @param indices The indices of the optimizers, in the order they were added.
+     * Only consecutive optimizers are run concurrently.
+     * @return The identifier of the new group.
+     * @throw IndexOutOfBoundsException If an index is not valid.
+     */
+    virtual unsigned int setIndependent(const std::vector<size_t>& indices)
+    {
+      unsigned int group = 1;
+      for (size_t i = 0; i < groups_.size(); i++)
+        if (groups_[i] >= group) group = groups_[i] + 1;
+      for (size_t i = 0; i < indices.size(); i++)
+      {
+        if (indices[i] >= groups_.size())
+          throw IndexOutOfBoundsException("MetaOptimizerInfos::setIndependent.", indices[i], 0, groups_.size() - 1);
+        groups_[indices[i]] = group;
+      }
+      return group;
+    }
+
+    /**
+     * @return The independence group of the ith optimizer in the set, or 0 if it was not declared independent of other optimizers.
+     */
+    virtual unsigned int getIndependenceGroup(size_t i) const { return groups_[i]; }
+
     /**
      * @return The display name of the ith optimizer in the set.
      */
@@ -181,6 +223,16 @@ namespace bpp
    * The number of steps @f$n@f$ is set in the constructor of the optimizer.
    *
    * This optimizer can be used with numerical derivatives.
+   *
+   * Block-coordinate parallelism: when several threads are allowed (see setNumberOfThreads()),
+   * consecutive optimizers declared independent with MetaOptimizerInfos::setIndependent()
+   * are run concurrently, each one on its own copy of the function, starting from the same point
+   * (Jacobi iteration). Their parameters are then merged into the main function.
+   * If the merged point is worse than the best point found by one of the optimizers alone,
+   * the parameters were not independent enough: the point is restored and the group is
+   * optimized sequentially (Gauss-Seidel iteration) for this step and a number of following steps,
+   * doubled after each failure and reset after each successful concurrent update.
+   * Messages and profiles of the optimizers are disabled while they run concurrently.
    * 
    * @see MetaOptimizerInfos.
    */
@@ -195,6 +247,12 @@ namespace bpp
     double precisionStep_;
     unsigned int stepCount_;
     double initialValue_;
+    unsigned int nbThreads_;
+    std::vector< std::shared_ptr<Function> > clones_;
+    std::map<unsigned int, unsigned int> sequentialSteps_;
+    std::map<unsigned int, unsigned int> sequentialBackoff_;
+    unsigned int nbConcurrentUpdates_;
+    unsigned int nbSequentialUpdates_;
 		
   public:
     /**
@@ -228,6 +286,31 @@ namespace bpp
     
     double doStep();
 
+    /**
+     * @brief Set the number of threads used to run independent optimizers concurrently.
+     *
+     * @param nbThreads The number of threads. 1 (default) means all optimizers run sequentially,
+     * 0 means all available threads.
+     */
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    /**
+     * @return The number of threads used to run independent optimizers concurrently.
+     */
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+
+    /**
+     * @return The number of group updates since the last initialization
+     * where the optimizers ran concurrently and their merged results were kept.
+     */
+    unsigned int getNumberOfConcurrentUpdates() const { return nbConcurrentUpdates_; }
+
+    /**
+     * @return The number of group updates since the last initialization
+     * where the optimizers ran sequentially, after a rejected merge or while backing off.
+     */
+    unsigned int getNumberOfSequentialUpdates() const { return nbSequentialUpdates_; }
+
     /**
      * @return The MetaOptimizerInfos object associated to this optimizer.
      */
@@ -238,6 +321,19 @@ namespace bpp
      */
     const MetaOptimizerInfos* getOptimizers() const { return optDesc_; }
 
+  protected:
+    /**
+     * @brief Run the ith optimizer on a given function.
+     */
+    void runOptimizer_(size_t i, Function* function, double tol);
+
+    /**
+     * @brief Run the optimizers in [begin, end[ concurrently, and merge their results.
+     *
+     * @return false if the merged point was rejected, in which case parameters are restored.
+     */
+    bool runConcurrently_(size_t begin, size_t end, double tol);
+
   };
 
 } //end of namespace bpp.
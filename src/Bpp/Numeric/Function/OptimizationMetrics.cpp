@@ -0,0 +1,265 @@
+//
+// File: OptimizationMetrics.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "OptimizationMetrics.h"
+
+// From the STL:
+#include <iomanip>
+#include <sstream>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+const size_t OptimizationMetrics::INITIALIZATION      = 0;
+const size_t OptimizationMetrics::STEP                = 1;
+const size_t OptimizationMetrics::FUNCTION_EVALUATION = 2;
+const size_t OptimizationMetrics::DERIVATIVES         = 3;
+const size_t OptimizationMetrics::LINE_SEARCH         = 4;
+const size_t OptimizationMetrics::LISTENERS           = 5;
+const size_t OptimizationMetrics::BOOKKEEPING         = 6;
+
+const size_t OptimizationMetrics::STEPS                  = 0;
+const size_t OptimizationMetrics::FUNCTION_EVALUATIONS   = 1;
+const size_t OptimizationMetrics::DERIVATIVE_EVALUATIONS = 2;
+
+const size_t OptimizationMetrics::NB_BINS = 64;
+
+/******************************************************************************/
+
+OptimizationMetrics::PhaseStatistics::PhaseStatistics(const std::string& phaseName):
+  name(phaseName), count(0), total(0), min(0), max(0), histogram(NB_BINS, 0)
+{}
+
+/******************************************************************************/
+
+OptimizationMetrics::OptimizationMetrics(size_t maxTraceSize):
+  enabled_(true),
+  phases_(),
+  counterNames_(),
+  counters_(),
+  trace_(),
+  maxTraceSize_(maxTraceSize),
+  nbDroppedEvents_(0),
+  depth_(0),
+  origin_(chrono::steady_clock::now())
+{
+  // Order must match the predefined ids:
+  registerPhase("initialization");
+  registerPhase("step");
+  registerPhase("function evaluation");
+  registerPhase("derivatives");
+  registerPhase("line search");
+  registerPhase("listeners");
+  registerPhase("bookkeeping");
+  registerCounter("steps");
+  registerCounter("function evaluations");
+  registerCounter("derivative evaluations");
+}
+
+/******************************************************************************/
+
+size_t OptimizationMetrics::registerPhase(const std::string& name)
+{
+  for (size_t i = 0; i < phases_.size(); ++i)
+  {
+    if (phases_[i].name == name) return i;
+  }
+  phases_.push_back(PhaseStatistics(name));
+  return phases_.size() - 1;
+}
+
+/******************************************************************************/
+
+size_t OptimizationMetrics::registerCounter(const std::string& name)
+{
+  for (size_t i = 0; i < counterNames_.size(); ++i)
+  {
+    if (counterNames_[i] == name) return i;
+  }
+  counterNames_.push_back(name);
+  counters_.push_back(0);
+  return counters_.size() - 1;
+}
+
+/******************************************************************************/
+
+void OptimizationMetrics::record(size_t phase, const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end)
+{
+  if (!enabled_) return;
+  int64_t ns = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+  double seconds = static_cast<double>(ns) * 1e-9;
+  PhaseStatistics& stats = phases_[phase];
+  if (stats.count == 0 || seconds < stats.min) stats.min = seconds;
+  if (stats.count == 0 || seconds > stats.max) stats.max = seconds;
+  stats.count++;
+  stats.total += seconds;
+  size_t bin = 0;
+  for (uint64_t d = static_cast<uint64_t>(ns > 0 ? ns : 0); d > 0 && bin < NB_BINS - 1; d >>= 1)
+  {
+    bin++;
+  }
+  stats.histogram[bin]++;
+
+  if (trace_.size() < maxTraceSize_)
+  {
+    TraceEvent event;
+    event.phase = phase;
+    event.depth = depth_;
+    event.start = chrono::duration_cast<chrono::nanoseconds>(start - origin_).count();
+    event.duration = ns;
+    trace_.push_back(event);
+  }
+  else
+    nbDroppedEvents_++;
+}
+
+/******************************************************************************/
+
+void OptimizationMetrics::reset()
+{
+  for (size_t i = 0; i < phases_.size(); ++i)
+  {
+    phases_[i] = PhaseStatistics(phases_[i].name);
+  }
+  counters_.assign(counters_.size(), 0);
+  trace_.clear();
+  nbDroppedEvents_ = 0;
+  origin_ = chrono::steady_clock::now();
+}
+
+/******************************************************************************/
+
+std::string OptimizationMetrics::escape_(const std::string& s)
+{
+  string r;
+  for (size_t i = 0; i < s.size(); ++i)
+  {
+    if (s[i] == '"' || s[i] == '\\') r += '\\';
+    r += s[i];
+  }
+  return r;
+}
+
+std::string OptimizationMetrics::escapeCsv_(const std::string& s)
+{
+  // Quotes are doubled (RFC 4180):
+  string r;
+  for (size_t i = 0; i < s.size(); ++i)
+  {
+    if (s[i] == '"') r += '"';
+    r += s[i];
+  }
+  return r;
+}
+
+/******************************************************************************/
+
+void OptimizationMetrics::writeChromeTrace(std::ostream& out) const
+{
+  // Formatted locally, to leave the flags of the caller's stream untouched.
+  ostringstream text;
+  // Complete events ('X'), with timestamps in microseconds.
+  text << "{\"traceEvents\":[";
+  for (size_t i = 0; i < trace_.size(); ++i)
+  {
+    const TraceEvent& e = trace_[i];
+    text << (i > 0 ? ",\n" : "\n")
+         << "{\"name\":\"" << escape_(phases_[e.phase].name) << "\",\"cat\":\"optimization\",\"ph\":\"X\""
+         << ",\"ts\":" << fixed << setprecision(3) << static_cast<double>(e.start) * 1e-3
+         << ",\"dur\":" << static_cast<double>(e.duration) * 1e-3
+         << ",\"pid\":0,\"tid\":0,\"args\":{\"depth\":" << e.depth << "}}";
+  }
+  text << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << nbDroppedEvents_ << "}}" << endl;
+  out << text.str() << flush;
+}
+
+/******************************************************************************/
+
+void OptimizationMetrics::writeJson(std::ostream& out) const
+{
+  // Formatted locally, to leave the flags of the caller's stream untouched.
+  ostringstream text;
+  text << "{\"phases\":[";
+  for (size_t i = 0; i < phases_.size(); ++i)
+  {
+    const PhaseStatistics& s = phases_[i];
+    text << (i > 0 ? ",\n" : "\n")
+         << "{\"name\":\"" << escape_(s.name) << "\",\"count\":" << s.count
+         << setprecision(9) << ",\"total\":" << s.total << ",\"min\":" << s.min << ",\"max\":" << s.max
+         << ",\"histogram\":[";
+    for (size_t j = 0; j < s.histogram.size(); ++j)
+    {
+      text << (j > 0 ? "," : "") << s.histogram[j];
+    }
+    text << "]}";
+  }
+  text << "\n],\"counters\":{";
+  for (size_t i = 0; i < counters_.size(); ++i)
+  {
+    text << (i > 0 ? "," : "") << "\"" << escape_(counterNames_[i]) << "\":" << counters_[i];
+  }
+  text << "}}" << endl;
+  out << text.str() << flush;
+}
+
+/******************************************************************************/
+
+void OptimizationMetrics::writeCsv(std::ostream& out) const
+{
+  // Formatted locally, to leave the flags of the caller's stream untouched.
+  ostringstream text;
+  text << "type,name,count,total,mean,min,max" << endl;
+  text << setprecision(9);
+  for (size_t i = 0; i < phases_.size(); ++i)
+  {
+    const PhaseStatistics& s = phases_[i];
+    text << "phase,\"" << escapeCsv_(s.name) << "\"," << s.count << "," << s.total << ","
+         << (s.count > 0 ? s.total / static_cast<double>(s.count) : 0.) << ","
+         << s.min << "," << s.max << endl;
+  }
+  for (size_t i = 0; i < counters_.size(); ++i)
+  {
+    text << "counter,\"" << escapeCsv_(counterNames_[i]) << "\"," << counters_[i] << ",,,," << endl;
+  }
+  out << text.str() << flush;
+}
+
+/******************************************************************************/
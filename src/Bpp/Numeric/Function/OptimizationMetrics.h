@@ -0,0 +1,393 @@
+//
+// File: OptimizationMetrics.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _OPTIMIZATIONMETRICS_H_
+#define _OPTIMIZATIONMETRICS_H_
+
+#include "Functions.h"
+
+// From the STL:
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+
+  /**
+   * @brief Structured performance metrics for optimizers.
+   *
+   * This class records:
+   * - the number of occurrences and the durations of timed phases, with a
+   *   histogram of durations using logarithmic (power of two nanoseconds) bins;
+   * - named event counters;
+   * - a trace of all timed intervals, with their nesting depth, which can be
+   *   exported in the Chrome trace event format (chrome://tracing, Perfetto).
+   *
+   * Phases and counters are identified by integer ids, so that no string
+   * operation occurs while recording. Predefined phases are used by the
+   * optimizers of the library; others can be registered with registerPhase().
+   *
+   * An optimizer records metrics only if an instance of this class is attached
+   * to it with AbstractOptimizer::setMetrics(). When no instance is attached, or
+   * when it is disabled, the instrumentation costs a single test per timed phase.
+   * Function evaluations and derivative computations are timed by wrapping the
+   * optimized function into an InstrumentedFunctionWrapper (or one of its derivable
+   * versions).
+   *
+   * Instances are not thread-safe: each thread must use its own instance.
+   */
+  class OptimizationMetrics
+  {
+  public:
+    /**
+     * @name Predefined phases.
+     *
+     * @{
+     */
+    static const size_t INITIALIZATION;
+    static const size_t STEP;
+    static const size_t FUNCTION_EVALUATION;
+    static const size_t DERIVATIVES;
+    static const size_t LINE_SEARCH;
+    static const size_t LISTENERS;
+    static const size_t BOOKKEEPING;
+    /** @} */
+
+    /**
+     * @name Predefined counters.
+     *
+     * @{
+     */
+    static const size_t STEPS;
+    static const size_t FUNCTION_EVALUATIONS;
+    static const size_t DERIVATIVE_EVALUATIONS;
+    /** @} */
+
+    /**
+     * @brief Number of bins in duration histograms.
+     *
+     * Bin i counts durations d (in nanoseconds) with @f$2^{i-1} \leq d < 2^i@f$,
+     * bin 0 counting null durations.
+     */
+    static const size_t NB_BINS;
+
+    /**
+     * @brief Statistics about a timed phase.
+     */
+    struct PhaseStatistics
+    {
+      std::string name;
+      uint64_t count;
+      double total;
+      double min;
+      double max;
+      std::vector<uint64_t> histogram;
+
+      PhaseStatistics(const std::string& phaseName);
+    };
+
+    /**
+     * @brief Time a phase during the lifetime of the object.
+     *
+     * Timers may be nested. A timer created with a null or disabled OptimizationMetrics object does nothing.
+     */
+    class ScopedTimer
+    {
+    private:
+      OptimizationMetrics* metrics_;
+      size_t phase_;
+      std::chrono::steady_clock::time_point start_;
+
+    public:
+      ScopedTimer(OptimizationMetrics* metrics, size_t phase):
+        metrics_(metrics && metrics->isEnabled() ? metrics : 0),
+        phase_(phase),
+        start_()
+      {
+        if (metrics_)
+        {
+          metrics_->depth_++;
+          start_ = std::chrono::steady_clock::now();
+        }
+      }
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      ~ScopedTimer()
+      {
+        if (metrics_)
+        {
+          metrics_->depth_--;
+          metrics_->record(phase_, start_, std::chrono::steady_clock::now());
+        }
+      }
+    };
+
+    /**
+     * @brief A record of the trace.
+     */
+    struct TraceEvent
+    {
+      size_t phase;
+      unsigned int depth;
+      int64_t start; // nanoseconds since reset
+      int64_t duration; // nanoseconds
+    };
+
+  private:
+    bool enabled_;
+    std::vector<PhaseStatistics> phases_;
+    std::vector<std::string> counterNames_;
+    std::vector<uint64_t> counters_;
+    std::vector<TraceEvent> trace_;
+    size_t maxTraceSize_;
+    uint64_t nbDroppedEvents_;
+    unsigned int depth_;
+    std::chrono::steady_clock::time_point origin_;
+
+  public:
+    /**
+     * @param maxTraceSize The maximum number of trace events kept in memory.
+     * Further events are still counted in the statistics, but not traced.
+     */
+    OptimizationMetrics(size_t maxTraceSize = 1000000);
+
+    virtual ~OptimizationMetrics() {}
+
+  public:
+    void enable(bool yn) { enabled_ = yn; }
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief Register a new timed phase.
+     *
+     * @param name The name of the phase.
+     * @return The id of the phase, or the id of the existing phase with the same name.
+     */
+    size_t registerPhase(const std::string& name);
+
+    /**
+     * @brief Register a new counter.
+     *
+     * @param name The name of the counter.
+     * @return The id of the counter, or the id of the existing counter with the same name.
+     */
+    size_t registerCounter(const std::string& name);
+
+    /**
+     * @brief Increment a counter, if metrics are enabled.
+     */
+    void count(size_t counter, uint64_t n = 1)
+    {
+      if (enabled_) counters_[counter] += n;
+    }
+
+    /**
+     * @brief Record a timed interval, if metrics are enabled.
+     */
+    void record(size_t phase, const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+
+    /**
+     * @brief Clear all statistics, counters and trace, and restart the clock.
+     */
+    void reset();
+
+    size_t getNumberOfPhases() const { return phases_.size(); }
+    const PhaseStatistics& getPhaseStatistics(size_t phase) const { return phases_[phase]; }
+
+    size_t getNumberOfCounters() const { return counters_.size(); }
+    const std::string& getCounterName(size_t counter) const { return counterNames_[counter]; }
+    uint64_t getCounter(size_t counter) const { return counters_[counter]; }
+
+    const std::vector<TraceEvent>& getTrace() const { return trace_; }
+
+    /**
+     * @return The number of events not kept in the trace because its maximum size was reached.
+     */
+    uint64_t getNumberOfDroppedEvents() const { return nbDroppedEvents_; }
+
+    /**
+     * @brief Write the trace in the Chrome trace event JSON format.
+     */
+    void writeChromeTrace(std::ostream& out) const;
+
+    /**
+     * @brief Write phase statistics (with histograms) and counters as a JSON object.
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @brief Write phase statistics and counters in CSV format.
+     *
+     * Columns are: type (phase or counter), name, count, total, mean, min and max durations in seconds.
+     */
+    void writeCsv(std::ostream& out) const;
+
+  private:
+    static std::string escape_(const std::string& s);
+    static std::string escapeCsv_(const std::string& s);
+  };
+
+
+
+
+  /**
+   * @brief Time and count function evaluations.
+   *
+   * Each call to setParameters() or f() is recorded as a FUNCTION_EVALUATION phase.
+   *
+   * @see OptimizationMetrics
+   */
+  class InstrumentedFunctionWrapper:
+    public virtual FunctionWrapper
+  {
+  protected:
+    OptimizationMetrics* metrics_;
+
+  public:
+    InstrumentedFunctionWrapper(Function* function, OptimizationMetrics* metrics):
+      FunctionWrapper(function), metrics_(metrics) {}
+    InstrumentedFunctionWrapper(const InstrumentedFunctionWrapper& ifw):
+      FunctionWrapper(ifw), metrics_(ifw.metrics_) {}
+    InstrumentedFunctionWrapper& operator=(const InstrumentedFunctionWrapper& ifw)
+    {
+      FunctionWrapper::operator=(ifw);
+      metrics_ = ifw.metrics_;
+      return *this;
+    }
+    virtual ~InstrumentedFunctionWrapper() {}
+
+    InstrumentedFunctionWrapper* clone() const { return new InstrumentedFunctionWrapper(*this); }
+
+  public:
+    void setParameters(const ParameterList& parameters)
+    {
+      OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::FUNCTION_EVALUATION);
+      if (metrics_) metrics_->count(OptimizationMetrics::FUNCTION_EVALUATIONS);
+      function_->setParameters(parameters);
+    }
+
+    double f(const ParameterList& parameters)
+    {
+      setParameters(parameters);
+      return function_->getValue();
+    }
+
+    OptimizationMetrics* getMetrics() { return metrics_; }
+  };
+
+  /**
+   * @brief Time and count function evaluations and first order derivatives.
+   *
+   * Calls to getFirstOrderDerivative() are recorded as DERIVATIVES phases.
+   */
+  class InstrumentedDerivableFirstOrderWrapper:
+    public virtual InstrumentedFunctionWrapper,
+    public virtual DerivableFirstOrder
+  {
+  public:
+    InstrumentedDerivableFirstOrderWrapper(DerivableFirstOrder* function, OptimizationMetrics* metrics):
+      FunctionWrapper(function), InstrumentedFunctionWrapper(function, metrics) {}
+    virtual ~InstrumentedDerivableFirstOrderWrapper() {}
+
+    InstrumentedDerivableFirstOrderWrapper* clone() const { return new InstrumentedDerivableFirstOrderWrapper(*this); }
+
+  public:
+    void enableFirstOrderDerivatives(bool yn) {
+      dynamic_cast<DerivableFirstOrder*>(function_)->enableFirstOrderDerivatives(yn);
+    }
+
+    bool enableFirstOrderDerivatives() const {
+      return dynamic_cast<DerivableFirstOrder*>(function_)->enableFirstOrderDerivatives();
+    }
+
+    double getFirstOrderDerivative(const std::string& variable) const {
+      OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::DERIVATIVES);
+      if (metrics_) metrics_->count(OptimizationMetrics::DERIVATIVE_EVALUATIONS);
+      return dynamic_cast<DerivableFirstOrder*>(function_)->getFirstOrderDerivative(variable);
+    }
+  };
+
+  /**
+   * @brief Time and count function evaluations and derivatives.
+   *
+   * Calls to getSecondOrderDerivative() are recorded as DERIVATIVES phases.
+   */
+  class InstrumentedDerivableSecondOrderWrapper:
+    public virtual InstrumentedDerivableFirstOrderWrapper,
+    public virtual DerivableSecondOrder
+  {
+  public:
+    InstrumentedDerivableSecondOrderWrapper(DerivableSecondOrder* function, OptimizationMetrics* metrics):
+      FunctionWrapper(function),
+      InstrumentedFunctionWrapper(function, metrics),
+      InstrumentedDerivableFirstOrderWrapper(function, metrics) {}
+    virtual ~InstrumentedDerivableSecondOrderWrapper() {}
+
+    InstrumentedDerivableSecondOrderWrapper* clone() const { return new InstrumentedDerivableSecondOrderWrapper(*this); }
+
+  public:
+    void enableSecondOrderDerivatives(bool yn) {
+      dynamic_cast<DerivableSecondOrder*>(function_)->enableSecondOrderDerivatives(yn);
+    }
+
+    bool enableSecondOrderDerivatives() const {
+      return dynamic_cast<DerivableSecondOrder*>(function_)->enableSecondOrderDerivatives();
+    }
+
+    double getSecondOrderDerivative(const std::string& variable) const {
+      OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::DERIVATIVES);
+      if (metrics_) metrics_->count(OptimizationMetrics::DERIVATIVE_EVALUATIONS);
+      return dynamic_cast<DerivableSecondOrder*>(function_)->getSecondOrderDerivative(variable);
+    }
+
+    double getSecondOrderDerivative(const std::string& variable1, const std::string& variable2) const {
+      OptimizationMetrics::ScopedTimer timer(metrics_, OptimizationMetrics::DERIVATIVES);
+      if (metrics_) metrics_->count(OptimizationMetrics::DERIVATIVE_EVALUATIONS);
+      return dynamic_cast<DerivableSecondOrder*>(function_)->getSecondOrderDerivative(variable1, variable2);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_OPTIMIZATIONMETRICS_H_
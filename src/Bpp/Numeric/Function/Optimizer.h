@@ -363,6 +363,9 @@ namespace bpp
 
   /**
    * @brief Save intermediate optimization results to file.
+   *
+   * The file is rewritten synchronously at each step. For long optimizations,
+   * prefer the asynchronous CheckpointListener.
    */
   class BackupListener:
     public OptimizationListener
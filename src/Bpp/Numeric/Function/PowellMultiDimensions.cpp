@@ -113,9 +113,12 @@ double PowellMultiDimensions::doStep()
       xit[j] = xi_[j][i];
     }
     fptt = fret_;
-    nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
-        getParameters_(), xit, getStopCondition()->getTolerance(),
-        0, getMessageHandler(), getVerbose() > 0 ? getVerbose() - 1 : 0);
+    {
+      OptimizationMetrics::ScopedTimer timer(getMetrics(), OptimizationMetrics::LINE_SEARCH);
+      nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
+          getParameters_(), xit, getStopCondition()->getTolerance(),
+          0, getMessageHandler(), getVerbose() > 0 ? getVerbose() - 1 : 0);
+    }
     fret_ = getFunction()->f(getParameters());
     if (getVerbose() > 2) printPoint(getParameters(), fret_);
     if (fret_ > fp_) throw Exception("DEBUG: PowellMultiDimensions::doStep(). Line minimization failed!");
@@ -140,9 +143,12 @@ double PowellMultiDimensions::doStep()
     if (t < 0.0)
     {
       //cout << endl << "New direction: drection " << ibig << " removed." << endl;
-      nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
-          getParameters_(), xit, getStopCondition()->getTolerance(),
-          0, getMessageHandler(), getVerbose() > 0 ? getVerbose() - 1 : 0);
+      {
+        OptimizationMetrics::ScopedTimer timer(getMetrics(), OptimizationMetrics::LINE_SEARCH);
+        nbEval_ += OneDimensionOptimizationTools::lineMinimization(f1dim_,
+            getParameters_(), xit, getStopCondition()->getTolerance(),
+            0, getMessageHandler(), getVerbose() > 0 ? getVerbose() - 1 : 0);
+      }
       fret_ = getFunction()->f(getParameters());
       if (fret_ > fp_)
         throw Exception("DEBUG: PowellMultiDimensions::doStep(). Line minimization failed!");
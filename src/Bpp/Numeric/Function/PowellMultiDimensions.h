@@ -101,6 +101,12 @@ class PowellMultiDimensions:
 		 * @{
 		 */		
 		double optimize();
+
+    void setFunction(Function* function)
+    {
+      AbstractOptimizer::setFunction(function);
+      f1dim_.setFunction(function);
+    }
 		/** @} */
 
 		void doInit(const ParameterList & params);
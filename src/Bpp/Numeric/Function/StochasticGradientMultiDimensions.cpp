@@ -0,0 +1,279 @@
+//
+// File: StochasticGradientMultiDimensions.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "StochasticGradientMultiDimensions.h"
+#include "BfgsMultiDimensions.h"
+#include "../Random/RandomTools.h"
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+string StochasticGradientMultiDimensions::METHOD_ADAM = "Adam";
+string StochasticGradientMultiDimensions::METHOD_SVRG = "SVRG";
+
+/******************************************************************************/
+
+StochasticGradientMultiDimensions::StochasticGradientMultiDimensions(SumDecomposableFunction* function, const std::string& method):
+  AbstractOptimizer(function),
+  sdFunction_(function), method_(), batchSize_(32), learningRate_(0.01),
+  beta1_(0.9), beta2_(0.999), epsilon_(1e-8), polish_(true), polishMaxSteps_(1000),
+  point_(), snapshot_(), m_(), v_(), gradient_(), snapshotGradient_(), fullGradient_(),
+  order_(), batch_(), nbUpdates_(0), nbComponentEvaluations_(0)
+{
+  setMethod(method);
+  nbEvalMax_ = 100;
+  setDefaultStopCondition_(new FunctionStopCondition(this));
+  setStopCondition(*getDefaultStopCondition());
+}
+
+/******************************************************************************/
+
+StochasticGradientMultiDimensions::StochasticGradientMultiDimensions(const StochasticGradientMultiDimensions& opt):
+  AbstractOptimizer(opt),
+  sdFunction_(opt.sdFunction_), method_(opt.method_), batchSize_(opt.batchSize_),
+  learningRate_(opt.learningRate_), beta1_(opt.beta1_), beta2_(opt.beta2_), epsilon_(opt.epsilon_),
+  polish_(opt.polish_), polishMaxSteps_(opt.polishMaxSteps_),
+  point_(opt.point_), snapshot_(opt.snapshot_), m_(opt.m_), v_(opt.v_),
+  gradient_(opt.gradient_), snapshotGradient_(opt.snapshotGradient_), fullGradient_(opt.fullGradient_),
+  order_(opt.order_), batch_(opt.batch_),
+  nbUpdates_(opt.nbUpdates_), nbComponentEvaluations_(opt.nbComponentEvaluations_)
+{}
+
+/******************************************************************************/
+
+StochasticGradientMultiDimensions& StochasticGradientMultiDimensions::operator=(const StochasticGradientMultiDimensions& opt)
+{
+  AbstractOptimizer::operator=(opt);
+  sdFunction_             = opt.sdFunction_;
+  method_                 = opt.method_;
+  batchSize_              = opt.batchSize_;
+  learningRate_           = opt.learningRate_;
+  beta1_                  = opt.beta1_;
+  beta2_                  = opt.beta2_;
+  epsilon_                = opt.epsilon_;
+  polish_                 = opt.polish_;
+  polishMaxSteps_         = opt.polishMaxSteps_;
+  point_                  = opt.point_;
+  snapshot_               = opt.snapshot_;
+  m_                      = opt.m_;
+  v_                      = opt.v_;
+  gradient_               = opt.gradient_;
+  snapshotGradient_       = opt.snapshotGradient_;
+  fullGradient_           = opt.fullGradient_;
+  order_                  = opt.order_;
+  batch_                  = opt.batch_;
+  nbUpdates_              = opt.nbUpdates_;
+  nbComponentEvaluations_ = opt.nbComponentEvaluations_;
+  return *this;
+}
+
+/******************************************************************************/
+
+void StochasticGradientMultiDimensions::setFunction(Function* function)
+{
+  SumDecomposableFunction* sdf = dynamic_cast<SumDecomposableFunction*>(function);
+  if (function && !sdf)
+    throw Exception("StochasticGradientMultiDimensions::setFunction. The function must be a SumDecomposableFunction.");
+  AbstractOptimizer::setFunction(function);
+  sdFunction_ = sdf;
+}
+
+/******************************************************************************/
+
+void StochasticGradientMultiDimensions::setMethod(const std::string& method)
+{
+  if (method != METHOD_ADAM && method != METHOD_SVRG)
+    throw Exception("StochasticGradientMultiDimensions::setMethod. Unknown method: " + method + ".");
+  method_ = method;
+}
+
+/******************************************************************************/
+
+void StochasticGradientMultiDimensions::doInit(const ParameterList& params)
+{
+  size_t nc = sdFunction_->getNumberOfComponents();
+  if (nc == 0)
+    throw Exception("StochasticGradientMultiDimensions::doInit. The function has no component.");
+  size_t n = getParameters().size();
+  point_ = getParameters();
+  snapshot_ = getParameters();
+  m_.assign(n, 0.);
+  v_.assign(n, 0.);
+  gradient_.assign(n, 0.);
+  snapshotGradient_.assign(n, 0.);
+  fullGradient_.assign(n, 0.);
+  order_.resize(nc);
+  for (size_t i = 0; i < nc; ++i)
+  {
+    order_[i] = i;
+  }
+  batch_.reserve(min(batchSize_, nc));
+  nbUpdates_ = 0;
+  nbComponentEvaluations_ = 0;
+  if (method_ == METHOD_SVRG)
+    computeFullGradient_();
+  getFunction_()->setParameters(getParameters());
+}
+
+/******************************************************************************/
+
+double StochasticGradientMultiDimensions::computeFullGradient_()
+{
+  snapshot_.matchParametersValues(point_);
+  double value = computeComponents_(snapshot_, order_, fullGradient_);
+  for (size_t j = 0; j < fullGradient_.size(); ++j)
+  {
+    fullGradient_[j] /= static_cast<double>(order_.size());
+  }
+  return value;
+}
+
+/******************************************************************************/
+
+double StochasticGradientMultiDimensions::computeComponents_(const ParameterList& parameters, const std::vector<size_t>& components, Vdouble& gradient)
+{
+  double value = sdFunction_->computeComponents(parameters, components, gradient);
+  nbComponentEvaluations_ += components.size();
+  if (gradient.size() != parameters.size())
+    throw Exception("StochasticGradientMultiDimensions::computeComponents_. Gradient size does not match the number of parameters.");
+  return value;
+}
+
+/******************************************************************************/
+
+double StochasticGradientMultiDimensions::doStep()
+{
+  size_t n = point_.size();
+  size_t nc = order_.size();
+  bool svrg = (method_ == METHOD_SVRG);
+
+  // Shuffle the components (Fisher-Yates):
+  for (size_t i = nc - 1; i > 0; --i)
+  {
+    size_t j = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(i + 1);
+    swap(order_[i], order_[j]);
+  }
+
+  // SVRG: the full gradient at the snapshot point was computed at the end of the previous epoch.
+  for (size_t b = 0; b < nc; b += batchSize_)
+  {
+    batch_.assign(order_.begin() + static_cast<ptrdiff_t>(b), order_.begin() + static_cast<ptrdiff_t>(min(b + batchSize_, nc)));
+    double scale = 1. / static_cast<double>(batch_.size());
+    computeComponents_(point_, batch_, gradient_);
+    if (svrg)
+      computeComponents_(snapshot_, batch_, snapshotGradient_);
+    nbUpdates_++;
+
+    double bc1 = 1. - pow(beta1_, static_cast<double>(nbUpdates_));
+    double bc2 = 1. - pow(beta2_, static_cast<double>(nbUpdates_));
+    for (size_t j = 0; j < n; ++j)
+    {
+      double x = point_[j].getValue();
+      if (svrg)
+      {
+        double g = (gradient_[j] - snapshotGradient_[j]) * scale + fullGradient_[j];
+        x -= learningRate_ * g;
+      }
+      else
+      {
+        double g = gradient_[j] * scale;
+        m_[j] = beta1_ * m_[j] + (1. - beta1_) * g;
+        v_[j] = beta2_ * v_[j] + (1. - beta2_) * g * g;
+        x -= learningRate_ * (m_[j] / bc1) / (sqrt(v_[j] / bc2) + epsilon_);
+      }
+      shared_ptr<Constraint> constraint = point_[j].getConstraint();
+      if (constraint && !constraint->isCorrect(x))
+        x = constraint->getAcceptedLimit(x);
+      point_[j].setValue(x);
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j)
+  {
+    getParameter_(j).setValue(point_[j].getValue());
+  }
+
+  // The stop condition compares the full function values at the end of each epoch,
+  // sums over mini-batches are too noisy for that.
+  // For SVRG, this is the value of the full gradient computation of the next epoch.
+  if (svrg)
+    return computeFullGradient_();
+  nbComponentEvaluations_ += nc;
+  return getFunction_()->f(getParameters());
+}
+
+/******************************************************************************/
+
+double StochasticGradientMultiDimensions::optimize()
+{
+  AbstractOptimizer::optimize();
+  if (polish_)
+  {
+    BfgsMultiDimensions bfgs(sdFunction_);
+    bfgs.setProfiler(0);
+    bfgs.setMessageHandler(0);
+    bfgs.setVerbose(0);
+    bfgs.setConstraintPolicy(getConstraintPolicy());
+    bfgs.setMetrics(getMetrics());
+    bfgs.getStopCondition()->setTolerance(getStopCondition()->getTolerance());
+    bfgs.setMaximumNumberOfEvaluations(polishMaxSteps_);
+    bfgs.init(getParameters());
+    currentValue_ = bfgs.optimize();
+    const ParameterList& pl = bfgs.getParameters();
+    for (size_t j = 0; j < pl.size(); ++j)
+    {
+      getParameter_(j).setValue(pl[j].getValue());
+    }
+    point_.matchParametersValues(pl);
+  }
+  else
+  {
+    currentValue_ = getFunction_()->f(getParameters());
+  }
+  return currentValue_;
+}
+
+/******************************************************************************/
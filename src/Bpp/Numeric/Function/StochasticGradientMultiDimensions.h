@@ -0,0 +1,241 @@
+//
+// File: StochasticGradientMultiDimensions.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _STOCHASTICGRADIENTMULTIDIMENSIONS_H_
+#define _STOCHASTICGRADIENTMULTIDIMENSIONS_H_
+
+#include "AbstractOptimizer.h"
+#include "../VectorTools.h"
+
+// From the STL:
+#include <cstdint>
+
+namespace bpp
+{
+
+/**
+ * @brief Mini-batch stochastic gradient optimizer for sums of independent components.
+ *
+ * This optimizer minimizes a SumDecomposableFunction
+ * @f$ f(\theta) = \sum_{i=0}^{n-1} f_i(\theta) @f$
+ * by following gradients estimated on random subsets (mini-batches) of the components.
+ * Each step of the optimizer corresponds to an epoch: the components are randomly
+ * shuffled, then split into consecutive mini-batches, each one of them leading to an
+ * update of the parameters. Two update rules are available:
+ * - METHOD_ADAM (default): the adaptive moment estimation method of
+ *   Kingma and Ba (2015), which rescales each coordinate of the gradient
+ *   according to running estimates of its first and second moments;
+ * - METHOD_SVRG: the stochastic variance reduced gradient method of Johnson and Zhang (2013).
+ *   The full gradient is computed at the beginning of each epoch, and used to correct the
+ *   mini-batch gradients, which allows a constant learning rate to converge.
+ *
+ * The function value reported at each step is the full function value at the end of the
+ * epoch, so that the stop condition is not fooled by the noise of the mini-batch values.
+ * With Adam, this costs one more pass over the components per epoch. With SVRG, it is
+ * obtained from the full gradient computation at the start of the next epoch.
+ * Since stochastic updates hardly reach a precise optimum, the optimization ends by
+ * default with a full-batch polish, using BfgsMultiDimensions from the point found by the
+ * stochastic phase. On large data sets, most of the way towards the optimum is hence
+ * performed with a fraction of the component evaluations of a full-batch optimizer.
+ *
+ * Parameters which do not satisfy their constraint after an update are moved to the
+ * closest accepted value.
+ * Random numbers are drawn with RandomTools, so results are reproducible with
+ * RandomTools::setSeed().
+ *
+ * References:
+ * <pre>
+ * D.P. Kingma and J. Ba (2015), Adam: a method for stochastic optimization. ICLR 2015.
+ * R. Johnson and T. Zhang (2013), Accelerating stochastic gradient descent using predictive
+ * variance reduction. NIPS 26.
+ * </pre>
+ */
+class StochasticGradientMultiDimensions:
+  public AbstractOptimizer
+{
+  public:
+    static std::string METHOD_ADAM;
+    static std::string METHOD_SVRG;
+
+  private:
+    SumDecomposableFunction* sdFunction_;
+    std::string method_;
+    size_t batchSize_;
+    double learningRate_;
+    double beta1_;
+    double beta2_;
+    double epsilon_;
+    bool polish_;
+    unsigned int polishMaxSteps_;
+
+    // Optimizer state:
+    ParameterList point_;
+    ParameterList snapshot_;
+    Vdouble m_;
+    Vdouble v_;
+    Vdouble gradient_;
+    Vdouble snapshotGradient_;
+    Vdouble fullGradient_;
+    std::vector<size_t> order_;
+    std::vector<size_t> batch_;
+    uint64_t nbUpdates_;
+    uint64_t nbComponentEvaluations_;
+
+  public:
+    /**
+     * @brief Build a new stochastic gradient optimizer.
+     *
+     * @param function A pointer toward the function to minimize.
+     * @param method   The update rule, METHOD_ADAM or METHOD_SVRG.
+     */
+    StochasticGradientMultiDimensions(SumDecomposableFunction* function, const std::string& method = METHOD_ADAM);
+
+    StochasticGradientMultiDimensions(const StochasticGradientMultiDimensions& opt);
+
+    StochasticGradientMultiDimensions& operator=(const StochasticGradientMultiDimensions& opt);
+
+    virtual ~StochasticGradientMultiDimensions() {}
+
+    StochasticGradientMultiDimensions* clone() const { return new StochasticGradientMultiDimensions(*this); }
+
+  public:
+    void setFunction(Function* function);
+
+    void doInit(const ParameterList& params);
+
+    double doStep();
+
+    /**
+     * @brief Run the stochastic epochs, then the full-batch polish if enabled.
+     *
+     * @return The function value at the optimum found.
+     */
+    double optimize();
+
+    /**
+     * @brief Set the update rule.
+     *
+     * @param method METHOD_ADAM or METHOD_SVRG.
+     * @throw Exception If the method is unknown.
+     */
+    void setMethod(const std::string& method);
+
+    /**
+     * @return The update rule.
+     */
+    const std::string& getMethod() const { return method_; }
+
+    /**
+     * @brief Set the number of components per mini-batch (default: 32).
+     *
+     * @param batchSize The mini-batch size.
+     */
+    void setBatchSize(size_t batchSize) { batchSize_ = (batchSize > 0 ? batchSize : 1); }
+
+    /**
+     * @return The number of components per mini-batch.
+     */
+    size_t getBatchSize() const { return batchSize_; }
+
+    /**
+     * @brief Set the learning rate (default: 0.01).
+     *
+     * For SVRG, updates are made along the gradient of the mean component,
+     * @f$\nabla f/n@f$, so the learning rate should be of the order of
+     * the inverse of the largest curvature of a single component.
+     *
+     * @param rate The learning rate.
+     */
+    void setLearningRate(double rate) { learningRate_ = rate; }
+
+    /**
+     * @return The learning rate.
+     */
+    double getLearningRate() const { return learningRate_; }
+
+    /**
+     * @brief Set the decay rates of the moment estimates of Adam (default: 0.9 and 0.999).
+     *
+     * @param beta1 The decay rate of the first moment.
+     * @param beta2 The decay rate of the second moment.
+     */
+    void setMomentDecayRates(double beta1, double beta2) { beta1_ = beta1; beta2_ = beta2; }
+
+    /**
+     * @brief Enable or disable the full-batch polish at the end of the optimization (default: enabled).
+     *
+     * @param yn yes/no.
+     * @param maxSteps The maximum number of steps of the polish.
+     */
+    void setPolish(bool yn, unsigned int maxSteps = 1000) { polish_ = yn; polishMaxSteps_ = maxSteps; }
+
+    /**
+     * @return True if the optimization ends with a full-batch polish.
+     */
+    bool getPolish() const { return polish_; }
+
+    /**
+     * @return The number of parameter updates performed so far.
+     */
+    uint64_t getNumberOfUpdates() const { return nbUpdates_; }
+
+    /**
+     * @return The number of component evaluations performed by the stochastic phase
+     * (the polish evaluates the full function, and is not counted).
+     */
+    uint64_t getNumberOfComponentEvaluations() const { return nbComponentEvaluations_; }
+
+  protected:
+    /**
+     * @brief Compute a partial sum and its gradient, and update the evaluation counter.
+     */
+    double computeComponents_(const ParameterList& parameters, const std::vector<size_t>& components, Vdouble& gradient);
+
+    /**
+     * @brief Compute the full gradient of the mean component at the current point, which becomes the snapshot of SVRG.
+     *
+     * @return The function value at this point.
+     */
+    double computeFullGradient_();
+};
+
+} //end of namespace bpp.
+
+#endif //_STOCHASTICGRADIENTMULTIDIMENSIONS_H_
@@ -42,6 +42,8 @@
 #include "../Random/RandomTools.h"
 #include "../VectorTools.h"
 
+#include <algorithm>
+
 using namespace bpp;
 using namespace std;
 
@@ -52,7 +54,16 @@ AbstractDiscreteDistribution::AbstractDiscreteDistribution(size_t nbClasses, con
   distribution_(),
   bounds_(nbClasses-1),
   intMinMax_(new IntervalConstraint(-NumConstants::VERY_BIG(), NumConstants::VERY_BIG(), true, true)),
-  median_(false)
+  median_(false),
+  categories_(),
+  probabilities_(),
+  cumulative_(),
+  arraysAreUpToDate_(false),
+  sampler_(),
+  samplerIsUpToDate_(false),
+  cacheMutex_(),
+  discretizations_(),
+  discretizationCacheSize_(8)
 {}
 
 AbstractDiscreteDistribution::AbstractDiscreteDistribution(size_t nbClasses, double delta, const std::string& prefix) :
@@ -61,7 +72,16 @@ AbstractDiscreteDistribution::AbstractDiscreteDistribution(size_t nbClasses, dou
   distribution_(Order(delta)),
   bounds_(nbClasses-1),
   intMinMax_(new IntervalConstraint(-NumConstants::VERY_BIG(), NumConstants::VERY_BIG(),true, true)),
-  median_(false)
+  median_(false),
+  categories_(),
+  probabilities_(),
+  cumulative_(),
+  arraysAreUpToDate_(false),
+  sampler_(),
+  samplerIsUpToDate_(false),
+  cacheMutex_(),
+  discretizations_(),
+  discretizationCacheSize_(8)
 {}
 
 AbstractDiscreteDistribution::AbstractDiscreteDistribution(const AbstractDiscreteDistribution& adde) :
@@ -70,7 +90,16 @@ AbstractDiscreteDistribution::AbstractDiscreteDistribution(const AbstractDiscret
   distribution_(adde.distribution_),
   bounds_(adde.bounds_),
   intMinMax_(adde.intMinMax_->clone()),
-  median_(adde.median_)
+  median_(adde.median_),
+  categories_(),
+  probabilities_(),
+  cumulative_(),
+  arraysAreUpToDate_(false),
+  sampler_(),
+  samplerIsUpToDate_(false),
+  cacheMutex_(),
+  discretizations_(adde.discretizations_),
+  discretizationCacheSize_(adde.discretizationCacheSize_)
 {
 }
 
@@ -82,6 +111,9 @@ AbstractDiscreteDistribution& AbstractDiscreteDistribution::operator=(const Abst
   bounds_=adde.bounds_;
   intMinMax_=std::shared_ptr<IntervalConstraint>(adde.intMinMax_->clone());
   median_=adde.median_;
+  discretizations_=adde.discretizations_;
+  discretizationCacheSize_=adde.discretizationCacheSize_;
+  distributionChanged_();
 
   return *this;
 }
@@ -110,63 +142,36 @@ void AbstractDiscreteDistribution::setNumberOfCategories(size_t nbClasses)
 
 double AbstractDiscreteDistribution::getCategory(size_t categoryIndex) const
 {
-  map<double, double>::const_iterator it = distribution_.begin();
-  for (unsigned int i = 0; i < categoryIndex; i++)
-  {
-    it++;
-  }
-  return it->first;
+  return getCategoriesArray()[categoryIndex];
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getProbability(size_t categoryIndex) const
 {
-  map<double, double>::const_iterator it = distribution_.begin();
-  for (unsigned int i = 0; i < categoryIndex; i++)
-  {
-    it++;
-  }
-  return it->second;
+  return getProbabilitiesArray()[categoryIndex];
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getProbability(double category) const
 {
-  return distribution_.find(category)->second;
+  size_t i = findCategory_(category);
+  return (i < probabilities_.size() ? probabilities_[i] : 0.);
 }
 
 /******************************************************************************/
 
 Vdouble AbstractDiscreteDistribution::getCategories() const
 {
-  Vdouble result(distribution_.size());
-  unsigned int i = 0;
-  for (map<double, double>::const_iterator it = distribution_.begin();
-       it != distribution_.end();
-       it++)
-  {
-    result[i] = it->first;
-    i++;
-  }
-  return result;
+  return getCategoriesArray();
 }
 
 /******************************************************************************/
 
 Vdouble AbstractDiscreteDistribution::getProbabilities() const
 {
-  Vdouble result(distribution_.size());
-  size_t i = 0;
-  for (map<double, double>::const_iterator it = distribution_.begin();
-       it != distribution_.end();
-       it++)
-  {
-    result[i] = it->second;
-    i++;
-  }
-  return result;
+  return getProbabilitiesArray();
 }
 
 /******************************************************************************/
@@ -174,6 +179,7 @@ Vdouble AbstractDiscreteDistribution::getProbabilities() const
 void AbstractDiscreteDistribution::set(double category, double probability)
 {
   distribution_[category] = probability;
+  distributionChanged_();
 }
 
 /******************************************************************************/
@@ -190,88 +196,98 @@ void AbstractDiscreteDistribution::add(double category, double probability)
     // existing category
     distribution_[category] += probability;
   }
+  distributionChanged_();
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::rand() const
 {
-  double r = RandomTools::giveRandomNumberBetweenZeroAndEntry(1);
-  double cumprob = 0;
-  for (map<double, double>::const_iterator i = distribution_.begin();
-       i != distribution_.end();
-       i++)
+  if (!samplerIsUpToDate_)
+    updateSampler_();
+  return categories_[sampler_.draw(*RandomTools::DEFAULT_GENERATOR)];
+}
+
+/******************************************************************************/
+
+void AbstractDiscreteDistribution::updateArrays_() const
+{
+  lock_guard<mutex> lock(cacheMutex_);
+  if (arraysAreUpToDate_)
+    return;
+  size_t n = distribution_.size();
+  categories_.resize(n);
+  probabilities_.resize(n);
+  cumulative_.resize(n + 1);
+  cumulative_[0] = 0;
+  size_t i = 0;
+  for (map<double, double>::const_iterator it = distribution_.begin(); it != distribution_.end(); ++it, ++i)
   {
-    cumprob += i->second;
-    if (r <= cumprob)
-      return i->first;
+    categories_[i] = it->first;
+    probabilities_[i] = it->second;
+    cumulative_[i + 1] = cumulative_[i] + it->second;
   }
-  // This line can't be reached:
-  return -1.;
+  arraysAreUpToDate_ = true;
+}
+
+/******************************************************************************/
+
+void AbstractDiscreteDistribution::updateSampler_() const
+{
+  if (!arraysAreUpToDate_)
+    updateArrays_();
+  lock_guard<mutex> lock(cacheMutex_);
+  if (samplerIsUpToDate_)
+    return;
+  sampler_.build(probabilities_);
+  samplerIsUpToDate_ = true;
+}
+
+/******************************************************************************/
+
+size_t AbstractDiscreteDistribution::findCategory_(double category) const
+{
+  const Vdouble& cats = getCategoriesArray();
+  const Order& order = distribution_.key_comp();
+  Vdouble::const_iterator it = lower_bound(cats.begin(), cats.end(), category, order);
+  if (it == cats.end() || order(category, *it))
+    return cats.size();
+  return static_cast<size_t>(it - cats.begin());
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getInfCumulativeProbability(double category) const
 {
-  double prob = 0;
-  map<double, double>::const_iterator it = distribution_.find(category);
-  for (map<double, double>::const_iterator i = distribution_.begin();
-       i != it;
-       i++)
-  {
-    prob += i->second;
-  }
-  return prob;
+  // Sum of the probabilities before the category (all of them if it is not found):
+  return cumulative_[findCategory_(category)];
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getIInfCumulativeProbability(double category) const
 {
-  double prob = 0;
-  map<double, double>::const_iterator it = distribution_.find(category);
-  if (it == distribution_.end())
+  size_t i = findCategory_(category);
+  if (i == categories_.size())
     return 0;
-  for (map<double, double>::const_iterator i = ++it;
-       i != distribution_.end();
-       i++)
-  {
-    prob += i->second;
-  }
-  return 1. - prob;
+  return 1. - (cumulative_.back() - cumulative_[i + 1]);
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getSupCumulativeProbability(double category) const
 {
-  double prob = 0;
-  map<double, double>::const_iterator it = distribution_.find(category);
-  if (it == distribution_.end())
+  size_t i = findCategory_(category);
+  if (i == categories_.size())
     return 0;
-  for (map<double, double>::const_iterator i = ++it;
-       i != distribution_.end();
-       i++)
-  {
-    prob += i->second;
-  }
-  return prob;
+  return cumulative_.back() - cumulative_[i + 1];
 }
 
 /******************************************************************************/
 
 double AbstractDiscreteDistribution::getSSupCumulativeProbability(double category) const
 {
-  double prob = 0;
-  map<double, double>::const_iterator it = distribution_.find(category);
-  for (map<double, double>::const_iterator i = distribution_.begin();
-       i != it;
-       i++)
-  {
-    prob += i->second;
-  }
-  return 1. - prob;
+  return 1. - cumulative_[findCategory_(category)];
 }
 
 /******************************************************************************/
@@ -291,20 +307,99 @@ double AbstractDiscreteDistribution::getValueCategory(double value) const
   if (!(intMinMax_->isCorrect(value)))
     throw Exception("AbstractDiscreteDistribution::getValueCategory out of bounds:" + TextTools::toString(value));
 
-  map<double, double>::const_iterator it = distribution_.begin();
-  for (unsigned int i=1;i<bounds_.size();i++)
-    if (value<bounds_[i])
-      break;
-    else
-      it++;
-
-  return it->first;
+  // The category index is the number of bounds lower or equal to the value:
+  const Vdouble& cats = getCategoriesArray();
+  size_t i = static_cast<size_t>(upper_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+  if (i >= cats.size())
+    i = cats.size() - 1;
+  return cats[i];
 }
 
 /***********************************************************************/
 
 
+void AbstractDiscreteDistribution::qProbs(const Vdouble& x, Vdouble& quantiles) const
+{
+  quantiles.resize(x.size());
+  for (size_t i = 0; i < x.size(); i++)
+    quantiles[i] = qProb(x[i]);
+}
+
+/******************************************************************************/
+
+void AbstractDiscreteDistribution::Expectations(const Vdouble& a, Vdouble& expectations) const
+{
+  expectations.resize(a.size());
+  for (size_t i = 0; i < a.size(); i++)
+    expectations[i] = Expectation(a[i]);
+}
+
+/******************************************************************************/
+
+void AbstractDiscreteDistribution::discretizationKey_(Vdouble& key) const
+{
+  const ParameterList& pl = getParameters();
+  key.resize(pl.size() + 6);
+  size_t k = 0;
+  for (size_t i = 0; i < pl.size(); i++)
+    key[k++] = pl[i].getValue();
+  key[k++] = static_cast<double>(numberOfCategories_);
+  key[k++] = median_ ? 1. : 0.;
+  key[k++] = intMinMax_->getLowerBound();
+  key[k++] = intMinMax_->strictLowerBound() ? 1. : 0.;
+  key[k++] = intMinMax_->getUpperBound();
+  key[k++] = intMinMax_->strictUpperBound() ? 1. : 0.;
+}
+
+/******************************************************************************/
+
 void AbstractDiscreteDistribution::discretize()
+{
+  if (discretizationCacheSize_ == 0)
+  {
+    computeDiscretization_();
+    return;
+  }
+
+  Vdouble key;
+  discretizationKey_(key);
+  for (size_t i = 0; i < discretizations_.size(); i++)
+  {
+    if (discretizations_[i].key == key)
+    {
+      // Move to front, then restore:
+      std::rotate(discretizations_.begin(), discretizations_.begin() + static_cast<ptrdiff_t>(i), discretizations_.begin() + static_cast<ptrdiff_t>(i + 1));
+      const Discretization& d = discretizations_.front();
+      distribution_.clear();
+      for (size_t j = 0; j < d.categories.size(); j++)
+        distribution_.emplace_hint(distribution_.end(), d.categories[j], d.probabilities[j]);
+      bounds_ = d.bounds;
+      distributionChanged_();
+      return;
+    }
+  }
+
+  computeDiscretization_();
+
+  if (discretizations_.size() < discretizationCacheSize_)
+    discretizations_.emplace_back();
+  // Reuse the storage of the least recently used discretization:
+  std::rotate(discretizations_.begin(), discretizations_.end() - 1, discretizations_.end());
+  Discretization& d = discretizations_.front();
+  d.key.swap(key);
+  d.categories.clear();
+  d.probabilities.clear();
+  for (const auto& it : distribution_)
+  {
+    d.categories.push_back(it.first);
+    d.probabilities.push_back(it.second);
+  }
+  d.bounds = bounds_;
+}
+
+/******************************************************************************/
+
+void AbstractDiscreteDistribution::computeDiscretization_()
 {
   /* discretization of distribution with equal proportions in each
      category
@@ -325,20 +420,22 @@ void AbstractDiscreteDistribution::discretize()
     // divide the domain into equiprobable intervals
     ec = (maxX - minX) / static_cast<double>(numberOfCategories_);
 
+    vector<double> probs(numberOfCategories_ - 1);
     for (i = 1; i < numberOfCategories_; i++)
-    {
-      bounds_[i-1] = qProb(minX + static_cast<double>(i) * ec);
-    }
+      probs[i-1] = minX + static_cast<double>(i) * ec;
+    qProbs(probs, bounds_);
 
     // for each category, sets the value v as the median, adjusted
     //      such that the sum of the values = 1
     if (median_)
     {
-      double t=0;
+      probs.resize(numberOfCategories_);
       for (i = 0; i < numberOfCategories_; i++)
-        values[i] = qProb(minX + (static_cast<double>(i) + 0.5) * ec);
+        probs[i] = minX + (static_cast<double>(i) + 0.5) * ec;
+      qProbs(probs, values);
 
-      for (i = 0, t = 0; i < numberOfCategories_; i++)
+      double t = 0;
+      for (i = 0; i < numberOfCategories_; i++)
         t += values[i];
 
       double mean = Expectation(intMinMax_->getUpperBound()) - Expectation(intMinMax_->getLowerBound());
@@ -350,14 +447,14 @@ void AbstractDiscreteDistribution::discretize()
       // for each category, sets the value v such that
       //      v * length_of_the_interval = the surface of the category
       {
-      double a = Expectation(intMinMax_->getLowerBound()), b;
-      for (i = 0; i < numberOfCategories_-1; i++)
-        {
-          b = Expectation(bounds_[i]);
-          values[i] = (b - a) / ec;
-          a = b;
-        }
-      values[numberOfCategories_-1] = (Expectation(intMinMax_->getUpperBound())-a) / ec;
+      vector<double> points(numberOfCategories_ + 1), expectations;
+      points[0] = intMinMax_->getLowerBound();
+      for (i = 0; i < numberOfCategories_ - 1; i++)
+        points[i+1] = bounds_[i];
+      points[numberOfCategories_] = intMinMax_->getUpperBound();
+      Expectations(points, expectations);
+      for (i = 0; i < numberOfCategories_; i++)
+        values[i] = (expectations[i+1] - expectations[i]) / ec;
     }
   }
   else 
@@ -437,6 +534,7 @@ void AbstractDiscreteDistribution::discretize()
     else
       distribution_[values[i]] = p;
   }
+  distributionChanged_();
 
   return;
 }
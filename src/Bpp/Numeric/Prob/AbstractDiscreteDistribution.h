@@ -43,8 +43,11 @@
 #include "DiscreteDistribution.h"
 #include "../Constraints.h"
 #include "../AbstractParameterAliasable.h"
+#include "../Random/AliasSampler.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
 
 namespace bpp
 {
@@ -55,6 +58,19 @@ namespace bpp
    * This class uses a map to store the cateogry values as keys and probabilities as values.
    * It uses its own comparator class to deal with double precision.
    * By default, category values that differ less than 10E-9 will be considered identical.
+   *
+   * The map is only used to build the distribution. All accessors read contiguous arrays
+   * of the sorted categories, of their probabilities and of the cumulative probabilities,
+   * which are rebuilt on demand after each modification of the map. The map is private:
+   * derived classes fill it with set(), add() and clearCategories_(), and read it with
+   * getCategoryMap_(), so that no modification can leave these arrays out of date.
+   * getCategoriesArray(), getProbabilitiesArray() and getCumulativeProbabilitiesArray()
+   * give access to these arrays without any copy.
+   *
+   * The results of discretize() are memoized in a small cache, keyed on the parameter
+   * values, the number of categories, the median option and the domain of the distribution,
+   * so that optimizers going back and forth between nearby points do not compute the
+   * same quantiles again.
    */
   class AbstractDiscreteDistribution :
     public virtual DiscreteDistribution,
@@ -109,11 +125,14 @@ namespace bpp
      */
 
     size_t numberOfCategories_;  
+
+  private:
     /**
-     * These fields must be initialized in the constructor of the derived classes.
+     * The categories and their probabilities, which must be set in the constructor of the derived classes.
      */
     std::map<double, double, Order> distribution_;
-    
+
+  protected:
     std::vector<double> bounds_;
 
     /**
@@ -129,6 +148,46 @@ namespace bpp
      */
 
     bool median_;
+
+  private:
+    /**
+     * @name Arrays built on demand from distribution_.
+     *
+     * cumulative_ has one more element than categories_: cumulative_[i] is
+     * the sum of the probabilities of the categories before i.
+     * @{
+     */
+    mutable Vdouble categories_;
+    mutable Vdouble probabilities_;
+    mutable Vdouble cumulative_;
+    mutable std::atomic<bool> arraysAreUpToDate_;
+    /** @} */
+
+    /**
+     * @brief Alias table for rand(), built on demand from distribution_.
+     */
+    mutable AliasSampler sampler_;
+    mutable std::atomic<bool> samplerIsUpToDate_;
+    mutable std::mutex cacheMutex_;
+
+    /**
+     * @brief A memoized discretization.
+     */
+    struct Discretization
+    {
+      Vdouble key;
+      Vdouble categories;
+      Vdouble probabilities;
+      Vdouble bounds;
+
+      Discretization(): key(), categories(), probabilities(), bounds() {}
+    };
+
+    /**
+     * @brief The last discretizations, most recently used first.
+     */
+    std::vector<Discretization> discretizations_;
+    size_t discretizationCacheSize_;
     
   public:
     AbstractDiscreteDistribution(size_t nbClasses, const std::string& prefix = ""); 
@@ -210,6 +269,69 @@ namespace bpp
     }
 
     Vdouble getBounds() const;
+
+    /**
+     * @name Batched versions of qProb() and Expectation(), used by discretize().
+     *
+     * The default implementations call the scalar functions for each value.
+     * Derived classes may override them to share the computations between values.
+     * @{
+     */
+
+    /**
+     * @brief Compute the quantiles of several probabilities.
+     *
+     * @param x The probabilities.
+     * @param quantiles [out] qProb(x[i]) for each i.
+     */
+    virtual void qProbs(const Vdouble& x, Vdouble& quantiles) const;
+
+    /**
+     * @brief Compute the cumulative expectations of several values.
+     *
+     * @param a The values.
+     * @param expectations [out] Expectation(a[i]) for each i.
+     */
+    virtual void Expectations(const Vdouble& a, Vdouble& expectations) const;
+
+    /** @} */
+
+    /**
+     * @name Access to the categories without copy.
+     *
+     * The references are valid until the next modification of the distribution.
+     * @{
+     */
+
+    /**
+     * @return The sorted category values.
+     */
+    const Vdouble& getCategoriesArray() const
+    {
+      if (!arraysAreUpToDate_) updateArrays_();
+      return categories_;
+    }
+
+    /**
+     * @return The probabilities of the categories, in the same order as getCategoriesArray().
+     */
+    const Vdouble& getProbabilitiesArray() const
+    {
+      if (!arraysAreUpToDate_) updateArrays_();
+      return probabilities_;
+    }
+
+    /**
+     * @return The cumulative probabilities, with one more element than the number of categories:
+     * element i is the sum of the probabilities of categories 0 to i-1.
+     */
+    const Vdouble& getCumulativeProbabilitiesArray() const
+    {
+      if (!arraysAreUpToDate_) updateArrays_();
+      return cumulative_;
+    }
+
+    /** @} */
     
     void print(OutputStream& out) const;
 
@@ -222,10 +344,31 @@ namespace bpp
       }
     }
     
+    /**
+     * @brief Discretize the distribution into equiprobable categories.
+     *
+     * The result is taken from the cache of discretizations if the distribution
+     * was already discretized with the same parameter values, number of categories,
+     * median option and domain.
+     */
     virtual void discretize();
 
     /** @} */
 
+    /**
+     * @brief Set the number of discretizations kept in the cache (default: 8).
+     *
+     * @param size The number of discretizations, 0 to disable the cache.
+     */
+    void setDiscretizationCacheSize(size_t size)
+    {
+      discretizationCacheSize_ = size;
+      if (discretizations_.size() > size)
+        discretizations_.resize(size);
+    }
+
+    size_t getDiscretizationCacheSize() const { return discretizationCacheSize_; }
+
     /**
      * @brief Restricts the distribution to the domain where the
      * constraint is respected, in addition of other predefined
@@ -236,6 +379,47 @@ namespace bpp
      */
     
     virtual void restrictToConstraint(const Constraint& c);
+
+  protected:
+    /**
+     * @return The categories and their probabilities.
+     */
+    const std::map<double, double, Order>& getCategoryMap_() const { return distribution_; }
+
+    /**
+     * @brief Remove all categories.
+     */
+    void clearCategories_()
+    {
+      distribution_.clear();
+      distributionChanged_();
+    }
+
+  private:
+    /**
+     * @brief Tell that the content of distribution_ has changed.
+     */
+    void distributionChanged_()
+    {
+      arraysAreUpToDate_ = false;
+      samplerIsUpToDate_ = false;
+    }
+
+    /**
+     * @brief Compute the discretization, without the cache.
+     */
+    void computeDiscretization_();
+
+    void discretizationKey_(Vdouble& key) const;
+
+    void updateArrays_() const;
+    void updateSampler_() const;
+
+    /**
+     * @return The index of a category, using the precision of the distribution,
+     * or the number of categories if it is not found.
+     */
+    size_t findCategory_(double category) const;
       
 
   };
@@ -52,7 +52,7 @@ ConstantDistribution::ConstantDistribution(double value):
   value_(value)
 {
   addParameter_(new Parameter("Constant.value", value)); 
-  distribution_[value_] = 1; //One single class  with probability 1.
+  set(value_, 1); //One single class  with probability 1.
 }
 
 ConstantDistribution::ConstantDistribution(const ConstantDistribution& cd) :
@@ -75,8 +75,8 @@ void ConstantDistribution::fireParameterChanged(const ParameterList& parameters)
   AbstractDiscreteDistribution::fireParameterChanged(parameters);
 
   value_=getParameterValue("value");
-  distribution_.clear();
-  distribution_[value_] = 1; //One single class of rate 1 with probability 1.
+  clearCategories_();
+  set(value_, 1); //One single class of rate 1 with probability 1.
 }
 
 /******************************************************************************/
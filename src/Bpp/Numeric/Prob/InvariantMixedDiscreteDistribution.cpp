@@ -67,30 +67,35 @@ InvariantMixedDiscreteDistribution::InvariantMixedDiscreteDistribution(
 void InvariantMixedDiscreteDistribution::fireParameterChanged(const ParameterList& parameters)
 {
   AbstractDiscreteDistribution::fireParameterChanged(parameters);
-  p_ = getParameterValue("p");
-  dist_->matchParametersValues(parameters);
-
-  updateDistribution();
+  double p = getParameterValue("p");
+  bool changed = (p != p_);
+  p_ = p;
+  // The nested distribution is only discretized again if its parameters have changed:
+  if (dist_->matchParametersValues(parameters))
+    changed = true;
+
+  if (changed)
+    updateDistribution();
 }
 
 /******************************************************************************/
 
 void InvariantMixedDiscreteDistribution::updateDistribution()
 {
-  distribution_.clear();
+  clearCategories_();
   bounds_.clear();
 
   size_t distNCat = dist_->getNumberOfCategories();
   vector<double> probs = dist_->getProbabilities();
   vector<double> cats  = dist_->getCategories();
 
-  distribution_[invariant_] = p_;
+  set(invariant_, p_);
   for (size_t i = 0; i < distNCat; i++)
   {
     if (cats[i] == invariant_)
-      distribution_[invariant_] += (1. - p_) * probs[i];
+      add(invariant_, (1. - p_) * probs[i]);
     else
-      distribution_[cats[i]] = (1. - p_) * probs[i];
+      set(cats[i], (1. - p_) * probs[i]);
   }
 
   intMinMax_->setLowerBound(dist_->getLowerBound(), !dist_->strictLowerBound());
@@ -101,7 +106,7 @@ void InvariantMixedDiscreteDistribution::updateDistribution()
   if (invariant_ >= intMinMax_->getUpperBound())
     intMinMax_->setUpperBound(invariant_, true);
 
-  numberOfCategories_ = distribution_.size();
+  numberOfCategories_ = getCategoryMap_().size();
 
   // bounds_
 
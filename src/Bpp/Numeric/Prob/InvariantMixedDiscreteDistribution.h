@@ -110,8 +110,11 @@ public:
    */
   void setNumberOfCategories(size_t nbClasses)
   {
-    dist_->setNumberOfCategories(nbClasses);
-    updateDistribution();
+    if (dist_->getNumberOfCategories() != nbClasses)
+    {
+      dist_->setNumberOfCategories(nbClasses);
+      updateDistribution();
+    }
   }
 
   /**
@@ -149,12 +149,18 @@ MixtureOfDiscreteDistributions::~MixtureOfDiscreteDistributions()
 
 void MixtureOfDiscreteDistributions::setNumberOfCategories(size_t nbClasses)
 {
+  bool changed = false;
   for (size_t i = 0; i < vdd_.size(); i++)
   {
-    vdd_[i]->setNumberOfCategories(nbClasses);
+    if (vdd_[i]->getNumberOfCategories() != nbClasses)
+    {
+      vdd_[i]->setNumberOfCategories(nbClasses);
+      changed = true;
+    }
   }
 
-  updateDistribution();
+  if (changed)
+    updateDistribution();
 }
 
 
@@ -162,50 +168,54 @@ void MixtureOfDiscreteDistributions::fireParameterChanged(const ParameterList& p
 {
   AbstractDiscreteDistribution::fireParameterChanged(parameters);
   size_t size = vdd_.size();
+  bool changed = false;
   double x = 1.0;
   for (size_t i = 0; i < size - 1; i++)
   {
-    probas_[i] = getParameterValue("theta" + TextTools::toString(i + 1)) * x;
-    x *= 1 - getParameterValue("theta" + TextTools::toString(i + 1));
+    double theta = getParameterValue("theta" + TextTools::toString(i + 1));
+    double p = theta * x;
+    if (p != probas_[i])
+    {
+      probas_[i] = p;
+      changed = true;
+    }
+    x *= 1 - theta;
   }
 
-  probas_[size - 1] = x;
-
+  if (x != probas_[size - 1])
+  {
+    probas_[size - 1] = x;
+    changed = true;
+  }
 
+  // Only the components whose parameters have changed are discretized again:
   for (size_t i = 0; i < size; i++)
   {
-    vdd_[i]->matchParametersValues(parameters);
+    if (vdd_[i]->matchParametersValues(parameters))
+      changed = true;
   }
 
-  updateDistribution();
+  if (changed)
+    updateDistribution();
 }
 
 void MixtureOfDiscreteDistributions::updateDistribution()
 {
   size_t size = vdd_.size();
-  distribution_.clear();
+  clearCategories_();
   // calculation of distribution
 
-  for (size_t i = 0; i < size; i++)
-  {
-    vector<double> values = vdd_[i]->getCategories();
-    for (size_t j = 0; j < values.size(); j++)
-    {
-      distribution_[values[j]] = 0;
-    }
-  }
-
   for (size_t i = 0; i < size; i++)
   {
     vector<double> values = vdd_[i]->getCategories();
     vector<double> probas2 = vdd_[i]->getProbabilities();
     for (size_t j = 0; j < values.size(); j++)
     {
-      distribution_[values[j]] += probas2[j] * probas_[i];
+      add(values[j], probas2[j] * probas_[i]);
     }
   }
 
-  numberOfCategories_ = distribution_.size();
+  numberOfCategories_ = getCategoryMap_().size();
 
   // intMinMax_
 
@@ -233,7 +243,7 @@ void MixtureOfDiscreteDistributions::updateDistribution()
   intMinMax_->setUpperBound(uB, suB);
 
   // Compute midpoint bounds_:
-  vector<double> values = MapTools::getKeys<double, double, AbstractDiscreteDistribution::Order>(distribution_);
+  vector<double> values = MapTools::getKeys<double, double, AbstractDiscreteDistribution::Order>(getCategoryMap_());
 
   bounds_.resize(numberOfCategories_ - 1);
 
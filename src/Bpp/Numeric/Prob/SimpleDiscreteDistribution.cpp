@@ -55,7 +55,7 @@ SimpleDiscreteDistribution::SimpleDiscreteDistribution(const map<double, double>
   double sum = 0;
   for (map<double, double>::const_iterator i = distribution.begin(); i != distribution.end(); i++)
   {
-    distribution_[i->first] = i->second;
+    set(i->first, i->second);
     sum += i->second;
   }
   if (fabs(1. - sum) > precision())
@@ -97,10 +97,10 @@ SimpleDiscreteDistribution::SimpleDiscreteDistribution(const vector<double>& val
 
   for (size_t i = 0; i < size; i++)
   {
-    if (distribution_.find(values[i]) != distribution_.end())
+    if (getCategoryMap_().find(values[i]) != getCategoryMap_().end())
       throw Exception("SimpleDiscreteDistribution: two given values are equal");
     else
-      distribution_[values[i]] = probas[i];
+      set(values[i], probas[i]);
   }
 
   double sum = VectorTools::sum(probas);
@@ -138,10 +138,10 @@ SimpleDiscreteDistribution::SimpleDiscreteDistribution(const std::vector<double>
 
   for (size_t i = 0; i < size; i++)
   {
-    if (distribution_.find(values[i]) != distribution_.end())
+    if (getCategoryMap_().find(values[i]) != getCategoryMap_().end())
       throw Exception("SimpleDiscreteDistribution: two given values are equal");
     else
-      distribution_[values[i]] = probas[i];
+      set(values[i], probas[i]);
   }
 
   double sum = VectorTools::sum(probas);
@@ -207,26 +207,26 @@ void SimpleDiscreteDistribution::fireParameterChanged(const ParameterList& param
   if (getNumberOfParameters() != 0)
   {
     AbstractDiscreteDistribution::fireParameterChanged(parameters);
-    size_t size = distribution_.size();
+    size_t size = getCategoryMap_().size();
 
-    distribution_.clear();
+    clearCategories_();
     double x = 1.0;
     double v;
     for (size_t i = 0; i < size; i++)
     {
       v = getParameterValue("V" + TextTools::toString(i + 1));
       double v2(v);
-      if (distribution_.find(v2) != distribution_.end())
+      if (getCategoryMap_().find(v2) != getCategoryMap_().end())
       {
         int j(1);
         while (true)
         {
           v2 = v + j * precision();
-          if (v2 < intMinMax_->getUpperBound() && (distribution_.find(v2) == distribution_.end()))
+          if (v2 < intMinMax_->getUpperBound() && (getCategoryMap_().find(v2) == getCategoryMap_().end()))
             break;
 
           v2 = v - j * precision();
-          if (v2 > intMinMax_->getLowerBound() && (distribution_.find(v2) == distribution_.end()))
+          if (v2 > intMinMax_->getLowerBound() && (getCategoryMap_().find(v2) == getCategoryMap_().end()))
             break;
           j++;
         }
@@ -235,11 +235,11 @@ void SimpleDiscreteDistribution::fireParameterChanged(const ParameterList& param
       }
       if (i<size-1)
       {
-        distribution_[v2] = getParameterValue("theta" + TextTools::toString(i + 1)) * x;
+        set(v2, getParameterValue("theta" + TextTools::toString(i + 1)) * x);
         x *= 1 - getParameterValue("theta" + TextTools::toString(i + 1));
       }
       else
-        distribution_[v2] = x;
+        set(v2, x);
     }
   }
   
@@ -250,7 +250,7 @@ double SimpleDiscreteDistribution::qProb(double x) const
 {
   double s = -NumConstants::VERY_BIG();
   double x2 = x;
-  for (map<double, double>::const_iterator it = distribution_.begin(); it != distribution_.end(); it++)
+  for (map<double, double>::const_iterator it = getCategoryMap_().begin(); it != getCategoryMap_().end(); it++)
   {
     x2 -= it->second;
     if (x2 < 0)
@@ -265,7 +265,7 @@ double SimpleDiscreteDistribution::qProb(double x) const
 double SimpleDiscreteDistribution::pProb(double x) const
 {
   double s = 0;
-  for (map<double, double>::const_iterator it = distribution_.begin(); it != distribution_.end(); it++)
+  for (map<double, double>::const_iterator it = getCategoryMap_().begin(); it != getCategoryMap_().end(); it++)
   {
     if (it->first >= x)
       s += it->second;
@@ -279,7 +279,7 @@ double SimpleDiscreteDistribution::pProb(double x) const
 double SimpleDiscreteDistribution::Expectation(double a) const
 {
   double s = 0;
-  for (map<double, double>::const_iterator it = distribution_.begin(); it != distribution_.end(); it++)
+  for (map<double, double>::const_iterator it = getCategoryMap_().begin(); it != getCategoryMap_().end(); it++)
   {
     if (it->first >= a)
       s += it->second;
@@ -294,7 +294,7 @@ double SimpleDiscreteDistribution::Expectation(double a) const
 void SimpleDiscreteDistribution::discretize()
 {
   // Compute a new arbitray bounderi:
-  vector<double> values = MapTools::getKeys<double, double, AbstractDiscreteDistribution::Order>(distribution_);
+  vector<double> values = MapTools::getKeys<double, double, AbstractDiscreteDistribution::Order>(getCategoryMap_());
 
   // Fill from 0 to numberOfCategories_-2 with midpoints:
   for (unsigned int i = 0; i < numberOfCategories_ - 1; i++)
@@ -315,7 +315,7 @@ void SimpleDiscreteDistribution::restrictToConstraint(const Constraint& c)
 
   map<double, double>::const_iterator it;
 
-  for (it = distribution_.begin(); it != distribution_.end(); it++)
+  for (it = getCategoryMap_().begin(); it != getCategoryMap_().end(); it++)
   {
     if (!pi->isCorrect(it->first))
       throw Exception("Impossible to restrict to Constraint value " + TextTools::toString(it->first));
@@ -323,7 +323,7 @@ void SimpleDiscreteDistribution::restrictToConstraint(const Constraint& c)
 
   AbstractDiscreteDistribution::restrictToConstraint(c);
 
-  size_t size = distribution_.size();
+  size_t size = getCategoryMap_().size();
   for (size_t i = 0; i < size; i++)
   {
     map<size_t, vector<double> >::const_iterator itr = givenRanges_.find(i + 1);
@@ -136,11 +136,11 @@ public:
   void fireParameterChanged(const ParameterList & parameters);
 
   double getLowerBound() const {
-    return distribution_.begin()->first;
+    return getCategoryMap_().begin()->first;
   }
 
   double getUpperBound() const {
-    return distribution_.rbegin()->first;
+    return getCategoryMap_().rbegin()->first;
   }  
   
   double qProb(double x) const ;
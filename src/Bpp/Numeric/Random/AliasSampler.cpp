@@ -0,0 +1,127 @@
+//
+// File: AliasSampler.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "AliasSampler.h"
+#include "../../Exceptions.h"
+#include "../../Text/TextTools.h"
+
+// From the STL:
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+void AliasSampler::build(const std::vector<double>& weights)
+{
+  size_t n = weights.size();
+  if (n == 0)
+    throw Exception("AliasSampler::build. No weight.");
+  double sum = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (!(weights[i] >= 0) || std::isinf(weights[i]))
+      throw Exception("AliasSampler::build. Invalid weight: " + TextTools::toString(weights[i]) + ".");
+    sum += weights[i];
+  }
+  if (sum <= 0)
+    throw Exception("AliasSampler::build. All weights are zero.");
+
+  threshold_.resize(n);
+  alias_.resize(n);
+  // Scaled probabilities, with mean 1, and worklists of columns below and above 1:
+  vector<size_t> small, large;
+  small.reserve(n);
+  large.reserve(n);
+  double scale = static_cast<double>(n) / sum;
+  for (size_t i = 0; i < n; ++i)
+  {
+    threshold_[i] = weights[i] * scale;
+    if (threshold_[i] < 1.)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+  while (!small.empty() && !large.empty())
+  {
+    size_t s = small.back();
+    small.pop_back();
+    size_t l = large.back();
+    // Column s is filled with l:
+    alias_[s] = l;
+    threshold_[l] -= 1. - threshold_[s];
+    if (threshold_[l] < 1.)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Remaining columns are full, up to rounding errors:
+  for (size_t i : large)
+  {
+    threshold_[i] = 1.;
+    alias_[i] = i;
+  }
+  for (size_t i : small)
+  {
+    threshold_[i] = 1.;
+    alias_[i] = i;
+  }
+}
+
+/******************************************************************************/
+
+void AliasSampler::draw(size_t* indices, size_t k, const RandomFactory& generator) const
+{
+  const size_t blockSize = 256;
+  double u[blockSize];
+  for (size_t start = 0; start < k; start += blockSize)
+  {
+    size_t m = (k - start < blockSize ? k - start : blockSize);
+    generator.drawNumbers(u, m);
+    for (size_t j = 0; j < m; ++j)
+    {
+      indices[start + j] = draw(u[j]);
+    }
+  }
+}
+
+/******************************************************************************/
@@ -0,0 +1,139 @@
+//
+// File: AliasSampler.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _ALIASSAMPLER_H_
+#define _ALIASSAMPLER_H_
+
+#include "RandomFactory.h"
+
+// From the STL:
+#include <cstddef>
+#include <vector>
+
+namespace bpp
+{
+
+  /**
+   * @brief Sample indices from a discrete distribution in constant time, with Walker's alias method.
+   *
+   * The table is built once from a vector of n non-negative weights, in O(n) time
+   * (Vose's algorithm), after which each draw takes O(1) time and a single uniform number:
+   * the integer part of @f$nU@f$ gives a column of the table, and the fractional part
+   * chooses between the column index and its alias.
+   *
+   * Reference:
+   * <pre>
+   * M.D. Vose (1991), A linear algorithm for generating random numbers with a given distribution.
+   * IEEE Transactions on Software Engineering 17(9):972-975.
+   * </pre>
+   */
+  class AliasSampler
+  {
+  private:
+    std::vector<double> threshold_;
+    std::vector<size_t> alias_;
+
+  public:
+    /**
+     * @brief Build an empty sampler.
+     */
+    AliasSampler(): threshold_(), alias_() {}
+
+    /**
+     * @brief Build a sampler for a set of weights.
+     *
+     * @param weights The weights of the indices, which do not need to sum to one.
+     * @throw Exception If the weights are empty, negative, not finite or all zero.
+     */
+    AliasSampler(const std::vector<double>& weights): threshold_(), alias_() { build(weights); }
+
+  public:
+    /**
+     * @brief Rebuild the table for a new set of weights.
+     *
+     * @param weights The weights of the indices, which do not need to sum to one.
+     * @throw Exception If the weights are empty, negative, not finite or all zero.
+     */
+    void build(const std::vector<double>& weights);
+
+    /**
+     * @return The number of indices of the distribution.
+     */
+    size_t getSize() const { return threshold_.size(); }
+
+    bool isEmpty() const { return threshold_.empty(); }
+
+    /**
+     * @brief Get the index corresponding to a uniform number.
+     *
+     * @param u A number in [0, 1).
+     * @return An index in [0, n).
+     */
+    size_t draw(double u) const
+    {
+      size_t n = threshold_.size();
+      double x = u * static_cast<double>(n);
+      size_t i = static_cast<size_t>(x);
+      if (i >= n)
+        i = n - 1;
+      return (x - static_cast<double>(i) < threshold_[i] ? i : alias_[i]);
+    }
+
+    /**
+     * @brief Draw an index.
+     *
+     * @param generator The uniform generator to use.
+     * @return An index in [0, n).
+     */
+    size_t draw(const RandomFactory& generator) const { return draw(generator.drawNumber()); }
+
+    /**
+     * @brief Draw several indices, with uniform numbers drawn by blocks.
+     *
+     * @param indices [out] A pointer toward the first index to fill.
+     * @param k The number of indices to draw.
+     * @param generator The uniform generator to use.
+     */
+    void draw(size_t* indices, size_t k, const RandomFactory& generator) const;
+  };
+
+} //end of namespace bpp.
+
+#endif // _ALIASSAMPLER_H_
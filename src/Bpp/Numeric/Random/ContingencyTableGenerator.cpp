@@ -91,6 +91,14 @@ ContingencyTableGenerator::ContingencyTableGenerator(
 RowMatrix<size_t> ContingencyTableGenerator::rcont2(const RandomFactory& generator)
 {
   RowMatrix<size_t> table(nrow_, ncol_); //Result
+  rcont2(table, generator);
+  return table;
+}
+
+void ContingencyTableGenerator::rcont2(RowMatrix<size_t>& table, const RandomFactory& generator)
+{
+  if (table.getNumberOfRows() != nrow_ || table.getNumberOfColumns() != ncol_)
+    table.resize(nrow_, ncol_);
   size_t j, l, m, ia, ib, ic, jc, id, ie, ii, nll, nlm, nr_1, nc_1;
   long double x, y, dummy, sumprb;
   bool lsm, lsp;
@@ -191,8 +199,6 @@ L160:
     table(nr_1, m) = jwork_[m];
 
   table(nr_1, nc_1) = ib - table(nr_1, nc_1 - 1);
-
-  return table;
 }
   
 /**************************************************************************/
@@ -85,6 +85,19 @@ class ContingencyTableGenerator
 
   public:
     RowMatrix<size_t> rcont2(const RandomFactory& generator = *RandomTools::DEFAULT_GENERATOR); 
+
+    /**
+     * @brief Generate a random matrix into an existing one.
+     *
+     * The matrix is only resized if its dimensions do not match the marginals,
+     * so that no allocation occurs when the same matrix is used for many replicates.
+     * As the generator uses an internal workspace, a ContingencyTableGenerator object
+     * should not be used concurrently by several threads.
+     *
+     * @param table [out] The random matrix.
+     * @param generator The random number generator to use.
+     */
+    void rcont2(RowMatrix<size_t>& table, const RandomFactory& generator = *RandomTools::DEFAULT_GENERATOR);
 };
 
 } //end of namespace bpp.
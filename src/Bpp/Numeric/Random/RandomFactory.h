@@ -40,6 +40,9 @@ knowledge of the CeCILL license and that you accept its terms.
 #ifndef _RANDOMFACTORY_H_
 #define _RANDOMFACTORY_H_
 
+// From the STL:
+#include <cstddef>
+
 namespace bpp
 {
 
@@ -64,6 +67,22 @@ class RandomFactory {
 		 * @brief Return a random number.
 		 */
 		virtual double drawNumber() const = 0;
+
+		/**
+		 * @brief Fill an array with random numbers.
+		 *
+		 * The default implementation calls drawNumber() for each value.
+		 * Generators should override it with a loop free of virtual calls,
+		 * as this method is the core of the bulk functions of RandomTools.
+		 *
+		 * @param values [out] A pointer toward the first value to fill.
+		 * @param n The number of values to draw.
+		 */
+		virtual void drawNumbers(double* values, size_t n) const
+		{
+			for (size_t i = 0; i < n; ++i)
+				values[i] = drawNumber();
+		}
 };
 
 } //end of namespace bpp.
@@ -0,0 +1,156 @@
+//
+// File: RandomStreams.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "RandomStreams.h"
+
+// From the STL:
+#include <unordered_map>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+  /**
+   * @brief The stream of a thread for a given RandomStreams instance.
+   */
+  struct ThreadStream
+  {
+    uint64_t epoch;
+    Uniform01Xoshiro generator;
+    ThreadStream(): epoch(0), generator(0) {}
+  };
+
+  std::atomic<uint64_t> nextInstanceId(1);
+
+  // Streams of the current thread, by instance identifier, with a cache of the last one used:
+  thread_local std::unordered_map<uint64_t, ThreadStream> threadStreams;
+  thread_local uint64_t lastInstanceId = 0;
+  thread_local ThreadStream* lastThreadStream = 0;
+}
+
+/******************************************************************************/
+
+RandomStreams::RandomStreams(long seed):
+  id_(nextInstanceId++), epoch_(1), nextThreadStream_(0), mutex_(),
+  master_(seed), taskCache_(), threadCache_()
+{
+  setSeed(seed);
+}
+
+/******************************************************************************/
+
+void RandomStreams::setSeed(long seed)
+{
+  lock_guard<mutex> lock(mutex_);
+  master_.setSeed(seed);
+  taskCache_.index = 0;
+  taskCache_.generator = master_;
+  // Thread streams start 2^192 draws after task streams:
+  threadCache_.index = 0;
+  threadCache_.generator = master_;
+  threadCache_.generator.longJump();
+  nextThreadStream_ = 0;
+  epoch_++;
+}
+
+/******************************************************************************/
+
+Uniform01Xoshiro& RandomStreams::getThreadStream_() const
+{
+  uint64_t epoch = epoch_.load(memory_order_relaxed);
+  if (lastInstanceId != id_ || lastThreadStream->epoch != epoch)
+  {
+    ThreadStream& ts = threadStreams[id_];
+    if (ts.epoch != epoch)
+    {
+      size_t index = nextThreadStream_++;
+      lock_guard<mutex> lock(mutex_);
+      ts.generator = getStream_(threadCache_, index);
+      ts.epoch = epoch;
+    }
+    lastInstanceId = id_;
+    lastThreadStream = &ts;
+  }
+  return lastThreadStream->generator;
+}
+
+/******************************************************************************/
+
+double RandomStreams::drawNumber() const
+{
+  return getThreadStream_().drawNumber();
+}
+
+/******************************************************************************/
+
+void RandomStreams::drawNumbers(double* values, size_t n) const
+{
+  getThreadStream_().drawNumbers(values, n);
+}
+
+/******************************************************************************/
+
+Uniform01Xoshiro RandomStreams::getStream(size_t index) const
+{
+  lock_guard<mutex> lock(mutex_);
+  return getStream_(taskCache_, index);
+}
+
+/******************************************************************************/
+
+Uniform01Xoshiro RandomStreams::getStream_(StreamCache& cache, size_t index) const
+{
+  if (index < cache.index)
+  {
+    // Restart from the first stream of the family:
+    cache.generator = master_;
+    if (&cache == &threadCache_)
+      cache.generator.longJump();
+    cache.index = 0;
+  }
+  for ( ; cache.index < index; ++cache.index)
+  {
+    cache.generator.jump();
+  }
+  return cache.generator;
+}
+
+/******************************************************************************/
@@ -0,0 +1,155 @@
+//
+// File: RandomStreams.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _RANDOMSTREAMS_H_
+#define _RANDOMSTREAMS_H_
+
+#include "Uniform01Xoshiro.h"
+
+// From the STL:
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace bpp
+{
+
+  /**
+   * @brief A thread-safe uniform random number generator, made of independent streams.
+   *
+   * All streams are derived from a single master seed, by jumping a Uniform01Xoshiro
+   * generator, so that they never overlap. Two families of streams are available:
+   * - Thread streams, used by drawNumber(): each thread draws numbers from its own
+   *   stream, allocated the first time the thread draws a number. Streams are
+   *   allocated in the order of the first draws, so that the thread which calls
+   *   setSeed() and draws first always gets the first stream, and sequential programs
+   *   are reproducible. drawNumber() can be called concurrently without synchronization.
+   * - Task streams, obtained with getStream(): they are identified by an index,
+   *   typically the index of a task or of a work item in a parallel loop. A program
+   *   in which each task only draws from its own stream gives the same results for a
+   *   given seed, whatever the number of threads and the order of execution of the tasks.
+   *
+   * This is the default generator of RandomTools.
+   *
+   * setSeed() must not be called while other threads are drawing numbers.
+   */
+  class RandomStreams:
+    public virtual RandomFactory
+  {
+  private:
+    /**
+     * @brief The position of the last stream derived from the master generator,
+     * so that streams requested in increasing order are obtained with a single jump.
+     */
+    struct StreamCache
+    {
+      size_t index;
+      Uniform01Xoshiro generator;
+      StreamCache(): index(0), generator(0) {}
+    };
+
+    uint64_t id_;
+    std::atomic<uint64_t> epoch_;
+    mutable std::atomic<size_t> nextThreadStream_;
+    mutable std::mutex mutex_;
+    Uniform01Xoshiro master_;
+    mutable StreamCache taskCache_;
+    mutable StreamCache threadCache_;
+
+  public:
+    /**
+     * @brief Create a new set of streams.
+     *
+     * @param seed The master seed.
+     */
+    RandomStreams(long seed);
+
+    RandomStreams(const RandomStreams&) = delete;
+    RandomStreams& operator=(const RandomStreams&) = delete;
+
+    virtual ~RandomStreams() {}
+
+  public:
+    /**
+     * @brief Set the master seed, and reset all streams.
+     */
+    void setSeed(long seed);
+
+    /**
+     * @brief Get a random number between 0.0 and 1.0 (exclusive of the end point values),
+     * from the stream of the calling thread.
+     */
+    double drawNumber() const;
+
+    /**
+     * @brief Fill an array with random numbers from the stream of the calling thread.
+     */
+    void drawNumbers(double* values, size_t n) const;
+
+    /**
+     * @brief Get a copy of a task stream.
+     *
+     * This method is thread-safe. Its cost is proportional to the difference between
+     * the index and the previously requested one, it is hence cheaper to request streams
+     * in increasing order.
+     *
+     * @param index The index of the stream.
+     * @return A generator positioned at the beginning of the stream.
+     */
+    Uniform01Xoshiro getStream(size_t index) const;
+
+    /**
+     * @return The number of thread streams allocated since the last call to setSeed().
+     */
+    size_t getNumberOfThreadStreams() const { return nextThreadStream_.load(); }
+
+  private:
+    /**
+     * @return The stream of the calling thread.
+     */
+    Uniform01Xoshiro& getThreadStream_() const;
+
+    Uniform01Xoshiro getStream_(StreamCache& cache, size_t index) const;
+  };
+
+} //end of namespace bpp.
+
+#endif // _RANDOMSTREAMS_H_
@@ -38,7 +38,7 @@
  */
 
 #include "RandomTools.h"
-#include "Uniform01K.h"
+#include "RandomStreams.h"
 #include "../VectorTools.h"
 #include "../NumConstants.h"
 
@@ -47,7 +47,7 @@
 using namespace bpp;
 using namespace std;
 
-RandomFactory* RandomTools::DEFAULT_GENERATOR = new Uniform01K(time(NULL));
+RandomFactory* RandomTools::DEFAULT_GENERATOR = new RandomStreams(time(NULL));
 
 // Initiate random seed :
 // RandomTools::RandInt RandomTools::r = time(NULL) ;
@@ -57,6 +57,14 @@ void RandomTools::setSeed(long seed)
   DEFAULT_GENERATOR->setSeed(seed);
 }
 
+Uniform01Xoshiro RandomTools::getStream(size_t index)
+{
+  const RandomStreams* streams = dynamic_cast<const RandomStreams*>(DEFAULT_GENERATOR);
+  if (!streams)
+    throw Exception("RandomTools::getStream. The default generator does not provide streams.");
+  return streams->getStream(index);
+}
+
 // Method to get a double random value (between 0 and specified range)
 // Note : the number you get is between 0 and entry not including entry !
 double RandomTools::giveRandomNumberBetweenZeroAndEntry(double entry, const RandomFactory& generator)
@@ -98,33 +106,267 @@ double RandomTools::randExponential(double mean, const RandomFactory& generator)
   return -mean* log(RandomTools::giveRandomNumberBetweenZeroAndEntry(1, generator));
 }
 
-std::vector<size_t> RandomTools::randMultinomial(size_t n, const std::vector<double>& probs)
+namespace
 {
-  double s = VectorTools::sum(probs);
-  double r;
-  double cumprob;
-  vector<size_t> sample(n);
-  for (unsigned int i = 0; i < n; i++)
+  /**
+   * @brief A block of uniform numbers, refilled with RandomFactory::drawNumbers().
+   */
+  class UniformBlock
+  {
+  private:
+    static const size_t SIZE = 256;
+    const RandomFactory& generator_;
+    double values_[SIZE];
+    size_t pos_;
+
+  public:
+    UniformBlock(const RandomFactory& generator): generator_(generator), values_(), pos_(SIZE) {}
+
+    double next()
+    {
+      if (pos_ == SIZE)
+      {
+        generator_.drawNumbers(values_, SIZE);
+        pos_ = 0;
+      }
+      return values_[pos_++];
+    }
+  };
+
+  /**
+   * @brief Tables of the 128 layers normal ziggurat (Doornik's formulation).
+   */
+  struct ZigguratTables
   {
-    r = RandomTools::giveRandomNumberBetweenZeroAndEntry(1);
-    cumprob = 0;
-    bool test = true;
-    for (unsigned int j = 0; test &(j < probs.size()); j++)
+    static const size_t C = 128;
+    static constexpr double R = 3.442619855899;
+    static constexpr double V = 9.91256303526217e-3;
+    double x[C + 1];
+    double ratio[C];
+
+    ZigguratTables(): x(), ratio()
     {
-      cumprob += probs[j] / s;
-      if (r <= cumprob)
+      double f = exp(-0.5 * R * R);
+      x[0] = V / f;
+      x[1] = R;
+      x[C] = 0;
+      for (size_t i = 2; i < C; ++i)
+      {
+        x[i] = sqrt(-2. * log(V / x[i - 1] + f));
+        f = exp(-0.5 * x[i] * x[i]);
+      }
+      for (size_t i = 0; i < C; ++i)
       {
-        sample[i] = j;
-        test = false;
+        ratio[i] = x[i + 1] / x[i];
       }
     }
-    // This test should never be true if probs sum to one:
-    if (test)
-      sample[i] = probs.size();
+  };
+
+  constexpr double ZigguratTables::R;
+  constexpr double ZigguratTables::V;
+
+  const ZigguratTables& zigguratTables()
+  {
+    static const ZigguratTables tables;
+    return tables;
   }
+
+  double zigguratGaussian(const ZigguratTables& z, UniformBlock& u)
+  {
+    for (;;)
+    {
+      // One uniform gives the layer (7 bits), the sign (1 bit) and the position in the layer:
+      double v = u.next() * 256.;
+      unsigned int k = static_cast<unsigned int>(v);
+      size_t i = k & 127;
+      double w = v - static_cast<double>(k);
+      if (k & 128)
+        w = -w;
+      if (fabs(w) < z.ratio[i])
+        return w * z.x[i];
+      if (i == 0)
+      {
+        // Tail of the distribution, beyond R:
+        double x, y;
+        do
+        {
+          x = log(u.next()) / ZigguratTables::R;
+          y = log(u.next());
+        }
+        while (-2. * y < x * x);
+        return (w < 0 ? x - ZigguratTables::R : ZigguratTables::R - x);
+      }
+      double x = w * z.x[i];
+      double f0 = exp(-0.5 * (z.x[i] * z.x[i] - x * x));
+      double f1 = exp(-0.5 * (z.x[i + 1] * z.x[i + 1] - x * x));
+      if (f1 + u.next() * (f0 - f1) < 1.)
+        return x;
+    }
+  }
+
+  // Marsaglia and Tsang's method, for alpha >= 1:
+  double marsagliaTsangGamma(double d, double c, const ZigguratTables& z, UniformBlock& u)
+  {
+    for (;;)
+    {
+      double x, v;
+      do
+      {
+        x = zigguratGaussian(z, u);
+        v = 1. + c * x;
+      }
+      while (v <= 0);
+      v = v * v * v;
+      double w = u.next();
+      double x2 = x * x;
+      if (w < 1. - 0.0331 * x2 * x2)
+        return d * v;
+      if (log(w) < 0.5 * x2 + d * (1. - v + log(v)))
+        return d * v;
+    }
+  }
+}
+
+void RandomTools::fillUniform(double* values, size_t n, double min, double max, const RandomFactory& generator)
+{
+  generator.drawNumbers(values, n);
+  if (min != 0. || max != 1.)
+  {
+    double range = max - min;
+    for (size_t i = 0; i < n; ++i)
+    {
+      values[i] = min + range * values[i];
+    }
+  }
+}
+
+void RandomTools::fillGaussian(double* values, size_t n, double mean, double variance, const RandomFactory& generator)
+{
+  const ZigguratTables& z = zigguratTables();
+  UniformBlock u(generator);
+  double sd = sqrt(variance);
+  for (size_t i = 0; i < n; ++i)
+  {
+    values[i] = mean + sd * zigguratGaussian(z, u);
+  }
+}
+
+void RandomTools::fillExponential(double* values, size_t n, double mean, const RandomFactory& generator)
+{
+  generator.drawNumbers(values, n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    values[i] = -mean * log(values[i]);
+  }
+}
+
+void RandomTools::fillGamma(double* values, size_t n, double alpha, double beta, const RandomFactory& generator)
+{
+  if (alpha <= 0)
+    throw Exception("RandomTools::fillGamma. Alpha must be positive.");
+  const ZigguratTables& z = zigguratTables();
+  UniformBlock u(generator);
+  // For alpha < 1, draw from Gamma(alpha + 1) and multiply by U^(1/alpha):
+  bool boost = alpha < 1.;
+  double d = (boost ? alpha + 1. : alpha) - 1. / 3.;
+  double c = 1. / sqrt(9. * d);
+  for (size_t i = 0; i < n; ++i)
+  {
+    double x = marsagliaTsangGamma(d, c, z, u);
+    if (boost)
+      x *= pow(u.next(), 1. / alpha);
+    values[i] = x / beta;
+  }
+}
+
+std::vector<size_t> RandomTools::randMultinomial(size_t n, const std::vector<double>& probs)
+{
+  vector<size_t> sample(n);
+  if (n == 0)
+    return sample;
+  AliasSampler sampler(probs);
+  sampler.draw(&sample[0], n, *DEFAULT_GENERATOR);
   return sample;
 }
 
+std::vector<size_t> RandomTools::randMultinomialCounts(size_t n, const std::vector<double>& probs, const RandomFactory& generator)
+{
+  size_t k = probs.size();
+  vector<size_t> counts(k, 0);
+  if (n == 0)
+    return counts;
+  if (n < 32 * k)
+  {
+    // Small sample: draw each state.
+    AliasSampler sampler(probs);
+    vector<size_t> sample(n);
+    sampler.draw(&sample[0], n, generator);
+    for (size_t i = 0; i < n; ++i)
+    {
+      counts[sample[i]]++;
+    }
+    return counts;
+  }
+  // Large sample: the count of each state, given the previous ones, is binomial.
+  double remainingProb = VectorTools::sum(probs);
+  size_t remaining = n;
+  for (size_t j = 0; j + 1 < k && remaining > 0; ++j)
+  {
+    double p = (remainingProb > 0 ? probs[j] / remainingProb : 0.);
+    counts[j] = randBinomial(remaining, p > 1. ? 1. : p, generator);
+    remaining -= counts[j];
+    remainingProb -= probs[j];
+  }
+  counts[k - 1] += remaining;
+  return counts;
+}
+
+size_t RandomTools::randBinomial(size_t n, double p, const RandomFactory& generator)
+{
+  if (p <= 0. || n == 0)
+    return 0;
+  if (p >= 1.)
+    return n;
+  double q = 1. - p;
+  double dn = static_cast<double>(n);
+  size_t mode = static_cast<size_t>(floor((dn + 1.) * p));
+  if (mode > n)
+    mode = n;
+  double dm = static_cast<double>(mode);
+  double pMode = exp(lgamma(dn + 1.) - lgamma(dm + 1.) - lgamma(dn - dm + 1.) + dm * log(p) + (dn - dm) * log(q));
+  double u = generator.drawNumber() - pMode;
+  if (u <= 0)
+    return mode;
+  // Chop-down search, alternately above and below the mode:
+  double r = p / q;
+  double pUp = pMode, pDown = pMode;
+  size_t up = mode, down = mode;
+  bool moreUp = up < n, moreDown = down > 0;
+  while (moreUp || moreDown)
+  {
+    if (moreUp)
+    {
+      pUp *= static_cast<double>(n - up) / static_cast<double>(up + 1) * r;
+      up++;
+      u -= pUp;
+      if (u <= 0)
+        return up;
+      moreUp = up < n && pUp > 0;
+    }
+    if (moreDown)
+    {
+      pDown *= static_cast<double>(down) / static_cast<double>(n - down + 1) / r;
+      down--;
+      u -= pDown;
+      if (u <= 0)
+        return down;
+      moreDown = down > 0 && pDown > 0;
+    }
+  }
+  // Only reached because of rounding errors:
+  return mode;
+}
+
 // ------------------------------------------------------------------------------
 
 
@@ -1032,3 +1274,232 @@ double RandomTools::incompletebetaps(double a, double b, double x, double maxgam
 
 /**************************************************************************/
 
+/******************************************************************************/
+
+namespace
+{
+  const double KERNEL_EPS = 1e-15;
+  const double KERNEL_FPMIN = 1e-300;
+  const int KERNEL_MAX_ITERATIONS = 10000;
+
+  /**
+   * @brief Regularized lower incomplete Gamma function P(a, x), given ln(Gamma(a)).
+   */
+  double regularizedGammaP(double a, double x, double lnGammaA)
+  {
+    if (x <= 0)
+      return 0.;
+    double lnPrefix = a * log(x) - x - lnGammaA;
+    if (x < a + 1.)
+    {
+      // Series expansion:
+      double ap = a, del = 1. / a, sum = del;
+      for (int n = 0; n < KERNEL_MAX_ITERATIONS; ++n)
+      {
+        ap += 1.;
+        del *= x / ap;
+        sum += del;
+        if (fabs(del) < fabs(sum) * KERNEL_EPS)
+          break;
+      }
+      return sum * exp(lnPrefix);
+    }
+    // Continued fraction for Q(a, x):
+    double b = x + 1. - a, c = 1. / KERNEL_FPMIN, d = 1. / b, h = d;
+    for (int i = 1; i < KERNEL_MAX_ITERATIONS; ++i)
+    {
+      double an = -i * (i - a);
+      b += 2.;
+      d = an * d + b;
+      if (fabs(d) < KERNEL_FPMIN) d = KERNEL_FPMIN;
+      c = b + an / c;
+      if (fabs(c) < KERNEL_FPMIN) c = KERNEL_FPMIN;
+      d = 1. / d;
+      double del = d * c;
+      h *= del;
+      if (fabs(del - 1.) < KERNEL_EPS)
+        break;
+    }
+    return 1. - exp(lnPrefix) * h;
+  }
+
+  /**
+   * @brief Continued fraction of the incomplete Beta function.
+   */
+  double betaContinuedFraction(double a, double b, double x)
+  {
+    double qab = a + b, qap = a + 1., qam = a - 1.;
+    double c = 1., d = 1. - qab * x / qap;
+    if (fabs(d) < KERNEL_FPMIN) d = KERNEL_FPMIN;
+    d = 1. / d;
+    double h = d;
+    for (int m = 1; m < KERNEL_MAX_ITERATIONS; ++m)
+    {
+      double dm = static_cast<double>(m), m2 = 2. * dm;
+      double aa = dm * (b - dm) * x / ((qam + m2) * (a + m2));
+      d = 1. + aa * d;
+      if (fabs(d) < KERNEL_FPMIN) d = KERNEL_FPMIN;
+      c = 1. + aa / c;
+      if (fabs(c) < KERNEL_FPMIN) c = KERNEL_FPMIN;
+      d = 1. / d;
+      h *= d * c;
+      aa = -(a + dm) * (qab + dm) * x / ((a + m2) * (qap + m2));
+      d = 1. + aa * d;
+      if (fabs(d) < KERNEL_FPMIN) d = KERNEL_FPMIN;
+      c = 1. + aa / c;
+      if (fabs(c) < KERNEL_FPMIN) c = KERNEL_FPMIN;
+      d = 1. / d;
+      double del = d * c;
+      h *= del;
+      if (fabs(del - 1.) < KERNEL_EPS)
+        break;
+    }
+    return h;
+  }
+
+  /**
+   * @brief Regularized incomplete Beta function I_x(a, b), given ln(Beta(a, b)).
+   */
+  double regularizedBetaI(double a, double b, double x, double lnBetaAB)
+  {
+    if (x <= 0)
+      return 0.;
+    if (x >= 1)
+      return 1.;
+    double prefix = exp(a * log(x) + b * log1p(-x) - lnBetaAB);
+    if (x < (a + 1.) / (a + b + 2.))
+      return prefix * betaContinuedFraction(a, b, x) / a;
+    return 1. - prefix * betaContinuedFraction(b, a, 1. - x) / b;
+  }
+
+  /**
+   * @brief Solve cdf(x) = p by Halley iterations, safeguarded by bisection.
+   *
+   * Halley's method converges cubically, so that the iterations stop as soon as
+   * a step is smaller than 1e-6 relatively to the current value.
+   *
+   * @param hi The upper bound of the support (may be infinite).
+   * @param logPdf The logarithm of the density.
+   * @param dLogPdf The derivative of the logarithm of the density.
+   */
+  template<class Cdf, class LogPdf, class DLogPdf>
+  double solveQuantile(double p, double x, double hi, const Cdf& cdf, const LogPdf& logPdf, const DLogPdf& dLogPdf)
+  {
+    double lo = 0.;
+    if (!(x > lo && x < hi))
+      x = (std::isinf(hi) ? 1. : 0.5 * hi);
+    for (int it = 0; it < 200; ++it)
+    {
+      double f = cdf(x) - p;
+      if (f == 0)
+        return x;
+      if (f < 0)
+        lo = x;
+      else
+        hi = x;
+      double d = exp(logPdf(x));
+      double next = NumConstants::NaN();
+      if (d > 0)
+      {
+        double u = f / d;
+        double h = 1. - 0.5 * u * dLogPdf(x);
+        next = x - (h > 0.5 && h < 2. ? u / h : u);
+      }
+      if (next > lo && next < hi)
+      {
+        if (fabs(next - x) <= 1e-6 * fabs(next))
+          return next;
+      }
+      else
+        next = (std::isinf(hi) ? 2. * x : 0.5 * (lo + hi));
+      if (hi - lo <= 1e-15 * fabs(next))
+        return next;
+      x = next;
+    }
+    return x;
+  }
+}
+
+void RandomTools::qGamma(const std::vector<double>& probs, double alpha, double beta, std::vector<double>& quantiles, bool warmStart)
+{
+  size_t n = probs.size();
+  if (!warmStart || quantiles.size() != n)
+  {
+    quantiles.resize(n);
+    warmStart = false;
+  }
+  double lga = lnGamma(alpha);
+  auto cdf = [alpha, lga](double y) { return regularizedGammaP(alpha, y, lga); };
+  auto logPdf = [alpha, lga](double y) { return (alpha - 1.) * log(y) - y - lga; };
+  auto dLogPdf = [alpha](double y) { return (alpha - 1.) / y - 1.; };
+  for (size_t i = 0; i < n; ++i)
+  {
+    double p = probs[i];
+    if (p <= 0.)
+      quantiles[i] = 0.;
+    else if (p >= 1.)
+      quantiles[i] = NumConstants::PINF();
+    else
+    {
+      // Iterations on the unit-rate distribution:
+      double y0 = warmStart ? quantiles[i] * beta : qGamma(p, alpha, 1.);
+      quantiles[i] = solveQuantile(p, y0, NumConstants::PINF(), cdf, logPdf, dLogPdf) / beta;
+    }
+  }
+}
+
+void RandomTools::pGamma(const std::vector<double>& x, double alpha, double beta, std::vector<double>& probs)
+{
+  if (alpha < 0) throw Exception("RandomTools::pGamma. Negative alpha is not allowed.");
+  if (beta < 0) throw Exception("RandomTools::pGamma. Negative beta is not allowed.");
+  probs.resize(x.size());
+  if (alpha == 0.)
+  {
+    probs.assign(x.size(), 1.);
+    return;
+  }
+  double lga = lnGamma(alpha);
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    probs[i] = regularizedGammaP(alpha, beta * x[i], lga);
+  }
+}
+
+void RandomTools::qBeta(const std::vector<double>& probs, double alpha, double beta, std::vector<double>& quantiles, bool warmStart)
+{
+  size_t n = probs.size();
+  if (!warmStart || quantiles.size() != n)
+  {
+    quantiles.resize(n);
+    warmStart = false;
+  }
+  double lb = lnBeta(alpha, beta);
+  auto cdf = [alpha, beta, lb](double y) { return regularizedBetaI(alpha, beta, y, lb); };
+  auto logPdf = [alpha, beta, lb](double y) { return (alpha - 1.) * log(y) + (beta - 1.) * log1p(-y) - lb; };
+  auto dLogPdf = [alpha, beta](double y) { return (alpha - 1.) / y - (beta - 1.) / (1. - y); };
+  for (size_t i = 0; i < n; ++i)
+  {
+    double p = probs[i];
+    if (p <= 0.)
+      quantiles[i] = 0.;
+    else if (p >= 1.)
+      quantiles[i] = 1.;
+    else
+    {
+      double y0 = warmStart ? quantiles[i] : qBeta(p, alpha, beta);
+      quantiles[i] = solveQuantile(p, y0, 1., cdf, logPdf, dLogPdf);
+    }
+  }
+}
+
+void RandomTools::pBeta(const std::vector<double>& x, double alpha, double beta, std::vector<double>& probs)
+{
+  if (alpha <= 0) throw Exception("RandomTools::pBeta. alpha <= 0.");
+  if (beta <= 0) throw Exception("RandomTools::pBeta. beta <= 0.");
+  probs.resize(x.size());
+  double lb = lnBeta(alpha, beta);
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    probs[i] = regularizedBetaI(alpha, beta, x[i], lb);
+  }
+}
@@ -41,15 +41,19 @@
 #ifndef _RANDOMTOOLS_H_
 #define _RANDOMTOOLS_H_
 
+#include "AliasSampler.h"
 #include "RandomFactory.h"
+#include "Uniform01Xoshiro.h"
 #include "../VectorExceptions.h"
 #include "../VectorTools.h"
 #include "../../Exceptions.h"
 
 // From the STL:
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <ctime>
+#include <utility>
 #include <vector>
 
 namespace bpp
@@ -58,8 +62,14 @@ namespace bpp
   /**
    * @brief Utilitary function dealing with random numbers.
    *
-   * This class uses Uniform01K generator by default.
-   * It is possible to change this by setting the DEFAULT_GENERATOR variable.
+   * This class uses a RandomStreams generator by default, so that all functions
+   * can be called concurrently from several threads, each thread drawing numbers
+   * from its own stream. It is possible to change this by setting the
+   * DEFAULT_GENERATOR variable.
+   *
+   * For parallel computations to be reproducible whatever the number of threads,
+   * each task should draw numbers from its own stream, obtained with getStream(),
+   * and passed as the generator argument of the functions of this class.
    *
    * This class is adapted from Pupko's SEMPHY library.
    * It also borrow some code from Yang's PAML package.
@@ -129,6 +139,16 @@ namespace bpp
      */
     static void setSeed(long seed);
 
+    /**
+     * @brief Get a task stream of the default generator.
+     *
+     * @param index The index of the stream.
+     * @return A generator positioned at the beginning of the stream.
+     * @throw Exception If the default generator is not a RandomStreams object.
+     * @see RandomStreams::getStream()
+     */
+    static Uniform01Xoshiro getStream(size_t index);
+
     /**
      * @return A random number drawn from a normal distribution.
      * @param mean The mean of the law.
@@ -167,6 +187,74 @@ namespace bpp
      */
     static double randExponential(double mean, const RandomFactory& generator = *DEFAULT_GENERATOR);
 
+    /**
+     * @name Bulk generation.
+     *
+     * These functions fill an array provided by the caller, and are much faster than
+     * successive calls to the corresponding one-value functions: uniform numbers are
+     * drawn by blocks with RandomFactory::drawNumbers(), and Gaussian numbers are
+     * generated with the ziggurat method instead of the inversion of the cumulative
+     * distribution. They hence do not give the same values as the one-value functions,
+     * and the number of uniform numbers consumed from the generator is not specified.
+     * Arrays in vectors are passed as (v.data(), v.size()).
+     *
+     * References:
+     * <pre>
+     * G. Marsaglia and W.W. Tsang (2000), The ziggurat method for generating random variables.
+     * Journal of Statistical Software 5(8).
+     * J.A. Doornik (2005), An improved ziggurat method to generate normal random samples.
+     * G. Marsaglia and W.W. Tsang (2000), A simple method for generating gamma variables.
+     * ACM Transactions on Mathematical Software 26(3):363-372.
+     * </pre>
+     * @{
+     */
+
+    /**
+     * @brief Fill an array with numbers drawn from a uniform distribution.
+     *
+     * @param values [out] A pointer toward the first value to fill.
+     * @param n The number of values to draw.
+     * @param min The lower bound of the distribution.
+     * @param max The upper bound of the distribution.
+     * @param generator The uniform generator to use.
+     */
+    static void fillUniform(double* values, size_t n, double min = 0., double max = 1., const RandomFactory& generator = *DEFAULT_GENERATOR);
+
+    /**
+     * @brief Fill an array with numbers drawn from a normal distribution.
+     *
+     * @param values [out] A pointer toward the first value to fill.
+     * @param n The number of values to draw.
+     * @param mean The mean of the law.
+     * @param variance The variance of the law.
+     * @param generator The uniform generator to use.
+     */
+    static void fillGaussian(double* values, size_t n, double mean = 0., double variance = 1., const RandomFactory& generator = *DEFAULT_GENERATOR);
+
+    /**
+     * @brief Fill an array with numbers drawn from an exponential distribution.
+     *
+     * @param values [out] A pointer toward the first value to fill.
+     * @param n The number of values to draw.
+     * @param mean The mean of the distribution.
+     * @param generator The uniform generator to use.
+     */
+    static void fillExponential(double* values, size_t n, double mean = 1., const RandomFactory& generator = *DEFAULT_GENERATOR);
+
+    /**
+     * @brief Fill an array with numbers drawn from a gamma distribution.
+     *
+     * @param values [out] A pointer toward the first value to fill.
+     * @param n The number of values to draw.
+     * @param alpha The alpha (shape) parameter.
+     * @param beta The beta (rate) parameter, as in randGamma().
+     * @param generator The uniform generator to use.
+     * @throw Exception If alpha is not positive.
+     */
+    static void fillGamma(double* values, size_t n, double alpha, double beta = 1., const RandomFactory& generator = *DEFAULT_GENERATOR);
+
+    /** @} */
+
     /**
      * @brief Pick one element in a vector
      *
@@ -250,15 +338,13 @@ namespace bpp
     static T pickOne(std::vector<T>& v, std::vector<double>& w, bool replace = false) {
       if (v.empty())
         throw EmptyVectorException<T>("RandomTools::pickOne (with weight): input vector is empty", &v);
-      //Compute cumulative sum of weights:
-      std::vector<double> sumw = VectorTools::cumSum(w);
-      //Convert to cumulative distribution:
-      sumw /= sumw.back();
-      //Get random positions:
-      double prob = RandomTools::giveRandomNumberBetweenZeroAndEntry(1.0);
+      //Get a random position, in a single pass over the weights:
+      double prob = RandomTools::giveRandomNumberBetweenZeroAndEntry(VectorTools::sum(w));
       size_t pos = v.size() - 1;
+      double sumw = 0;
       for (size_t i = 0; i < v.size(); ++i) {
-        if (prob < sumw[i]) {
+        sumw += w[i];
+        if (prob < sumw) {
           pos = i;
           break;
         }
@@ -294,9 +380,21 @@ namespace bpp
      * @return A vector which is a sample of v.
      * @throw IndexOutOfBoundException if the sample size exceeds the original
      * size when sampling without replacement.
+     * Sampling with replacement uses an AliasSampler, and takes O(n + k) time
+     * for a sample of size k from n elements. Sampling without replacement is
+     * equivalent to successive weighted picks, but is performed in O(n log n) time
+     * with the method of Efraimidis and Spirakis (2006): each element gets the key
+     * @f$U^{1/w}@f$ and the sample is made of the elements with the largest keys,
+     * in decreasing order.
+     *
+     * @param vin The vector to sample.
+     * @param w The vector of weights.
+     * @param vout [out] The output vector to fill, with the appropriate size.
+     * @param replace Should sampling be with replacement?
+     * @return A vector which is a sample of v.
+     * @throw IndexOutOfBoundException if the sample size exceeds the original
+     * size when sampling without replacement.
      * @throw EmptyVectorException if the vector is empty.
-     * @warning: For large sampling with replacement, the function is not efficient,
-     * as it recomputes the some of weights for each element picked.
      * @author Julien Dutheil
      */
    template<class T> 
@@ -304,12 +402,26 @@ namespace bpp
     {
       if (vout.size() > vin.size() && !replace)
         throw IndexOutOfBoundsException("RandomTools::getSample (with weights): size exceeded v.size.", vout.size(), 0, vin.size());
-      std::vector<size_t> hat(vin.size());
-      for (size_t i = 0 ; i < vin.size() ; i++)
-        hat[i] = i;
-      std::vector<double> w2(w); //non const copy
-      for (size_t i = 0 ; i < vout.size() ; i++)
-        vout[i] = vin[pickOne(hat, w2, replace)];
+      if (vout.empty())
+        return;
+      if (vin.empty())
+        throw EmptyVectorException<T>("RandomTools::getSample (with weights): input vector is empty", &vin);
+      if (replace) {
+        AliasSampler sampler(w);
+        std::vector<size_t> pos(vout.size());
+        sampler.draw(&pos[0], pos.size(), *DEFAULT_GENERATOR);
+        for (size_t i = 0 ; i < vout.size() ; i++)
+          vout[i] = vin[pos[i]];
+      } else {
+        //Keys log(U)/w, elements with a null weight come last:
+        std::vector< std::pair<double, size_t> > keys(vin.size());
+        for (size_t i = 0 ; i < vin.size() ; i++)
+          keys[i] = std::make_pair(std::log(DEFAULT_GENERATOR->drawNumber()) / w[i], i);
+        std::partial_sort(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(vout.size()), keys.end(),
+            [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) { return a.first > b.first; });
+        for (size_t i = 0 ; i < vout.size() ; i++)
+          vout[i] = vin[keys[i].second];
+      }
     }
 
     /**
@@ -324,6 +436,31 @@ namespace bpp
      */ 
     static std::vector<size_t> randMultinomial(size_t n, const std::vector<double>& probs);
 
+    /**
+     * @brief Get the counts of a multinomial sample.
+     *
+     * For large samples, the counts are drawn as a sequence of binomial variables,
+     * in O(k sqrt(n)) time for k categories, instead of drawing each of the n states.
+     *
+     * @param n The sample size.
+     * @param probs The set of intput probabilities, scaled so that they sum to one.
+     * @param generator The uniform generator to use.
+     * @return The number of times each state is drawn.
+     */
+    static std::vector<size_t> randMultinomialCounts(size_t n, const std::vector<double>& probs, const RandomFactory& generator = *DEFAULT_GENERATOR);
+
+    /**
+     * @return A number drawn from a binomial distribution.
+     *
+     * The inversion method is used, with a search starting from the mode of the distribution,
+     * so that the expected number of iterations is proportional to the standard deviation.
+     *
+     * @param n The number of trials.
+     * @param p The probability of success.
+     * @param generator The uniform generator to use.
+     */
+    static size_t randBinomial(size_t n, double p, const RandomFactory& generator = *DEFAULT_GENERATOR);
+
     /**
      * @name Probability functions.
      *
@@ -543,6 +680,71 @@ namespace bpp
 
     /** @} */
 
+    /**
+     * @name Batched probability functions.
+     *
+     * These functions evaluate the Gamma and Beta quantile and cumulative functions for
+     * a whole vector of values at once, to full precision. They are slower than the scalar
+     * functions, which are accurate to about 1e-6 and are used by the discretized
+     * distributions, and are meant for callers which need accurate quantiles. The log-Gamma and log-Beta normalizing constants are computed once
+     * per batch, and the regularized incomplete Gamma and Beta functions are evaluated
+     * with a relative precision close to 1e-15, with series and continued fractions
+     * (modified Lentz's method).
+     *
+     * Quantiles are obtained by safeguarded Newton iterations on the cumulative function.
+     * When warmStart is true, the iterations start from the values already present in the
+     * quantiles vector, typically the quantiles of the same probabilities for close
+     * parameter values kept by the caller: a few iterations are then enough. Otherwise, they start from
+     * the scalar approximations qGamma() and qBeta(). In both cases the iterations are
+     * carried to convergence, so that the result does not depend on the starting points.
+     *
+     * @{
+     */
+
+    /**
+     * @brief Batched Gamma quantile function.
+     *
+     * @param probs The probabilities.
+     * @param alpha Alpha parameter.
+     * @param beta  Beta parameter.
+     * @param quantiles [in,out] The quantiles corresponding to the probabilities.
+     * @param warmStart Use the input quantiles as starting points.
+     */
+    static void qGamma(const std::vector<double>& probs, double alpha, double beta, std::vector<double>& quantiles, bool warmStart = false);
+
+    /**
+     * @brief Batched Gamma cumulative probability function.
+     *
+     * @param x The quantiles for which the probabilities should be computed.
+     * @param alpha Alpha parameter.
+     * @param beta  Beta parameter.
+     * @param probs [out] The corresponding probabilities.
+     */
+    static void pGamma(const std::vector<double>& x, double alpha, double beta, std::vector<double>& probs);
+
+    /**
+     * @brief Batched Beta quantile function.
+     *
+     * @param probs The probabilities.
+     * @param alpha Alpha parameter.
+     * @param beta  Beta parameter.
+     * @param quantiles [in,out] The quantiles corresponding to the probabilities.
+     * @param warmStart Use the input quantiles as starting points.
+     */
+    static void qBeta(const std::vector<double>& probs, double alpha, double beta, std::vector<double>& quantiles, bool warmStart = false);
+
+    /**
+     * @brief Batched Beta cumulative probability function.
+     *
+     * @param x The quantiles for which the probabilities should be computed.
+     * @param alpha Alpha parameter.
+     * @param beta  Beta parameter.
+     * @param probs [out] The corresponding probabilities.
+     */
+    static void pBeta(const std::vector<double>& x, double alpha, double beta, std::vector<double>& probs);
+
+    /** @} */
+
   private:
     static double DblGammaGreaterThanOne(double dblAlpha, const RandomFactory& generator);
     static double DblGammaLessThanOne(double dblAlpha, const RandomFactory& generator);
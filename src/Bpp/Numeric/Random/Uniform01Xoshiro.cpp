@@ -0,0 +1,147 @@
+//
+// File: Uniform01Xoshiro.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "Uniform01Xoshiro.h"
+#include "../../Exceptions.h"
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+const uint64_t Uniform01Xoshiro::JUMP_[4] = {
+  0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+
+const uint64_t Uniform01Xoshiro::LONG_JUMP_[4] = {
+  0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+};
+
+/******************************************************************************/
+
+Uniform01Xoshiro::Uniform01Xoshiro(long seed):
+  s_()
+{
+  setSeed(seed);
+}
+
+/******************************************************************************/
+
+void Uniform01Xoshiro::setSeed(long seed)
+{
+  // SplitMix64 expansion of the seed:
+  uint64_t x = static_cast<uint64_t>(seed);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    s_[i] = z ^ (z >> 31);
+  }
+}
+
+/******************************************************************************/
+
+void Uniform01Xoshiro::drawNumbers(double* values, size_t n) const
+{
+  uint64_t s0 = s_[0], s1 = s_[1], s2 = s_[2], s3 = s_[3];
+  for (size_t i = 0; i < n; ++i)
+  {
+    uint64_t result = rotl_(s1 * 5, 7) * 9;
+    uint64_t t = s1 << 17;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = rotl_(s3, 45);
+    values[i] = (static_cast<double>(result >> 11) + 0.5) / 9007199254740992.;
+  }
+  s_[0] = s0; s_[1] = s1; s_[2] = s2; s_[3] = s3;
+}
+
+/******************************************************************************/
+
+void Uniform01Xoshiro::setState(const uint64_t state[4])
+{
+  if (!(state[0] | state[1] | state[2] | state[3]))
+    throw Exception("Uniform01Xoshiro::setState. The state must not be all zero.");
+  for (size_t i = 0; i < 4; ++i)
+  {
+    s_[i] = state[i];
+  }
+}
+
+/******************************************************************************/
+
+void Uniform01Xoshiro::getState(uint64_t state[4]) const
+{
+  for (size_t i = 0; i < 4; ++i)
+  {
+    state[i] = s_[i];
+  }
+}
+
+/******************************************************************************/
+
+void Uniform01Xoshiro::jump_(const uint64_t polynomial[4])
+{
+  uint64_t s[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    for (int b = 0; b < 64; ++b)
+    {
+      if (polynomial[i] & (1ULL << b))
+      {
+        for (size_t j = 0; j < 4; ++j)
+        {
+          s[j] ^= s_[j];
+        }
+      }
+      drawInteger();
+    }
+  }
+  for (size_t j = 0; j < 4; ++j)
+  {
+    s_[j] = s[j];
+  }
+}
+
+/******************************************************************************/
@@ -0,0 +1,158 @@
+//
+// File: Uniform01Xoshiro.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _UNIFORM01XOSHIRO_H_
+#define _UNIFORM01XOSHIRO_H_
+
+#include "RandomFactory.h"
+
+// From the STL:
+#include <cstdint>
+
+namespace bpp
+{
+
+  /**
+   * @brief A uniform random number generator, based on the xoshiro256** algorithm.
+   *
+   * This generator draws doubles between 0 and 1 excluding the end points,
+   * with 53 bits of precision. It has a period of @f$2^{256}-1@f$, is very fast,
+   * and its state can be advanced by @f$2^{128}@f$ (jump()) or @f$2^{192}@f$ (longJump())
+   * draws at a small cost. Jumps split the period into non-overlapping streams,
+   * which can be used independently by concurrent threads or tasks (see RandomStreams).
+   *
+   * The seed is expanded into the 256 bits state with the SplitMix64 generator.
+   *
+   * Reference:
+   * <pre>
+   * D. Blackman and S. Vigna (2021), Scrambled linear pseudorandom number generators.
+   * ACM Transactions on Mathematical Software 47(4):36.
+   * </pre>
+   */
+  class Uniform01Xoshiro:
+    public virtual RandomFactory
+  {
+  private:
+    mutable uint64_t s_[4];
+
+  public:
+    /**
+     * @brief Create a Random Number Generator.
+     *
+     * @param seed The seed for the random numbers.
+     */
+    Uniform01Xoshiro(long seed);
+
+    virtual ~Uniform01Xoshiro() {}
+
+  public:
+    /**
+     * @brief Set the seed for a new set of random numbers.
+     */
+    void setSeed(long seed);
+
+    /**
+     * @brief Get a random number between 0.0 and 1.0 (exclusive of the end point values).
+     */
+    double drawNumber() const
+    {
+      return (static_cast<double>(drawInteger() >> 11) + 0.5) / 9007199254740992.;
+    }
+
+    /**
+     * @brief Fill an array with random numbers between 0.0 and 1.0 (exclusive of the end point values).
+     *
+     * The state is kept in local variables during the loop, so that it stays in registers.
+     * The values are identical to the ones of n successive calls to drawNumber().
+     */
+    void drawNumbers(double* values, size_t n) const;
+
+    /**
+     * @brief Get 64 random bits.
+     */
+    uint64_t drawInteger() const
+    {
+      uint64_t result = rotl_(s_[1] * 5, 7) * 9;
+      uint64_t t = s_[1] << 17;
+      s_[2] ^= s_[0];
+      s_[3] ^= s_[1];
+      s_[1] ^= s_[2];
+      s_[0] ^= s_[3];
+      s_[2] ^= t;
+      s_[3] = rotl_(s_[3], 45);
+      return result;
+    }
+
+    /**
+     * @brief Advance the generator by @f$2^{128}@f$ draws.
+     */
+    void jump() { jump_(JUMP_); }
+
+    /**
+     * @brief Advance the generator by @f$2^{192}@f$ draws.
+     */
+    void longJump() { jump_(LONG_JUMP_); }
+
+    /**
+     * @brief Set the internal state of the generator.
+     *
+     * @param state The four 64 bits words of the state, not all zero.
+     */
+    void setState(const uint64_t state[4]);
+
+    /**
+     * @brief Get the internal state of the generator.
+     *
+     * @param state [out] The four 64 bits words of the state.
+     */
+    void getState(uint64_t state[4]) const;
+
+  private:
+    static const uint64_t JUMP_[4];
+    static const uint64_t LONG_JUMP_[4];
+
+    void jump_(const uint64_t polynomial[4]);
+
+    static uint64_t rotl_(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+  };
+
+} //end of namespace bpp.
+
+#endif // _UNIFORM01XOSHIRO_H_
@@ -0,0 +1,246 @@
+//
+// File: ContingencyTableBatch.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "ContingencyTableBatch.h"
+#include "../NumConstants.h"
+#include "../Random/RandomTools.h"
+#include "../../Exceptions.h"
+#include "../../Text/TextTools.h"
+
+//From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+LogFactorialTable::LogFactorialTable(size_t nmax):
+  values_(1, 0.)
+{
+  reserve(nmax);
+}
+
+void LogFactorialTable::reserve(size_t nmax)
+{
+  size_t n = values_.size();
+  if (nmax < n)
+    return;
+  values_.resize(nmax + 1);
+  for (size_t i = n; i <= nmax; ++i)
+    values_[i] = values_[i - 1] + log(static_cast<double>(i));
+}
+
+/******************************************************************************/
+
+namespace
+{
+  /**
+   * @brief Upper tail of the chi square distribution with an integer number of degrees of freedom.
+   *
+   * Uses the closed forms of the upper incomplete Gamma function at integer and half-integer shapes:
+   * Q(1, y) = exp(-y), Q(1/2, y) = erfc(sqrt(y)) and Q(a + 1, y) = Q(a, y) + y^a exp(-y) / Gamma(a + 1).
+   */
+  double chiSquareSurvival(double x, size_t df)
+  {
+    if (std::isnan(x))
+      return x;
+    if (x <= 0)
+      return 1.;
+    double y = x / 2.;
+    double a, q, term;
+    if (df % 2 == 0)
+    {
+      a = 1.;
+      q = exp(-y);
+      term = y * q;
+    }
+    else
+    {
+      a = 0.5;
+      q = erfc(sqrt(y));
+      term = 2. * sqrt(y / 3.14159265358979323846) * exp(-y);
+    }
+    for (double target = static_cast<double>(df) / 2.; a < target; a += 1.)
+    {
+      q += term;
+      term *= y / (a + 1.);
+    }
+    return min(q, 1.);
+  }
+}
+
+ContingencyTableBatch::ContingencyTableBatch(size_t nbRows, size_t nbColumns):
+  nbRows_(nbRows),
+  nbColumns_(nbColumns),
+  logFactorials_(),
+  rowSums_(),
+  columnSums_(),
+  totals_()
+{
+  if (nbRows < 2 || nbColumns < 2)
+    throw Exception("ContingencyTableBatch. Table size should be at least 2x2!");
+}
+
+/******************************************************************************/
+
+void ContingencyTableBatch::computeMargins_(const std::vector<size_t>& counts, size_t nbTables)
+{
+  if (counts.size() != nbRows_ * nbColumns_ * nbTables)
+    throw Exception("ContingencyTableBatch. Wrong number of counts: " + TextTools::toString(counts.size()) + ", expected " + TextTools::toString(nbRows_ * nbColumns_ * nbTables) + ".");
+  rowSums_.assign(nbRows_ * nbTables, 0.);
+  columnSums_.assign(nbColumns_ * nbTables, 0.);
+  totals_.assign(nbTables, 0.);
+  for (size_t i = 0; i < nbRows_; ++i)
+  {
+    for (size_t j = 0; j < nbColumns_; ++j)
+    {
+      const size_t* c = &counts[(i * nbColumns_ + j) * nbTables];
+      double* r = &rowSums_[i * nbTables];
+      double* s = &columnSums_[j * nbTables];
+      for (size_t t = 0; t < nbTables; ++t)
+      {
+        double x = static_cast<double>(c[t]);
+        r[t] += x;
+        s[t] += x;
+      }
+    }
+  }
+  for (size_t i = 0; i < nbRows_; ++i)
+  {
+    const double* r = &rowSums_[i * nbTables];
+    for (size_t t = 0; t < nbTables; ++t)
+      totals_[t] += r[t];
+  }
+}
+
+/******************************************************************************/
+
+void ContingencyTableBatch::chiSquareTests(const std::vector<size_t>& counts, size_t nbTables, std::vector<double>& statistics, std::vector<double>& pvalues)
+{
+  computeMargins_(counts, nbTables);
+  statistics.assign(nbTables, 0.);
+  pvalues.resize(nbTables);
+  if (nbTables == 0)
+    return;
+  for (size_t i = 0; i < nbRows_; ++i)
+  {
+    const double* r = &rowSums_[i * nbTables];
+    for (size_t j = 0; j < nbColumns_; ++j)
+    {
+      const size_t* c = &counts[(i * nbColumns_ + j) * nbTables];
+      const double* s = &columnSums_[j * nbTables];
+      for (size_t t = 0; t < nbTables; ++t)
+      {
+        // Empty rows or columns give 0/0 = NaN:
+        double e = r[t] * s[t] / totals_[t];
+        double d = static_cast<double>(c[t]) - e;
+        statistics[t] += d * d / e;
+      }
+    }
+  }
+
+  size_t df = (nbRows_ - 1) * (nbColumns_ - 1);
+  if (df <= 100)
+  {
+    for (size_t t = 0; t < nbTables; ++t)
+      pvalues[t] = chiSquareSurvival(statistics[t], df);
+  }
+  else
+  {
+    // One call for the whole batch, with the same degrees of freedom:
+    vector<double> x(statistics);
+    for (size_t t = 0; t < nbTables; ++t)
+      if (std::isnan(x[t])) x[t] = 0.;
+    RandomTools::pGamma(x, static_cast<double>(df) / 2., 0.5, pvalues);
+    for (size_t t = 0; t < nbTables; ++t)
+      pvalues[t] = std::isnan(statistics[t]) ? NumConstants::NaN() : 1. - pvalues[t];
+  }
+}
+
+/******************************************************************************/
+
+void ContingencyTableBatch::fisherExactTests(const std::vector<size_t>& counts, size_t nbTables, std::vector<double>& pvalues)
+{
+  if (nbRows_ != 2 || nbColumns_ != 2)
+    throw Exception("ContingencyTableBatch::fisherExactTests. Tables must be 2x2.");
+  computeMargins_(counts, nbTables);
+  size_t nmax = 0;
+  for (size_t t = 0; t < nbTables; ++t)
+    nmax = max(nmax, static_cast<size_t>(totals_[t]));
+  logFactorials_.reserve(nmax);
+  const LogFactorialTable& lf = logFactorials_;
+
+  pvalues.resize(nbTables);
+  if (nbTables == 0)
+    return;
+  const size_t* a = &counts[0];
+  for (size_t t = 0; t < nbTables; ++t)
+  {
+    size_t r1 = static_cast<size_t>(rowSums_[t]);
+    size_t r2 = static_cast<size_t>(rowSums_[nbTables + t]);
+    size_t c1 = static_cast<size_t>(columnSums_[t]);
+    size_t c2 = static_cast<size_t>(columnSums_[nbTables + t]);
+    size_t n = r1 + r2;
+    if (r1 == 0 || r2 == 0 || c1 == 0 || c2 == 0)
+    {
+      pvalues[t] = NumConstants::NaN();
+      continue;
+    }
+    // Hypergeometric probability of the tables with x in cell (0, 0):
+    double k = lf(r1) + lf(r2) + lf(c1) + lf(c2) - lf(n);
+    size_t xmin = (c1 > r2 ? c1 - r2 : 0);
+    size_t xmax = min(r1, c1);
+    double lpObs = k - lf(a[t]) - lf(r1 - a[t]) - lf(c1 - a[t]) - lf(r2 + a[t] - c1);
+    // Relative tolerance for tables with the same probability, as in R:
+    double lpMax = lpObs + log1p(1e-7);
+    double p = 0;
+    for (size_t x = xmin; x <= xmax; ++x)
+    {
+      double lp = k - lf(x) - lf(r1 - x) - lf(c1 - x) - lf(r2 + x - c1);
+      if (lp <= lpMax)
+        p += exp(lp);
+    }
+    pvalues[t] = min(p, 1.);
+  }
+}
+
+/******************************************************************************/
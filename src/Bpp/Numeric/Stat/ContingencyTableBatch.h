@@ -0,0 +1,158 @@
+//
+// File: ContingencyTableBatch.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _CONTINGENCYTABLEBATCH_H_
+#define _CONTINGENCYTABLEBATCH_H_
+
+//From the STL:
+#include <cstddef>
+#include <vector>
+
+namespace bpp
+{
+
+/**
+ * @brief A table of the logarithms of the factorials, extended on demand.
+ *
+ * Read accesses do not modify the table, and can be done concurrently,
+ * provided that the table was extended beforehand with reserve().
+ */
+class LogFactorialTable
+{
+  private:
+    std::vector<double> values_;
+
+  public:
+    /**
+     * @param nmax The largest integer for which the log-factorial is computed.
+     */
+    LogFactorialTable(size_t nmax = 0);
+
+  public:
+    /**
+     * @brief Extend the table up to nmax, if needed.
+     */
+    void reserve(size_t nmax);
+
+    /**
+     * @return The largest integer in the table.
+     */
+    size_t getMaximum() const { return values_.size() - 1; }
+
+    /**
+     * @return log(n!). n must not be greater than getMaximum().
+     */
+    double operator()(size_t n) const { return values_[n]; }
+};
+
+/**
+ * @brief Tests on many contingency tables of the same dimensions.
+ *
+ * This class is the batched counterpart of ContingencyTableTest, for scans where
+ * millions of small tables are tested. Tables are passed as a structure of arrays:
+ * for a block of nbTables tables with n rows and m columns, the count of cell (i, j)
+ * of table t is counts[(i * m + j) * nbTables + t]. All computations are done by
+ * passes over the tables, cell by cell, in contiguous arrays.
+ *
+ * A table with a row or column summing to 0 gets a NaN statistic and p-value.
+ */
+class ContingencyTableBatch
+{
+  private:
+    size_t nbRows_;
+    size_t nbColumns_;
+    LogFactorialTable logFactorials_;
+
+    /**
+     * @name Workspace.
+     * @{
+     */
+    std::vector<double> rowSums_;
+    std::vector<double> columnSums_;
+    std::vector<double> totals_;
+    /** @} */
+
+  public:
+    /**
+     * @param nbRows    The number of rows of the tables (at least 2).
+     * @param nbColumns The number of columns of the tables (at least 2).
+     */
+    ContingencyTableBatch(size_t nbRows, size_t nbColumns);
+
+  public:
+    size_t getNumberOfRows() const { return nbRows_; }
+    size_t getNumberOfColumns() const { return nbColumns_; }
+
+    /**
+     * @return The number of degrees of freedom of the chi square tests.
+     */
+    double getDegreesOfFreedom() const { return static_cast<double>((nbRows_ - 1) * (nbColumns_ - 1)); }
+
+    /**
+     * @brief Chi square tests.
+     *
+     * @param counts     The counts, in the layout described above.
+     * @param nbTables   The number of tables in the block.
+     * @param statistics [out] The chi square statistics.
+     * @param pvalues    [out] The p-values, using the chi square approximation.
+     * @throw Exception If the size of counts does not match the number of tables.
+     */
+    void chiSquareTests(const std::vector<size_t>& counts, size_t nbTables, std::vector<double>& statistics, std::vector<double>& pvalues);
+
+    /**
+     * @brief Fisher's exact tests, two-sided, for 2x2 tables.
+     *
+     * The p-value is the sum of the probabilities of the tables with the same
+     * marginals which are not more probable than the observed one.
+     *
+     * @param counts   The counts, in the layout described above.
+     * @param nbTables The number of tables in the block.
+     * @param pvalues  [out] The p-values.
+     * @throw Exception If the tables are not 2x2, or if the size of counts does not match the number of tables.
+     */
+    void fisherExactTests(const std::vector<size_t>& counts, size_t nbTables, std::vector<double>& pvalues);
+
+  private:
+    void computeMargins_(const std::vector<size_t>& counts, size_t nbTables);
+};
+
+} //end of namespace bpp.
+
+#endif //_CONTINGENCYTABLEBATCH_H_
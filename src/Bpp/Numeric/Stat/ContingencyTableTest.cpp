@@ -50,12 +50,96 @@ knowledge of the CeCILL license and that you accept its terms.
 using namespace bpp;
 using namespace std;
 
+namespace
+{
+  void computeExpectedCounts(const std::vector<size_t>& margin1, const std::vector<size_t>& margin2, std::vector<double>& expected)
+  {
+    size_t m = margin2.size();
+    double tot = static_cast<double>(VectorTools::sum(margin1));
+    expected.resize(margin1.size() * m);
+    for (size_t i = 0; i < margin1.size(); ++i)
+      for (size_t j = 0; j < m; ++j)
+        expected[i * m + j] = static_cast<double>(margin1[i]) * static_cast<double>(margin2[j]) / tot;
+  }
+
+  // Observed and replicated tables use the same arithmetic, so that ties are exact.
+  template<class Count>
+  double computeChiSquare(const std::vector<double>& expected, size_t n, size_t m, const Count& count)
+  {
+    double stat = 0;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < m; ++j) {
+        double e = expected[i * m + j];
+        double d = static_cast<double>(count(i, j)) - e;
+        stat += d * d / e;
+      }
+    }
+    return stat;
+  }
+}
+
+ContingencyTableStatistic::ContingencyTableStatistic(const std::vector<size_t>& margin1, const std::vector<size_t>& margin2):
+  generator_(margin1, margin2),
+  expected_(),
+  table_(margin1.size(), margin2.size())
+{
+  computeExpectedCounts(margin1, margin2, expected_);
+}
+
+double ContingencyTableStatistic::drawReplicate(const RandomFactory& generator)
+{
+  generator_.rcont2(table_, generator);
+  return computeStatistic(table_);
+}
+
+double ContingencyTableStatistic::computeStatistic(const RowMatrix<size_t>& table) const
+{
+  return computeChiSquare(expected_, table.getNumberOfRows(), table.getNumberOfColumns(),
+      [&table](size_t i, size_t j) { return table(i, j); });
+}
+
+/******************************************************************************/
+
 ContingencyTableTest::ContingencyTableTest(const std::vector< std::vector<size_t> >& table, unsigned int nbPermutations, bool warn):
   statistic_(0),
   pvalue_(0),
   df_(0),
   margin1_(table.size()),
-  margin2_(0)
+  margin2_(0),
+  nbPermutations_(0)
+{
+  bool test = false;
+  init_(table, test);
+
+  if (nbPermutations > 0) {
+    PermutationTestResult res = PermutationTestEngine(1).run(ContingencyTableStatistic(margin1_, margin2_), statistic_, nbPermutations);
+    nbPermutations_ = res.nbReplicates;
+    pvalue_ = res.pValue;
+  } else {
+    if (test && warn)
+      ApplicationTools::displayWarning("Unsufficient observations, p-value might be incorrect.");
+
+    //Compute p-value:
+    pvalue_ = 1. - RandomTools::pChisq(statistic_, df_);
+  }
+}
+
+ContingencyTableTest::ContingencyTableTest(const std::vector< std::vector<size_t> >& table, unsigned int nbPermutations, const PermutationTestEngine& engine):
+  statistic_(0),
+  pvalue_(0),
+  df_(0),
+  margin1_(table.size()),
+  margin2_(0),
+  nbPermutations_(0)
+{
+  bool test = false;
+  init_(table, test);
+  PermutationTestResult res = engine.run(ContingencyTableStatistic(margin1_, margin2_), statistic_, nbPermutations);
+  nbPermutations_ = res.nbReplicates;
+  pvalue_ = res.pValue;
+}
+
+void ContingencyTableTest::init_(const std::vector< std::vector<size_t> >& table, bool& test)
 {
   //Compute marginals:
   size_t n = table.size();
@@ -67,7 +151,7 @@ ContingencyTableTest::ContingencyTableTest(const std::vector< std::vector<size_t
   margin2_.resize(m);
   for (size_t j = 0; j < m; ++j)
     margin2_[j] = 0;
-  bool test = false;
+  test = false;
   for (size_t i = 0; i < n; ++i) {
     if (table[i].size() != m)
       throw Exception("ContingencyTableTest. Input array has non-homogeneous dimensions!");
@@ -85,45 +169,10 @@ ContingencyTableTest::ContingencyTableTest(const std::vector< std::vector<size_t
     if (margin2_[j] == 0)
       throw Exception("ContingencyTableTest. Column " + TextTools::toString(j) + " sums to 0.");
 
-
-  size_t tot = VectorTools::sum(margin1_);
   df_ = static_cast<double>((m - 1) * (n - 1));
-  
-  RowMatrix<long double> expc(n, m);
-  for (size_t i = 0; i < n; ++i) {
-    for (size_t j = 0; j < m; ++j) {
-      long double c = table[i][j];
-      long double e = static_cast<long double>(margin1_[i] * margin2_[j]) / static_cast<long double>(tot);
-      expc(i, j) = e;
-      statistic_ += static_cast<double>(std::pow(c - e, 2.L) / e);
-    }
-  }
-
-  if (nbPermutations > 0) {
-    size_t count = 0;
-    ContingencyTableGenerator ctgen(margin1_, margin2_);
-    for (unsigned int k = 0; k < nbPermutations; ++k) {
-      //Randomize:
-      RowMatrix<size_t> table_rep = ctgen.rcont2();
-      //Recompute statistic:
-      double stat_rep = 0;
-      for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < m; ++j) {
-          long double c = table_rep(i , j);
-          long double e = expc(i, j);
-          stat_rep += static_cast<double>(std::pow(c - e, 2.L) / e);
-        }
-      }
-      if (stat_rep >= statistic_)
-        count++;
-    }
-    pvalue_ = static_cast<double>(count + 1) / static_cast<double>(nbPermutations + 1);
-  } else {
-    if (test && warn)
-      ApplicationTools::displayWarning("Unsufficient observations, p-value might be incorrect.");
 
-    //Compute p-value:
-    pvalue_ = 1. - RandomTools::pChisq(statistic_, df_);
-  }
+  vector<double> expected;
+  computeExpectedCounts(margin1_, margin2_, expected);
+  statistic_ = computeChiSquare(expected, n, m,
+      [&table](size_t i, size_t j) { return table[i][j]; });
 }
-
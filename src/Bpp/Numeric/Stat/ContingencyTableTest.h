@@ -41,6 +41,9 @@ knowledge of the CeCILL license and that you accept its terms.
 #define _CONTINGENCYTABLETEST_H_
 
 #include "StatTest.h"
+#include "PermutationTest.h"
+#include "../Matrix/Matrix.h"
+#include "../Random/ContingencyTableGenerator.h"
 
 //From the STL:
 #include <vector>
@@ -48,6 +51,38 @@ knowledge of the CeCILL license and that you accept its terms.
 namespace bpp
 {
 
+/**
+ * @brief The chi square statistic of contingency tables with given marginals.
+ *
+ * Replicates are drawn with ContingencyTableGenerator::rcont2(), in a buffer
+ * allocated once.
+ */
+class ContingencyTableStatistic:
+  public virtual ResamplingStatistic
+{
+  private:
+    ContingencyTableGenerator generator_;
+    std::vector<double> expected_;
+    RowMatrix<size_t> table_;
+
+  public:
+    /**
+     * @param margin1 The row marginals.
+     * @param margin2 The column marginals.
+     */
+    ContingencyTableStatistic(const std::vector<size_t>& margin1, const std::vector<size_t>& margin2);
+
+    ContingencyTableStatistic* clone() const { return new ContingencyTableStatistic(*this); }
+
+  public:
+    double drawReplicate(const RandomFactory& generator);
+
+    /**
+     * @return The chi square statistic of a table with the marginals of this object.
+     */
+    double computeStatistic(const RowMatrix<size_t>& table) const;
+};
+
 /**
  * @brief Implements tests on contingency tables.
  *
@@ -62,6 +97,7 @@ class ContingencyTableTest:
     double df_;
     std::vector<size_t> margin1_;
     std::vector<size_t> margin2_;
+    size_t nbPermutations_;
 
   public:
     /**
@@ -72,6 +108,17 @@ class ContingencyTableTest:
      * @param warn Should a warning message be displayed in case of unsufficient observations?
      */
     ContingencyTableTest(const std::vector< std::vector<size_t> >& table, unsigned int nbPermutations = 0, bool warn = true);
+
+    /**
+     * @brief Build a new test object and perform a randomization test with a given engine.
+     *
+     * The engine sets the number of threads and the early stopping rule.
+     *
+     * @param table The input contingency table.
+     * @param nbPermutations The maximum number of permutations.
+     * @param engine The resampling engine.
+     */
+    ContingencyTableTest(const std::vector< std::vector<size_t> >& table, unsigned int nbPermutations, const PermutationTestEngine& engine);
     virtual ~ContingencyTableTest() {}
 
     ContingencyTableTest* clone() const { return new ContingencyTableTest(*this); }
@@ -84,6 +131,15 @@ class ContingencyTableTest:
     const std::vector<size_t> getMarginRows() const { return margin1_; }
     const std::vector<size_t> getMarginColumns() const { return margin2_; }
 
+    /**
+     * @return The number of permutations performed, which may be lower than the one
+     * requested if the test stopped early (0 for the chi square approximation).
+     */
+    size_t getNumberOfPermutations() const { return nbPermutations_; }
+
+  private:
+    void init_(const std::vector< std::vector<size_t> >& table, bool& lowCounts);
+
 };
 
 } //end of namespace bpp.
@@ -0,0 +1,139 @@
+//
+// File: PermutationTest.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "PermutationTest.h"
+#include "../Random/Uniform01Xoshiro.h"
+#include "../../Exceptions.h"
+#include "../../Utils/ThreadTools.h"
+
+//From the STL:
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+PermutationTestEngine::PermutationTestEngine(unsigned int nbThreads, size_t blockSize):
+  nbThreads_(nbThreads),
+  blockSize_(blockSize),
+  threshold_(0),
+  minExceedances_(10)
+{
+  if (blockSize == 0)
+    throw Exception("PermutationTestEngine. Block size must be greater than 0.");
+}
+
+/******************************************************************************/
+
+void PermutationTestEngine::setBlockSize(size_t blockSize)
+{
+  if (blockSize == 0)
+    throw Exception("PermutationTestEngine::setBlockSize. Block size must be greater than 0.");
+  blockSize_ = blockSize;
+}
+
+/******************************************************************************/
+
+PermutationTestResult PermutationTestEngine::run(const ResamplingStatistic& statistic, double observed, size_t nbReplicates, const RandomFactory& generator) const
+{
+  // the threads are started for each round: rounds are only kept short
+  // when the test may stop after any block
+  const size_t roundSize = (threshold_ > 0 ? 16 : 1024);
+  PermutationTestResult result;
+  if (nbReplicates == 0)
+    return result;
+
+  unsigned int nbThreads = (nbThreads_ == 0 ? ThreadTools::getNumberOfAvailableThreads() : nbThreads_);
+  size_t nbBlocks = (nbReplicates + blockSize_ - 1) / blockSize_;
+  nbThreads = static_cast<unsigned int>(min(static_cast<size_t>(nbThreads), min(nbBlocks, roundSize)));
+
+  vector< unique_ptr<ResamplingStatistic> > statistics(nbThreads);
+  for (size_t t = 0; t < nbThreads; ++t)
+    statistics[t].reset(dynamic_cast<ResamplingStatistic*>(statistic.clone()));
+
+  Uniform01Xoshiro master(static_cast<long>(generator.drawNumber() * 9007199254740992.));
+  vector<Uniform01Xoshiro> streams;
+  vector<size_t> counts;
+  bool stop = false;
+  for (size_t first = 0; first < nbBlocks && !stop; first += roundSize)
+  {
+    size_t nb = min(roundSize, nbBlocks - first);
+    streams.clear();
+    for (size_t b = 0; b < nb; ++b)
+    {
+      streams.push_back(master);
+      master.jump();
+    }
+    counts.assign(nb, 0);
+    ThreadTools::parallelFor(nb, nbThreads, [&](size_t b, unsigned int threadId) {
+        ResamplingStatistic& stat = *statistics[threadId];
+        size_t start = (first + b) * blockSize_;
+        size_t end = min(start + blockSize_, nbReplicates);
+        size_t count = 0;
+        for (size_t k = start; k < end; ++k)
+        {
+          if (stat.drawReplicate(streams[b]) >= observed)
+            count++;
+        }
+        counts[b] = count;
+      });
+
+    for (size_t b = 0; b < nb && !stop; ++b)
+    {
+      result.nbExceedances += counts[b];
+      result.nbReplicates = min((first + b + 1) * blockSize_, nbReplicates);
+      if (threshold_ > 0 && result.nbExceedances >= minExceedances_)
+      {
+        double n = static_cast<double>(result.nbReplicates);
+        double p = static_cast<double>(result.nbExceedances) / n;
+        if (p - 3. * sqrt(p * (1. - p) / n) > threshold_)
+          stop = true;
+      }
+    }
+  }
+  result.pValue = static_cast<double>(result.nbExceedances + 1) / static_cast<double>(result.nbReplicates + 1);
+  return result;
+}
+
+/******************************************************************************/
@@ -0,0 +1,172 @@
+//
+// File: PermutationTest.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _PERMUTATIONTEST_H_
+#define _PERMUTATIONTEST_H_
+
+#include "../../Clonable.h"
+#include "../Random/RandomFactory.h"
+#include "../Random/RandomTools.h"
+
+//From the STL:
+#include <cstddef>
+
+namespace bpp
+{
+
+/**
+ * @brief Interface for the statistics of resampling tests.
+ *
+ * An instance draws a replicate of the data under the null hypothesis and computes
+ * the statistic on it. Each thread of a PermutationTestEngine uses its own copy of the
+ * statistic, obtained with clone(), so that buffers can be kept and reused
+ * between replicates without synchronization.
+ */
+class ResamplingStatistic:
+  public virtual Clonable
+{
+  public:
+    ResamplingStatistic() {}
+    virtual ~ResamplingStatistic() {}
+
+    ResamplingStatistic* clone() const = 0;
+
+  public:
+    /**
+     * @brief Draw a replicate under the null hypothesis and compute its statistic.
+     *
+     * @param generator The random number generator to use.
+     * @return The statistic of the replicate.
+     */
+    virtual double drawReplicate(const RandomFactory& generator) = 0;
+};
+
+/**
+ * @brief The result of a resampling test.
+ */
+struct PermutationTestResult
+{
+  /**
+   * @brief The number of replicates drawn.
+   */
+  size_t nbReplicates;
+
+  /**
+   * @brief The number of replicates with a statistic greater or equal to the observed one.
+   */
+  size_t nbExceedances;
+
+  /**
+   * @brief The p-value, (nbExceedances + 1) / (nbReplicates + 1).
+   */
+  double pValue;
+
+  PermutationTestResult(): nbReplicates(0), nbExceedances(0), pValue(1.) {}
+};
+
+/**
+ * @brief Run resampling tests on several threads.
+ *
+ * Replicates are drawn by blocks. Each block uses its own random stream, a
+ * Uniform01Xoshiro generator advanced by one jump from the stream of the previous block,
+ * the first one being seeded from the generator passed to run(). Blocks are
+ * distributed over threads by rounds of 16 blocks with early stopping, or of 1024 blocks
+ * otherwise, and their results are accumulated in block order, so that the result only
+ * depends on the seed, not on the number of threads. A single thread is used unless
+ * more are asked for.
+ *
+ * Early stopping, as in sequential Monte-Carlo tests, can be enabled with
+ * setEarlyStopping(): the test stops at the end of a block when at least minExceedances
+ * replicates exceed the observed statistic and the p-value is clearly above the
+ * significance threshold, that is, the estimated p-value minus three standard
+ * errors is greater than the threshold. The p-value is then computed on the
+ * replicates drawn so far.
+ */
+class PermutationTestEngine
+{
+  private:
+    unsigned int nbThreads_;
+    size_t blockSize_;
+    double threshold_;
+    size_t minExceedances_;
+
+  public:
+    /**
+     * @param nbThreads The number of threads to use (0 means all available threads).
+     * @param blockSize The number of replicates per block.
+     */
+    PermutationTestEngine(unsigned int nbThreads = 1, size_t blockSize = 256);
+
+  public:
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    size_t getBlockSize() const { return blockSize_; }
+    void setBlockSize(size_t blockSize);
+
+    /**
+     * @brief Enable early stopping.
+     *
+     * @param threshold      The significance threshold (0 to disable early stopping).
+     * @param minExceedances The minimum number of exceedances before stopping.
+     */
+    void setEarlyStopping(double threshold, size_t minExceedances = 10)
+    {
+      threshold_ = threshold;
+      minExceedances_ = minExceedances;
+    }
+
+    double getEarlyStoppingThreshold() const { return threshold_; }
+
+    /**
+     * @brief Perform a resampling test.
+     *
+     * @param statistic    The statistic, which is cloned for each thread.
+     * @param observed     The observed value of the statistic.
+     * @param nbReplicates The maximum number of replicates.
+     * @param generator    The generator used to seed the random streams.
+     * @return The result of the test.
+     */
+    PermutationTestResult run(const ResamplingStatistic& statistic, double observed, size_t nbReplicates, const RandomFactory& generator = *RandomTools::DEFAULT_GENERATOR) const;
+};
+
+} //end of namespace bpp.
+
+#endif //_PERMUTATIONTEST_H_
@@ -38,6 +38,7 @@ knowledge of the CeCILL license and that you accept its terms.
 */
 
 #include "StatTools.h"
+#include "../../Utils/ThreadTools.h"
 
 //From the STL:
 #include <algorithm>
@@ -48,13 +49,17 @@ using namespace std;
 vector<double> StatTools::computeFdr(const vector<double>& pvalues) {
   size_t n = pvalues.size();
   vector<PValue_> sortedPValues;
+  sortedPValues.reserve(n);
   for (size_t i = 0; i < n; ++i) {
     sortedPValues.push_back(PValue_(pvalues[i], i));  
   }
-  sort(sortedPValues.begin(), sortedPValues.end());
+  ThreadTools::parallelSort(sortedPValues.begin(), sortedPValues.end());
   vector<double> fdr(pvalues.size());
-  for (size_t i = 0; i < sortedPValues.size(); ++i) {
-    fdr[sortedPValues[i].index_] = sortedPValues[i].pvalue_ * static_cast<double>(n) / ( static_cast<double>(sortedPValues[i].index_ + 1));
+  //Step-up: each rate is the minimum of the ones of this rank and above.
+  double q = 1.;
+  for (size_t i = n; i > 0; --i) {
+    q = min(q, sortedPValues[i - 1].pvalue_ * static_cast<double>(n) / static_cast<double>(i));
+    fdr[sortedPValues[i - 1].index_] = q;
   }
   return fdr;
 }
@@ -59,7 +59,7 @@ class StatTools
         pvalue_(pvalue), index_(index) {}
 
       bool operator<(const PValue_& pvalue) const {
-        return pvalue.pvalue_ < pvalue_;
+        return pvalue_ < pvalue.pvalue_;
       }
     };
 
@@ -71,6 +71,10 @@ class StatTools
      * The FDR r is calculated with the formula
      * @f$ r = p * n / i@f$
      * where p is the p-value, n is the number of tests (the size of the input vector) and i is the rank of the p-value, that is the index in the sorted array.
+     * Each rate is then replaced by the minimum of the rates of the larger p-values, and bounded by 1,
+     * so that the rates are in the same order as the p-values (these are the values of StreamingFdr with the 'BH' method).
+     * P-values are sorted on all available threads.
+     * For sets of p-values too large to be held in memory, see StreamingFdr.
      * 
      * References:
      * - Benjamini, Y and Hochberg, Y (1995). Controlling the false discovery rate: a practical and powerful approach to multiple testing. Journal of the Royal Statistical Society, Series B (Methodological) 57(1):289-300.
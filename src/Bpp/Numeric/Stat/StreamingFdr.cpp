@@ -0,0 +1,338 @@
+//
+// File: StreamingFdr.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#include "StreamingFdr.h"
+#include "../../Exceptions.h"
+#include "../../Text/TextTools.h"
+#include "../../Utils/ThreadTools.h"
+
+//From the STL:
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace bpp;
+using namespace std;
+
+const string StreamingFdr::METHOD_BH = "BH";
+const string StreamingFdr::METHOD_STOREY = "Storey";
+
+namespace
+{
+  // Number of bins per power of 2, and number of powers of 2 from 2^-1022 to 1:
+  const size_t NB_SUBBINS = 1024;
+  const size_t NB_OCTAVES = 1024;
+  const size_t NB_BINS = 1 + NB_SUBBINS * NB_OCTAVES;
+  const size_t BLOCK_SIZE = 1048576;
+
+  /**
+   * @brief Call a function on consecutive blocks of a file of doubles.
+   *
+   * The file is memory-mapped when possible, and read with stdio otherwise.
+   */
+  void forEachBlock(const string& path, const function<void (const double*, size_t)>& f)
+  {
+#if !defined(_WIN32)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw IOException("StreamingFdr::adjustFile. Cannot open file " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw IOException("StreamingFdr::adjustFile. Cannot read the size of file " + path);
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size % sizeof(double) != 0)
+    {
+      close(fd);
+      throw IOException("StreamingFdr::adjustFile. The size of file " + path + " is not a multiple of the size of a double.");
+    }
+    if (size == 0)
+    {
+      close(fd);
+      return;
+    }
+    void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+      throw IOException("StreamingFdr::adjustFile. Cannot map file " + path);
+    madvise(map, size, MADV_SEQUENTIAL);
+    const double* data = static_cast<const double*>(map);
+    size_t n = size / sizeof(double);
+    try
+    {
+      for (size_t i = 0; i < n; i += BLOCK_SIZE)
+        f(data + i, min(BLOCK_SIZE, n - i));
+    }
+    catch (...)
+    {
+      munmap(map, size);
+      throw;
+    }
+    munmap(map, size);
+#else
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+      throw IOException("StreamingFdr::adjustFile. Cannot open file " + path);
+    vector<double> buffer(BLOCK_SIZE);
+    size_t n;
+    try
+    {
+      while ((n = fread(&buffer[0], sizeof(double), BLOCK_SIZE, file)) > 0)
+        f(&buffer[0], n);
+    }
+    catch (...)
+    {
+      fclose(file);
+      throw;
+    }
+    fclose(file);
+#endif
+  }
+}
+
+/******************************************************************************/
+
+StreamingFdr::StreamingFdr(const std::string& method, size_t maxInMemory, unsigned int nbThreads, double lambda):
+  method_(method),
+  lambda_(lambda),
+  maxInMemory_(maxInMemory),
+  nbThreads_(nbThreads),
+  nbPValues_(0),
+  nbAboveLambda_(0),
+  values_(),
+  histogram_(),
+  finalized_(false),
+  pi0_(1.),
+  adjusted_(),
+  cumulative_()
+{
+  if (method != METHOD_BH && method != METHOD_STOREY)
+    throw Exception("StreamingFdr. Unknown method: " + method);
+  if (!(lambda > 0 && lambda < 1))
+    throw Exception("StreamingFdr. Lambda must be in ]0, 1[.");
+}
+
+/******************************************************************************/
+
+size_t StreamingFdr::getBin_(double pvalue)
+{
+  if (pvalue <= 0)
+    return 0;
+  int e;
+  double m = frexp(pvalue, &e); // pvalue = m * 2^e, with m in [0.5, 1[
+  if (e < -1022)
+    return 1;
+  size_t octave = static_cast<size_t>(e + 1022);
+  size_t sub = static_cast<size_t>((m - 0.5) * 2. * static_cast<double>(NB_SUBBINS));
+  return min(1 + octave * NB_SUBBINS + sub, NB_BINS - 1);
+}
+
+double StreamingFdr::getBinUpperBound_(size_t bin)
+{
+  if (bin == 0)
+    return 0.;
+  size_t octave = (bin - 1) / NB_SUBBINS;
+  size_t sub = (bin - 1) % NB_SUBBINS;
+  return min(1., ldexp(0.5 + static_cast<double>(sub + 1) / static_cast<double>(2 * NB_SUBBINS), static_cast<int>(octave) - 1022));
+}
+
+/******************************************************************************/
+
+void StreamingFdr::add(double pvalue)
+{
+  if (finalized_)
+    throw Exception("StreamingFdr::add. P-values cannot be added after finalize().");
+  if (!(pvalue >= 0 && pvalue <= 1))
+    throw Exception("StreamingFdr::add. Invalid p-value: " + TextTools::toString(pvalue));
+  nbPValues_++;
+  if (pvalue > lambda_)
+    nbAboveLambda_++;
+  if (histogram_.empty())
+  {
+    if (values_.size() < maxInMemory_)
+    {
+      values_.push_back(pvalue);
+      return;
+    }
+    spill_();
+  }
+  histogram_[getBin_(pvalue)]++;
+}
+
+void StreamingFdr::add(const double* pvalues, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    add(pvalues[i]);
+}
+
+void StreamingFdr::spill_()
+{
+  histogram_.assign(NB_BINS, 0);
+  for (size_t i = 0; i < values_.size(); ++i)
+    histogram_[getBin_(values_[i])]++;
+  vector<double>().swap(values_);
+}
+
+/******************************************************************************/
+
+void StreamingFdr::finalize()
+{
+  if (finalized_)
+    return;
+  finalized_ = true;
+  double n = static_cast<double>(nbPValues_);
+  if (method_ == METHOD_STOREY && nbPValues_ > 0)
+    pi0_ = min(1., static_cast<double>(nbAboveLambda_) / (n * (1. - lambda_)));
+
+  if (histogram_.empty())
+  {
+    // Exact computation:
+    ThreadTools::parallelSort(values_.begin(), values_.end(), nbThreads_);
+    adjusted_.resize(values_.size());
+    double q = 1.;
+    for (size_t i = values_.size(); i > 0; --i)
+    {
+      q = min(q, values_[i - 1] * n / static_cast<double>(i));
+      adjusted_[i - 1] = q;
+    }
+  }
+  else
+  {
+    // adjusted_[b] is an upper bound of the adjusted value of the largest p-value
+    // in bins b and above:
+    cumulative_.resize(NB_BINS + 1);
+    cumulative_[0] = 0;
+    for (size_t b = 0; b < NB_BINS; ++b)
+      cumulative_[b + 1] = cumulative_[b] + histogram_[b];
+    adjusted_.resize(NB_BINS + 1);
+    adjusted_[NB_BINS] = 1.;
+    for (size_t b = NB_BINS; b > 0; --b)
+    {
+      double q = adjusted_[b];
+      if (histogram_[b - 1] > 0)
+        q = min(q, getBinUpperBound_(b - 1) * n / static_cast<double>(cumulative_[b]));
+      adjusted_[b - 1] = q;
+    }
+  }
+}
+
+/******************************************************************************/
+
+void StreamingFdr::checkFinalized_() const
+{
+  if (!finalized_)
+    throw Exception("StreamingFdr. finalize() must be called first.");
+}
+
+double StreamingFdr::getPi0() const
+{
+  checkFinalized_();
+  return pi0_;
+}
+
+double StreamingFdr::getAdjustedPValue(double pvalue) const
+{
+  checkFinalized_();
+  double n = static_cast<double>(nbPValues_);
+  double q;
+  if (histogram_.empty())
+  {
+    size_t i = static_cast<size_t>(upper_bound(values_.begin(), values_.end(), pvalue) - values_.begin());
+    if (i > 0)
+      q = adjusted_[i - 1];
+    else
+      q = min(1., min(pvalue * n, values_.empty() ? 1. : adjusted_[0]));
+  }
+  else
+  {
+    size_t b = getBin_(pvalue);
+    q = min(pvalue * n / static_cast<double>(cumulative_[b] + 1), adjusted_[b]);
+  }
+  return pi0_ * q;
+}
+
+void StreamingFdr::getAdjustedPValues(const double* pvalues, double* adjusted, size_t n) const
+{
+  for (size_t i = 0; i < n; ++i)
+    adjusted[i] = getAdjustedPValue(pvalues[i]);
+}
+
+/******************************************************************************/
+
+uint64_t StreamingFdr::adjustFile(const std::string& inputFile, const std::string& outputFile, const std::string& method, size_t maxInMemory, unsigned int nbThreads, double lambda)
+{
+  StreamingFdr fdr(method, maxInMemory, nbThreads, lambda);
+  forEachBlock(inputFile, [&fdr](const double* values, size_t n) { fdr.add(values, n); });
+  fdr.finalize();
+
+  FILE* out = fopen(outputFile.c_str(), "wb");
+  if (!out)
+    throw IOException("StreamingFdr::adjustFile. Cannot create file " + outputFile);
+  vector<double> buffer;
+  try
+  {
+    forEachBlock(inputFile, [&fdr, &buffer, out, &outputFile](const double* values, size_t n) {
+        buffer.resize(n);
+        fdr.getAdjustedPValues(values, &buffer[0], n);
+        if (fwrite(&buffer[0], sizeof(double), n, out) != n)
+          throw IOException("StreamingFdr::adjustFile. Cannot write to file " + outputFile);
+      });
+  }
+  catch (...)
+  {
+    fclose(out);
+    throw;
+  }
+  if (fclose(out) != 0)
+    throw IOException("StreamingFdr::adjustFile. Cannot write to file " + outputFile);
+  return fdr.getNumberOfPValues();
+}
+
+/******************************************************************************/
@@ -0,0 +1,190 @@
+//
+// File: StreamingFdr.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  for numerical calculus.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+
+#ifndef _STREAMINGFDR_H_
+#define _STREAMINGFDR_H_
+
+//From the STL:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+
+/**
+ * @brief False discovery rates of very large sets of p-values.
+ *
+ * P-values are added one by one or by blocks, with add(). As long as their number
+ * does not exceed a given limit, they are kept in memory. Above this limit, they
+ * are only counted in a histogram with logarithmic bins: each power of 2 is split into
+ * 1024 bins, so that the relative width of a bin is below 1e-3, and the memory used
+ * does not depend on the number of p-values.
+ *
+ * Once all p-values have been added, finalize() sorts the p-values kept in memory
+ * (on several threads, see ThreadTools::parallelSort()), or accumulates the histogram,
+ * after which getAdjustedPValue() gives the adjusted value of any p-value of the set:
+ * - with METHOD_BH, the Benjamini and Hochberg adjusted p-value,
+ *   @f$q_{(i)} = \min_{j \geq i} \min(1, n p_{(j)} / j)@f$;
+ * - with METHOD_STOREY, Storey's q-value, that is the same value multiplied by the
+ *   estimated proportion of true null hypotheses,
+ *   @f$\pi_0 = \#\{p > \lambda\} / (n (1 - \lambda))@f$, with a fixed @f$\lambda@f$.
+ *
+ * With p-values kept in memory, the adjusted values are exact. With the histogram,
+ * the rank of a p-value is replaced by the number of p-values in the lower bins plus one,
+ * which gives conservative adjusted values (never below the exact ones). The error is
+ * only due to p-values in the same bin, which are within 0.1% of each other.
+ *
+ * For p-values stored on disk, adjustFile() performs both passes on a
+ * memory-mapped file.
+ *
+ * References:
+ * - Benjamini, Y and Hochberg, Y (1995). Controlling the false discovery rate: a practical and powerful approach to multiple testing. Journal of the Royal Statistical Society, Series B (Methodological) 57(1):289-300.
+ * - Storey, JD (2002). A direct approach to false discovery rates. Journal of the Royal Statistical Society, Series B (Statistical Methodology) 64(3):479-498.
+ */
+class StreamingFdr
+{
+  public:
+    static const std::string METHOD_BH;
+    static const std::string METHOD_STOREY;
+
+  private:
+    std::string method_;
+    double lambda_;
+    size_t maxInMemory_;
+    unsigned int nbThreads_;
+    uint64_t nbPValues_;
+    uint64_t nbAboveLambda_;
+    std::vector<double> values_;
+    std::vector<uint64_t> histogram_;
+    bool finalized_;
+    double pi0_;
+
+    /**
+     * @name Tables computed by finalize().
+     *
+     * For sorted values, the adjusted value of each value. For the histogram, the number
+     * of p-values in the lower bins and the adjusted value of the upper bound of each bin.
+     * @{
+     */
+    std::vector<double> adjusted_;
+    std::vector<uint64_t> cumulative_;
+    /** @} */
+
+  public:
+    /**
+     * @param method      The method to use, METHOD_BH or METHOD_STOREY.
+     * @param maxInMemory The maximum number of p-values kept in memory.
+     * @param nbThreads   The number of threads used to sort the p-values (0 means all available threads).
+     * @param lambda      The threshold used to estimate the proportion of true null hypotheses (Storey's method only).
+     */
+    StreamingFdr(const std::string& method = METHOD_BH, size_t maxInMemory = 16777216, unsigned int nbThreads = 0, double lambda = 0.5);
+
+  public:
+    /**
+     * @brief Add a p-value to the set.
+     *
+     * @throw Exception If the p-value is not in [0, 1], or if finalize() was already called.
+     */
+    void add(double pvalue);
+
+    /**
+     * @brief Add several p-values to the set.
+     */
+    void add(const double* pvalues, size_t n);
+
+    /**
+     * @brief Compute the tables of adjusted values, once all p-values have been added.
+     */
+    void finalize();
+
+    uint64_t getNumberOfPValues() const { return nbPValues_; }
+
+    /**
+     * @return true if the adjusted values are exact, that is if all p-values were kept in memory.
+     */
+    bool isExact() const { return histogram_.empty(); }
+
+    /**
+     * @return The estimated proportion of true null hypotheses (1 with METHOD_BH).
+     * @throw Exception If finalize() was not called.
+     */
+    double getPi0() const;
+
+    /**
+     * @return The adjusted value of a p-value of the set.
+     * @throw Exception If finalize() was not called.
+     */
+    double getAdjustedPValue(double pvalue) const;
+
+    /**
+     * @brief Compute the adjusted values of several p-values of the set.
+     */
+    void getAdjustedPValues(const double* pvalues, double* adjusted, size_t n) const;
+
+    /**
+     * @brief Compute the adjusted values of a file of p-values.
+     *
+     * The input file is a raw array of doubles, in the byte order of the machine,
+     * which is mapped into memory. A first pass builds the tables, a second pass
+     * writes the adjusted values to the output file, in the same format and order.
+     *
+     * @param inputFile   The path of the file of p-values.
+     * @param outputFile  The path of the file of adjusted values.
+     * @param method      The method to use.
+     * @param maxInMemory The maximum number of p-values kept in memory.
+     * @param nbThreads   The number of threads used to sort the p-values.
+     * @param lambda      The threshold of Storey's method.
+     * @return The number of p-values.
+     * @throw IOException If a file cannot be read or written.
+     */
+    static uint64_t adjustFile(const std::string& inputFile, const std::string& outputFile, const std::string& method = METHOD_BH, size_t maxInMemory = 16777216, unsigned int nbThreads = 0, double lambda = 0.5);
+
+  private:
+    void spill_();
+    static size_t getBin_(double pvalue);
+    static double getBinUpperBound_(size_t bin);
+    void checkFinalized_() const;
+};
+
+} //end of namespace bpp.
+
+#endif //_STREAMINGFDR_H_
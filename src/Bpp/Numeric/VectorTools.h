@@ -1677,30 +1677,36 @@ namespace bpp
      * This is the continuous version. The vector is supposed to be a finite sample from
      * a continuous distribution. The density is of the distribution is estimated using
      * a kernel method, and is used to compute the continuous entropy.
+     * Densities are exact by default. With a tolerance of eg 1e-3, the error on
+     * each log density is about 1e-3 at most, in natural log units, and large
+     * samples are processed much faster.
      *
      * Reference: Ivan Kojadinovic (2004) _Computational Statistics & Data Analysis_, 46:269-294
      *
      * @author Julien Dutheil
      * @see shannon For the discrete version.
+     * @see AdaptiveKernelDensityEstimation
      *
      * @param v The input std::vector.
      * @param base The base of the logarithm to use.
+     * @param tolerance The maximum relative error of the estimated densities (0 for the exact estimator).
+     * @param nbThreads The maximum number of threads to use (0 means all available threads).
      */
     template<class InputType, class OutputType>
-    static OutputType shannonContinuous(const std::vector<InputType>& v, double base = 2.7182818)
+    static OutputType shannonContinuous(const std::vector<InputType>& v, double base = 2.7182818, double tolerance = 0, unsigned int nbThreads = 1)
     {
       LinearMatrix<InputType> m(1, v.size());
       for (size_t i = 0; i < v.size(); i++)
       {
         m(0, i) = v[i];
       }
-      AdaptiveKernelDensityEstimation kd(m);
+      AdaptiveKernelDensityEstimation kd(m, 0.5, tolerance, nbThreads);
+      std::vector<double> d;
+      kd.kDensities(m, d, nbThreads);
       OutputType s = 0;
-      std::vector<double> x(1);
-      for (auto it : v)
+      for (auto it : d)
       {
-        x[0] = static_cast<double>(it);
-        s += static_cast<OutputType>(std::log(kd.kDensity(x)) / std::log(base));
+        s += static_cast<OutputType>(std::log(it) / std::log(base));
       }
       return -s / static_cast<double>(v.size());
     }
@@ -1711,7 +1717,8 @@ namespace bpp
      * This is the continuous version. Each vector is supposed to be a finite sample from
      * a continuous distribution. The density is of the distribution is estimated using
      * a kernel method, as well as the joint density, and are used to compute the continuous
-     * mutual information.
+     * mutual information. Densities are exact by default, see shannonContinuous
+     * for the tolerance.
      *
      * Reference: Ivan Kojadinovic (2004) _Computational Statistics & Data Analysis_, 46:269-294
      *
@@ -1722,10 +1729,12 @@ namespace bpp
      * @param v1 The first input vector.
      * @param v2 The second input vector.
      * @param base The base of the logarithm to use.
+     * @param tolerance The maximum relative error of the estimated densities (0 for the exact estimator).
+     * @param nbThreads The maximum number of threads to use (0 means all available threads).
      * @throw DimensionException if the two vectors do not have the same lengths.
      */
     template<class InputType, class OutputType>
-    static OutputType miContinuous(const std::vector<InputType>& v1, const std::vector<InputType>& v2, double base = 2.7182818)
+    static OutputType miContinuous(const std::vector<InputType>& v1, const std::vector<InputType>& v2, double base = 2.7182818, double tolerance = 0, unsigned int nbThreads = 1)
     {
       if (v1.size() != v2.size())
         throw DimensionException("VectorTools::miContinuous. The two samples must have the same length.", v2.size(), v1.size());
@@ -1737,18 +1746,17 @@ namespace bpp
         m1(0, i) = m12(0, i) = v1[i];
         m2(0, i) = m12(1, i) = v2[i];
       }
-      AdaptiveKernelDensityEstimation kd1(m1);
-      AdaptiveKernelDensityEstimation kd2(m2);
-      AdaptiveKernelDensityEstimation kd12(m12);
+      AdaptiveKernelDensityEstimation kd1(m1, 0.5, tolerance, nbThreads);
+      AdaptiveKernelDensityEstimation kd2(m2, 0.5, tolerance, nbThreads);
+      AdaptiveKernelDensityEstimation kd12(m12, 0.5, tolerance, nbThreads);
+      std::vector<double> d1, d2, d12;
+      kd1.kDensities(m1, d1, nbThreads);
+      kd2.kDensities(m2, d2, nbThreads);
+      kd12.kDensities(m12, d12, nbThreads);
       OutputType s = 0;
-      std::vector<double> x1(1);
-      std::vector<double> x2(1);
-      std::vector<double> x12(2);
       for (size_t i = 0; i < v1.size(); i++)
       {
-        x1[0] = x12[0] = static_cast<double>(v1[i]);
-        x2[0] = x12[1] = static_cast<double>(v2[i]);
-        s += static_cast<OutputType>(std::log(kd12.kDensity(x12) / (kd1.kDensity(x1) * kd2.kDensity(x2))) / std::log(base));
+        s += static_cast<OutputType>(std::log(d12[i] / (d1[i] * d2[i])) / std::log(base));
       }
       return s / static_cast<double>(v1.size());
     }
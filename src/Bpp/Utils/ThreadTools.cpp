@@ -0,0 +1,114 @@
+//
+// File: ThreadTools.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  to deal with threads.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "ThreadTools.h"
+
+// From the STL:
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+unsigned int ThreadTools::getNumberOfAvailableThreads()
+{
+  unsigned int n = thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+/******************************************************************************/
+
+void ThreadTools::parallelFor(size_t n, unsigned int nbThreads, const std::function<void (size_t, unsigned int)>& task)
+{
+  if (nbThreads == 0)
+    nbThreads = getNumberOfAvailableThreads();
+  if (nbThreads > n)
+    nbThreads = static_cast<unsigned int>(n);
+  if (nbThreads <= 1)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      task(i, 0);
+    }
+    return;
+  }
+
+  atomic<size_t> next(0);
+  atomic<bool> failed(false);
+  exception_ptr error;
+  mutex errorMutex;
+
+  auto worker = [&](unsigned int t) {
+    try
+    {
+      for (size_t i = next++; i < n && !failed; i = next++)
+      {
+        task(i, t);
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(errorMutex);
+      if (!error)
+        error = current_exception();
+      failed = true;
+    }
+  };
+
+  vector<thread> threads;
+  threads.reserve(nbThreads - 1);
+  for (unsigned int t = 1; t < nbThreads; ++t)
+  {
+    threads.push_back(thread(worker, t));
+  }
+  worker(0);
+  for (size_t t = 0; t < threads.size(); ++t)
+  {
+    threads[t].join();
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,141 @@
+//
+// File: ThreadTools.h
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+  Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+  This software is a computer program whose purpose is to provide classes
+  to deal with threads.
+
+  This software is governed by the CeCILL  license under French law and
+  abiding by the rules of distribution of free software.  You can  use,
+  modify and/ or redistribute the software under the terms of the CeCILL
+  license as circulated by CEA, CNRS and INRIA at the following URL
+  "http://www.cecill.info".
+
+  As a counterpart to the access to the source code and  rights to copy,
+  modify and redistribute granted by the license, users are provided only
+  with a limited warranty  and the software's author,  the holder of the
+  economic rights,  and the successive licensors  have only  limited
+  liability.
+
+  In this respect, the user's attention is drawn to the risks associated
+  with loading,  using,  modifying and/or developing or reproducing the
+  software by the user in light of its specific status of free software,
+  that may mean  that it is complicated to manipulate,  and  that  also
+  therefore means  that it is reserved for developers  and  experienced
+  professionals having in-depth computer knowledge. Users are therefore
+  encouraged to load and test the software's suitability as regards their
+  requirements in conditions enabling the security of their systems and/or
+  data to be ensured and,  more generally, to use and operate it in the
+  same conditions as regards security.
+
+  The fact that you are presently reading this means that you have had
+  knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef _THREADTOOLS_H_
+#define _THREADTOOLS_H_
+
+// From the STL:
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Some functions to run independent tasks on several threads.
+ *
+ * These helpers are used by the parallel algorithms of the library.
+ * They use plain STL threads, created for each call: they are designed for
+ * tasks which are at least several microseconds long (function evaluations,
+ * simulation replicates, etc.).
+ */
+class ThreadTools
+{
+public:
+  /**
+   * @return The number of concurrent threads supported by the hardware, or 1 if unknown.
+   */
+  static unsigned int getNumberOfAvailableThreads();
+
+  /**
+   * @brief Run a task for each index in [0, n[, on several threads.
+   *
+   * Indices are distributed dynamically, so that tasks of unequal length are
+   * balanced between threads. The calling thread takes part in the computation,
+   * with thread index 0, so that at most nbThreads - 1 new threads are created.
+   * Each thread index is used by a single thread at a time, so that it can be
+   * used to access per-thread resources (function clones, buffers, etc.).
+   *
+   * If one or several tasks throw an exception, the remaining indices are
+   * skipped and the first exception is rethrown in the calling thread.
+   *
+   * @param n         The number of indices.
+   * @param nbThreads The maximum number of threads to use (0 means all available threads).
+   * @param task      The task, called with the index and the thread index in [0, nbThreads[.
+   */
+  static void parallelFor(size_t n, unsigned int nbThreads, const std::function<void (size_t, unsigned int)>& task);
+
+  /**
+   * @brief Sort a range on several threads.
+   *
+   * The range is split into one chunk per thread, chunks are sorted concurrently
+   * with std::sort, then merged pairwise, also concurrently, with std::inplace_merge.
+   * Small ranges are sorted by the calling thread only. As with std::sort,
+   * the order of equivalent elements is not preserved.
+   *
+   * @param first     The beginning of the range.
+   * @param last      The end of the range.
+   * @param nbThreads The maximum number of threads to use (0 means all available threads).
+   * @param comp      The comparison function.
+   */
+  template<class RandomIt, class Compare>
+  static void parallelSort(RandomIt first, RandomIt last, unsigned int nbThreads, Compare comp)
+  {
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    if (nbThreads == 0)
+      nbThreads = getNumberOfAvailableThreads();
+    size_t nbChunks = std::min(static_cast<size_t>(nbThreads), n / 16384);
+    if (nbChunks <= 1)
+    {
+      std::sort(first, last, comp);
+      return;
+    }
+    std::vector<RandomIt> bounds(nbChunks + 1);
+    for (size_t k = 0; k <= nbChunks; ++k)
+      bounds[k] = first + static_cast<typename std::iterator_traits<RandomIt>::difference_type>(n * k / nbChunks);
+    parallelFor(nbChunks, nbThreads, [&](size_t k, unsigned int) {
+        std::sort(bounds[k], bounds[k + 1], comp);
+      });
+    for (size_t width = 1; width < nbChunks; width *= 2)
+    {
+      size_t nbMerges = (nbChunks + 2 * width - 1) / (2 * width);
+      parallelFor(nbMerges, nbThreads, [&](size_t m, unsigned int) {
+          size_t lo = 2 * width * m;
+          size_t mid = std::min(lo + width, nbChunks);
+          size_t hi = std::min(lo + 2 * width, nbChunks);
+          if (mid < hi)
+            std::inplace_merge(bounds[lo], bounds[mid], bounds[hi], comp);
+        });
+    }
+  }
+
+  /**
+   * @brief Sort a range on several threads, using operator<.
+   */
+  template<class RandomIt>
+  static void parallelSort(RandomIt first, RandomIt last, unsigned int nbThreads = 0)
+  {
+    parallelSort(first, last, nbThreads, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+  }
+};
+} // end of namespace bpp.
+
+#endif // _THREADTOOLS_H_
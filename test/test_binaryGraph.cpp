@@ -0,0 +1,251 @@
+//
+// File: test_binaryGraph.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/AssociationGraphImplObserver.h"
+#include "../src/Bpp/Graph/AssociationTreeGraphImplObserver.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <iostream>
+#include <sstream>
+using namespace bpp;
+using namespace std;
+
+void freezeGraph(CompactGraph& graph) { graph.freeze(); }
+void freezeGraph(Graph&) {}
+
+bool isFrozen(const CompactGraph& graph) { return graph.isFrozen(); }
+bool isFrozen(const Graph&) { return true; }
+
+string toDot(const Graph& graph)
+{
+  ostringstream out;
+  graph.outputToDot(out, "tree");
+  return out.str();
+}
+
+void writeString(const string& object, string& data) { data = object; }
+void writeUInt(const unsigned int& object, string& data) { data = TextTools::toString(object); }
+shared_ptr<string> readString(const char* data, size_t size) { return make_shared<string>(data, size); }
+shared_ptr<unsigned int> readUInt(const char* data, size_t size) { return make_shared<unsigned int>(TextTools::to<unsigned int>(string(data, size))); }
+
+// Write a random tree with holes in its ids, read it back and
+// compare the topologies, the objects and the indexes.
+template<class Obs, class GraphImpl>
+bool checkRoundTrip(bool freeze, const string& path)
+{
+  size_t nbNodes = 1000;
+  vector<shared_ptr<string> > nodes;
+  vector<shared_ptr<unsigned int> > branches;
+  vector<size_t> fathers(nbNodes, 0);
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    nodes.push_back(make_shared<string>("node" + TextTools::toString(i)));
+    branches.push_back(make_shared<unsigned int>(static_cast<unsigned int>(i)));
+    if (i > 0)
+      fathers[i] = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(i);
+  }
+  Obs tree(true);
+  tree.createNodesFromFathers(nodes, fathers, branches, true);
+  for (size_t i = nbNodes - 1; i > nbNodes - 20; i--)
+    if (tree.getNumberOfSons(nodes[i]) == 0)
+      tree.deleteNode(nodes[i]);
+  if (freeze)
+    freezeGraph(*tree.getGraph());
+  tree.writeBinary(path, writeString, writeUInt);
+
+  Obs copy(true);
+  copy.readBinary(path, readString, readUInt);
+  bool test = copy.isValid() && toDot(*copy.getGraph()) == toDot(*tree.getGraph());
+  test &= isFrozen(*copy.getGraph());
+  test &= copy.getNumberOfNodes() == tree.getNumberOfNodes() && copy.getNumberOfEdges() == tree.getNumberOfEdges();
+  for (const auto& node : tree.getAllNodes())
+  {
+    shared_ptr<string> copied = copy.getNodeFromGraphid(tree.getNodeGraphid(node));
+    test &= copied && *copied == *node && copy.getNodeIndex(copied) == tree.getNodeIndex(node);
+  }
+  for (const auto& branch : tree.getAllEdges())
+  {
+    shared_ptr<unsigned int> copied = copy.getEdgeFromGraphid(tree.getEdgeGraphid(branch));
+    test &= copied && *copied == *branch && copy.getEdgeIndex(copied) == tree.getEdgeIndex(branch);
+  }
+  test &= *copy.getRoot() == *tree.getRoot();
+
+  // the read graph can be modified
+  shared_ptr<string> leaf = make_shared<string>("leaf");
+  copy.createNode(copy.getRoot(), leaf);
+  test &= copy.isValid() && copy.getFatherOfNode(leaf) == copy.getRoot();
+
+  // the topology alone
+  tree.writeBinary(path, nullptr, nullptr);
+  GraphImpl graph;
+  BinaryGraphFormat::read(path, graph);
+  test &= toDot(graph) == toDot(*tree.getGraph()) && graph.getRoot() == tree.getGraph()->getRoot();
+  return test;
+}
+
+// Undirected graphs list each edge from both of its nodes.
+template<class GraphImpl>
+bool checkUndirected(const string& path)
+{
+  AssociationGraphImplObserver<string, unsigned int, GraphImpl> graph(false);
+  vector<shared_ptr<string> > nodes;
+  for (unsigned int i = 0; i < 6; i++)
+  {
+    nodes.push_back(make_shared<string>(TextTools::toString(i)));
+    graph.createNode(nodes.back());
+  }
+  for (unsigned int i = 0; i < 6; i++)
+    graph.link(nodes[i], nodes[(i + 1) % 6], make_shared<unsigned int>(i));
+  graph.link(nodes[0], nodes[3], make_shared<unsigned int>(6));
+  graph.writeBinary(path, writeString, writeUInt);
+
+  AssociationGraphImplObserver<string, unsigned int, GraphImpl> copy(false);
+  copy.readBinary(path, readString, readUInt);
+  return toDot(*copy.getGraph()) == toDot(*graph.getGraph()) && copy.getNumberOfEdges() == 7;
+}
+
+uint32_t readU32(const string& content, size_t position)
+{
+  uint32_t v = 0;
+  for (unsigned int i = 0; i < 4; i++)
+    v |= static_cast<uint32_t>(static_cast<unsigned char>(content[position + i])) << (8 * i);
+  return v;
+}
+
+string withU32(string content, size_t position, uint32_t value)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    content[position + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  return content;
+}
+
+// Truncated and corrupted files must be rejected.
+bool checkErrors(const string& path)
+{
+  AssociationTreeGlobalGraphObserver<string, unsigned int> tree(true);
+  shared_ptr<string> root = make_shared<string>("root");
+  tree.createNode(root);
+  for (unsigned int i = 1; i < 10; i++)
+    tree.createNode(root, make_shared<string>(TextTools::toString(i)));
+  BinaryGraphFormat::write(*tree.getGraph(), path);
+  ifstream in(path.c_str(), ios::binary);
+  string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+  in.close();
+
+  bool test = true;
+  vector<string> wrongFiles;
+  wrongFiles.push_back(content.substr(0, content.size() - 4));
+  wrongFiles.push_back(content.substr(0, 20));
+  wrongFiles.push_back("NOTGRAPH" + content.substr(8));
+  string badVersion = content;
+  badVersion[8] = 99;
+  wrongFiles.push_back(badVersion);
+  string badNode = content;
+  badNode[48] = 50;
+  wrongFiles.push_back(badNode);
+
+  // header: root at 16, highest node and edge ids at 20 and 24, numbers
+  // of nodes and edges at 32 and 40; then 10 nodes, 9 edges and the
+  // offsets of the outgoing neighbors, each section aligned on 8 bytes
+  size_t nbIds = readU32(content, 20);
+  size_t outNeighbors = 48 + 40 + 112 + 8 * (nbIds + 1);
+  // sizes that do not fit in the file, to be rejected before any allocation
+  wrongFiles.push_back(withU32(content, 20, 0xFFFFFFF0));
+  wrongFiles.push_back(withU32(content, 36, 0x10000000));
+  wrongFiles.push_back(withU32(content, 44, 0x10000000));
+  // unknown root, edges above the highest edge id
+  wrongFiles.push_back(withU32(content, 16, static_cast<uint32_t>(nbIds)));
+  wrongFiles.push_back(withU32(content, 24, 0));
+  // neighbors linked by an unknown edge, by the edge of another neighbor,
+  // and not sorted
+  wrongFiles.push_back(withU32(content, outNeighbors + 4, 1000));
+  wrongFiles.push_back(withU32(content, outNeighbors + 4, readU32(content, outNeighbors + 12)));
+  wrongFiles.push_back(content.substr(0, outNeighbors) + content.substr(outNeighbors + 8, 8) + content.substr(outNeighbors, 8) + content.substr(outNeighbors + 16));
+  for (const auto& wrongFile : wrongFiles)
+  {
+    ofstream out(path.c_str(), ios::binary);
+    out << wrongFile;
+    out.close();
+    try
+    {
+      GlobalGraph wrong;
+      BinaryGraphFormat::read(path, wrong);
+      test = false;
+    }
+    catch (IOException&)
+    {}
+    try
+    {
+      CompactGraph wrong;
+      BinaryGraphFormat::read(path, wrong);
+      test = false;
+    }
+    catch (IOException&)
+    {}
+  }
+
+  // a failed writing leaves no temporary file
+  try
+  {
+    BinaryGraphFormat::write(*tree.getGraph(), path, [](uint32_t, uint32_t&, string&) -> bool {
+        throw Exception("stop");
+      });
+    test = false;
+  }
+  catch (Exception&)
+  {}
+  test &= !ifstream((path + ".tmp").c_str()).good();
+  return test;
+}
+
+int main()
+{
+  string path = "test_binaryGraph.bin";
+  bool test = checkRoundTrip<AssociationTreeGlobalGraphObserver<string, unsigned int>, GlobalGraph>(false, path);
+  test &= checkRoundTrip<AssociationTreeCompactGraphObserver<string, unsigned int>, CompactGraph>(false, path);
+  test &= checkRoundTrip<AssociationTreeCompactGraphObserver<string, unsigned int>, CompactGraph>(true, path);
+  test &= checkUndirected<GlobalGraph>(path) && checkUndirected<CompactGraph>(path);
+  test &= checkErrors(path);
+  remove(path.c_str());
+  cout << (test ? "Binary graph format: ok." : "Binary graph format: failed.") << endl;
+  return test ? 0 : 1;
+}
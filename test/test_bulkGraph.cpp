@@ -0,0 +1,175 @@
+//
+// File: test_bulkGraph.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/AssociationTreeGraphImplObserver.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <sstream>
+using namespace bpp;
+using namespace std;
+
+void freezeGraph(CompactGraph& graph) { graph.freeze(); }
+void freezeGraph(Graph&) {}
+
+string toDot(const Graph& graph)
+{
+  ostringstream out;
+  graph.outputToDot(out, "tree");
+  return out.str();
+}
+
+// Build a random tree from a parent array, compare it to the same tree
+// built node by node, then modify a copy of it.
+template<class Obs>
+bool checkBulk(bool freeze)
+{
+  size_t nbNodes = 2000;
+  vector<shared_ptr<string> > nodes;
+  vector<shared_ptr<unsigned int> > branches;
+  vector<size_t> fathers(nbNodes, 0);
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    nodes.push_back(make_shared<string>(TextTools::toString(i)));
+    branches.push_back(make_shared<unsigned int>(static_cast<unsigned int>(i)));
+    if (i > 0)
+      fathers[i] = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(i);
+  }
+
+  Obs bulk(true);
+  bulk.createNodesFromFathers(nodes, fathers, branches, true);
+  if (freeze)
+    freezeGraph(*bulk.getGraph());
+
+  Obs incremental(true);
+  incremental.createNode(nodes[0]);
+  for (size_t i = 1; i < nbNodes; i++)
+    incremental.createNode(nodes[fathers[i]], nodes[i], branches[i]);
+
+  bool test = bulk.isValid() && bulk.getRoot() == nodes[0];
+  test &= toDot(*bulk.getGraph()) == toDot(*incremental.getGraph());
+  for (size_t i = 1; i < nbNodes; i++)
+  {
+    test &= bulk.getFatherOfNode(nodes[i]) == nodes[fathers[i]];
+    test &= bulk.getEdgeToFather(nodes[i]) == branches[i];
+    test &= bulk.getNodeIndex(nodes[i]) == i && bulk.getEdgeIndex(branches[i]) == i - 1;
+  }
+
+  // the copy gets its own topology
+  string dot = toDot(*bulk.getGraph());
+  Obs copy(bulk);
+  copy.deleteNode(copy.getNodeFromGraphid(bulk.getNodeGraphid(nodes.back())));
+  test &= copy.getNumberOfNodes() == nbNodes - 1 && copy.isValid();
+  test &= bulk.getNumberOfNodes() == nbNodes && toDot(*bulk.getGraph()) == dot && bulk.isValid();
+  test &= *copy.getNodeFromGraphid(0) == "0" && copy.getNodeFromGraphid(0) != nodes[0];
+
+  // errors are detected before the graph is modified
+  Obs wrong(true);
+  vector<shared_ptr<string> > twoNodes(1, make_shared<string>("a"));
+  twoNodes.push_back(make_shared<string>("b"));
+  try
+  {
+    wrong.createNodesFromFathers(twoNodes, vector<size_t>({0, 1}), vector<shared_ptr<unsigned int> >());
+    test = false;
+  }
+  catch (Exception&)
+  {}
+  try
+  {
+    wrong.createNodesFromFathers(twoNodes, vector<size_t>({0, 2}), vector<shared_ptr<unsigned int> >());
+    test = false;
+  }
+  catch (Exception&)
+  {}
+  test &= wrong.getNumberOfNodes() == 0;
+  return test;
+}
+
+// Copies sharing their topology are modified on several threads, while
+// the original is read.
+template<class Obs>
+bool checkThreadedCopies()
+{
+  size_t nbNodes = 2000;
+  vector<shared_ptr<string> > nodes;
+  vector<size_t> fathers(nbNodes, 0);
+  for (size_t i = 0; i < nbNodes; i++)
+  {
+    nodes.push_back(make_shared<string>(TextTools::toString(i)));
+    if (i > 0)
+      fathers[i] = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(i);
+  }
+  Obs tree(true);
+  tree.createNodesFromFathers(nodes, fathers, vector<shared_ptr<unsigned int> >());
+  string dot = toDot(*tree.getGraph());
+
+  vector<unique_ptr<Obs> > copies;
+  for (size_t t = 0; t < 4; t++)
+    copies.push_back(unique_ptr<Obs>(new Obs(tree)));
+  vector<char> results(copies.size(), 0);
+  vector<thread> threads;
+  for (size_t t = 0; t < copies.size(); t++)
+    threads.push_back(thread([&copies, &results, t, nbNodes]() {
+        Obs& copy = *copies[t];
+        copy.createNode(copy.getRoot(), make_shared<string>("new"));
+        results[t] = copy.getNumberOfNodes() == nbNodes + 1 && copy.isValid();
+      }));
+  bool test = true;
+  for (size_t i = 0; i < 10; i++)
+    test &= toDot(*tree.getGraph()) == dot;
+  for (auto& th : threads)
+    th.join();
+  for (auto result : results)
+    test &= result != 0;
+  test &= tree.getNumberOfNodes() == nbNodes;
+  return test;
+}
+
+int main()
+{
+  bool test = checkBulk<AssociationTreeGlobalGraphObserver<string, unsigned int> >(false);
+  test &= checkBulk<AssociationTreeCompactGraphObserver<string, unsigned int> >(false);
+  test &= checkBulk<AssociationTreeCompactGraphObserver<string, unsigned int> >(true);
+  test &= checkThreadedCopies<AssociationTreeGlobalGraphObserver<string, unsigned int> >();
+  test &= checkThreadedCopies<AssociationTreeCompactGraphObserver<string, unsigned int> >();
+  cout << (test ? "Bulk graph construction: ok." : "Bulk graph construction: failed.") << endl;
+  return test ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+//
+// File: test_checkpoint.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Function/DownhillSimplexMethod.h>
+#include <Bpp/Numeric/Function/CheckpointListener.h>
+#include <Bpp/Numeric/AutoParameter.h>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include "PolynomialFunction.h"
+
+using namespace bpp;
+using namespace std;
+
+bool checkCheckpoint(const string& file) {
+  PolynomialFunction1 f;
+  DownhillSimplexMethod optimizer(&f);
+  optimizer.setProfiler(0);
+  optimizer.setMessageHandler(0);
+  optimizer.setConstraintPolicy(AutoParameter::CONSTRAINTS_AUTO);
+  {
+    //Small values so that the file gets compacted several times:
+    CheckpointListener checkpoint(file, 3, 5);
+    optimizer.addOptimizationListener(&checkpoint);
+    optimizer.init(f.getParameters());
+    for (unsigned int i = 0; i < 23; ++i)
+      optimizer.step();
+    checkpoint.flush();
+
+    vector<string> names;
+    OptimizationSnapshot snapshot;
+    if (!CheckpointListener::readLatestSnapshot(file, names, snapshot)) {
+      cerr << "No snapshot found." << endl;
+      return false;
+    }
+    cout << "Step " << snapshot.step << ", f=" << snapshot.value << endl;
+    if (snapshot.step != 23 || snapshot.value != optimizer.getFunctionValue() || names.size() != 3)
+      return false;
+    for (size_t i = 0; i < names.size(); ++i) {
+      cout << names[i] << "=" << snapshot.values[i] << endl;
+      if (snapshot.values[i] != optimizer.getParameterValue(names[i]))
+        return false;
+    }
+  }
+
+  //Resume from the checkpoint:
+  PolynomialFunction1 f2;
+  DownhillSimplexMethod optimizer2(&f2);
+  optimizer2.setProfiler(0);
+  optimizer2.setMessageHandler(0);
+  optimizer2.setConstraintPolicy(AutoParameter::CONSTRAINTS_AUTO);
+  if (!optimizer2.initFromCheckpoint(file, f2.getParameters()))
+    return false;
+  for (size_t i = 0; i < optimizer.getParameters().size(); ++i) {
+    string name = optimizer.getParameters()[i].getName();
+    if (optimizer2.getParameterValue(name) != optimizer.getParameterValue(name))
+      return false;
+  }
+
+  //A missing file is not an error:
+  remove(file.c_str());
+  PolynomialFunction1 f3;
+  DownhillSimplexMethod optimizer3(&f3);
+  optimizer3.setProfiler(0);
+  optimizer3.setMessageHandler(0);
+  optimizer3.setConstraintPolicy(AutoParameter::CONSTRAINTS_AUTO);
+  if (optimizer3.initFromCheckpoint(file, f3.getParameters()))
+    return false;
+  return true;
+}
+
+int main() {
+  string file = "test_checkpoint.bin";
+  bool test = false;
+  try {
+    test = checkCheckpoint(file);
+  } catch (Exception& e) {
+    cerr << e.what() << endl;
+  }
+  //Leave no file behind, whatever the result:
+  remove(file.c_str());
+  remove((file + ".tmp").c_str());
+  return (test ? 0 : 1);
+}
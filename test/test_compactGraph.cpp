@@ -0,0 +1,222 @@
+//
+// File: test_compactGraph.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/AssociationTreeGraphImplObserver.h"
+#include "../src/Bpp/Graph/AssociationDAGraphImplObserver.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+using namespace bpp;
+using namespace std;
+
+void freezeGraph(CompactGraph& graph) { graph.freeze(); }
+void freezeGraph(Graph&) {}
+
+// Build a tree, modify and reroot it, and record what the graph looks like
+// at each step. With freeze, the graph is frozen before each step.
+template<class Obs>
+string treeScenario(bool freeze)
+{
+  Obs grObs(true);
+  ostringstream out;
+
+  vector<shared_ptr<string> > nodes;
+  for (size_t i = 0; i < 6; i++)
+    nodes.push_back(shared_ptr<string>(new string(TextTools::toString(i))));
+
+  grObs.createNode(nodes[0]);
+  grObs.createNode(nodes[0], nodes[1]);
+  grObs.createNode(nodes[1], nodes[2]);
+  grObs.createNode(nodes[1], nodes[3]);
+  grObs.createNode(nodes[2], nodes[4], shared_ptr<unsigned int>(new unsigned int(5)));
+  grObs.getGraph()->outputToDot(out, "tree");
+  out << grObs.isValid() << endl;
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.link(nodes[2], nodes[0]);
+  grObs.getGraph()->outputToDot(out, "tree");
+  out << grObs.isValid() << endl;
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.unlink(nodes[2], nodes[0]);
+  out << grObs.isValid() << endl;
+  for (auto& son : grObs.getSons(nodes[1]))
+    out << *son << " ";
+  out << endl;
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  unique_ptr<AssociationTreeGraphObserver<string, unsigned int>::NodeIterator> sonsIt = grObs.sonsIterator(nodes[1]);
+  for ( ; !sonsIt->end(); sonsIt->next())
+    out << ***sonsIt << " ";
+  out << *grObs.getFatherOfNode(nodes[4]) << endl;
+
+  grObs.createNode(nodes[5]);
+  grObs.link(nodes[5], nodes[2]);
+  out << grObs.isValid() << endl;
+  grObs.unlink(nodes[5], nodes[2]);
+  grObs.link(nodes[4], nodes[5]);
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.getGraph()->makeUndirected();
+  grObs.rootAt(nodes[4]);
+  grObs.getGraph()->outputToDot(out, "tree");
+  grObs.outputToDot(out, "tree");
+  out << grObs.isValid() << endl;
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.deleteNode(nodes[3]);
+  grObs.getGraph()->outputToDot(out, "tree");
+  out << grObs.isValid() << " " << grObs.getNumberOfNodes() << " " << grObs.getNumberOfEdges() << endl;
+  for (auto& leaf : grObs.getAllLeaves())
+    out << *leaf << " ";
+  out << endl;
+
+  return out.str();
+}
+
+template<class Obs>
+string dagScenario(bool freeze)
+{
+  Obs grObs;
+  ostringstream out;
+
+  vector<shared_ptr<string> > nodes;
+  for (size_t i = 0; i < 6; i++)
+    nodes.push_back(shared_ptr<string>(new string(TextTools::toString(i))));
+
+  grObs.createNode(nodes[0]);
+  grObs.createNode(nodes[1]);
+  grObs.addFather(nodes[1], nodes[0]);
+  grObs.createNode(nodes[1], nodes[2]);
+  grObs.createNode(nodes[1], nodes[3]);
+  grObs.createNode(nodes[0], nodes[4]);
+  grObs.createNode(nodes[4], nodes[5]);
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.addFather(nodes[3], nodes[4]);
+  grObs.getGraph()->outputToDot(out, "dag");
+  out << grObs.isValid() << endl;
+  for (auto& father : grObs.getFathers(nodes[3]))
+    out << *father << " ";
+  out << endl;
+
+  if (freeze)
+    freezeGraph(*grObs.getGraph());
+  grObs.addFather(nodes[0], nodes[3]);
+  out << grObs.isValid() << endl;
+  grObs.removeFather(nodes[0], nodes[3]);
+  out << grObs.isValid() << endl;
+  for (auto& below : grObs.getBelowNodes(nodes[0]))
+    out << *below << " ";
+  out << endl;
+
+  return out.str();
+}
+
+int main() {
+  bool test = true;
+
+  // The compact graph must behave as the global one, frozen or not.
+  string global = treeScenario<AssociationTreeGlobalGraphObserver<string, unsigned int> >(false);
+  string compact = treeScenario<AssociationTreeCompactGraphObserver<string, unsigned int> >(false);
+  string frozen = treeScenario<AssociationTreeCompactGraphObserver<string, unsigned int> >(true);
+  cout << global << endl;
+  test &= (compact == global) && (frozen == global);
+  cout << "Trees are identical: " << (test ? "TRUE" : "FALSE") << endl;
+  if (compact != global)
+    cout << compact << endl;
+
+  global = dagScenario<AssociationDAGlobalGraphObserver<string, unsigned int> >(false);
+  compact = dagScenario<AssociationDAGCompactGraphObserver<string, unsigned int> >(false);
+  frozen = dagScenario<AssociationDAGCompactGraphObserver<string, unsigned int> >(true);
+  cout << global << endl;
+  test &= (compact == global) && (frozen == global);
+  cout << "DAGs are identical: " << (test ? "TRUE" : "FALSE") << endl;
+  if (compact != global)
+    cout << compact << endl;
+
+  // Random directed graph, compared edge by edge with the global one.
+  AssociationGlobalGraphObserver<unsigned int, unsigned int> gObs(true);
+  AssociationCompactGraphObserver<unsigned int, unsigned int> cObs(true);
+  vector<shared_ptr<unsigned int> > nodes;
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    nodes.push_back(shared_ptr<unsigned int>(new unsigned int(i)));
+    gObs.createNode(nodes[i]);
+    cObs.createNode(nodes[i]);
+  }
+  for (size_t i = 0; i < 1000; i++)
+  {
+    size_t a = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(nodes.size());
+    size_t b = RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(nodes.size());
+    try {
+      gObs.link(nodes[a], nodes[b]);
+      cObs.link(nodes[a], nodes[b]);
+    }
+    catch (Exception& e) {}
+  }
+  cObs.getGraph()->freeze();
+  test &= cObs.getGraph()->isFrozen();
+  test &= (gObs.getNumberOfEdges() == cObs.getNumberOfEdges());
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    test &= (gObs.getGraph()->getOutgoingEdges(gObs.getNodeGraphid(nodes[i])) == cObs.getGraph()->getOutgoingEdges(cObs.getNodeGraphid(nodes[i])));
+    test &= (gObs.getGraph()->getIncomingNeighbors(gObs.getNodeGraphid(nodes[i])) == cObs.getGraph()->getIncomingNeighbors(cObs.getNodeGraphid(nodes[i])));
+    test &= (gObs.isLeaf(nodes[i]) == cObs.isLeaf(nodes[i]));
+  }
+  test &= (gObs.getGraph()->isDA() == cObs.getGraph()->isDA());
+  test &= (gObs.getGraph()->containsReciprocalRelations() == cObs.getGraph()->containsReciprocalRelations());
+  test &= cObs.getGraph()->isFrozen();
+
+  // Any modification thaws the graph.
+  cObs.deleteNode(nodes[0]);
+  gObs.deleteNode(nodes[0]);
+  test &= !cObs.getGraph()->isFrozen();
+  test &= (gObs.getGraph()->getAllEdges() == cObs.getGraph()->getAllEdges());
+  cout << "Random graphs are identical: " << (test ? "TRUE" : "FALSE") << endl;
+
+  return (test ? 0 : 1);
+}
@@ -39,10 +39,30 @@ knowledge of the CeCILL license and that you accept its terms.
 
 #include <Bpp/Numeric/Prob/ExponentialDiscreteDistribution.h>
 #include <Bpp/Numeric/Prob/TruncatedExponentialDiscreteDistribution.h>
+#include <Bpp/Numeric/Prob/GammaDiscreteDistribution.h>
+#include <Bpp/Numeric/Prob/BetaDiscreteDistribution.h>
+#include <Bpp/Numeric/Prob/MixtureOfDiscreteDistributions.h>
+#include <Bpp/Numeric/Prob/ConstantDistribution.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
 
 using namespace bpp;
 using namespace std;
 
+// A distribution which replaces its categories after they were used.
+class TwoPointDistribution :
+  public ConstantDistribution
+{
+public:
+  TwoPointDistribution() : ConstantDistribution(0.) {}
+  void setPoints(double x1, double x2)
+  {
+    clearCategories_();
+    set(x1, 0.5);
+    set(x2, 0.5);
+    numberOfCategories_ = 2;
+  }
+};
+
 void testSumProbs(const DiscreteDistribution& dist) {
   cout << "Test sum of probabilities: ";
   cout.flush();
@@ -143,6 +163,110 @@ int main() {
     if (abs(trExpDist.getBound(2) - 0.7306344) > 0.0001) throw Exception("Unvalid bound.");
     if (abs(trExpDist.getUpperBound() - 1) > 0.0001) throw Exception("Unvalid bound.");
 
+    cout << "Check value categories and cumulative probabilities:" << endl;
+    const Vdouble& cats = expDist.getCategoriesArray();
+    const Vdouble& cumProbs = expDist.getCumulativeProbabilitiesArray();
+    if (cats.size() != 4 || cumProbs.size() != 5 || abs(cumProbs[4] - 1.) > 0.000001)
+      throw Exception("Unvalid arrays.");
+    if (expDist.getValueCategory(1.) != cats[0]) throw Exception("Unvalid category for 1.");
+    if (expDist.getValueCategory(2.) != cats[1]) throw Exception("Unvalid category for 2.");
+    if (expDist.getValueCategory(5.) != cats[2]) throw Exception("Unvalid category for 5.");
+    if (expDist.getValueCategory(10.) != cats[3]) throw Exception("Unvalid category for 10.");
+    if (abs(expDist.getInfCumulativeProbability(cats[2]) - 0.5) > 0.000001) throw Exception("Unvalid cumulative probability.");
+    if (abs(expDist.getSupCumulativeProbability(cats[2]) - 0.25) > 0.000001) throw Exception("Unvalid cumulative probability.");
+    if (abs(expDist.getIInfCumulativeProbability(cats[2]) - 0.75) > 0.000001) throw Exception("Unvalid cumulative probability.");
+    if (abs(expDist.getSSupCumulativeProbability(cats[2]) - 0.5) > 0.000001) throw Exception("Unvalid cumulative probability.");
+    if (abs(expDist.getProbability(cats[1]) - 0.25) > 0.000001) throw Exception("Unvalid probability.");
+    //Arrays follow changes of the distribution:
+    expDist.setNumberOfCategories(8);
+    if (expDist.getCategoriesArray().size() != 8 || expDist.getCategory(7) != expDist.getCategoriesArray()[7])
+      throw Exception("Arrays not updated.");
+
+    cout << "Check batched quantiles against the scalar functions:" << endl;
+    vector<double> probs, quantiles, cdf;
+    for (unsigned int i = 1; i < 50; ++i)
+      probs.push_back(static_cast<double>(i) / 50.);
+    double alphas[] = {0.1, 0.5, 1., 2.5, 20.};
+    for (double alpha : alphas) {
+      RandomTools::qGamma(probs, alpha, 2., quantiles);
+      RandomTools::pGamma(quantiles, alpha, 2., cdf);
+      for (size_t i = 0; i < probs.size(); ++i) {
+        if (abs(cdf[i] - probs[i]) > 1e-12) throw Exception("Unvalid batched Gamma quantile.");
+        if (abs(quantiles[i] - RandomTools::qGamma(probs[i], alpha, 2.)) > 1e-5 * (1. + quantiles[i])) throw Exception("Batched and scalar Gamma quantiles differ.");
+      }
+      RandomTools::qBeta(probs, alpha, 3., quantiles);
+      RandomTools::pBeta(quantiles, alpha, 3., cdf);
+      for (size_t i = 0; i < probs.size(); ++i) {
+        if (abs(cdf[i] - probs[i]) > 1e-12) throw Exception("Unvalid batched Beta quantile.");
+        if (abs(cdf[i] - RandomTools::pBeta(quantiles[i], alpha, 3.)) > 1e-6) throw Exception("Batched and scalar Beta probabilities differ.");
+      }
+      //Warm start from quantiles kept by the caller, for a close parameter value:
+      vector<double> cold;
+      RandomTools::qGamma(probs, alpha * 1.01, 2., cold);
+      RandomTools::qGamma(probs, alpha, 2., quantiles);
+      RandomTools::qGamma(probs, alpha * 1.01, 2., quantiles, true);
+      for (size_t i = 0; i < probs.size(); ++i)
+        if (abs(quantiles[i] - cold[i]) > 1e-10 * (1. + cold[i])) throw Exception("Warm-started Gamma quantiles differ.");
+    }
+
+    cout << "Check that discretizations do not depend on history:" << endl;
+    GammaDiscreteDistribution gammaDist(8, 0.5, 0.5);
+    gammaDist.setParameterValue("alpha", 3.);
+    gammaDist.setParameterValue("beta", 3.);
+    GammaDiscreteDistribution gammaRef(8, 3., 3.);
+    BetaDiscreteDistribution betaDist(8, 0.5, 2.);
+    betaDist.setParameterValue("alpha", 4.);
+    BetaDiscreteDistribution betaRef(8, 4., 2.);
+    for (size_t i = 0; i < 8; ++i) {
+      if (abs(gammaDist.getCategory(i) - gammaRef.getCategory(i)) > 1e-10) throw Exception("Gamma discretization depends on history.");
+      if (abs(betaDist.getCategory(i) - betaRef.getCategory(i)) > 1e-10) throw Exception("Beta discretization depends on history.");
+    }
+    //Discretizations use the scalar quantile functions:
+    for (size_t i = 0; i < 7; ++i) {
+      if (abs(gammaRef.getBound(i) - RandomTools::qGamma(static_cast<double>(i + 1) / 8., 3., 3.)) > 1e-12) throw Exception("Unvalid Gamma bound.");
+      if (abs(betaRef.getBound(i) - RandomTools::qBeta(static_cast<double>(i + 1) / 8., 4., 2.)) > 1e-12) throw Exception("Unvalid Beta bound.");
+    }
+
+    cout << "Check memoized discretizations:" << endl;
+    Vdouble cats3 = gammaDist.getCategories();
+    gammaDist.setParameterValue("alpha", 0.7);
+    gammaDist.setNumberOfCategories(4);
+    gammaDist.setNumberOfCategories(8);
+    gammaDist.setParameterValue("alpha", 3.);
+    if (gammaDist.getCategories() != cats3) throw Exception("Memoized discretization differs.");
+    gammaDist.setDiscretizationCacheSize(0);
+    gammaDist.discretize();
+    for (size_t i = 0; i < 8; ++i)
+      if (abs(gammaDist.getCategory(i) - cats3[i]) > 1e-10) throw Exception("Discretization without cache differs.");
+
+    cout << "Check mixtures after a change of one component:" << endl;
+    vector<DiscreteDistribution*> components;
+    components.push_back(new GammaDiscreteDistribution(4, 0.5, 0.5));
+    components.push_back(new ExponentialDiscreteDistribution(4, 2.));
+    vector<double> weights(2, 0.5);
+    MixtureOfDiscreteDistributions mixture(components, weights);
+    for (size_t i = 0; i < components.size(); ++i)
+      delete components[i];
+    mixture.setParameterValue("1_Gamma.alpha", 2.);
+    MixtureOfDiscreteDistributions mixtureRef(mixture);
+    mixtureRef.discretize();
+    testSumProbs(mixture);
+    if (mixture.getCategories() != mixtureRef.getCategories() || mixture.getNumberOfCategories() != 8)
+      throw Exception("Unvalid mixture update.");
+    GammaDiscreteDistribution gammaComp(4, 2., 0.5);
+    const Vdouble& compCats = gammaComp.getCategoriesArray();
+    for (size_t i = 0; i < compCats.size(); ++i)
+      if (abs(mixture.getProbability(compCats[i]) - 0.125) > 0.000001) throw Exception("Unvalid mixture component.");
+
+    cout << "Check modifications of the categories by a derived class:" << endl;
+    TwoPointDistribution twoPoints;
+    twoPoints.setPoints(1., 2.);
+    if (twoPoints.getCategory(1) != 2. || twoPoints.getProbability(1.) != 0.5 || twoPoints.rand() < 1.)
+      throw Exception("Unvalid categories.");
+    twoPoints.setPoints(3., 4.);
+    if (twoPoints.getCategory(0) != 3. || twoPoints.getProbability(4.) != 0.5 || twoPoints.rand() < 3.)
+      throw Exception("Stale categories after a modification.");
+
 
 
 
@@ -0,0 +1,142 @@
+//
+// File: test_graphRange.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/AssociationTreeGraphImplObserver.h"
+#include "../src/Bpp/Graph/AssociationDAGraphImplObserver.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+using namespace bpp;
+using namespace std;
+
+template<class Range>
+vector<typename Range::value_type> toVector(const Range& range)
+{
+  vector<typename Range::value_type> result;
+  for (auto id : range)
+    result.push_back(id);
+  return result;
+}
+
+void freezeGraph(CompactGraph& graph) { graph.freeze(); }
+void freezeGraph(Graph&) {}
+
+// The ranges of a random graph must list the same ids as the vectors.
+template<class GraphType>
+bool checkGraphRanges(bool frozen)
+{
+  GraphType graph(true);
+  vector<Graph::NodeId> nodes(1, graph.createNode());
+  for (unsigned int i = 0; i < 300; i++)
+  {
+    Graph::NodeId origin = nodes[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(nodes.size())];
+    nodes.push_back(graph.createNodeFromNode(origin));
+    if (i % 5 == 0)
+      nodes.push_back(graph.createNodeOnEdge(graph.getOutgoingEdges(origin).front()));
+  }
+  graph.deleteNode(nodes[3]);
+  graph.deleteNode(nodes[50]);
+  if (frozen)
+    freezeGraph(graph);
+
+  bool test = toVector(graph.nodeRange()) == graph.getAllNodes();
+  test &= graph.nodeRange().size() == graph.getNumberOfNodes();
+  for (auto node : graph.nodeRange())
+  {
+    test &= toVector(graph.outgoingNeighborRange(node)) == graph.getOutgoingNeighbors(node);
+    test &= toVector(graph.incomingNeighborRange(node)) == graph.getIncomingNeighbors(node);
+    test &= toVector(graph.outgoingEdgeRange(node)) == graph.getOutgoingEdges(node);
+    test &= toVector(graph.incomingEdgeRange(node)) == graph.getIncomingEdges(node);
+    test &= graph.outgoingNeighborRange(node).size() == graph.getNumberOfOutgoingNeighbors(node);
+  }
+  return test;
+}
+
+// The observers map the ids of the ranges to their objects, and skip the
+// nodes with no object.
+template<class Observer>
+bool checkObserverRanges()
+{
+  Observer tree(true);
+  vector<shared_ptr<string> > nodes;
+  for (unsigned int i = 0; i < 5; i++)
+  {
+    nodes.push_back(make_shared<string>("n" + to_string(i)));
+    tree.createNode(nodes.back());
+  }
+  tree.setRoot(nodes[0]);
+  for (unsigned int i = 1; i < 5; i++)
+    tree.link(nodes[i < 3 ? 0 : 1], nodes[i], make_shared<string>("b" + to_string(i)));
+
+  bool test = toVector(tree.sonRange(nodes[0])) == tree.getSons(nodes[0]);
+  test &= tree.getSons(nodes[0]) == (vector<shared_ptr<string> >{nodes[1], nodes[2]});
+  test &= toVector(tree.branchRange(nodes[1])) == tree.getBranches(nodes[1]);
+  test &= tree.branchRange(nodes[1]).size() == 2 && tree.sonRange(nodes[3]).empty();
+  test &= toVector(tree.incomingNeighborRange(nodes[4])) == (vector<shared_ptr<string> >{nodes[1]});
+  test &= toVector(tree.outgoingEdgeRange(nodes[0])) == tree.getOutgoingEdges(nodes[0]);
+
+  // a son which is not associated to an object is skipped
+  tree.dissociateNode(nodes[2]);
+  test &= toVector(tree.sonRange(nodes[0])) == (vector<shared_ptr<string> >{nodes[1]});
+  test &= tree.getSons(nodes[0]).size() == 1;
+  return test;
+}
+
+int main()
+{
+  bool test = checkGraphRanges<GlobalGraph>(false) && checkGraphRanges<CompactGraph>(false)
+              && checkGraphRanges<CompactGraph>(true);
+  test &= checkObserverRanges<AssociationTreeGlobalGraphObserver<string, string> >();
+  test &= checkObserverRanges<AssociationTreeCompactGraphObserver<string, string> >();
+
+  AssociationDAGlobalGraphObserver<string, string> dag;
+  shared_ptr<string> a = make_shared<string>("a"), b = make_shared<string>("b"), c = make_shared<string>("c");
+  dag.createNode(a);
+  dag.createNode(a, b);
+  dag.createNode(a, c);
+  dag.link(b, c);
+  test &= toVector(dag.fatherRange(c)) == dag.getFathers(c) && dag.getFathers(c).size() == 2;
+  test &= toVector(dag.sonRange(a)) == dag.getSons(a);
+
+  cout << (test ? "Graph ranges: ok." : "Graph ranges: failed.") << endl;
+  return test ? 0 : 1;
+}
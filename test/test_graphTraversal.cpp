@@ -0,0 +1,185 @@
+//
+// File: test_graphTraversal.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/TreeGraphImpl.h"
+#include "../src/Bpp/Graph/DAGraphImpl.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+using namespace bpp;
+using namespace std;
+
+template<class T>
+T pick(const vector<T>& v)
+{
+  return v[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(v.size())];
+}
+
+// Subtree sizes computed in post-order, and depths in pre-order, on
+// several threads, compared to the sequential queries of the tree.
+template<class Tree>
+bool checkTree(unsigned int nbThreads)
+{
+  Tree tree(true);
+  vector<Graph::NodeId> nodes(1, tree.createNode());
+  for (unsigned int i = 0; i < 3000; i++)
+    nodes.push_back(tree.createNodeFromNode(pick(nodes)));
+
+  bool test = true;
+  for (unsigned int round = 0; round < 3; round++)
+  {
+    vector<size_t> sizes(nodes.size() + 1, 0);
+    vector<unsigned int> depths(nodes.size() + 1, 0);
+    atomic<bool> badThread(false);
+    tree.parallelPostOrder([&](Graph::NodeId node, unsigned int threadId) {
+        badThread = badThread || threadId >= nbThreads;
+        sizes[node] = 1;
+        for (auto son : tree.sonRange(node))
+          sizes[node] += sizes[son];
+      }, nbThreads);
+    tree.parallelPreOrder([&](Graph::NodeId node, unsigned int) {
+        depths[node] = tree.hasFather(node) ? depths[tree.getFatherOfNode(node)] + 1 : 0;
+      }, nbThreads);
+
+    test &= !badThread;
+    test &= tree.getTraversalSchedule().getNumberOfNodes() == nodes.size();
+    for (auto node : nodes)
+    {
+      test &= sizes[node] == tree.getSubtreeNodes(node).size();
+      test &= depths[node] == tree.getDepth(node);
+    }
+
+    // the schedule follows the modifications of the tree
+    nodes.push_back(tree.createNodeFromNode(pick(nodes)));
+    Graph::NodeId node = pick(nodes);
+    Graph::NodeId father = pick(nodes);
+    if (node != tree.getRoot() && !tree.isAncestor(node, father))
+      tree.setFather(node, father);
+  }
+  return test;
+}
+
+// On a DAG, a node is processed after all its sons, or all its fathers.
+template<class DAG>
+bool checkDAG(unsigned int nbThreads)
+{
+  DAG dag;
+  vector<Graph::NodeId> nodes;
+  for (unsigned int i = 0; i < 1000; i++)
+  {
+    nodes.push_back(dag.createNode());
+    // edges from older to newer nodes keep the graph acyclic
+    set<Graph::NodeId> fathers;
+    for (unsigned int j = 0; j < 3 && i > 0; j++)
+      fathers.insert(nodes[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(i)]);
+    for (auto father : fathers)
+      dag.addSon(father, nodes.back());
+  }
+
+  unique_ptr<atomic<bool>[]> done(new atomic<bool>[nodes.size()]);
+  for (size_t i = 0; i < nodes.size(); i++)
+    done[i] = false;
+  atomic<bool> ordered(true);
+  dag.parallelPostOrder([&](Graph::NodeId node, unsigned int) {
+      for (auto son : dag.sonRange(node))
+        ordered = ordered && done[son];
+      done[node] = true;
+    }, nbThreads);
+  bool test = ordered;
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    test &= done[i];
+    done[i] = false;
+  }
+  dag.parallelPreOrder([&](Graph::NodeId node, unsigned int) {
+      for (auto father : dag.fatherRange(node))
+        ordered = ordered && done[father];
+      done[node] = true;
+    }, nbThreads);
+  test &= ordered;
+  test &= dag.getTraversalSchedule().getLevel(nodes[0]) == 0;
+
+  // an exception stops the traversal and is rethrown
+  try
+  {
+    dag.parallelPostOrder([&](Graph::NodeId node, unsigned int) {
+        if (node == nodes[500])
+          throw runtime_error("stop");
+      }, nbThreads);
+    test = false;
+  }
+  catch (runtime_error&)
+  {}
+  return test;
+}
+
+// A chain leaves a single node ready at a time: the other workers wait,
+// and must all stop at the end.
+template<class Tree>
+bool checkChain(unsigned int nbThreads)
+{
+  Tree tree(true);
+  vector<Graph::NodeId> nodes(1, tree.createNode());
+  for (unsigned int i = 0; i < 2000; i++)
+    nodes.push_back(tree.createNodeFromNode(nodes.back()));
+
+  vector<size_t> heights(nodes.size(), 0);
+  tree.parallelPostOrder([&](Graph::NodeId node, unsigned int) {
+      heights[node] = tree.isLeaf(node) ? 0 : heights[tree.getSons(node)[0]] + 1;
+    }, nbThreads);
+  return heights[nodes[0]] == nodes.size() - 1;
+}
+
+int main()
+{
+  bool test = true;
+  for (unsigned int nbThreads : {1u, 4u})
+  {
+    test &= checkTree<TreeGlobalGraph>(nbThreads) && checkTree<TreeCompactGraph>(nbThreads);
+    test &= checkDAG<DAGlobalGraph>(nbThreads) && checkDAG<DAGCompactGraph>(nbThreads);
+    test &= checkChain<TreeGlobalGraph>(nbThreads);
+  }
+  cout << (test ? "Parallel traversals: ok." : "Parallel traversals: failed.") << endl;
+  return test ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+//
+// File: test_graphValidity.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/TreeGraphImpl.h"
+#include "../src/Bpp/Graph/DAGraphImpl.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <algorithm>
+#include <vector>
+#include <iostream>
+using namespace bpp;
+using namespace std;
+
+template<class T>
+T pick(const vector<T>& v)
+{
+  return v[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(v.size())];
+}
+
+bool isSon(const Graph& graph, Graph::NodeId father, Graph::NodeId son)
+{
+  vector<Graph::NodeId> sons = graph.getOutgoingNeighbors(father);
+  return find(sons.begin(), sons.end(), son) != sons.end();
+}
+
+// Random edits of a tree: after each of them, the incremental validation
+// must agree with a full browsing of the graph. The edits that make the
+// graph invalid are undone at the next step.
+template<class Tree>
+bool checkTreeEdits(unsigned int nbEdits)
+{
+  Tree tree(true);
+  vector<Graph::NodeId> nodes(1, tree.createNode());
+  bool test = true;
+  unsigned int nbValid = 0;
+  // edit to undo: 0 none, 1 set father, 2 add son, 3 remove son
+  unsigned int toUndo = 0;
+  Graph::NodeId undoA = 0, undoB = 0;
+  for (unsigned int i = 0; i < nbEdits; i++)
+  {
+    Graph::NodeId nodeA = pick(nodes);
+    Graph::NodeId nodeB = pick(nodes);
+    if (toUndo == 1)
+      tree.setFather(undoB, undoA);
+    else if (toUndo == 2)
+      tree.addSon(undoA, undoB);
+    else if (toUndo == 3)
+      tree.removeSon(undoA, undoB);
+    else
+    {
+      switch (RandomTools::giveIntRandomNumberBetweenZeroAndEntry<unsigned int>(10))
+      {
+      case 0: case 1: case 2: case 3:
+        nodes.push_back(tree.createNode());
+        tree.addSon(nodeA, nodes.back());
+        break;
+      case 4: case 5:
+        // regraft a subtree, which may make a cycle
+        if (nodeB != tree.getRoot() && tree.getNumberOfIncomingNeighbors(nodeB) == 1 && !isSon(tree, nodeA, nodeB))
+        {
+          undoA = tree.getFatherOfNode(nodeB);
+          undoB = nodeB;
+          tree.setFather(nodeB, nodeA);
+          if (!tree.isTree())
+            toUndo = 1;
+        }
+        break;
+      case 6:
+        if (tree.hasFather(nodeB))
+        {
+          undoA = tree.getFatherOfNode(nodeB);
+          undoB = nodeB;
+          tree.removeSon(undoA, undoB);
+          toUndo = 2;
+        }
+        break;
+      case 7:
+        if (!isSon(tree, nodeA, nodeB))
+        {
+          undoA = nodeA;
+          undoB = nodeB;
+          tree.addSon(nodeA, nodeB);
+          toUndo = 3;
+        }
+        break;
+      case 8: case 9:
+        if (nodeB != tree.getRoot() && tree.getNumberOfSons(nodeB) == 0)
+        {
+          tree.deleteNode(nodeB);
+          nodes.erase(find(nodes.begin(), nodes.end(), nodeB));
+        }
+        break;
+      }
+      test &= (tree.isValid() == tree.isTree());
+      nbValid += tree.isValid();
+      continue;
+    }
+    toUndo = 0;
+    test &= (tree.isValid() == tree.isTree());
+    nbValid += tree.isValid();
+  }
+  // most of the steps must have been checked incrementally
+  return test && nbValid > nbEdits / 2;
+}
+
+template<class DAG>
+bool checkDAGEdits(unsigned int nbEdits)
+{
+  DAG dag;
+  vector<Graph::NodeId> nodes(1, dag.createNode());
+  bool test = true;
+  for (unsigned int i = 0; i < nbEdits; i++)
+  {
+    Graph::NodeId nodeA = pick(nodes);
+    Graph::NodeId nodeB = pick(nodes);
+    switch (RandomTools::giveIntRandomNumberBetweenZeroAndEntry<unsigned int>(6))
+    {
+    case 0: case 1:
+      nodes.push_back(dag.createNode());
+      dag.addSon(nodeA, nodes.back());
+      break;
+    case 2: case 3:
+      if (!isSon(dag, nodeA, nodeB))
+        dag.addSon(nodeA, nodeB);
+      break;
+    case 4:
+      if (isSon(dag, nodeA, nodeB))
+        dag.removeSon(nodeA, nodeB);
+      break;
+    case 5:
+      if (nodes.size() > 1)
+      {
+        dag.deleteNode(nodeB);
+        nodes.erase(find(nodes.begin(), nodes.end(), nodeB));
+      }
+      break;
+    }
+    test &= (dag.isValid() == dag.isDA());
+  }
+  return test;
+}
+
+// A caterpillar tree is deep enough to break recursive validations.
+template<class Tree>
+bool checkCaterpillar(unsigned int nbLeaves)
+{
+  Tree tree(true);
+  Graph::NodeId node = tree.createNode();
+  for (unsigned int i = 0; i < nbLeaves; i++)
+  {
+    tree.addSon(node, tree.createNode());
+    Graph::NodeId son = tree.createNode();
+    tree.addSon(node, son);
+    node = son;
+  }
+  bool test = tree.isValid();
+  tree.addSon(node, tree.getRoot());
+  test &= !tree.isValid();
+  return test;
+}
+
+int main() {
+  bool test = true;
+
+  test &= checkTreeEdits<TreeGlobalGraph>(2000);
+  test &= checkTreeEdits<TreeCompactGraph>(2000);
+  cout << "Tree validation: " << (test ? "OK" : "FAILED") << endl;
+
+  test &= checkDAGEdits<DAGlobalGraph>(2000);
+  test &= checkDAGEdits<DAGCompactGraph>(2000);
+  cout << "DAG validation: " << (test ? "OK" : "FAILED") << endl;
+
+  test &= checkCaterpillar<TreeGlobalGraph>(100000);
+  test &= checkCaterpillar<TreeCompactGraph>(100000);
+  cout << "Caterpillar validation: " << (test ? "OK" : "FAILED") << endl;
+
+  return (test ? 0 : 1);
+}
@@ -0,0 +1,180 @@
+//
+// File: test_kde.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/AdaptiveKernelDensityEstimation.h>
+#include <Bpp/Numeric/Matrix/MatrixTools.h>
+#include <Bpp/Numeric/NumConstants.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/VectorTools.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+//Direct implementation of the estimator, summing over all sample points:
+class BruteForceDensity
+{
+private:
+  RowMatrix<double> x_;
+  size_t n_, r_;
+  RowMatrix<double> w_;
+  double h_, c1_;
+  vector<double> lambda_;
+
+public:
+  BruteForceDensity(const RowMatrix<double>& x, double gamma):
+    x_(x), n_(x.getNumberOfColumns()), r_(x.getNumberOfRows()), w_(), h_(0), c1_(0), lambda_(n_, 1.)
+  {
+    RowMatrix<double> covar;
+    MatrixTools::covar(x_, covar);
+    MatrixTools::pow<double>(covar, -0.5, w_);
+    h_ = pow(4. / ((2 * static_cast<double>(r_) + 1.) * static_cast<double>(n_)), 1. / (static_cast<double>(r_) + 4.));
+    c1_ = pow(2. * NumConstants::PI(), -static_cast<double>(r_) / 2.) / (sqrt(MatrixTools::det(covar)) * static_cast<double>(n_) * pow(h_, static_cast<int>(r_)));
+    vector<double> pilot(n_), xi(r_);
+    double g = 0;
+    for (size_t i = 0; i < n_; i++)
+    {
+      for (size_t k = 0; k < r_; k++)
+        xi[k] = x_(k, i);
+      pilot[i] = density(xi);
+      g += log(pilot[i]);
+    }
+    g = exp(g / static_cast<double>(n_));
+    for (size_t i = 0; i < n_; i++)
+      lambda_[i] = pow(g / pilot[i], gamma);
+  }
+
+  double density(const vector<double>& x) const
+  {
+    double sum = 0;
+    for (size_t j = 0; j < n_; j++)
+    {
+      double s = 0;
+      for (size_t k = 0; k < r_; k++)
+      {
+        double u = 0;
+        for (size_t l = 0; l < r_; l++)
+          u += w_(k, l) * (x[l] - x_(l, j));
+        u /= h_ * lambda_[j];
+        s += u * u;
+      }
+      sum += exp(-0.5 * s) * pow(lambda_[j], -static_cast<double>(r_));
+    }
+    return c1_ * sum;
+  }
+};
+
+int main() {
+  RandomTools::setSeed(5);
+  size_t n = 600;
+  RowMatrix<double> x(2, n);
+  for (size_t j = 0; j < n; j++)
+  {
+    //A correlated mixture, so that local bandwidths vary:
+    double a = RandomTools::randGaussian(0., 1.);
+    double b = RandomTools::randGaussian(0., 0.5);
+    if (j % 3 == 0) a = RandomTools::randExponential(0.2) + 3.;
+    x(0, j) = a;
+    x(1, j) = 0.8 * a + b;
+  }
+  BruteForceDensity reference(x, 0.5);
+  AdaptiveKernelDensityEstimation exact(x, 0.5, 0.);
+  AdaptiveKernelDensityEstimation approx(x, 0.5, 1e-6);
+  AdaptiveKernelDensityEstimation exactPilot(exact);
+  exactPilot.setTolerance(1e-6);
+
+  //Sample points, then points on a grid, including far in the tails:
+  RowMatrix<double> q(2, n + 121);
+  for (size_t j = 0; j < n; j++)
+  {
+    q(0, j) = x(0, j);
+    q(1, j) = x(1, j);
+  }
+  for (size_t j = 0; j < 121; j++)
+  {
+    q(0, n + j) = -6. + static_cast<double>(j % 11) * 1.5;
+    q(1, n + j) = -6. + static_cast<double>(j / 11) * 1.5;
+  }
+  vector<double> d, dThreads;
+  approx.kDensities(q, d, 1);
+  approx.kDensities(q, dThreads, 4);
+  vector<double> p(2);
+  for (size_t j = 0; j < q.getNumberOfColumns(); j++)
+  {
+    p[0] = q(0, j);
+    p[1] = q(1, j);
+    double ref = reference.density(p);
+    double e = exact.kDensity(p);
+    if (abs(e - ref) > 1e-10 * ref)
+    {
+      cerr << "Exact density mismatch at point " << j << ": " << e << " vs " << ref << endl;
+      return 1;
+    }
+    //The tolerance applies to the sum given the pilot density, which is itself approximated:
+    if (abs(exactPilot.kDensity(p) - e) > 1e-6 * e || abs(d[j] - ref) > 1e-4 * ref)
+    {
+      cerr << "Approximated density mismatch at point " << j << ": " << d[j] << " vs " << ref << endl;
+      return 1;
+    }
+    if (dThreads[j] != d[j] || approx.kDensity(p) != d[j])
+    {
+      cerr << "Batched densities differ at point " << j << endl;
+      return 1;
+    }
+  }
+
+  //Entropy of a standard normal distribution:
+  vector<double> v(5000);
+  for (auto& vi : v)
+    vi = RandomTools::randGaussian(0., 1.);
+  double entropy = VectorTools::shannonContinuous<double, double>(v);
+  cout << "Continuous entropy: " << entropy << " (expected " << 0.5 * log(2. * 3.14159265358979 * exp(1.)) << ")" << endl;
+  if (abs(entropy - 0.5 * log(2. * 3.14159265358979 * exp(1.))) > 0.05)
+    return 1;
+  //The approximated estimator, on several threads, is opt-in:
+  double entropyApprox = VectorTools::shannonContinuous<double, double>(v, exp(1.), 1e-3, 4);
+  if (abs(entropyApprox - entropy) > 2e-3)
+  {
+    cerr << "Approximated entropy mismatch: " << entropyApprox << " vs " << entropy << endl;
+    return 1;
+  }
+  return 0;
+}
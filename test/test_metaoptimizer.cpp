@@ -0,0 +1,172 @@
+//
+// File: test_metaoptimizer.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Function/MetaOptimizer.h>
+#include <Bpp/Numeric/Function/SimpleMultiDimensions.h>
+#include <Bpp/Numeric/Function/PowellMultiDimensions.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include "PolynomialFunction.h"
+
+using namespace bpp;
+using namespace std;
+
+// Two parameters which are not independent: optimizing them concurrently overshoots.
+class CoupledFunction:
+  public virtual Function,
+  public AbstractParametrizable
+{
+  private:
+    double fval_;
+
+  public:
+    CoupledFunction() : AbstractParametrizable(""), fval_(0) {
+      addParameter_(new Parameter("x", 0));
+      addParameter_(new Parameter("y", 0));
+      fireParameterChanged(getParameters());
+    }
+
+    CoupledFunction* clone() const { return new CoupledFunction(*this); }
+
+  public:
+    void setParameters(const ParameterList& pl)
+    {
+      matchParametersValues(pl);
+    }
+    double getValue() const { return fval_; }
+
+    void fireParameterChanged(const ParameterList& pl) {
+      double x = getParameterValue("x");
+      double y = getParameterValue("y");
+      //Minimum at x=2, y=1:
+      fval_ = (x + y - 3) * (x + y - 3) + 0.1 * (x - y - 1) * (x - y - 1);
+    }
+};
+
+// Counts the evaluations of the original function and of its copies.
+class CountingFunction:
+  public PolynomialFunction1
+{
+  private:
+    bool isCopy_;
+    std::shared_ptr< std::atomic<unsigned int> > nbOriginalEvaluations_;
+    std::shared_ptr< std::atomic<unsigned int> > nbCopyEvaluations_;
+
+  public:
+    CountingFunction() :
+      isCopy_(false),
+      nbOriginalEvaluations_(std::make_shared< std::atomic<unsigned int> >(0)),
+      nbCopyEvaluations_(std::make_shared< std::atomic<unsigned int> >(0)) {}
+    CountingFunction(const CountingFunction& f) :
+      PolynomialFunction1(f), isCopy_(true),
+      nbOriginalEvaluations_(f.nbOriginalEvaluations_), nbCopyEvaluations_(f.nbCopyEvaluations_) {}
+    CountingFunction& operator=(const CountingFunction& f) = delete;
+
+    CountingFunction* clone() const { return new CountingFunction(*this); }
+
+    void fireParameterChanged(const ParameterList& pl) {
+      PolynomialFunction1::fireParameterChanged(pl);
+      (isCopy_ ? *nbCopyEvaluations_ : *nbOriginalEvaluations_)++;
+    }
+    unsigned int getNumberOfOriginalEvaluations() const { return *nbOriginalEvaluations_; }
+    unsigned int getNumberOfCopyEvaluations() const { return *nbCopyEvaluations_; }
+};
+
+Optimizer* newOptimizer(const string& type, Function* f) {
+  if (type == "Powell")
+    return new PowellMultiDimensions(f);
+  return new SimpleMultiDimensions(f);
+}
+
+//Optimize x and y of f, and return the distance to the expected minimum.
+template<class F>
+double optimize(F& f, unsigned int nbThreads, bool independent, double xMin, double yMin, unsigned int& nbConcurrent, unsigned int& nbSequential, const string& type = "Simple") {
+  MetaOptimizerInfos* desc = new MetaOptimizerInfos();
+  desc->addOptimizer("x", newOptimizer(type, &f), vector<string>(1, "x"), 0, MetaOptimizerInfos::IT_TYPE_FULL);
+  desc->addOptimizer("y", newOptimizer(type, &f), vector<string>(1, "y"), 0, MetaOptimizerInfos::IT_TYPE_FULL);
+  if (independent) {
+    vector<size_t> block;
+    block.push_back(0);
+    block.push_back(1);
+    desc->setIndependent(block);
+  }
+  MetaOptimizer optimizer(&f, desc);
+  optimizer.setNumberOfThreads(nbThreads);
+  optimizer.setProfiler(0);
+  optimizer.setMessageHandler(0);
+  optimizer.setVerbose(0);
+  optimizer.getStopCondition()->setTolerance(1e-8);
+  optimizer.init(f.getParameters().createSubList(vector<string>{"x", "y"}));
+  optimizer.optimize();
+  nbConcurrent = optimizer.getNumberOfConcurrentUpdates();
+  nbSequential = optimizer.getNumberOfSequentialUpdates();
+  double x = f.getParameterValue("x");
+  double y = f.getParameterValue("y");
+  cout << type << ", " << nbThreads << " thread(s): x=" << x << " y=" << y << " f=" << f.getValue()
+       << " concurrent=" << nbConcurrent << " sequential=" << nbSequential << endl;
+  return abs(x - xMin) + abs(y - yMin);
+}
+
+int main() {
+  unsigned int nbConcurrent, nbSequential;
+  //Independent parameters: the concurrent path is always taken.
+  PolynomialFunction1 f1, f2, f3;
+  if (optimize(f1, 1, false, 5, -2, nbConcurrent, nbSequential) > 1e-4 || nbConcurrent + nbSequential > 0) return 1;
+  if (optimize(f2, 1, true, 5, -2, nbConcurrent, nbSequential) > 1e-4 || nbConcurrent + nbSequential > 0) return 1;
+  if (optimize(f3, 2, true, 5, -2, nbConcurrent, nbSequential) > 1e-4 || nbConcurrent == 0 || nbSequential > 0) return 1;
+  if (abs(f3.getParameterValue("x") - f1.getParameterValue("x")) > 1e-6 || abs(f3.getParameterValue("y") - f1.getParameterValue("y")) > 1e-6) return 1;
+
+  //Optimizers with line searches run on the copies of the function too:
+  CountingFunction p1, p2;
+  if (optimize(p1, 1, false, 5, -2, nbConcurrent, nbSequential, "Powell") > 1e-4) return 1;
+  if (optimize(p2, 2, true, 5, -2, nbConcurrent, nbSequential, "Powell") > 1e-4 || nbConcurrent == 0 || nbSequential > 0) return 1;
+  if (abs(p2.getParameterValue("x") - p1.getParameterValue("x")) > 1e-6 || abs(p2.getParameterValue("y") - p1.getParameterValue("y")) > 1e-6) return 1;
+  cout << "Evaluations of the original function: " << p2.getNumberOfOriginalEvaluations()
+       << ", of its copies: " << p2.getNumberOfCopyEvaluations() << endl;
+  if (p2.getNumberOfCopyEvaluations() <= p2.getNumberOfOriginalEvaluations()) return 1;
+
+  //Coupled parameters wrongly declared independent: the merges are rejected, and the sequential fallback reaches the same point.
+  CoupledFunction g1, g2;
+  if (optimize(g1, 1, false, 2, 1, nbConcurrent, nbSequential) > 1e-3 || nbConcurrent + nbSequential > 0) return 1;
+  if (optimize(g2, 2, true, 2, 1, nbConcurrent, nbSequential) > 1e-3 || nbSequential == 0) return 1;
+  if (abs(g2.getParameterValue("x") - g1.getParameterValue("x")) > 1e-3 || abs(g2.getParameterValue("y") - g1.getParameterValue("y")) > 1e-3) return 1;
+  return 0;
+}
@@ -0,0 +1,114 @@
+//
+// File: test_metrics.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Function/BfgsMultiDimensions.h>
+#include <Bpp/Numeric/Function/OptimizationMetrics.h>
+#include <Bpp/Numeric/AutoParameter.h>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include "PolynomialFunction.h"
+
+using namespace bpp;
+using namespace std;
+
+int main() {
+  PolynomialFunction1Der1 f;
+  OptimizationMetrics metrics;
+  InstrumentedDerivableFirstOrderWrapper wf(&f, &metrics);
+  BfgsMultiDimensions optimizer(&wf);
+  optimizer.setProfiler(0);
+  optimizer.setMessageHandler(0);
+  optimizer.setVerbose(0);
+  optimizer.setConstraintPolicy(AutoParameter::CONSTRAINTS_AUTO);
+  optimizer.setMetrics(&metrics);
+  optimizer.init(wf.getParameters());
+  optimizer.optimize();
+  metrics.writeCsv(cout);
+
+  const OptimizationMetrics::PhaseStatistics& steps = metrics.getPhaseStatistics(OptimizationMetrics::STEP);
+  if (steps.count == 0 || steps.count != metrics.getCounter(OptimizationMetrics::STEPS))
+    return 1;
+  if (metrics.getPhaseStatistics(OptimizationMetrics::LINE_SEARCH).count != steps.count)
+    return 1;
+  if (metrics.getCounter(OptimizationMetrics::FUNCTION_EVALUATIONS) == 0 ||
+      metrics.getCounter(OptimizationMetrics::DERIVATIVE_EVALUATIONS) == 0)
+    return 1;
+  //Nested phases are shorter than the steps they belong to:
+  if (metrics.getPhaseStatistics(OptimizationMetrics::LINE_SEARCH).total > steps.total)
+    return 1;
+  uint64_t nb = 0;
+  for (size_t i = 0; i < OptimizationMetrics::NB_BINS; ++i)
+    nb += steps.histogram[i];
+  if (nb != steps.count)
+    return 1;
+  //Events are traced when they end, nested ones first:
+  const vector<OptimizationMetrics::TraceEvent>& events = metrics.getTrace();
+  if (events.size() == 0 || events.back().depth != 0)
+    return 1;
+  if (events[0].phase != OptimizationMetrics::FUNCTION_EVALUATION || events[0].depth != 1)
+    return 1;
+
+  ostringstream trace;
+  trace.precision(4);
+  metrics.writeChromeTrace(trace);
+  metrics.writeJson(trace);
+  metrics.writeCsv(trace);
+  if (trace.str().find("\"traceEvents\"") == string::npos)
+    return 1;
+  //The format of the caller's stream is left untouched:
+  if (trace.flags() != ostringstream().flags() || trace.precision() != 4)
+    return 1;
+
+  //Quotes in names are doubled in CSV:
+  metrics.registerCounter("say \"hi\"");
+  ostringstream csv;
+  metrics.writeCsv(csv);
+  if (csv.str().find("counter,\"say \"\"hi\"\"\",") == string::npos)
+    return 1;
+
+  //Disabled metrics record nothing:
+  metrics.reset();
+  metrics.enable(false);
+  optimizer.init(wf.getParameters());
+  optimizer.optimize();
+  if (metrics.getTrace().size() > 0 || metrics.getCounter(OptimizationMetrics::STEPS) > 0)
+    return 1;
+  return 0;
+}
@@ -0,0 +1,144 @@
+//
+// File: test_pointerHashMap.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/AssociationTreeGraphImplObserver.h"
+#include "../src/Bpp/Graph/PointerHashMap.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+using namespace bpp;
+using namespace std;
+
+// Random insertions and removals, compared to a std::map.
+bool checkMap()
+{
+  vector<shared_ptr<int> > keys(1, shared_ptr<int>());
+  for (int i = 0; i < 2000; i++)
+    keys.push_back(make_shared<int>(i));
+
+  PointerHashMap<int, size_t> hashMap;
+  map<shared_ptr<int>, size_t> reference;
+  bool test = true;
+  for (size_t step = 0; step < 50000; step++)
+  {
+    const shared_ptr<int>& key = keys[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(keys.size())];
+    if (RandomTools::flipCoin())
+    {
+      hashMap[key] = step;
+      reference[key] = step;
+    }
+    else
+      test &= hashMap.erase(key) == reference.erase(key);
+  }
+
+  test &= hashMap.size() == reference.size();
+  for (const auto& key : keys)
+  {
+    auto found = reference.find(key);
+    test &= hashMap.count(key) == reference.count(key);
+    if (found != reference.end())
+      test &= hashMap.find(key) != hashMap.end() && hashMap.at(key) == found->second && hashMap.find(key)->first == key;
+    else
+      test &= hashMap.find(key) == hashMap.end();
+  }
+
+  size_t nbEntries = 0;
+  for (const auto& entry : hashMap)
+  {
+    nbEntries++;
+    test &= reference.at(entry.first) == entry.second;
+  }
+  test &= nbEntries == reference.size();
+
+  try
+  {
+    hashMap.erase(keys[1]);
+    hashMap.at(keys[1]);
+    test = false;
+  }
+  catch (out_of_range&)
+  {}
+  return test;
+}
+
+// Batch conversions of an observer, into reused buffers.
+bool checkObserver()
+{
+  AssociationTreeGlobalGraphObserver<string, string> tree(true);
+  vector<shared_ptr<string> > nodes;
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    nodes.push_back(make_shared<string>("n" + to_string(i)));
+    tree.createNode(nodes.back());
+    tree.addNodeIndex(nodes.back());
+  }
+
+  vector<Graph::NodeId> ids;
+  vector<shared_ptr<string> > objects;
+  vector<AssociationGraphObserver<string, string>::NodeIndex> indexes;
+  tree.getNodeGraphids(nodes, ids);
+  tree.getNodesFromGraphid(ids, objects);
+  tree.getNodeIndexes(nodes, indexes);
+  bool test = objects == nodes && indexes == tree.getNodeIndexes(nodes);
+  for (size_t i = 0; i < nodes.size(); i++)
+    test &= ids[i] == tree.getNodeGraphid(nodes[i]);
+
+  // dissociated objects are skipped
+  tree.dissociateNode(nodes[4]);
+  tree.getNodesFromGraphid(ids, objects);
+  test &= objects.size() == nodes.size() - 1 && !tree.hasNode(nodes[4]);
+  test &= tree.getNumberOfNodes() == nodes.size() - 1;
+
+  // copies have their own objects
+  AssociationTreeGlobalGraphObserver<string, string> copy(tree);
+  test &= copy.getNumberOfNodes() == nodes.size() - 1 && *copy.getNodeFromGraphid(ids[0]) == "n0";
+  return test;
+}
+
+int main()
+{
+  bool test = checkMap() && checkObserver();
+  cout << (test ? "Pointer hash map: ok." : "Pointer hash map: failed.") << endl;
+  return test ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+//
+// File: test_random_fill.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/Random/Uniform01Xoshiro.h>
+#include <vector>
+#include <iostream>
+
+using namespace bpp;
+using namespace std;
+
+bool checkMoments(const string& name, const vector<double>& v, double mean, double variance)
+{
+  double s = 0, s2 = 0;
+  for (double x : v) {
+    s += x;
+    s2 += x * x;
+  }
+  double n = static_cast<double>(v.size());
+  double m = s / n;
+  double var = s2 / n - m * m;
+  cout << name << ": mean=" << m << " (" << mean << ") variance=" << var << " (" << variance << ")" << endl;
+  //Tolerances of about 5 standard errors:
+  return abs(m - mean) < 5. * sqrt(variance / n) && abs(var - variance) < 0.02 * variance;
+}
+
+int main() {
+  //The bulk uniform generation gives the same numbers as successive draws:
+  Uniform01Xoshiro g1(3), g2(3);
+  vector<double> v(1000);
+  RandomTools::fillUniform(v.data(), v.size(), 0., 1., g1);
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (v[i] != g2.drawNumber()) {
+      cerr << "fillUniform and drawNumber differ." << endl;
+      return 1;
+    }
+  }
+
+  RandomTools::setSeed(11);
+  v.resize(400000);
+  RandomTools::fillUniform(v.data(), v.size(), -1., 3.);
+  bool test = checkMoments("uniform", v, 1., 16. / 12.);
+  RandomTools::fillGaussian(v.data(), v.size(), 2., 4.);
+  test = checkMoments("gaussian", v, 2., 4.) && test;
+  //Fraction in the tail of the ziggurat (|x| > 3.4426 sd), expected 5.76e-4:
+  size_t nTail = 0;
+  for (double x : v)
+    if (abs(x - 2.) > 2. * 3.442619855899) nTail++;
+  double fTail = static_cast<double>(nTail) / static_cast<double>(v.size());
+  cout << "gaussian tail: " << fTail << endl;
+  test = test && fTail > 4e-4 && fTail < 7.5e-4;
+  RandomTools::fillExponential(v.data(), v.size(), 2.);
+  test = checkMoments("exponential", v, 2., 4.) && test;
+  RandomTools::fillGamma(v.data(), v.size(), 2.5, 2.);
+  test = checkMoments("gamma(2.5, 2)", v, 1.25, 0.625) && test;
+  RandomTools::fillGamma(v.data(), v.size(), 0.3);
+  test = checkMoments("gamma(0.3)", v, 0.3, 0.3) && test;
+  return (test ? 0 : 1);
+}
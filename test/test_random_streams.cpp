@@ -0,0 +1,122 @@
+//
+// File: test_random_streams.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Random/RandomStreams.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Utils/ThreadTools.h>
+#include <vector>
+#include <iostream>
+
+using namespace bpp;
+using namespace std;
+
+//Sum of 1000 draws for each of 64 tasks, each task using its own stream:
+vector<double> simulate(unsigned int nbThreads) {
+  RandomTools::setSeed(123);
+  vector<double> sums(64, 0.);
+  ThreadTools::parallelFor(sums.size(), nbThreads, [&sums](size_t i, unsigned int) {
+      Uniform01Xoshiro stream = RandomTools::getStream(i);
+      for (size_t k = 0; k < 1000; ++k)
+        sums[i] += RandomTools::randGaussian(0., 1., stream);
+    });
+  return sums;
+}
+
+int main() {
+  //Reference output of xoshiro256** from the state {1, 2, 3, 4}:
+  uint64_t state[4] = {1, 2, 3, 4};
+  Uniform01Xoshiro gen(0);
+  gen.setState(state);
+  uint64_t expected[4] = {11520ULL, 0ULL, 1509978240ULL, 1215971899390074240ULL};
+  for (size_t i = 0; i < 4; ++i) {
+    if (gen.drawInteger() != expected[i]) {
+      cerr << "Wrong xoshiro256** output." << endl;
+      return 1;
+    }
+  }
+
+  //Task streams are jumps of the master generator:
+  RandomStreams streams(42);
+  Uniform01Xoshiro master(42);
+  master.jump();
+  master.jump();
+  Uniform01Xoshiro s2 = streams.getStream(2);
+  Uniform01Xoshiro s0 = streams.getStream(0);
+  if (s2.drawInteger() != master.drawInteger() || s0.drawInteger() != Uniform01Xoshiro(42).drawInteger()) {
+    cerr << "Wrong task stream." << endl;
+    return 1;
+  }
+
+  //The default generator is reproducible after setSeed:
+  RandomTools::setSeed(7);
+  double x1 = RandomTools::giveRandomNumberBetweenZeroAndEntry(1.);
+  double x2 = RandomTools::giveRandomNumberBetweenZeroAndEntry(1.);
+  RandomTools::setSeed(7);
+  if (x1 != RandomTools::giveRandomNumberBetweenZeroAndEntry(1.) || x2 != RandomTools::giveRandomNumberBetweenZeroAndEntry(1.)) {
+    cerr << "Default generator is not reproducible." << endl;
+    return 1;
+  }
+
+  //Concurrent draws from the default generator, one stream per thread:
+  RandomTools::setSeed(7);
+  vector<double> means(8, 0.);
+  ThreadTools::parallelFor(means.size(), 4, [&means](size_t i, unsigned int) {
+      for (size_t k = 0; k < 10000; ++k) {
+        double u = RandomTools::giveRandomNumberBetweenZeroAndEntry(1.);
+        if (u <= 0. || u >= 1.) throw Exception("Out of range.");
+        means[i] += u / 10000.;
+      }
+    });
+  for (size_t i = 0; i < means.size(); ++i) {
+    cout << means[i] << " ";
+    if (abs(means[i] - 0.5) > 0.02) return 1;
+  }
+  cout << endl;
+
+  //Task streams give the same results whatever the number of threads:
+  vector<double> r1 = simulate(1);
+  vector<double> r4 = simulate(4);
+  for (size_t i = 0; i < r1.size(); ++i) {
+    if (r1[i] != r4[i]) {
+      cerr << "Results depend on the number of threads." << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
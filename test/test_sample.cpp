@@ -39,10 +39,12 @@ knowledge of the CeCILL license and that you accept its terms.
 
 #include <Bpp/Numeric/VectorTools.h>
 #include <Bpp/Numeric/Random/RandomTools.h>
+#include <Bpp/Numeric/Prob/GammaDiscreteDistribution.h>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 using namespace bpp;
 using namespace std;
@@ -124,7 +126,73 @@ int main() {
     cout << "---------------------------------------" << endl;
   }
 
+  cout << "-*- Check without replacement and weights -*-" << endl;
+  //The first element of the sample is a weighted pick:
+  map<string, unsigned int> firsts;
+  for (unsigned int i = 0; i < n; ++i) {
+    vector<string> sample(3);
+    RandomTools::getSample(pop, weights, sample, false);
+    if (sample[0] == sample[1] || sample[0] == sample[2] || sample[1] == sample[2])
+      return 1;
+    firsts[sample[0]]++;
+  }
+  for (size_t i = 0; i < pop.size(); ++i) {
+    double fobs = static_cast<double>(firsts[pop[i]]) / static_cast<double>(n);
+    cout << pop[i] << "\t" << firsts[pop[i]] << "\t" << fobs << "\t" << fexp[i] << endl;
+    if (abs(fobs - fexp[i]) > 0.02)
+      return 1;
+  }
+  cout << "---------------------------------------" << endl;
 
+  cout << "-*- Check multinomial counts -*-" << endl;
+  for (size_t m : {100, 1000000}) {
+    vector<size_t> counts = RandomTools::randMultinomialCounts(m, weights);
+    if (VectorTools::sum(counts) != m)
+      return 1;
+    for (size_t i = 0; i < pop.size(); ++i) {
+      double fobs = static_cast<double>(counts[i]) / static_cast<double>(m);
+      cout << pop[i] << "\t" << counts[i] << "\t" << fobs << "\t" << fexp[i] << endl;
+      if (abs(fobs - fexp[i]) > (m > 100 ? 0.005 : 0.2))
+        return 1;
+    }
+    cout << "---------------------------------------" << endl;
+  }
+  vector<size_t> states = RandomTools::randMultinomial(n, weights);
+  for (size_t i = 0; i < states.size(); ++i)
+    if (states[i] >= weights.size())
+      return 1;
+
+  cout << "-*- Check binomial draws -*-" << endl;
+  double sx = 0, sx2 = 0;
+  for (unsigned int i = 0; i < n; ++i) {
+    double x = static_cast<double>(RandomTools::randBinomial(1000, 0.3));
+    sx += x;
+    sx2 += x * x;
+  }
+  double bmean = sx / n, bvar = sx2 / n - bmean * bmean;
+  cout << "mean=" << bmean << " (300)\tvariance=" << bvar << " (210)" << endl;
+  if (abs(bmean - 300) > 1 || abs(bvar - 210) > 15)
+    return 1;
+
+  cout << "-*- Check discrete distribution draws -*-" << endl;
+  GammaDiscreteDistribution gamma(4, 0.5);
+  gamma.rand(); //Builds the alias table.
+  gamma.setParameterValue("alpha", 2.);
+  vector<double> cats = gamma.getCategories();
+  vector<unsigned int> catCounts(cats.size(), 0);
+  for (unsigned int i = 0; i < n; ++i) {
+    double x = gamma.rand();
+    size_t j = static_cast<size_t>(find(cats.begin(), cats.end(), x) - cats.begin());
+    if (j == cats.size())
+      return 1; //Category of the old distribution.
+    catCounts[j]++;
+  }
+  for (size_t j = 0; j < cats.size(); ++j) {
+    double fobs = static_cast<double>(catCounts[j]) / static_cast<double>(n);
+    cout << cats[j] << "\t" << catCounts[j] << "\t" << fobs << "\t0.25" << endl;
+    if (abs(fobs - 0.25) > 0.03)
+      return 1;
+  }
 
   return 0;
 }
@@ -38,6 +38,10 @@ knowledge of the CeCILL license and that you accept its terms.
 */
 
 #include <Bpp/Numeric/Stat/ContingencyTableTest.h>
+#include <Bpp/Numeric/Stat/ContingencyTableBatch.h>
+#include <Bpp/Numeric/Stat/StatTools.h>
+#include <Bpp/Numeric/Stat/StreamingFdr.h>
+#include <Bpp/Utils/ThreadTools.h>
 #include <Bpp/Numeric/VectorTools.h>
 #include <Bpp/Numeric/Random/ContingencyTableGenerator.h>
 #include <Bpp/Numeric/Random/RandomTools.h>
@@ -45,6 +49,8 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
+#include <algorithm>
 
 using namespace bpp;
 using namespace std;
@@ -82,6 +88,113 @@ int main() {
   if (abs(test2.getPValue() - 0.01324) > 0.01)
     return 1;
 
+  //Results of the parallel engine do not depend on the number of threads:
+  RandomTools::setSeed(42);
+  ContingencyTableTest test3(table, 5000, PermutationTestEngine(1, 100));
+  RandomTools::setSeed(42);
+  ContingencyTableTest test4(table, 5000, PermutationTestEngine(4, 100));
+  cout << test3.getPValue() << " \t" << test4.getPValue() << endl;
+  if (test3.getPValue() != test4.getPValue() || test3.getNumberOfPermutations() != 5000)
+    return 1;
+
+  //Early stopping when the p-value is clearly above the threshold:
+  vector< vector<size_t> > table2(2, vector<size_t>(2, 10));
+  table2[0][0] = 12;
+  PermutationTestEngine engine(2, 100);
+  engine.setEarlyStopping(0.05);
+  ContingencyTableTest test5(table2, 100000, engine);
+  cout << test5.getPValue() << " \t" << test5.getNumberOfPermutations() << endl;
+  if (test5.getNumberOfPermutations() >= 100000 || test5.getPValue() < 0.05)
+    return 1;
+
+  //Batched tests, with tables stored as a structure of arrays:
+  ContingencyTableBatch batch(2, 4);
+  vector<size_t> counts(8 * 3);
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t i = 0; i < 2; ++i)
+      for (size_t j = 0; j < 4; ++j)
+        counts[(i * 4 + j) * 3 + k] = table[i][j] + k * (i + j);
+  }
+  vector<double> stats, pvalues;
+  batch.chiSquareTests(counts, 3, stats, pvalues);
+  for (size_t k = 0; k < 3; ++k) {
+    vector< vector<size_t> > tablek(2, vector<size_t>(4));
+    for (size_t i = 0; i < 2; ++i)
+      for (size_t j = 0; j < 4; ++j)
+        tablek[i][j] = counts[(i * 4 + j) * 3 + k];
+    ContingencyTableTest testk(tablek, 0, false);
+    cout << stats[k] << " \t" << pvalues[k] << endl;
+    if (abs(stats[k] - testk.getStatistic()) > 1e-10 || abs(pvalues[k] - testk.getPValue()) > 1e-6)
+      return 1;
+  }
+
+  //fisher.test(rbind(c(3,1),c(1,3))); fisher.test(rbind(c(10,2),c(3,15)))
+  ContingencyTableBatch batch2(2, 2);
+  size_t counts2[] = {3, 10, 1, 2, 1, 3, 3, 15};
+  batch2.fisherExactTests(vector<size_t>(counts2, counts2 + 8), 2, pvalues);
+  cout << pvalues[0] << " \t" << pvalues[1] << endl;
+  if (abs(pvalues[0] - 0.4857) > 0.0001 || abs(pvalues[1] - 0.0005367) > 0.000001)
+    return 1;
+
+  //False discovery rates:
+  double pv[] = {0.01, 0.04, 0.03, 0.2};
+  vector<double> fdr = StatTools::computeFdr(vector<double>(pv, pv + 4));
+  if (abs(fdr[0] - 0.04) > 1e-12 || abs(fdr[1] - 0.04 * 4 / 3) > 1e-12 || abs(fdr[2] - 0.04 * 4 / 3) > 1e-12 || abs(fdr[3] - 0.2) > 1e-12)
+    return 1;
+  //Same values as the streaming computation, with ties and values above 1 before the cap:
+  double pvTies[] = {0.5, 0.01, 0.03, 0.03, 0.9, 0.02, 0.6, 0.04};
+  vector<double> pvTiesV(pvTies, pvTies + 8);
+  vector<double> fdrTies = StatTools::computeFdr(pvTiesV);
+  StreamingFdr streamingBh(StreamingFdr::METHOD_BH);
+  streamingBh.add(&pvTiesV[0], pvTiesV.size());
+  streamingBh.finalize();
+  for (size_t i = 0; i < pvTiesV.size(); ++i)
+    if (abs(fdrTies[i] - streamingBh.getAdjustedPValue(pvTiesV[i])) > 1e-12 || fdrTies[i] > 1.)
+      return 1;
+
+  size_t nbTests = 200000;
+  vector<double> scan(nbTests);
+  for (size_t i = 0; i < nbTests; ++i)
+    scan[i] = (i % 10 == 0 ? RandomTools::giveRandomNumberBetweenZeroAndEntry(1e-4) : RandomTools::giveRandomNumberBetweenZeroAndEntry(1.));
+  vector<double> sorted(scan);
+  ThreadTools::parallelSort(sorted.begin(), sorted.end(), 4);
+  if (!is_sorted(sorted.begin(), sorted.end()))
+    return 1;
+
+  StreamingFdr exact(StreamingFdr::METHOD_STOREY);
+  StreamingFdr approx(StreamingFdr::METHOD_STOREY, 1000);
+  exact.add(&scan[0], nbTests);
+  approx.add(&scan[0], nbTests);
+  exact.finalize();
+  approx.finalize();
+  cout << "pi0 = " << exact.getPi0() << endl;
+  if (!exact.isExact() || approx.isExact() || abs(exact.getPi0() - 0.9) > 0.01 || exact.getPi0() != approx.getPi0())
+    return 1;
+  for (size_t i = 0; i < nbTests; ++i) {
+    double q = exact.getAdjustedPValue(scan[i]);
+    double qa = approx.getAdjustedPValue(scan[i]);
+    if (qa < q - 1e-12 || qa > q * 1.01 + 1e-12)
+      return 1;
+  }
+
+  //Two passes on a file:
+  string inFile = "test_stats_pvalues.bin", outFile = "test_stats_fdr.bin";
+  FILE* f = fopen(inFile.c_str(), "wb");
+  fwrite(&scan[0], sizeof(double), nbTests, f);
+  fclose(f);
+  StreamingFdr::adjustFile(inFile, outFile, StreamingFdr::METHOD_STOREY);
+  vector<double> adjusted(nbTests);
+  f = fopen(outFile.c_str(), "rb");
+  size_t nbRead = fread(&adjusted[0], sizeof(double), nbTests, f);
+  fclose(f);
+  remove(inFile.c_str());
+  remove(outFile.c_str());
+  if (nbRead != nbTests)
+    return 1;
+  for (size_t i = 0; i < nbTests; ++i)
+    if (adjusted[i] != exact.getAdjustedPValue(scan[i]))
+      return 1;
+
   return 0;
 }
 
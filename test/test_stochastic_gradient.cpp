@@ -0,0 +1,165 @@
+//
+// File: test_stochastic_gradient.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 10:12 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include <Bpp/Numeric/Function/StochasticGradientMultiDimensions.h>
+#include <Bpp/Numeric/AbstractParametrizable.h>
+#include <Bpp/Numeric/Random/RandomTools.h>
+#include <vector>
+#include <iostream>
+
+using namespace bpp;
+using namespace std;
+
+//Least squares fit of y = a * x + b, one component per data point:
+class LinearRegression:
+  public virtual SumDecomposableFunction,
+  public AbstractParametrizable
+{
+  private:
+    vector<double> x_, y_;
+    double fval_;
+    double da_, db_;
+    bool compFirstDer_;
+
+  public:
+    LinearRegression(const vector<double>& x, const vector<double>& y):
+      AbstractParametrizable(""), x_(x), y_(y), fval_(0), da_(0), db_(0), compFirstDer_(true) {
+      addParameter_(new Parameter("a", 0));
+      addParameter_(new Parameter("b", 0));
+      fireParameterChanged(getParameters());
+    }
+
+    LinearRegression* clone() const { return new LinearRegression(*this); }
+
+  public:
+    void setParameters(const ParameterList& pl) { matchParametersValues(pl); }
+    double getValue() const { return fval_; }
+    void fireParameterChanged(const ParameterList& pl) {
+      vector<size_t> all(x_.size());
+      for (size_t i = 0; i < all.size(); ++i) all[i] = i;
+      vector<double> g;
+      fval_ = sum_(getParameterValue("a"), getParameterValue("b"), all, g);
+      da_ = g[0];
+      db_ = g[1];
+    }
+    void enableFirstOrderDerivatives(bool yn) { compFirstDer_ = yn; }
+    bool enableFirstOrderDerivatives() const { return compFirstDer_; }
+    double getFirstOrderDerivative(const std::string& variable) const {
+      return (variable == "a" ? da_ : db_);
+    }
+
+    size_t getNumberOfComponents() const { return x_.size(); }
+    double computeComponents(const ParameterList& parameters, const vector<size_t>& components, vector<double>& gradient) {
+      return sum_(parameters.getParameterValue("a"), parameters.getParameterValue("b"), components, gradient);
+    }
+
+  private:
+    double sum_(double a, double b, const vector<size_t>& components, vector<double>& gradient) const {
+      gradient.assign(2, 0.);
+      double s = 0;
+      for (size_t i : components) {
+        double r = a * x_[i] + b - y_[i];
+        s += r * r;
+        gradient[0] += 2 * r * x_[i];
+        gradient[1] += 2 * r;
+      }
+      return s;
+    }
+};
+
+bool fit(LinearRegression& f, const string& method, double rate, bool polish) {
+  ParameterList init = f.getParameters();
+  init.setParameterValue("a", 0);
+  init.setParameterValue("b", 0);
+  StochasticGradientMultiDimensions optimizer(&f, method);
+  optimizer.setProfiler(0);
+  optimizer.setMessageHandler(0);
+  optimizer.setVerbose(0);
+  optimizer.setBatchSize(50);
+  optimizer.setLearningRate(rate);
+  optimizer.setPolish(polish);
+  optimizer.setMaximumNumberOfEvaluations(20);
+  optimizer.getStopCondition()->setTolerance(1e-6);
+  optimizer.init(init);
+  optimizer.optimize();
+  double a = f.getParameterValue("a");
+  double b = f.getParameterValue("b");
+  cout << method << ": a=" << a << " b=" << b << " f=" << f.getValue()
+       << " updates=" << optimizer.getNumberOfUpdates()
+       << " component evaluations=" << optimizer.getNumberOfComponentEvaluations() << endl;
+  return abs(a - 2) < 0.05 && abs(b + 1) < 0.05 && abs(optimizer.getFunctionValue() - f.getValue()) < 1e-6;
+}
+
+//The value of each epoch, used by the stop condition, is the full function value:
+bool checkEpochValues(LinearRegression& f, const string& method, double rate) {
+  StochasticGradientMultiDimensions optimizer(&f, method);
+  optimizer.setProfiler(0);
+  optimizer.setMessageHandler(0);
+  optimizer.setVerbose(0);
+  optimizer.setBatchSize(50);
+  optimizer.setLearningRate(rate);
+  ParameterList init = f.getParameters();
+  init.setParameterValue("a", 0);
+  init.setParameterValue("b", 0);
+  optimizer.init(init);
+  for (unsigned int i = 0; i < 3; ++i) {
+    double value = optimizer.step();
+    ParameterList pl = optimizer.getParameters();
+    if (abs(value - f.f(pl)) > 1e-9 * f.f(pl) + 1e-12)
+      return false;
+  }
+  return true;
+}
+
+int main() {
+  RandomTools::setSeed(42);
+  size_t n = 2000;
+  vector<double> x(n), y(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = RandomTools::giveRandomNumberBetweenZeroAndEntry(2.) - 1.;
+    y[i] = 2. * x[i] - 1. + RandomTools::randGaussian(0, 0.01);
+  }
+  LinearRegression f(x, y);
+  bool test = fit(f, StochasticGradientMultiDimensions::METHOD_ADAM, 0.05, true);
+  //SVRG converges without the full-batch polish:
+  test = fit(f, StochasticGradientMultiDimensions::METHOD_SVRG, 0.1, false) && test;
+  test = checkEpochValues(f, StochasticGradientMultiDimensions::METHOD_ADAM, 0.05) && test;
+  test = checkEpochValues(f, StochasticGradientMultiDimensions::METHOD_SVRG, 0.1) && test;
+  return (test ? 0 : 1);
+}
@@ -0,0 +1,267 @@
+//
+// File: test_treeIndex.cpp
+// Created by: Bio++ Development Team
+// Created on: Sun Oct 18 2026
+//
+
+/*
+Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+This software is a computer program whose purpose is to provide classes
+for numerical calculus. This file is part of the Bio++ project.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security. 
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#include "../src/Bpp/Graph/TreeGraphImpl.h"
+#include "../src/Bpp/Numeric/Random/RandomTools.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <iostream>
+using namespace bpp;
+using namespace std;
+
+template<class T>
+T pick(const vector<T>& v)
+{
+  return v[RandomTools::giveIntRandomNumberBetweenZeroAndEntry<size_t>(v.size())];
+}
+
+// Queries answered by browsing the graph, to be compared with the index.
+
+vector<Graph::NodeId> pathToRoot(const Graph& tree, Graph::NodeId node)
+{
+  vector<Graph::NodeId> path(1, node);
+  vector<Graph::NodeId> fathers;
+  while (!(fathers = tree.getIncomingNeighbors(path.back())).empty())
+    path.push_back(fathers[0]);
+  return path;
+}
+
+Graph::NodeId slowMRCA(const Graph& tree, Graph::NodeId nodeA, Graph::NodeId nodeB)
+{
+  vector<Graph::NodeId> pathA = pathToRoot(tree, nodeA);
+  vector<Graph::NodeId> pathB = pathToRoot(tree, nodeB);
+  Graph::NodeId ancestor = pathA.back();
+  while (!pathA.empty() && !pathB.empty() && pathA.back() == pathB.back())
+  {
+    ancestor = pathA.back();
+    pathA.pop_back();
+    pathB.pop_back();
+  }
+  return ancestor;
+}
+
+void slowSubtree(const Graph& tree, Graph::NodeId node, vector<Graph::NodeId>& nodes, vector<Graph::NodeId>& leaves)
+{
+  nodes.push_back(node);
+  vector<Graph::NodeId> sons = tree.getOutgoingNeighbors(node);
+  if (sons.empty())
+    leaves.push_back(node);
+  for (auto son : sons)
+    slowSubtree(tree, son, nodes, leaves);
+}
+
+template<class Tree>
+bool checkQueries(const Tree& tree, const vector<Graph::NodeId>& nodes)
+{
+  bool test = true;
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    Graph::NodeId nodeA = pick(nodes);
+    Graph::NodeId nodeB = pick(nodes);
+    Graph::NodeId nodeC = pick(nodes);
+
+    Graph::NodeId ancestor = slowMRCA(tree, nodeA, nodeB);
+    test &= tree.MRCA(nodeA, nodeB) == ancestor;
+    test &= tree.MRCA(vector<Graph::NodeId>{nodeA, nodeB, nodeC}) == slowMRCA(tree, ancestor, nodeC);
+    test &= tree.isAncestor(ancestor, nodeA) && tree.isAncestor(ancestor, nodeB);
+    test &= tree.isAncestor(nodeA, nodeB) == (ancestor == nodeA);
+    test &= tree.getDepth(nodeA) == pathToRoot(tree, nodeA).size() - 1;
+
+    vector<Graph::NodeId> pathA = pathToRoot(tree, nodeA);
+    vector<Graph::NodeId> pathB = pathToRoot(tree, nodeB);
+    test &= tree.hasFather(nodeA) == (pathA.size() > 1);
+    if (pathA.size() > 1)
+    {
+      test &= tree.getFatherOfNode(nodeA) == pathA[1];
+      test &= tree.getEdgeToFather(nodeA) == tree.getEdge(pathA[1], nodeA);
+    }
+
+    // path from A up to the MRCA, then down to B
+    vector<Graph::NodeId> path(pathA.begin(), find(pathA.begin(), pathA.end(), ancestor));
+    path.push_back(ancestor);
+    vector<Graph::NodeId> down(pathB.begin(), find(pathB.begin(), pathB.end(), ancestor));
+    path.insert(path.end(), down.rbegin(), down.rend());
+    test &= tree.getNodePathBetweenTwoNodes(nodeA, nodeB) == path;
+    vector<Graph::EdgeId> edgePath;
+    for (size_t j = 0; j + 1 < path.size(); j++)
+      edgePath.push_back(tree.getAnyEdge(path[j], path[j + 1]));
+    test &= tree.getEdgePathBetweenTwoNodes(nodeA, nodeB) == edgePath;
+    path.erase(path.begin() + (find(pathA.begin(), pathA.end(), ancestor) - pathA.begin()));
+    test &= tree.getNodePathBetweenTwoNodes(nodeA, nodeB, false) == path;
+
+    vector<Graph::NodeId> subtree, leaves;
+    slowSubtree(tree, nodeA, subtree, leaves);
+    test &= tree.getSubtreeNodes(nodeA) == subtree;
+    test &= tree.getLeavesUnderNode(nodeA) == leaves;
+    vector<Graph::EdgeId> edges;
+    for (size_t j = 1; j < subtree.size(); j++)
+      edges.push_back(tree.getEdgeToFather(subtree[j]));
+    test &= tree.getSubtreeEdges(nodeA) == edges;
+  }
+
+  // sons before fathers in postorder
+  const TreeIndex& index = tree.getTreeIndex();
+  const vector<Graph::NodeId>& postOrder = index.getPostOrder();
+  test &= postOrder.size() == nodes.size() && postOrder.back() == tree.getRoot();
+  vector<size_t> position(*max_element(nodes.begin(), nodes.end()) + 1);
+  for (size_t j = 0; j < postOrder.size(); j++)
+    position[postOrder[j]] = j;
+  for (auto node : nodes)
+    if (tree.hasFather(node))
+      test &= position[node] < position[tree.getFatherOfNode(node)];
+
+  // an index updated along the modifications is the same as a new one
+  TreeIndex built;
+  built.build(tree);
+  test &= index.getRoot() == built.getRoot() && index.getPreOrder() == built.getPreOrder();
+  test &= postOrder == built.getPostOrder() && index.getLeaves() == built.getLeaves();
+  for (auto node : nodes)
+  {
+    test &= index.getFather(node) == built.getFather(node) && index.getEdgeToFather(node) == built.getEdgeToFather(node);
+    test &= index.getDepth(node) == built.getDepth(node) && index.getSubtreeEnd(node) == built.getSubtreeEnd(node);
+    test &= index.getLeavesBegin(node) == built.getLeavesBegin(node) && index.getLeavesEnd(node) == built.getLeavesEnd(node);
+  }
+  return test;
+}
+
+// Random trees, modified between rounds of queries: the index must
+// follow the modifications.
+template<class Tree>
+bool checkIndex()
+{
+  Tree tree(true);
+  vector<Graph::NodeId> nodes(1, tree.createNode());
+  for (unsigned int i = 0; i < 500; i++)
+    nodes.push_back(tree.createNodeFromNode(pick(nodes)));
+
+  bool test = checkQueries(tree, nodes);
+  for (unsigned int round = 0; round < 10 && test; round++)
+  {
+    // move subtrees
+    for (unsigned int i = 0; i < 20; i++)
+    {
+      Graph::NodeId node = pick(nodes);
+      Graph::NodeId father = pick(nodes);
+      if (node != tree.getRoot() && !tree.isAncestor(node, father))
+        tree.setFather(node, father);
+    }
+    tree.rootAt(pick(nodes));
+    if (round == 5)
+    {
+      Graph::NodeId node = pick(nodes);
+      if (node != tree.getRoot())
+      {
+        tree.setOutGroup(node);
+        nodes = tree.getAllNodes();
+        test &= tree.getFatherOfNode(node) == tree.getRoot();
+      }
+    }
+    test &= tree.isValid();
+    test &= checkQueries(tree, nodes);
+  }
+  return test;
+}
+
+// Leaves of an unrooted tree, where the sons of a node are all its
+// neighbors: a star with one longer branch.
+template<class Tree>
+bool checkUnrootedLeaves()
+{
+  Tree tree(false);
+  Graph::NodeId center = tree.createNode();
+  Graph::NodeId leafA = tree.createNodeFromNode(center);
+  Graph::NodeId leafB = tree.createNodeFromNode(center);
+  Graph::NodeId inner = tree.createNodeFromNode(center);
+  Graph::NodeId leafC = tree.createNodeFromNode(inner);
+  Graph::NodeId leafD = tree.createNodeFromNode(inner);
+
+  bool test = !tree.isRooted();
+  test &= tree.getLeavesUnderNode(center) == vector<Graph::NodeId>({leafA, leafB, leafC, leafD});
+  test &= tree.getLeavesUnderNode(leafA) == vector<Graph::NodeId>(1, leafA);
+  vector<Graph::NodeId> leaves = tree.getLeavesUnderNode(inner);
+  sort(leaves.begin(), leaves.end());
+  test &= leaves == vector<Graph::NodeId>({leafA, leafB, leafC, leafD});
+  return test;
+}
+
+// Concurrent queries on a tree whose index is not built yet: the index
+// is built once, by one of the threads, and copied with the tree.
+template<class Tree>
+bool checkConcurrentQueries()
+{
+  Tree tree(true);
+  vector<Graph::NodeId> nodes(1, tree.createNode());
+  for (unsigned int i = 0; i < 2000; i++)
+    nodes.push_back(tree.createNodeFromNode(pick(nodes)));
+  vector<Graph::NodeId> pairs, ancestors;
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    pairs.push_back(pick(nodes));
+    pairs.push_back(pick(nodes));
+    ancestors.push_back(slowMRCA(tree, pairs[2 * i], pairs[2 * i + 1]));
+  }
+
+  vector<char> results(4, 1);
+  vector<thread> threads;
+  for (size_t t = 0; t < results.size(); t++)
+    threads.push_back(thread([&tree, &pairs, &ancestors, &results, t]() {
+      for (size_t i = 0; i < ancestors.size(); i++)
+        if (tree.MRCA(pairs[2 * i], pairs[2 * i + 1]) != ancestors[i])
+          results[t] = 0;
+    }));
+  for (auto& th : threads)
+    th.join();
+
+  bool test = find(results.begin(), results.end(), 0) == results.end();
+  Tree copy(tree);
+  for (size_t i = 0; i < ancestors.size(); i++)
+    test &= copy.MRCA(pairs[2 * i], pairs[2 * i + 1]) == ancestors[i];
+  return test;
+}
+
+int main()
+{
+  bool test = checkIndex<TreeGlobalGraph>() && checkIndex<TreeCompactGraph>();
+  test &= checkUnrootedLeaves<TreeGlobalGraph>() && checkUnrootedLeaves<TreeCompactGraph>();
+  test &= checkConcurrentQueries<TreeGlobalGraph>() && checkConcurrentQueries<TreeCompactGraph>();
+  cout << (test ? "Tree index: ok." : "Tree index: failed.") << endl;
+  return test ? 0 : 1;
+}